@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name   : FreeRTOS.h
+*
+* Description : Host stand-in for the FreeRTOS kernel header, used by the
+*               Linux simulation of the application (see host/source/sim_rtos.c).
+*               It takes the settings of the application from FreeRTOSConfig.h.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "FreeRTOSConfig.h"
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+/* Memory of the statically allocated objects. The simulated kernel keeps
+ * its own control blocks, only the size matters to the application.
+ */
+typedef struct xSTATIC_TCB
+{
+    void *pvDummy[24];
+} StaticTask_t;
+
+typedef struct xSTATIC_TIMER
+{
+    void *pvDummy[8];
+} StaticTimer_t;
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define pdFALSE                     ((BaseType_t) 0)
+#define pdTRUE                      ((BaseType_t) 1)
+#define pdPASS                      (pdTRUE)
+#define pdFAIL                      (pdFALSE)
+
+#define portMAX_DELAY               ((TickType_t) 0xffffffffUL)
+#define portTICK_PERIOD_MS          ((TickType_t) 1000 / (configTICK_RATE_HZ))
+#define pdMS_TO_TICKS(xTimeInMs)    ((TickType_t) (((TickType_t) (xTimeInMs) * (TickType_t) (configTICK_RATE_HZ)) / (TickType_t) 1000U))
+
+/* The simulated kernel switches tasks when the running task blocks, and runs
+ * the interrupts between two tasks. The scheduler picks the highest priority
+ * task once the interrupt returns, no explicit yield is needed.
+ */
+#define portYIELD_FROM_ISR(x)       ((void) (x))
+
+#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#endif
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
+#define portGET_RUN_TIME_COUNTER_VALUE()    (0UL)
+#endif
+#ifndef traceTASK_SWITCHED_IN
+#define traceTASK_SWITCHED_IN()
+#endif
+#ifndef traceTASK_SWITCHED_OUT
+#define traceTASK_SWITCHED_OUT()
+#endif
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* INC_FREERTOS_H */
+
+/* [] END OF FILE */
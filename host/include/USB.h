@@ -0,0 +1,120 @@
+/******************************************************************************
+* File Name   : USB.h
+*
+* Description : Host stand-in for the core API of emUSB-Device, implemented by
+*               the simulated USB host in host/source/sim_usb.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef USB_H
+#define USB_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "Global.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define SEGGER_COUNTOF(a)                   (sizeof((a)) / sizeof((a)[0]))
+
+/* USB device state bits */
+#define USB_STAT_ATTACHED                   (0x04U)
+#define USB_STAT_READY                      (0x08U)
+#define USB_STAT_ADDRESSED                  (0x10U)
+#define USB_STAT_CONFIGURED                 (0x20U)
+#define USB_STAT_SUSPENDED                  (0x40U)
+
+/* Endpoint settings */
+#define USB_DIR_OUT                         (0U)
+#define USB_DIR_IN                          (1U)
+#define USB_TRANSFER_TYPE_ISO               (1U)
+#define USB_ISO_SYNC_TYPE_ASYNCHRONOUS      (1U)
+#define USB_ADD_EP_FLAG_USE_ISO_SYNC_TYPES  (1U << 0)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef struct
+{
+    U16 VendorId;
+    U16 ProductId;
+    const char *sVendorName;
+    const char *sProductName;
+    const char *sSerialNumber;
+} USB_DEVICE_INFO;
+
+typedef struct
+{
+    U16 MaxPacketSize;
+    U16 Interval;
+    U8 Flags;
+    U8 InDir;
+    U8 TransferType;
+    U8 ISO_Type;
+} USB_ADD_EP_INFO;
+
+typedef void USB_STATE_CALLBACK(void *pContext, U8 NewState);
+
+typedef struct USB_HOOK
+{
+    struct USB_HOOK *pNext;
+    USB_STATE_CALLBACK *cb;
+    void *pContext;
+} USB_HOOK;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void USBD_Init(void);
+void USBD_Start(void);
+int USBD_GetState(void);
+U8 USBD_AddEPEx(const USB_ADD_EP_INFO *pInfo, U8 *pBuffer, unsigned BufferSize);
+void USBD_SetDeviceInfo(const USB_DEVICE_INFO *pDeviceInfo);
+int USBD_RegisterSCHook(USB_HOOK *pHook, USB_STATE_CALLBACK *cb, void *pContext);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* USB_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,146 @@
+/******************************************************************************
+* File Name   : USB_Audio.h
+*
+* Description : Host stand-in for the Audio class API of emUSB-Device,
+*               implemented by the simulated USB host in host/source/sim_usb.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef USB_AUDIO_H
+#define USB_AUDIO_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "USB.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Events of the control callback */
+#define USB_AUDIO_PLAYBACK_START            (0U)
+#define USB_AUDIO_PLAYBACK_STOP             (1U)
+#define USB_AUDIO_RECORD_START              (2U)
+#define USB_AUDIO_RECORD_STOP               (3U)
+#define USB_AUDIO_SET_CUR                   (4U)
+#define USB_AUDIO_GET_CUR                   (5U)
+#define USB_AUDIO_SET_MIN                   (6U)
+#define USB_AUDIO_GET_MIN                   (7U)
+#define USB_AUDIO_SET_MAX                   (8U)
+#define USB_AUDIO_GET_MAX                   (9U)
+#define USB_AUDIO_SET_RES                   (10U)
+#define USB_AUDIO_GET_RES                   (11U)
+
+/* Control selectors */
+#define USB_AUDIO_MUTE_CONTROL              (0x01U)
+#define USB_AUDIO_VOLUME_CONTROL            (0x02U)
+#define USB_AUDIO_SAMPLING_FREQ_CONTROL     (0x81U)
+
+#define USB_AUDIO_TERMTYPE_INPUT_MICROPHONE (0x0201U)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef int USBD_AUDIO_HANDLE;
+
+typedef void USBD_AUDIO_TX_FUNC(void *pUserContext, const U8 **ppNextBuffer, U32 *pNextPacketSize);
+typedef void USBD_AUDIO_RX_FUNC(void *pUserContext, int NumBytesReceived, U8 **ppNextBuffer, U32 *pNextBufferSize);
+typedef int USBD_AUDIO_CONTROL_FUNC(void *pUserContext, U8 Event, U8 Unit, U8 ControlSelector, U8 *pBuffer,
+                                    U32 NumBytes, U8 InterfaceNo, U8 AltSetting);
+
+typedef struct
+{
+    U8 Flags;
+    U8 NrChannels;
+    U8 SubFrameSize;
+    U8 BitResolution;
+    U32 SamFreq;
+} USBD_AUDIO_FORMAT;
+
+typedef struct
+{
+    U8 InputTerminalID;
+    U8 OutputTerminalID;
+    U8 FeatureUnitID;
+} USBD_AUDIO_UNITS;
+
+typedef struct
+{
+    U8 Flags;
+    U8 Controls;
+    U8 TotalNrChannels;
+    U8 NumFormats;
+    const USBD_AUDIO_FORMAT *paFormats;
+    U16 bmChannelConfig;
+    U16 TerminalType;
+    USBD_AUDIO_UNITS *pUnits;
+} USBD_AUDIO_IF_CONF;
+
+typedef struct
+{
+    U8 EPIn;
+    U8 EPOut;
+    U16 OutPacketSize;
+    USBD_AUDIO_RX_FUNC *pfOnOut;
+    USBD_AUDIO_TX_FUNC *pfOnIn;
+    USBD_AUDIO_CONTROL_FUNC *pfOnControl;
+    void *pControlUserContext;
+    U8 NumInterfaces;
+    const USBD_AUDIO_IF_CONF *paInterfaces;
+    void *pOutUserContext;
+    void *pInUserContext;
+} USBD_AUDIO_INIT_DATA;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+USBD_AUDIO_HANDLE USBD_AUDIO_Add(const USBD_AUDIO_INIT_DATA *pInitData);
+void USBD_AUDIO_Set_Timeouts(USBD_AUDIO_HANDLE hInst, unsigned ReadTimeout, unsigned WriteTimeout);
+void USBD_AUDIO_Start_Play(USBD_AUDIO_HANDLE hInst, const U8 *pBuffer);
+void USBD_AUDIO_Stop_Play(USBD_AUDIO_HANDLE hInst);
+void USBD_AUDIO_Write_Task(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* USB_AUDIO_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/******************************************************************************
+* File Name   : cmsis_compiler.h
+*
+* Description : This file contains C versions of the Cortex-M4 intrinsics used by the
+*               application, to run the DSP extension paths on the Linux host.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef CMSIS_COMPILER_H
+#define CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define __STATIC_FORCEINLINE        static inline __attribute__((always_inline))
+
+#define __COMPILER_BARRIER()        __asm__ volatile ("" ::: "memory")
+#define __DMB()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* Halfword packing, the shift is a constant */
+#define __PKHBT(arg1, arg2, shift)  ((((uint32_t) (arg1)) & 0x0000FFFFUL) | \
+                                     ((((uint32_t) (arg2)) << (shift)) & 0xFFFF0000UL))
+#define __PKHTB(arg1, arg2, shift)  ((((uint32_t) (arg1)) & 0xFFFF0000UL) | \
+                                     ((((uint32_t) (arg2)) >> (shift)) & 0x0000FFFFUL))
+
+/* Signed saturation to a constant number of bits */
+#define __SSAT(arg1, arg2)          __sim_ssat((int32_t) (arg1), (arg2))
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+__STATIC_FORCEINLINE int32_t __sim_ssat(int32_t value, uint32_t bits)
+{
+    int32_t max = (int32_t) ((1UL << (bits - 1U)) - 1U);
+    int32_t min = -max - 1;
+
+    return (value > max) ? max : ((value < min) ? min : value);
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return (0U == value) ? 32U : (uint8_t) __builtin_clz(value);
+}
+
+/* Saturating subtraction of the halfwords */
+__STATIC_FORCEINLINE uint32_t __QSUB16(uint32_t op1, uint32_t op2)
+{
+    int32_t low = __sim_ssat((int32_t) (int16_t) op1 - (int32_t) (int16_t) op2, 16U);
+    int32_t high = __sim_ssat((int32_t) (int16_t) (op1 >> 16) - (int32_t) (int16_t) (op2 >> 16), 16U);
+
+    return ((uint32_t) low & 0x0000FFFFUL) | ((uint32_t) high << 16);
+}
+
+/* Halving addition of the halfwords */
+__STATIC_FORCEINLINE uint32_t __SHADD16(uint32_t op1, uint32_t op2)
+{
+    int32_t low = ((int32_t) (int16_t) op1 + (int32_t) (int16_t) op2) >> 1;
+    int32_t high = ((int32_t) (int16_t) (op1 >> 16) + (int32_t) (int16_t) (op2 >> 16)) >> 1;
+
+    return ((uint32_t) low & 0x0000FFFFUL) | ((uint32_t) high << 16);
+}
+
+/* Dual multiply of the halfwords, added to a 32-bit accumulator that wraps */
+__STATIC_FORCEINLINE uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    int32_t low = (int32_t) (int16_t) op1 * (int32_t) (int16_t) op2;
+    int32_t high = (int32_t) (int16_t) (op1 >> 16) * (int32_t) (int16_t) (op2 >> 16);
+
+    return op3 + (uint32_t) low + (uint32_t) high;
+}
+
+/* Dual 16 x 16 multiply, both products added to a 64-bit accumulator */
+__STATIC_FORCEINLINE uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc)
+{
+    int64_t low = (int64_t) ((int32_t) (int16_t) op1 * (int32_t) (int16_t) op2);
+    int64_t high = (int64_t) ((int32_t) (int16_t) (op1 >> 16) * (int32_t) (int16_t) (op2 >> 16));
+
+    return acc + (uint64_t) low + (uint64_t) high;
+}
+
+/* Word times the bottom halfword, top 32 bits of the 48-bit product */
+__STATIC_FORCEINLINE int32_t __SMULWB(int32_t op1, uint32_t op2)
+{
+    return (int32_t) (((int64_t) op1 * (int16_t) op2) >> 16);
+}
+
+/* Word times the top halfword, top 32 bits of the 48-bit product */
+__STATIC_FORCEINLINE int32_t __SMULWT(int32_t op1, uint32_t op2)
+{
+    return (int32_t) (((int64_t) op1 * (int16_t) (op2 >> 16)) >> 16);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CMSIS_COMPILER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/******************************************************************************
+* File Name   : cyhal.h
+*
+* Description : Host stand-in for the parts of the Cypress HAL used outside of
+*               audio_in_hal.c (debug UART of the console). The Audio In
+*               hardware is simulated behind the audio_in_hal API instead, see
+*               host/source/audio_in_hal_sim.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef CYHAL_H
+#define CYHAL_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define CY_RSLT_SUCCESS             ((cy_rslt_t) 0x00000000U)
+#define CYHAL_UART_RSLT_ERR_EMPTY   ((cy_rslt_t) 0x04020A00U)
+
+/* Interrupt of the debug UART, see cyhal_uart_enable_event() */
+#define CYHAL_UART_IRQ_RX_NOT_EMPTY ((cyhal_uart_event_t) (1UL << 8))
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef uint32_t cy_rslt_t;
+
+typedef uint32_t cyhal_uart_event_t;
+typedef void (*cyhal_uart_event_callback_t)(void *callback_arg, cyhal_uart_event_t event);
+
+typedef struct
+{
+    uint32_t instance;
+} cyhal_uart_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj);
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout);
+void cyhal_uart_register_callback(cyhal_uart_t *obj, cyhal_uart_event_callback_t callback, void *callback_arg);
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event, uint8_t intr_priority, bool enable);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CYHAL_H */
+
+/* [] END OF FILE */
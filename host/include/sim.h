@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name   : sim.h
+*
+* Description : This file contains the function prototypes and constants used
+*               to drive the Linux simulation of the application: virtual time,
+*               simulated PDM microphones and simulated USB host.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef SIM_H
+#define SIM_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Virtual time units */
+#define SIM_NS_PER_US               (1000ULL)
+#define SIM_NS_PER_MS               (1000000ULL)
+#define SIM_NS_PER_S                (1000000000ULL)
+
+/* Core clock of the simulated device, read through cycle_counter_get() */
+#define SIM_CORE_CLOCK_HZ           (150000000UL)
+
+/* Instances of the simulated Audio class, in the order of USBD_AUDIO_Add() */
+#define SIM_USB_MAX_INSTANCES       (3U)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/* Handler of a simulated interrupt */
+typedef void (*sim_event_handler_t)(void *arg);
+
+typedef struct sim_event
+{
+    uint64_t time_ns;
+    sim_event_handler_t handler;
+    void *arg;
+    bool pending;
+    struct sim_event *next;
+} sim_event_t;
+
+/* Sound pressure at a microphone (0 left, 1 right), as a fraction of the
+ * full scale of the PDM/PCM block at 0 dB gain
+ */
+typedef double (*sim_pdm_source_t)(void *arg, uint32_t microphone, double time_s);
+
+/* Called for each packet received by the simulated host */
+typedef void (*sim_usb_sink_t)(void *arg, uint32_t instance, const uint8_t *data, uint32_t size);
+
+typedef struct
+{
+    uint32_t packets;           /* Packets received */
+    uint32_t empty_packets;     /* Zero-length packets */
+    uint64_t bytes;             /* Bytes received */
+    uint32_t min_size;          /* Smallest non-empty packet, in bytes */
+    uint32_t max_size;          /* Largest packet, in bytes */
+    uint32_t oversized;         /* Packets larger than wMaxPacketSize */
+} sim_usb_stats_t;
+
+
+/******************************************************************************
+* Virtual Time (host/source/sim_rtos.c)
+******************************************************************************/
+uint64_t sim_now_ns(void);
+void sim_event_schedule(sim_event_t *event, uint64_t time_ns, sim_event_handler_t handler, void *arg);
+void sim_event_cancel(sim_event_t *event);
+bool sim_in_isr(void);
+void sim_run(uint32_t duration_ms);
+void sim_stop(void);
+void sim_set_cpu_charge(bool enable);
+void sim_set_cpu_cost(uint32_t cost_ns);
+
+
+/******************************************************************************
+* Simulated PDM Microphones (host/source/audio_in_hal_sim.c)
+******************************************************************************/
+void sim_pdm_set_source(sim_pdm_source_t source, void *arg);
+void sim_pdm_set_ppm(int32_t ppm);
+uint32_t sim_pdm_get_overflows(void);
+int32_t sim_pdm_get_gain(void);
+bool sim_pdm_is_running(void);
+bool sim_pdm_is_powered(void);
+bool sim_led_is_on(void);
+
+
+/******************************************************************************
+* Simulated USB Host (host/source/sim_usb.c)
+******************************************************************************/
+void sim_usb_set_sink(sim_usb_sink_t sink, void *arg);
+void sim_usb_connect(void);
+void sim_usb_disconnect(void);
+void sim_usb_suspend(void);
+void sim_usb_resume(void);
+void sim_usb_set_interface(uint32_t instance, uint8_t alt_setting);
+int sim_usb_set_cur(uint32_t instance, uint8_t selector, const uint8_t *buffer, uint32_t size);
+int sim_usb_get_cur(uint32_t instance, uint8_t selector, uint8_t *buffer, uint32_t size);
+void sim_usb_set_volume(uint32_t instance, int16_t volume);
+void sim_usb_set_mute(uint32_t instance, uint8_t mute);
+uint32_t sim_usb_get_max_packet_size(uint32_t instance);
+void sim_usb_get_stats(uint32_t instance, sim_usb_stats_t *stats);
+void sim_usb_clear_stats(uint32_t instance);
+
+
+/******************************************************************************
+* Simulated Debug UART (host/source/sim_platform.c)
+******************************************************************************/
+void sim_console_input(const char *keys);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SIM_H */
+
+/* [] END OF FILE */
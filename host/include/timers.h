@@ -0,0 +1,79 @@
+/******************************************************************************
+* File Name   : timers.h
+*
+* Description : Host stand-in for the FreeRTOS software timer API, implemented
+*               by the simulated kernel in host/source/sim_rtos.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+struct tmrTimerControl;
+typedef struct tmrTimerControl *TimerHandle_t;
+
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t xTimer);
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+TimerHandle_t xTimerCreateStatic(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                                 const UBaseType_t uxAutoReload, void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction, StaticTimer_t *pxTimerBuffer);
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+void *pvTimerGetTimerID(const TimerHandle_t xTimer);
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIMERS_H */
+
+/* [] END OF FILE */
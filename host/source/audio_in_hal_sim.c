@@ -0,0 +1,823 @@
+/*****************************************************************************
+* File Name    : audio_in_hal_sim.c
+*
+* Description  : This file contains the simulated hardware access layer of the
+*                Audio In path for the Linux simulation: PDM microphones with a
+*                clock offset, PDM/PCM RX FIFO, DMA periods and user LED.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_in_hal.h"
+#include "audio.h"
+#include "sim.h"
+#include "cy_utils.h"
+
+#include <math.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Depth of the PDM/PCM RX FIFO, in samples */
+#define SIM_PDM_FIFO_SAMPLES        (AUDIO_IN_HAL_FIFO_SAMPLES)
+
+/* Gain changes remembered, a change applies to the frames converted after it */
+#define SIM_PDM_GAIN_HISTORY        (16U)
+
+/* Default source: 1 KHz tone at -20 dBFS on both microphones */
+#define SIM_PDM_TONE_HZ             (1000.0)
+#define SIM_PDM_TONE_LEVEL          (0.1)
+
+#define SIM_PDM_PI                  (3.14159265358979323846)
+
+/* Frame rate in micro-Hz, to count frames in integers */
+#define SIM_PDM_UHZ_PER_HZ          (1000000ULL)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint64_t frame;
+    int32_t gain;
+} sim_pdm_gain_change_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Source of the sound and clock offset of the microphones */
+static sim_pdm_source_t sim_pdm_source = NULL;
+static void *sim_pdm_source_arg = NULL;
+static int32_t sim_pdm_ppm = 0;
+
+/* Configuration of the PDM/PCM block */
+static uint32_t sim_pdm_sample_rate = AUDIO_IN_SAMPLE_FREQ;
+static uint8_t sim_pdm_word_length = AUDIO_IN_BIT_RESOLUTION;
+static uint8_t sim_pdm_layout = AUDIO_IN_LAYOUT_STEREO;
+static int32_t sim_pdm_gain = AUDIO_IN_HAL_GAIN_MAX;
+static bool sim_pdm_powered = false;
+static bool sim_pdm_running = false;
+
+/* Conversion: start time, frame rate, and samples read from the RX FIFO */
+static uint64_t sim_pdm_start_ns;
+static uint64_t sim_pdm_rate_uhz;
+static uint64_t sim_pdm_consumed;
+static uint32_t sim_pdm_overflows = 0U;
+
+/* Gain of the frames, most recent change last */
+static sim_pdm_gain_change_t sim_pdm_gains[SIM_PDM_GAIN_HISTORY];
+static uint32_t sim_pdm_num_gains = 0U;
+
+/* DMA period */
+static audio_in_hal_period_callback_t sim_pdm_period_callback = NULL;
+static sim_event_t sim_pdm_dma_event;
+static void *sim_pdm_dma_buffer = NULL;
+static size_t sim_pdm_dma_count = 0U;
+static bool sim_pdm_dma_pending = false;
+
+/* User LED */
+static bool sim_led_on = false;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static double sim_pdm_tone(void *arg, uint32_t microphone, double time_s);
+static uint32_t sim_pdm_channels(void);
+static uint64_t sim_pdm_produced(void);
+static uint64_t sim_pdm_frame_time(uint64_t frame);
+static int32_t sim_pdm_frame_gain(uint64_t frame);
+static void sim_pdm_convert(void *buffer, uint64_t first, size_t count);
+static void sim_pdm_drain_overflow(void);
+static void sim_pdm_dma_complete(void *arg);
+static void sim_pdm_arm_dma(void);
+
+
+/*****************************************************************************
+* Function Name: sim_pdm_set_source
+******************************************************************************
+* Summary:
+*  Set the sound captured by the microphones.
+*
+* Parameters:
+*  source: Sound pressure at each microphone over time, NULL for the default
+*          1 KHz tone at -20 dBFS
+*  arg: Argument of the source
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_pdm_set_source(sim_pdm_source_t source, void *arg)
+{
+    sim_pdm_source = source;
+    sim_pdm_source_arg = arg;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_set_ppm
+******************************************************************************
+* Summary:
+*  Set the offset of the clock of the microphones from the nominal sample
+*  rate, which the USB SOF follows. Applies from the next start of the
+*  conversion.
+*
+* Parameters:
+*  ppm: Offset in parts per million, positive when the microphones run fast
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_pdm_set_ppm(int32_t ppm)
+{
+    sim_pdm_ppm = ppm;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_get_overflows
+******************************************************************************
+* Summary:
+*  Get the number of samples lost to overflows of the RX FIFO.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Samples lost
+*
+*****************************************************************************/
+uint32_t sim_pdm_get_overflows(void)
+{
+    return sim_pdm_overflows;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_get_gain
+******************************************************************************
+* Summary:
+*  Get the gain of the PDM/PCM block.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int32_t: Gain in 0.5 dB
+*
+*****************************************************************************/
+int32_t sim_pdm_get_gain(void)
+{
+    return sim_pdm_gain;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_is_running
+******************************************************************************
+* Summary:
+*  Check if the PDM/PCM block converts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while converting
+*
+*****************************************************************************/
+bool sim_pdm_is_running(void)
+{
+    return sim_pdm_running;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_is_powered
+******************************************************************************
+* Summary:
+*  Check if the audio subsystem clock runs.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while powered
+*
+*****************************************************************************/
+bool sim_pdm_is_powered(void)
+{
+    return sim_pdm_powered;
+}
+
+/*****************************************************************************
+* Function Name: sim_led_is_on
+******************************************************************************
+* Summary:
+*  Check if the user LED is on.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if on
+*
+*****************************************************************************/
+bool sim_led_is_on(void)
+{
+    return sim_led_on;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_tone
+******************************************************************************
+* Summary:
+*  Default source of sound, a tone on both microphones.
+*
+*****************************************************************************/
+static double sim_pdm_tone(void *arg, uint32_t microphone, double time_s)
+{
+    CY_UNUSED_PARAMETER(arg);
+    CY_UNUSED_PARAMETER(microphone);
+
+    return (SIM_PDM_TONE_LEVEL) * sin(2.0 * (SIM_PDM_PI) * (SIM_PDM_TONE_HZ) * time_s);
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_channels
+******************************************************************************
+* Summary:
+*  Get the number of microphones converted.
+*
+*****************************************************************************/
+static uint32_t sim_pdm_channels(void)
+{
+    return ((AUDIO_IN_LAYOUT_LEFT == sim_pdm_layout) || (AUDIO_IN_LAYOUT_RIGHT == sim_pdm_layout)) ? 1U : 2U;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_produced
+******************************************************************************
+* Summary:
+*  Get the number of frames converted since the start of the conversion.
+*
+*****************************************************************************/
+static uint64_t sim_pdm_produced(void)
+{
+    unsigned __int128 elapsed;
+
+    if (!sim_pdm_running)
+    {
+        return 0U;
+    }
+
+    elapsed = (unsigned __int128) (sim_now_ns() - sim_pdm_start_ns);
+    return (uint64_t) ((elapsed * sim_pdm_rate_uhz) / ((unsigned __int128) (SIM_NS_PER_S) * (SIM_PDM_UHZ_PER_HZ)));
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_frame_time
+******************************************************************************
+* Summary:
+*  Get the virtual time at which a frame is converted.
+*
+*****************************************************************************/
+static uint64_t sim_pdm_frame_time(uint64_t frame)
+{
+    unsigned __int128 scaled = (unsigned __int128) frame * (SIM_NS_PER_S) * (SIM_PDM_UHZ_PER_HZ);
+
+    /* Round up, the frame is available once converted */
+    return sim_pdm_start_ns + (uint64_t) ((scaled + sim_pdm_rate_uhz - 1U) / sim_pdm_rate_uhz);
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_frame_gain
+******************************************************************************
+* Summary:
+*  Get the gain applied to a frame.
+*
+*****************************************************************************/
+static int32_t sim_pdm_frame_gain(uint64_t frame)
+{
+    uint32_t i = sim_pdm_num_gains;
+
+    while (i > 0U)
+    {
+        i--;
+        if (frame >= sim_pdm_gains[i].frame)
+        {
+            return sim_pdm_gains[i].gain;
+        }
+    }
+
+    return (sim_pdm_num_gains > 0U) ? sim_pdm_gains[0].gain : sim_pdm_gain;
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_convert
+******************************************************************************
+* Summary:
+*  Write converted samples the way the PDM/PCM block does: interleaved
+*  microphones, halfwords up to 16 bits and right-aligned words above.
+*
+*****************************************************************************/
+static void sim_pdm_convert(void *buffer, uint64_t first, size_t count)
+{
+    sim_pdm_source_t source = (NULL != sim_pdm_source) ? sim_pdm_source : sim_pdm_tone;
+    uint32_t channels = sim_pdm_channels();
+    double full_scale = ldexp(1.0, (int) sim_pdm_word_length - 1);
+    uint64_t sample;
+    uint64_t frame;
+    uint32_t microphone;
+    double value;
+    size_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        sample = first + i;
+        frame = sample / channels;
+        microphone = (AUDIO_IN_LAYOUT_RIGHT == sim_pdm_layout) ? 1U : (uint32_t) (sample % channels);
+
+        value = source(sim_pdm_source_arg, microphone,
+                       (double) (sim_pdm_frame_time(frame)) / (double) (SIM_NS_PER_S));
+        value *= pow(10.0, (double) sim_pdm_frame_gain(frame) / 40.0);
+        value = nearbyint(value * full_scale);
+        if (value > (full_scale - 1.0))
+        {
+            value = full_scale - 1.0;
+        }
+        else if (value < -full_scale)
+        {
+            value = -full_scale;
+        }
+
+        if (2U == AUDIO_IN_HAL_SAMPLE_SIZE(sim_pdm_word_length))
+        {
+            ((int16_t *) buffer)[i] = (int16_t) value;
+        }
+        else
+        {
+            ((int32_t *) buffer)[i] = (int32_t) value;
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_drain_overflow
+******************************************************************************
+* Summary:
+*  Drop the samples that did not fit in the RX FIFO while nothing read it.
+*
+*****************************************************************************/
+static void sim_pdm_drain_overflow(void)
+{
+    uint64_t produced = sim_pdm_produced() * sim_pdm_channels();
+
+    if ((produced - sim_pdm_consumed) > (SIM_PDM_FIFO_SAMPLES))
+    {
+        sim_pdm_overflows += (uint32_t) ((produced - sim_pdm_consumed) - (SIM_PDM_FIFO_SAMPLES));
+        sim_pdm_consumed = produced - (SIM_PDM_FIFO_SAMPLES);
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_arm_dma
+******************************************************************************
+* Summary:
+*  Schedule the completion of the DMA period, once the conversion reaches
+*  its last sample.
+*
+*****************************************************************************/
+static void sim_pdm_arm_dma(void)
+{
+    uint32_t channels = sim_pdm_channels();
+    uint64_t last_frame;
+
+    if (!sim_pdm_dma_pending || !sim_pdm_running)
+    {
+        return;
+    }
+
+    sim_pdm_drain_overflow();
+    last_frame = (sim_pdm_consumed + sim_pdm_dma_count + channels - 1U) / channels;
+    sim_event_schedule(&sim_pdm_dma_event, sim_pdm_frame_time(last_frame), sim_pdm_dma_complete, NULL);
+}
+
+/*****************************************************************************
+* Function Name: sim_pdm_dma_complete
+******************************************************************************
+* Summary:
+*  DMA completion interrupt.
+*
+*****************************************************************************/
+static void sim_pdm_dma_complete(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    sim_pdm_convert(sim_pdm_dma_buffer, sim_pdm_consumed, sim_pdm_dma_count);
+    sim_pdm_consumed += sim_pdm_dma_count;
+    sim_pdm_dma_pending = false;
+
+    if (NULL != sim_pdm_period_callback)
+    {
+        sim_pdm_period_callback();
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_clock_init
+******************************************************************************
+* Summary:
+*  Start the audio subsystem clock.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_clock_init(void)
+{
+    sim_pdm_powered = true;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_init
+******************************************************************************
+* Summary:
+*  Initialize the PDM/PCM block.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_init(void)
+{
+    sim_pdm_running = false;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_set_format
+******************************************************************************
+* Summary:
+*  Set the sample rate, word length and microphones of the conversion. Like
+*  the PDM/PCM block, a change stops the conversion.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*  bit_resolution: Bits per sample, capped to AUDIO_IN_HAL_MAX_WORD_LENGTH
+*  layout: Microphones captured (AUDIO_IN_LAYOUT_x)
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_set_format(uint32_t sample_rate, uint8_t bit_resolution, uint8_t layout)
+{
+    uint8_t word_length = (bit_resolution > (AUDIO_IN_HAL_MAX_WORD_LENGTH)) ? (AUDIO_IN_HAL_MAX_WORD_LENGTH) : bit_resolution;
+
+    if (AUDIO_IN_LAYOUT_DOWNMIX == layout)
+    {
+        layout = AUDIO_IN_LAYOUT_STEREO;
+    }
+
+    if ((sample_rate == sim_pdm_sample_rate) && (word_length == sim_pdm_word_length) && (layout == sim_pdm_layout))
+    {
+        return;
+    }
+
+    audio_in_hal_stop();
+    sim_pdm_sample_rate = sample_rate;
+    sim_pdm_word_length = word_length;
+    sim_pdm_layout = layout;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_set_gain
+******************************************************************************
+* Summary:
+*  Set the gain of both microphones. The gain applies to the frames
+*  converted from now on, the frames already in the RX FIFO or in the
+*  period of the DMA keep the previous gain.
+*
+* Parameters:
+*  gain: Gain in 0.5 dB, clamped to the range of the PDM/PCM block
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_set_gain(int32_t gain)
+{
+    if (gain < (AUDIO_IN_HAL_GAIN_MIN))
+    {
+        gain = (AUDIO_IN_HAL_GAIN_MIN);
+    }
+    else if (gain > (AUDIO_IN_HAL_GAIN_MAX))
+    {
+        gain = (AUDIO_IN_HAL_GAIN_MAX);
+    }
+
+    if (gain == sim_pdm_gain)
+    {
+        return;
+    }
+    sim_pdm_gain = gain;
+
+    if (!sim_pdm_running)
+    {
+        return;
+    }
+
+    if (sim_pdm_num_gains == (SIM_PDM_GAIN_HISTORY))
+    {
+        memmove(&sim_pdm_gains[0], &sim_pdm_gains[1], sizeof(sim_pdm_gains) - sizeof(sim_pdm_gains[0]));
+        sim_pdm_num_gains--;
+    }
+    sim_pdm_gains[sim_pdm_num_gains].frame = sim_pdm_produced();
+    sim_pdm_gains[sim_pdm_num_gains].gain = gain;
+    sim_pdm_num_gains++;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_start
+******************************************************************************
+* Summary:
+*  Start the conversion, at the sample rate offset by sim_pdm_set_ppm().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_start(void)
+{
+    CY_ASSERT(sim_pdm_powered);
+
+    sim_pdm_start_ns = sim_now_ns();
+    sim_pdm_rate_uhz = (uint64_t) sim_pdm_sample_rate * (uint64_t) ((int64_t) (SIM_PDM_UHZ_PER_HZ) + sim_pdm_ppm);
+    sim_pdm_consumed = 0U;
+    sim_pdm_gains[0].frame = 0U;
+    sim_pdm_gains[0].gain = sim_pdm_gain;
+    sim_pdm_num_gains = 1U;
+    sim_pdm_running = true;
+
+    sim_pdm_arm_dma();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_stop
+******************************************************************************
+* Summary:
+*  Stop the conversion. A pending DMA period does not complete.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_stop(void)
+{
+    sim_pdm_running = false;
+    sim_event_cancel(&sim_pdm_dma_event);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_clear
+******************************************************************************
+* Summary:
+*  Empty the RX FIFO.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_clear(void)
+{
+    sim_pdm_consumed = sim_pdm_produced() * sim_pdm_channels();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_get_fifo_level
+******************************************************************************
+* Summary:
+*  Get the number of samples in the RX FIFO.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Samples in the RX FIFO
+*
+*****************************************************************************/
+uint32_t audio_in_hal_get_fifo_level(void)
+{
+    sim_pdm_drain_overflow();
+    return (uint32_t) ((sim_pdm_produced() * sim_pdm_channels()) - sim_pdm_consumed);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_read
+******************************************************************************
+* Summary:
+*  Read the samples available in the RX FIFO.
+*
+* Parameters:
+*  buffer: Destination of the samples
+*  count: Samples to read, samples read on return
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_read(void *buffer, size_t *count)
+{
+    uint32_t level = audio_in_hal_get_fifo_level();
+
+    if (*count > level)
+    {
+        *count = level;
+    }
+
+    sim_pdm_convert(buffer, sim_pdm_consumed, *count);
+    sim_pdm_consumed += *count;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_register_period_callback
+******************************************************************************
+* Summary:
+*  Register the function called when a DMA period completes.
+*
+* Parameters:
+*  callback: Function called in interrupt context
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_register_period_callback(audio_in_hal_period_callback_t callback)
+{
+    sim_pdm_period_callback = callback;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_read_period
+******************************************************************************
+* Summary:
+*  Let the DMA drain the RX FIFO into a period.
+*
+* Parameters:
+*  buffer: Destination of the samples
+*  count: Samples of the period
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_read_period(void *buffer, size_t count)
+{
+    CY_ASSERT(!sim_pdm_dma_pending && (count > 0U));
+
+    sim_pdm_dma_buffer = buffer;
+    sim_pdm_dma_count = count;
+    sim_pdm_dma_pending = true;
+
+    sim_pdm_arm_dma();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_abort_period
+******************************************************************************
+* Summary:
+*  Abort the pending DMA period, if any.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_abort_period(void)
+{
+    sim_pdm_dma_pending = false;
+    sim_event_cancel(&sim_pdm_dma_event);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_power_down
+******************************************************************************
+* Summary:
+*  Stop the conversion and the audio subsystem clock.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_power_down(void)
+{
+    audio_in_hal_stop();
+    sim_pdm_powered = false;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_power_up
+******************************************************************************
+* Summary:
+*  Start the audio subsystem clock.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_power_up(void)
+{
+    sim_pdm_powered = true;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_set_led
+******************************************************************************
+* Summary:
+*  Turn the user LED on or off.
+*
+* Parameters:
+*  on: true to turn the LED on
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_set_led(bool on)
+{
+    sim_led_on = on;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_toggle_led
+******************************************************************************
+* Summary:
+*  Toggle the user LED.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_toggle_led(void)
+{
+    sim_led_on = !sim_led_on;
+}
+
+/* [] END OF FILE */
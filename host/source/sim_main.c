@@ -0,0 +1,119 @@
+/*****************************************************************************
+* File Name    : sim_main.c
+*
+* Description  : This is the source code for the Linux simulation of the USB Audio
+*                Recorder. Connects a simulated host, opens a stream and runs the
+*                application for a while, faster than real time.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "console.h"
+#include "telemetry.h"
+#include "cycle_counter.h"
+#include "sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Default duration of the run and alternate setting opened, 48 KHz stereo */
+#define SIM_MAIN_DEFAULT_SECONDS    (10U)
+#define SIM_MAIN_DEFAULT_ALT        (6U)
+
+/* Time given to the application to enumerate before opening the stream */
+#define SIM_MAIN_ENUMERATION_MS     (100U)
+
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Entry point of the simulation.
+*  Usage: audio_sim [seconds [alternate setting [ppm]]]
+*
+* Parameters:
+*  argc: Number of arguments
+*  argv: Arguments
+*
+* Return:
+*  int: 0 if every packet fit in wMaxPacketSize
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : (SIM_MAIN_DEFAULT_SECONDS);
+    uint8_t alt_setting = (argc > 2) ? (uint8_t) strtoul(argv[2], NULL, 0) : (SIM_MAIN_DEFAULT_ALT);
+    int32_t ppm = (argc > 3) ? (int32_t) strtol(argv[3], NULL, 0) : 0;
+    sim_usb_stats_t stats;
+
+    /* Count the time spent in the application, for the cycles of the DSP chain */
+    sim_set_cpu_charge(true);
+    cycle_counter_init();
+
+    printf("******************"
+           " emUSB-Device: Audio recorder (simulation) "
+           "******************\r\n\n");
+
+    audio_app_init();
+    console_init();
+    telemetry_init();
+
+    sim_pdm_set_ppm(ppm);
+    sim_usb_connect();
+    sim_run(SIM_MAIN_ENUMERATION_MS);
+
+    sim_usb_set_interface(0U, alt_setting);
+    sim_run(seconds * 1000U);
+
+    /* Print the statistics of the console */
+    sim_console_input("qld");
+    sim_run(SIM_MAIN_ENUMERATION_MS);
+
+    sim_usb_get_stats(0U, &stats);
+    printf("SIM: %lu packets, %lu empty, %llu bytes, %lu..%lu bytes (wMaxPacketSize %lu), %lu oversized, "
+           "%lu samples lost\r\n",
+           (unsigned long) stats.packets, (unsigned long) stats.empty_packets, (unsigned long long) stats.bytes,
+           (unsigned long) stats.min_size, (unsigned long) stats.max_size,
+           (unsigned long) sim_usb_get_max_packet_size(0U), (unsigned long) stats.oversized,
+           (unsigned long) sim_pdm_get_overflows());
+
+    return (0U == stats.oversized) ? 0 : 1;
+}
+
+/* [] END OF FILE */
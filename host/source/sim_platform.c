@@ -0,0 +1,304 @@
+/*****************************************************************************
+* File Name    : sim_platform.c
+*
+* Description  : This file contains the platform stand-ins of the Linux simulation:
+*                core clock, cycle counter on the virtual time, debug UART and heap.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "cycle_counter.h"
+#include "cy_retarget_io.h"
+#include "sim.h"
+#include "cy_utils.h"
+
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define CYCLE_COUNTER_HZ_PER_MHZ    (1000000U)
+
+/* Keys waiting in the RX FIFO of the debug UART */
+#define SIM_CONSOLE_QUEUE_SIZE      (64U)
+
+/* Size of the heap reported by the telemetry, see __HeapBase in CMakeLists.txt */
+#define SIM_HEAP_SIZE               (0x40000U)
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+uint32_t SystemCoreClock = SIM_CORE_CLOCK_HZ;
+
+/* Debug UART of retarget-io */
+cyhal_uart_t cy_retarget_io_uart_obj;
+
+/* Storage standing for the heap region of the linker script */
+uint8_t sim_heap[SIM_HEAP_SIZE];
+
+static char sim_console_queue[SIM_CONSOLE_QUEUE_SIZE];
+static uint32_t sim_console_head = 0U;
+static uint32_t sim_console_tail = 0U;
+
+/* Interrupt of the debug UART */
+static cyhal_uart_event_callback_t sim_console_callback = NULL;
+static void *sim_console_callback_arg = NULL;
+static cyhal_uart_event_t sim_console_events = 0U;
+static sim_event_t sim_console_event;
+
+
+/*****************************************************************************
+* Function Name: cycle_counter_init
+******************************************************************************
+* Summary:
+*  Enable the cycle counter, it always runs in the simulation.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void cycle_counter_init(void)
+{
+}
+
+/*****************************************************************************
+* Function Name: cycle_counter_get
+******************************************************************************
+* Summary:
+*  Get the cycle counter, derived from the virtual time at SystemCoreClock.
+*  The time spent in the code only counts with sim_set_cpu_charge().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Cycles, wraps around
+*
+*****************************************************************************/
+uint32_t cycle_counter_get(void)
+{
+    return (uint32_t) ((sim_now_ns() * (SystemCoreClock / CYCLE_COUNTER_HZ_PER_MHZ)) / (SIM_NS_PER_US));
+}
+
+/*****************************************************************************
+* Function Name: cycle_counter_to_us
+******************************************************************************
+* Summary:
+*  Convert cycles to microseconds.
+*
+* Parameters:
+*  cycles: Cycles
+*
+* Return:
+*  uint32_t: Microseconds
+*
+*****************************************************************************/
+uint32_t cycle_counter_to_us(uint32_t cycles)
+{
+    return (cycles / (SystemCoreClock / CYCLE_COUNTER_HZ_PER_MHZ));
+}
+
+/*****************************************************************************
+* Function Name: sim_console_interrupt
+******************************************************************************
+* Summary:
+*  Interrupt of the debug UART: calls the callback if keys wait and the RX
+*  not empty event is enabled.
+*
+*****************************************************************************/
+static void sim_console_interrupt(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    if ((NULL != sim_console_callback) && (0U != (sim_console_events & CYHAL_UART_IRQ_RX_NOT_EMPTY)) &&
+        (sim_console_tail != sim_console_head))
+    {
+        sim_console_callback(sim_console_callback_arg, CYHAL_UART_IRQ_RX_NOT_EMPTY);
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_console_raise
+******************************************************************************
+* Summary:
+*  Raise the interrupt of the debug UART now, it runs before the next task.
+*
+*****************************************************************************/
+static void sim_console_raise(void)
+{
+    sim_event_schedule(&sim_console_event, sim_now_ns(), sim_console_interrupt, NULL);
+}
+
+/*****************************************************************************
+* Function Name: sim_console_input
+******************************************************************************
+* Summary:
+*  Type keys on the debug UART. Keys that do not fit in the RX FIFO are lost.
+*
+* Parameters:
+*  keys: Keys, NUL terminated
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_console_input(const char *keys)
+{
+    size_t i;
+
+    for (i = 0U; i < strlen(keys); i++)
+    {
+        if ((sim_console_tail - sim_console_head) < (SIM_CONSOLE_QUEUE_SIZE))
+        {
+            sim_console_queue[sim_console_tail % (SIM_CONSOLE_QUEUE_SIZE)] = keys[i];
+            sim_console_tail++;
+        }
+    }
+
+    sim_console_raise();
+}
+
+/*****************************************************************************
+* Function Name: cyhal_uart_readable
+******************************************************************************
+* Summary:
+*  Get the number of keys waiting on the debug UART.
+*
+* Parameters:
+*  obj: UART object
+*
+* Return:
+*  uint32_t: Keys waiting
+*
+*****************************************************************************/
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj)
+{
+    CY_UNUSED_PARAMETER(obj);
+
+    return sim_console_tail - sim_console_head;
+}
+
+/*****************************************************************************
+* Function Name: cyhal_uart_getc
+******************************************************************************
+* Summary:
+*  Read a key from the debug UART.
+*
+* Parameters:
+*  obj: UART object
+*  value: Key read
+*  timeout: Unused, never waits
+*
+* Return:
+*  cy_rslt_t: CY_RSLT_SUCCESS, CYHAL_UART_RSLT_ERR_EMPTY if no key waits
+*
+*****************************************************************************/
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    CY_UNUSED_PARAMETER(obj);
+    CY_UNUSED_PARAMETER(timeout);
+
+    if (sim_console_tail == sim_console_head)
+    {
+        return CYHAL_UART_RSLT_ERR_EMPTY;
+    }
+
+    *value = (uint8_t) sim_console_queue[sim_console_head % (SIM_CONSOLE_QUEUE_SIZE)];
+    sim_console_head++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*****************************************************************************
+* Function Name: cyhal_uart_register_callback
+******************************************************************************
+* Summary:
+*  Register the callback of the interrupt of the debug UART.
+*
+* Parameters:
+*  obj: UART object
+*  callback: Called in interrupt context
+*  callback_arg: Argument of the callback
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void cyhal_uart_register_callback(cyhal_uart_t *obj, cyhal_uart_event_callback_t callback, void *callback_arg)
+{
+    CY_UNUSED_PARAMETER(obj);
+
+    sim_console_callback = callback;
+    sim_console_callback_arg = callback_arg;
+}
+
+/*****************************************************************************
+* Function Name: cyhal_uart_enable_event
+******************************************************************************
+* Summary:
+*  Enable or disable events of the debug UART. Like the level of the RX
+*  FIFO, enabling the RX not empty event while keys wait raises it.
+*
+* Parameters:
+*  obj: UART object
+*  event: Events
+*  intr_priority: Unused
+*  enable: true to enable the events
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event, uint8_t intr_priority, bool enable)
+{
+    CY_UNUSED_PARAMETER(obj);
+    CY_UNUSED_PARAMETER(intr_priority);
+
+    if (enable)
+    {
+        sim_console_events |= event;
+        sim_console_raise();
+    }
+    else
+    {
+        sim_console_events &= ~event;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,1218 @@
+/*****************************************************************************
+* File Name    : sim_rtos.c
+*
+* Description  : This file contains a FreeRTOS stand-in running the tasks of the
+*                application in virtual time on a Linux host, so the simulation
+*                runs faster than real time and gives the same result on each run.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "cy_utils.h"
+
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define SIM_RTOS_MAX_TASKS          (8U)
+#define SIM_RTOS_MAX_TIMERS         (4U)
+
+/* Host stack of each task. The frames of the host are larger than on the
+ * Cortex-M4, and the C library takes more stack for printf().
+ */
+#define SIM_RTOS_HOST_STACK_SIZE    (256U * 1024U)
+#define SIM_RTOS_STACK_FILL         (0xA5U)
+
+#define SIM_RTOS_NS_PER_TICK        ((SIM_NS_PER_S) / (configTICK_RATE_HZ))
+
+/* Tasks created by the kernel */
+#define SIM_RTOS_IDLE_STACK_DEPTH   (configMINIMAL_STACK_SIZE)
+#define SIM_RTOS_TIMER_STACK_DEPTH  (configTIMER_TASK_STACK_DEPTH)
+
+/* Tick count reached or passed */
+#define SIM_RTOS_TICK_REACHED(now, tick)    ((int32_t) ((now) - (tick)) >= 0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef enum
+{
+    SIM_TASK_READY,
+    SIM_TASK_DELAYED,
+    SIM_TASK_NOTIFY_WAIT,
+} sim_task_state_t;
+
+struct tskTaskControlBlock
+{
+    ucontext_t context;
+    TaskFunction_t function;
+    void *parameter;
+    char name[configMAX_TASK_NAME_LEN];
+    UBaseType_t priority;
+    UBaseType_t number;
+    StackType_t *stack;
+    uint32_t stack_depth;
+    uint8_t *host_stack;
+    sim_task_state_t state;
+    bool timed_wait;
+    TickType_t wake_tick;
+    uint32_t notify_value;
+    bool notify_pending;
+    void *tls[configNUM_THREAD_LOCAL_STORAGE_POINTERS];
+    uint32_t run_time;
+    uint64_t last_switch;
+};
+
+struct tmrTimerControl
+{
+    const char *name;
+    TickType_t period;
+    bool auto_reload;
+    bool active;
+    TickType_t expiry;
+    void *id;
+    TimerCallbackFunction_t callback;
+};
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static struct tskTaskControlBlock sim_rtos_tasks[SIM_RTOS_MAX_TASKS];
+static UBaseType_t sim_rtos_num_tasks = 0U;
+static struct tmrTimerControl sim_rtos_timers[SIM_RTOS_MAX_TIMERS];
+static UBaseType_t sim_rtos_num_timers = 0U;
+
+/* Context of the scheduler, which runs the interrupts between two tasks */
+static ucontext_t sim_rtos_scheduler_context;
+static TaskHandle_t sim_rtos_current = NULL;
+static TaskHandle_t sim_rtos_idle_task = NULL;
+static TaskHandle_t sim_rtos_timer_task = NULL;
+static bool sim_rtos_started = false;
+static bool sim_rtos_isr = false;
+static UBaseType_t sim_rtos_suspended = 0U;
+static uint64_t sim_rtos_switches = 0U;
+
+/* Virtual time, and end of the current sim_run() */
+static uint64_t sim_rtos_time_ns = 0U;
+static uint64_t sim_rtos_end_ns = UINT64_MAX;
+static TickType_t sim_rtos_tick_count = 0U;
+static sim_event_t sim_rtos_tick_event;
+
+/* Pending events, sorted by time */
+static sim_event_t *sim_rtos_events = NULL;
+
+/* Host CPU time of the running task charged to the virtual time */
+static bool sim_rtos_charge_cpu = false;
+static bool sim_rtos_task_running = false;
+static uint64_t sim_rtos_switch_in_host_ns;
+
+/* Fixed virtual time charged for each run of a task */
+static uint32_t sim_rtos_run_cost_ns = 0U;
+
+#if (configGENERATE_RUN_TIME_STATS)
+/* Run time counter when the running task was switched in */
+static uint32_t sim_rtos_switch_in_run_time;
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint64_t sim_rtos_host_ns(void);
+static void sim_rtos_task_entry(void);
+static void sim_rtos_block(void);
+static void sim_rtos_make_ready(TaskHandle_t task);
+static BaseType_t sim_rtos_notify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+static void sim_rtos_tick(void *arg);
+static void sim_rtos_idle(void *arg);
+static void sim_rtos_timer_daemon(void *arg);
+static void sim_rtos_start(void);
+static TaskHandle_t sim_rtos_select(void);
+static void sim_rtos_switch_to(TaskHandle_t task);
+static void sim_rtos_fire_events(void);
+
+
+/*****************************************************************************
+* Function Name: sim_rtos_host_ns
+******************************************************************************
+* Summary:
+*  Get the CPU time of the host thread running the simulation.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint64_t: CPU time in ns
+*
+*****************************************************************************/
+static uint64_t sim_rtos_host_ns(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return ((uint64_t) now.tv_sec * (SIM_NS_PER_S)) + (uint64_t) now.tv_nsec;
+}
+
+/*****************************************************************************
+* Function Name: sim_now_ns
+******************************************************************************
+* Summary:
+*  Get the virtual time since the start of the simulation. With
+*  sim_set_cpu_charge(), the time also runs while a task runs.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint64_t: Virtual time in ns
+*
+*****************************************************************************/
+uint64_t sim_now_ns(void)
+{
+    uint64_t now = sim_rtos_time_ns;
+
+    if (sim_rtos_charge_cpu && sim_rtos_task_running)
+    {
+        now += sim_rtos_host_ns() - sim_rtos_switch_in_host_ns;
+    }
+
+    return now;
+}
+
+/*****************************************************************************
+* Function Name: sim_set_cpu_charge
+******************************************************************************
+* Summary:
+*  Charge the host CPU time taken by the tasks to the virtual time. By
+*  default the tasks take no virtual time, so the simulation only depends on
+*  its inputs. With the charge, the run time statistics and the cycle
+*  counter show the load of the tasks, measured on the host.
+*
+* Parameters:
+*  enable: true to charge the CPU time of the tasks
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_set_cpu_charge(bool enable)
+{
+    sim_rtos_charge_cpu = enable;
+}
+
+/*****************************************************************************
+* Function Name: sim_set_cpu_cost
+******************************************************************************
+* Summary:
+*  Charge a fixed time to the virtual time for each run of a task, from its
+*  switch in to its switch out, on top of the host CPU time charged by
+*  sim_set_cpu_charge(). Unlike the host CPU time, it does not depend on
+*  the load of the host: the run time statistics and the cycle counter get
+*  the same values on every run of the simulation.
+*
+* Parameters:
+*  cost_ns: Time of a run in ns, 0 for none
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_set_cpu_cost(uint32_t cost_ns)
+{
+    sim_rtos_run_cost_ns = cost_ns;
+}
+
+/*****************************************************************************
+* Function Name: sim_in_isr
+******************************************************************************
+* Summary:
+*  Check if the caller runs in a simulated interrupt.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true in interrupt context
+*
+*****************************************************************************/
+bool sim_in_isr(void)
+{
+    return sim_rtos_isr;
+}
+
+/*****************************************************************************
+* Function Name: sim_event_schedule
+******************************************************************************
+* Summary:
+*  Schedule a simulated interrupt. The handler runs between two tasks, once
+*  the virtual time reaches time_ns. Events due at the same time run in the
+*  order they were scheduled. A pending event is moved.
+*
+* Parameters:
+*  event: Event, owned by the caller
+*  time_ns: Virtual time of the interrupt
+*  handler: Handler of the interrupt
+*  arg: Argument of the handler
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_event_schedule(sim_event_t *event, uint64_t time_ns, sim_event_handler_t handler, void *arg)
+{
+    sim_event_t **link = &sim_rtos_events;
+
+    sim_event_cancel(event);
+
+    event->time_ns = time_ns;
+    event->handler = handler;
+    event->arg = arg;
+    event->pending = true;
+
+    while ((NULL != *link) && ((*link)->time_ns <= time_ns))
+    {
+        link = &(*link)->next;
+    }
+    event->next = *link;
+    *link = event;
+}
+
+/*****************************************************************************
+* Function Name: sim_event_cancel
+******************************************************************************
+* Summary:
+*  Cancel a simulated interrupt, if pending.
+*
+* Parameters:
+*  event: Event
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_event_cancel(sim_event_t *event)
+{
+    sim_event_t **link = &sim_rtos_events;
+
+    if (!event->pending)
+    {
+        return;
+    }
+
+    while (*link != event)
+    {
+        link = &(*link)->next;
+    }
+    *link = event->next;
+    event->next = NULL;
+    event->pending = false;
+}
+
+/*****************************************************************************
+* Function Name: sim_run
+******************************************************************************
+* Summary:
+*  Run the simulation for a duration of virtual time. The first call starts
+*  the scheduler, the next calls resume it. The tasks must be created before.
+*
+* Parameters:
+*  duration_ms: Duration in ms
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_run(uint32_t duration_ms)
+{
+    sim_rtos_end_ns = sim_rtos_time_ns + ((uint64_t) duration_ms * (SIM_NS_PER_MS));
+    vTaskStartScheduler();
+}
+
+/*****************************************************************************
+* Function Name: sim_stop
+******************************************************************************
+* Summary:
+*  End the current sim_run() once the running task blocks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_stop(void)
+{
+    sim_rtos_end_ns = sim_rtos_time_ns;
+}
+
+/*****************************************************************************
+* Function Name: xTaskCreateStatic
+******************************************************************************
+* Summary:
+*  Create a task. The task runs on its own host stack, the stack given by
+*  the application is only reported by uxTaskGetSystemState().
+*
+*****************************************************************************/
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth,
+                               void * const pvParameters, UBaseType_t uxPriority,
+                               StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer)
+{
+    TaskHandle_t task;
+
+    CY_UNUSED_PARAMETER(pxTaskBuffer);
+
+    if ((sim_rtos_num_tasks >= (SIM_RTOS_MAX_TASKS)) || (uxPriority >= (configMAX_PRIORITIES)))
+    {
+        return NULL;
+    }
+
+    task = &sim_rtos_tasks[sim_rtos_num_tasks];
+    memset(task, 0, sizeof(*task));
+    sim_rtos_num_tasks++;
+
+    task->function = pxTaskCode;
+    task->parameter = pvParameters;
+    strncpy(task->name, pcName, sizeof(task->name) - 1U);
+    task->priority = uxPriority;
+    task->number = sim_rtos_num_tasks;
+    task->stack = puxStackBuffer;
+    task->stack_depth = ulStackDepth;
+    task->state = SIM_TASK_READY;
+
+    /* Outside of the C library heap, which the telemetry samples */
+    task->host_stack = mmap(NULL, SIM_RTOS_HOST_STACK_SIZE, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CY_ASSERT(MAP_FAILED != task->host_stack);
+    memset(task->host_stack, SIM_RTOS_STACK_FILL, SIM_RTOS_HOST_STACK_SIZE);
+
+    (void) getcontext(&task->context);
+    task->context.uc_stack.ss_sp = task->host_stack;
+    task->context.uc_stack.ss_size = SIM_RTOS_HOST_STACK_SIZE;
+    task->context.uc_link = NULL;
+    makecontext(&task->context, sim_rtos_task_entry, 0);
+
+    return task;
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_task_entry
+******************************************************************************
+* Summary:
+*  First function run on the stack of a task.
+*
+*****************************************************************************/
+static void sim_rtos_task_entry(void)
+{
+    TaskHandle_t task = sim_rtos_current;
+
+    task->function(task->parameter);
+
+    /* Tasks must not return */
+    CY_ASSERT(0);
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_block
+******************************************************************************
+* Summary:
+*  Switch from the running task back to the scheduler. The task resumes once
+*  the scheduler selects it again.
+*
+*****************************************************************************/
+static void sim_rtos_block(void)
+{
+    TaskHandle_t task = sim_rtos_current;
+
+    CY_ASSERT((NULL != task) && !sim_rtos_isr && (0U == sim_rtos_suspended));
+    (void) swapcontext(&task->context, &sim_rtos_scheduler_context);
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_make_ready
+******************************************************************************
+* Summary:
+*  Make a blocked task ready to run.
+*
+*****************************************************************************/
+static void sim_rtos_make_ready(TaskHandle_t task)
+{
+    task->state = SIM_TASK_READY;
+    task->timed_wait = false;
+}
+
+/*****************************************************************************
+* Function Name: vTaskDelay
+******************************************************************************
+* Summary:
+*  Block the running task for a number of ticks, or let the other ready
+*  tasks of the same priority run first when the delay is 0.
+*
+*****************************************************************************/
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    TaskHandle_t task = sim_rtos_current;
+
+    if (xTicksToDelay > 0U)
+    {
+        task->state = SIM_TASK_DELAYED;
+        task->wake_tick = sim_rtos_tick_count + xTicksToDelay;
+    }
+    sim_rtos_block();
+}
+
+/*****************************************************************************
+* Function Name: xTaskGetTickCount
+******************************************************************************
+* Summary:
+*  Get the number of ticks since the start of the scheduler.
+*
+*****************************************************************************/
+TickType_t xTaskGetTickCount(void)
+{
+    return sim_rtos_tick_count;
+}
+
+/*****************************************************************************
+* Function Name: xTaskGetTickCountFromISR
+******************************************************************************
+* Summary:
+*  Get the number of ticks since the start of the scheduler, from an
+*  interrupt.
+*
+*****************************************************************************/
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return sim_rtos_tick_count;
+}
+
+/*****************************************************************************
+* Function Name: vTaskSuspendAll
+******************************************************************************
+* Summary:
+*  The tasks only switch when the running task blocks, which it must not do
+*  while the scheduler is suspended.
+*
+*****************************************************************************/
+void vTaskSuspendAll(void)
+{
+    sim_rtos_suspended++;
+}
+
+/*****************************************************************************
+* Function Name: xTaskResumeAll
+******************************************************************************
+* Summary:
+*  Resume the scheduler suspended by vTaskSuspendAll().
+*
+*****************************************************************************/
+BaseType_t xTaskResumeAll(void)
+{
+    CY_ASSERT(sim_rtos_suspended > 0U);
+    sim_rtos_suspended--;
+    return pdFALSE;
+}
+
+/*****************************************************************************
+* Function Name: xTaskGetCurrentTaskHandle
+******************************************************************************
+* Summary:
+*  Get the running task, NULL in interrupt context.
+*
+*****************************************************************************/
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return sim_rtos_current;
+}
+
+/*****************************************************************************
+* Function Name: xTaskGetIdleTaskHandle
+******************************************************************************
+* Summary:
+*  Get the idle task created by the scheduler.
+*
+*****************************************************************************/
+TaskHandle_t xTaskGetIdleTaskHandle(void)
+{
+    return sim_rtos_idle_task;
+}
+
+/*****************************************************************************
+* Function Name: pcTaskGetName
+******************************************************************************
+* Summary:
+*  Get the name of a task, or of the running task if NULL.
+*
+*****************************************************************************/
+char *pcTaskGetName(TaskHandle_t xTaskToQuery)
+{
+    TaskHandle_t task = (NULL != xTaskToQuery) ? xTaskToQuery : sim_rtos_current;
+
+    return task->name;
+}
+
+/*****************************************************************************
+* Function Name: uxTaskGetNumberOfTasks
+******************************************************************************
+* Summary:
+*  Get the number of tasks created.
+*
+*****************************************************************************/
+UBaseType_t uxTaskGetNumberOfTasks(void)
+{
+    return sim_rtos_num_tasks;
+}
+
+/*****************************************************************************
+* Function Name: uxTaskGetStackHighWaterMark
+******************************************************************************
+* Summary:
+*  Get the stack left to a task, from the peak use of its host stack. The
+*  host stack is counted in words of the host, twice as wide as those of
+*  the Cortex-M4, so the figure is only an estimate.
+*
+*****************************************************************************/
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask)
+{
+    TaskHandle_t task = (NULL != xTask) ? xTask : sim_rtos_current;
+    uint32_t unused = 0U;
+    uint32_t used_words;
+
+    /* The stack grows down from the end of the host stack */
+    while ((unused < (SIM_RTOS_HOST_STACK_SIZE)) && ((SIM_RTOS_STACK_FILL) == task->host_stack[unused]))
+    {
+        unused++;
+    }
+
+    used_words = ((SIM_RTOS_HOST_STACK_SIZE) - unused) / sizeof(void *);
+    return (used_words < task->stack_depth) ? (task->stack_depth - used_words) : 0U;
+}
+
+/*****************************************************************************
+* Function Name: uxTaskGetSystemState
+******************************************************************************
+* Summary:
+*  Get the state, priority, run time and stack left of each task, and the
+*  total run time.
+*
+*****************************************************************************/
+UBaseType_t uxTaskGetSystemState(TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t * const pulTotalRunTime)
+{
+    TaskHandle_t task;
+    UBaseType_t i;
+
+    if (uxArraySize < sim_rtos_num_tasks)
+    {
+        return 0U;
+    }
+
+    for (i = 0U; i < sim_rtos_num_tasks; i++)
+    {
+        task = &sim_rtos_tasks[i];
+        pxTaskStatusArray[i].xHandle = task;
+        pxTaskStatusArray[i].pcTaskName = task->name;
+        pxTaskStatusArray[i].xTaskNumber = task->number;
+        pxTaskStatusArray[i].eCurrentState = (task == sim_rtos_current) ? eRunning :
+                                             ((SIM_TASK_READY == task->state) ? eReady : eBlocked);
+        pxTaskStatusArray[i].uxCurrentPriority = task->priority;
+        pxTaskStatusArray[i].uxBasePriority = task->priority;
+        pxTaskStatusArray[i].ulRunTimeCounter = task->run_time;
+        pxTaskStatusArray[i].pxStackBase = task->stack;
+        pxTaskStatusArray[i].usStackHighWaterMark = (uint16_t) uxTaskGetStackHighWaterMark(task);
+    }
+
+    if (NULL != pulTotalRunTime)
+    {
+        *pulTotalRunTime = (uint32_t) portGET_RUN_TIME_COUNTER_VALUE();
+    }
+
+    return sim_rtos_num_tasks;
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_notify
+******************************************************************************
+* Summary:
+*  Update the notification value of a task, and wake it up if it waits for
+*  a notification.
+*
+*****************************************************************************/
+static BaseType_t sim_rtos_notify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    BaseType_t result = pdPASS;
+
+    switch (action)
+    {
+        case eSetBits:
+            task->notify_value |= value;
+            break;
+
+        case eIncrement:
+            task->notify_value++;
+            break;
+
+        case eSetValueWithOverwrite:
+            task->notify_value = value;
+            break;
+
+        case eSetValueWithoutOverwrite:
+            if (task->notify_pending)
+            {
+                result = pdFAIL;
+            }
+            else
+            {
+                task->notify_value = value;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    task->notify_pending = true;
+    if (SIM_TASK_NOTIFY_WAIT == task->state)
+    {
+        sim_rtos_make_ready(task);
+    }
+
+    return result;
+}
+
+/*****************************************************************************
+* Function Name: xTaskNotify
+******************************************************************************
+* Summary:
+*  Notify a task from a task. The running task gives way if the notified
+*  task has a higher priority.
+*
+*****************************************************************************/
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction)
+{
+    BaseType_t result = sim_rtos_notify(xTaskToNotify, ulValue, eAction);
+
+    if ((NULL != sim_rtos_current) && !sim_rtos_isr && (0U == sim_rtos_suspended) &&
+        (xTaskToNotify->priority > sim_rtos_current->priority))
+    {
+        sim_rtos_block();
+    }
+
+    return result;
+}
+
+/*****************************************************************************
+* Function Name: xTaskNotifyFromISR
+******************************************************************************
+* Summary:
+*  Notify a task from an interrupt. The scheduler selects the highest
+*  priority ready task once the interrupt returns.
+*
+*****************************************************************************/
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              BaseType_t *pxHigherPriorityTaskWoken)
+{
+    BaseType_t result = sim_rtos_notify(xTaskToNotify, ulValue, eAction);
+
+    if ((NULL != pxHigherPriorityTaskWoken) &&
+        ((NULL == sim_rtos_current) || (xTaskToNotify->priority > sim_rtos_current->priority)))
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+
+    return result;
+}
+
+/*****************************************************************************
+* Function Name: xTaskNotifyWait
+******************************************************************************
+* Summary:
+*  Wait for a notification of the running task, at most xTicksToWait
+*  ticks.
+*
+*****************************************************************************/
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue, TickType_t xTicksToWait)
+{
+    TaskHandle_t task = sim_rtos_current;
+
+    if (!task->notify_pending)
+    {
+        task->notify_value &= ~ulBitsToClearOnEntry;
+
+        if (xTicksToWait > 0U)
+        {
+            task->state = SIM_TASK_NOTIFY_WAIT;
+            task->timed_wait = (portMAX_DELAY != xTicksToWait);
+            task->wake_tick = sim_rtos_tick_count + xTicksToWait;
+            sim_rtos_block();
+        }
+    }
+
+    if (NULL != pulNotificationValue)
+    {
+        *pulNotificationValue = task->notify_value;
+    }
+
+    if (!task->notify_pending)
+    {
+        /* Timed out */
+        return pdFALSE;
+    }
+
+    task->notify_value &= ~ulBitsToClearOnExit;
+    task->notify_pending = false;
+    return pdTRUE;
+}
+
+/*****************************************************************************
+* Function Name: vTaskNotifyGiveFromISR
+******************************************************************************
+* Summary:
+*  Increment the notification value of a task from an interrupt.
+*
+*****************************************************************************/
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskNotifyFromISR(xTaskToNotify, 0U, eIncrement, pxHigherPriorityTaskWoken);
+}
+
+/*****************************************************************************
+* Function Name: ulTaskNotifyTake
+******************************************************************************
+* Summary:
+*  Wait for the notification value of the running task to be non-zero, at
+*  most xTicksToWait ticks, then clear or decrement it.
+*
+*****************************************************************************/
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    TaskHandle_t task = sim_rtos_current;
+    uint32_t value;
+
+    if ((0U == task->notify_value) && (xTicksToWait > 0U))
+    {
+        task->notify_pending = false;
+        task->state = SIM_TASK_NOTIFY_WAIT;
+        task->timed_wait = (portMAX_DELAY != xTicksToWait);
+        task->wake_tick = sim_rtos_tick_count + xTicksToWait;
+        sim_rtos_block();
+    }
+
+    value = task->notify_value;
+    if (0U != value)
+    {
+        task->notify_value = (pdFALSE != xClearCountOnExit) ? 0U : (value - 1U);
+    }
+    task->notify_pending = false;
+
+    return value;
+}
+
+/*****************************************************************************
+* Function Name: pvTaskGetThreadLocalStoragePointer
+******************************************************************************
+* Summary:
+*  Get a thread local storage pointer of a task, or of the running task
+*  if NULL.
+*
+*****************************************************************************/
+void *pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex)
+{
+    TaskHandle_t task = (NULL != xTaskToQuery) ? xTaskToQuery : sim_rtos_current;
+
+    CY_ASSERT((xIndex >= 0) && (xIndex < (configNUM_THREAD_LOCAL_STORAGE_POINTERS)));
+    return task->tls[xIndex];
+}
+
+/*****************************************************************************
+* Function Name: vTaskSetThreadLocalStoragePointer
+******************************************************************************
+* Summary:
+*  Set a thread local storage pointer of a task, or of the running task
+*  if NULL.
+*
+*****************************************************************************/
+void vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void *pvValue)
+{
+    TaskHandle_t task = (NULL != xTaskToSet) ? xTaskToSet : sim_rtos_current;
+
+    CY_ASSERT((xIndex >= 0) && (xIndex < (configNUM_THREAD_LOCAL_STORAGE_POINTERS)));
+    task->tls[xIndex] = pvValue;
+}
+
+/*****************************************************************************
+* Function Name: xTimerCreateStatic
+******************************************************************************
+* Summary:
+*  Create a software timer, run by the timer daemon task.
+*
+*****************************************************************************/
+TimerHandle_t xTimerCreateStatic(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                                 const UBaseType_t uxAutoReload, void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction, StaticTimer_t *pxTimerBuffer)
+{
+    TimerHandle_t timer;
+
+    CY_UNUSED_PARAMETER(pxTimerBuffer);
+
+    if ((sim_rtos_num_timers >= (SIM_RTOS_MAX_TIMERS)) || (0U == xTimerPeriodInTicks))
+    {
+        return NULL;
+    }
+
+    timer = &sim_rtos_timers[sim_rtos_num_timers];
+    sim_rtos_num_timers++;
+
+    timer->name = pcTimerName;
+    timer->period = xTimerPeriodInTicks;
+    timer->auto_reload = (pdFALSE != uxAutoReload);
+    timer->active = false;
+    timer->id = pvTimerID;
+    timer->callback = pxCallbackFunction;
+
+    return timer;
+}
+
+/*****************************************************************************
+* Function Name: xTimerStart
+******************************************************************************
+* Summary:
+*  Start a timer, which expires a period from now.
+*
+*****************************************************************************/
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    CY_UNUSED_PARAMETER(xTicksToWait);
+
+    xTimer->expiry = sim_rtos_tick_count + xTimer->period;
+    xTimer->active = true;
+    return pdPASS;
+}
+
+/*****************************************************************************
+* Function Name: xTimerStop
+******************************************************************************
+* Summary:
+*  Stop a timer.
+*
+*****************************************************************************/
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait)
+{
+    CY_UNUSED_PARAMETER(xTicksToWait);
+
+    xTimer->active = false;
+    return pdPASS;
+}
+
+/*****************************************************************************
+* Function Name: pvTimerGetTimerID
+******************************************************************************
+* Summary:
+*  Get the identifier given to a timer on creation.
+*
+*****************************************************************************/
+void *pvTimerGetTimerID(const TimerHandle_t xTimer)
+{
+    return xTimer->id;
+}
+
+/*****************************************************************************
+* Function Name: xTimerGetTimerDaemonTaskHandle
+******************************************************************************
+* Summary:
+*  Get the timer daemon task created by the scheduler.
+*
+*****************************************************************************/
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void)
+{
+    return sim_rtos_timer_task;
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_tick
+******************************************************************************
+* Summary:
+*  Tick interrupt: runs the tick hook, wakes up the tasks whose delay or
+*  timeout expired and the timer daemon when a timer expired.
+*
+*****************************************************************************/
+static void sim_rtos_tick(void *arg)
+{
+    TaskHandle_t task;
+    UBaseType_t i;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    sim_rtos_tick_count++;
+
+#if (configUSE_TICK_HOOK)
+    vApplicationTickHook();
+#endif /* configUSE_TICK_HOOK */
+
+    for (i = 0U; i < sim_rtos_num_tasks; i++)
+    {
+        task = &sim_rtos_tasks[i];
+        if (((SIM_TASK_DELAYED == task->state) || ((SIM_TASK_NOTIFY_WAIT == task->state) && task->timed_wait)) &&
+            SIM_RTOS_TICK_REACHED(sim_rtos_tick_count, task->wake_tick))
+        {
+            sim_rtos_make_ready(task);
+        }
+    }
+
+    for (i = 0U; i < sim_rtos_num_timers; i++)
+    {
+        if (sim_rtos_timers[i].active && SIM_RTOS_TICK_REACHED(sim_rtos_tick_count, sim_rtos_timers[i].expiry))
+        {
+            (void) sim_rtos_notify(sim_rtos_timer_task, 0U, eNoAction);
+        }
+    }
+
+    sim_event_schedule(&sim_rtos_tick_event, (uint64_t) (sim_rtos_tick_count + 1U) * (SIM_RTOS_NS_PER_TICK),
+                       sim_rtos_tick, NULL);
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_idle
+******************************************************************************
+* Summary:
+*  Idle task: runs while no other task is ready, and lets the virtual time
+*  run to the next interrupt.
+*
+*****************************************************************************/
+static void sim_rtos_idle(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        if ((NULL != sim_rtos_events) && (sim_rtos_events->time_ns > sim_rtos_time_ns))
+        {
+            sim_rtos_time_ns = (sim_rtos_events->time_ns < sim_rtos_end_ns) ? sim_rtos_events->time_ns : sim_rtos_end_ns;
+        }
+        sim_rtos_block();
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_timer_daemon
+******************************************************************************
+* Summary:
+*  Timer daemon task: runs the callbacks of the expired timers.
+*
+*****************************************************************************/
+static void sim_rtos_timer_daemon(void *arg)
+{
+    TimerHandle_t timer;
+    UBaseType_t i;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        (void) xTaskNotifyWait(0U, UINT32_MAX, NULL, portMAX_DELAY);
+
+        for (i = 0U; i < sim_rtos_num_timers; i++)
+        {
+            timer = &sim_rtos_timers[i];
+            if (timer->active && SIM_RTOS_TICK_REACHED(sim_rtos_tick_count, timer->expiry))
+            {
+                if (timer->auto_reload)
+                {
+                    timer->expiry += timer->period;
+                }
+                else
+                {
+                    timer->active = false;
+                }
+                timer->callback(timer);
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_start
+******************************************************************************
+* Summary:
+*  Create the tasks of the kernel and start the tick.
+*
+*****************************************************************************/
+static void sim_rtos_start(void)
+{
+    static StackType_t idle_stack[SIM_RTOS_IDLE_STACK_DEPTH];
+    static StaticTask_t idle_tcb;
+    static StackType_t timer_stack[SIM_RTOS_TIMER_STACK_DEPTH];
+    static StaticTask_t timer_tcb;
+
+    sim_rtos_idle_task = xTaskCreateStatic(sim_rtos_idle, "IDLE", SIM_RTOS_IDLE_STACK_DEPTH, NULL,
+                                           tskIDLE_PRIORITY, idle_stack, &idle_tcb);
+    sim_rtos_timer_task = xTaskCreateStatic(sim_rtos_timer_daemon, "Tmr Svc", SIM_RTOS_TIMER_STACK_DEPTH, NULL,
+                                            configTIMER_TASK_PRIORITY, timer_stack, &timer_tcb);
+    CY_ASSERT((NULL != sim_rtos_idle_task) && (NULL != sim_rtos_timer_task));
+
+    sim_event_schedule(&sim_rtos_tick_event, sim_rtos_time_ns + (SIM_RTOS_NS_PER_TICK), sim_rtos_tick, NULL);
+
+    portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+    sim_rtos_started = true;
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_select
+******************************************************************************
+* Summary:
+*  Select the highest priority ready task. Tasks of the same priority take
+*  turns.
+*
+*****************************************************************************/
+static TaskHandle_t sim_rtos_select(void)
+{
+    TaskHandle_t selected = sim_rtos_idle_task;
+    TaskHandle_t task;
+    UBaseType_t i;
+
+    for (i = 0U; i < sim_rtos_num_tasks; i++)
+    {
+        task = &sim_rtos_tasks[i];
+        if ((task == sim_rtos_idle_task) || (SIM_TASK_READY != task->state))
+        {
+            continue;
+        }
+
+        if ((selected == sim_rtos_idle_task) || (task->priority > selected->priority) ||
+            ((task->priority == selected->priority) && (task->last_switch < selected->last_switch)))
+        {
+            selected = task;
+        }
+    }
+
+    return selected;
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_switch_to
+******************************************************************************
+* Summary:
+*  Run a task until it blocks, with the run time accounting of the kernel.
+*
+*****************************************************************************/
+static void sim_rtos_switch_to(TaskHandle_t task)
+{
+    sim_rtos_current = task;
+    task->last_switch = ++sim_rtos_switches;
+
+#if (configGENERATE_RUN_TIME_STATS)
+    sim_rtos_switch_in_run_time = (uint32_t) portGET_RUN_TIME_COUNTER_VALUE();
+#endif /* configGENERATE_RUN_TIME_STATS */
+    traceTASK_SWITCHED_IN();
+
+    sim_rtos_switch_in_host_ns = sim_rtos_host_ns();
+    sim_rtos_task_running = true;
+
+    (void) swapcontext(&sim_rtos_scheduler_context, &task->context);
+
+    if (sim_rtos_charge_cpu)
+    {
+        sim_rtos_time_ns += sim_rtos_host_ns() - sim_rtos_switch_in_host_ns;
+    }
+    sim_rtos_time_ns += sim_rtos_run_cost_ns;
+    sim_rtos_task_running = false;
+
+    traceTASK_SWITCHED_OUT();
+#if (configGENERATE_RUN_TIME_STATS)
+    task->run_time += (uint32_t) portGET_RUN_TIME_COUNTER_VALUE() - sim_rtos_switch_in_run_time;
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+    sim_rtos_current = NULL;
+}
+
+/*****************************************************************************
+* Function Name: sim_rtos_fire_events
+******************************************************************************
+* Summary:
+*  Run the simulated interrupts due at the current virtual time.
+*
+*****************************************************************************/
+static void sim_rtos_fire_events(void)
+{
+    sim_event_t *event;
+
+    while ((NULL != sim_rtos_events) && (sim_rtos_events->time_ns <= sim_rtos_time_ns))
+    {
+        event = sim_rtos_events;
+        sim_rtos_events = event->next;
+        event->next = NULL;
+        event->pending = false;
+
+        sim_rtos_isr = true;
+        event->handler(event->arg);
+        sim_rtos_isr = false;
+    }
+}
+
+/*****************************************************************************
+* Function Name: vTaskStartScheduler
+******************************************************************************
+* Summary:
+*  Start the scheduler, or resume it after sim_run(). Returns at the end of
+*  the duration given to sim_run(), never otherwise.
+*
+*****************************************************************************/
+void vTaskStartScheduler(void)
+{
+    if (!sim_rtos_started)
+    {
+        sim_rtos_start();
+    }
+
+    while (sim_rtos_time_ns < sim_rtos_end_ns)
+    {
+        sim_rtos_fire_events();
+        sim_rtos_switch_to(sim_rtos_select());
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,829 @@
+/*****************************************************************************
+* File Name    : sim_usb.c
+*
+* Description  : This file contains the emUSB-Device stand-in of the Linux
+*                simulation: endpoints, audio class instances, a simulated USB
+*                host issuing the control requests and a 1 ms start of frame.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "USB_Audio.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sim.h"
+#include "cy_utils.h"
+
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Endpoints available besides the control endpoint */
+#define SIM_USB_MAX_ENDPOINTS       (4U)
+
+/* Address of an IN endpoint */
+#define SIM_USB_EP_IN_ADDR(index)   ((U8) (0x80U | ((index) + 1U)))
+#define SIM_USB_EP_INDEX(addr)      ((uint32_t) ((addr) & 0x0FU) - 1U)
+
+/* First unit ID assigned to an audio instance, then one per unit */
+#define SIM_USB_FIRST_UNIT_ID       (1U)
+#define SIM_USB_UNITS_PER_INSTANCE  (3U)
+
+/* Event of the write task */
+#define SIM_USB_EVENT_SOF           (1UL << 0)
+
+/* Size of the replies to GET_CUR */
+#define SIM_USB_MAX_CONTROL_SIZE    (4U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    USBD_AUDIO_INIT_DATA init_data;
+    bool playing;
+    uint8_t alt_setting;
+    sim_usb_stats_t stats;
+} sim_usb_instance_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Endpoints added by USBD_AddEPEx() */
+static USB_ADD_EP_INFO sim_usb_endpoints[SIM_USB_MAX_ENDPOINTS];
+static uint32_t sim_usb_num_endpoints = 0U;
+
+/* Audio instances added by USBD_AUDIO_Add() */
+static sim_usb_instance_t sim_usb_instances[SIM_USB_MAX_INSTANCES];
+static uint32_t sim_usb_num_instances = 0U;
+
+/* Device state and the hook notified of its changes */
+static USB_HOOK *sim_usb_hooks = NULL;
+static uint8_t sim_usb_state = 0U;
+static bool sim_usb_started = false;
+static bool sim_usb_attached = false;
+
+/* Start of frame and the task running USBD_AUDIO_Write_Task() */
+static sim_event_t sim_usb_sof_event;
+static TaskHandle_t sim_usb_write_task = NULL;
+
+/* Host receiving the packets */
+static sim_usb_sink_t sim_usb_sink = NULL;
+static void *sim_usb_sink_arg = NULL;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void sim_usb_set_state(uint8_t state);
+static void sim_usb_sof(void *arg);
+static void sim_usb_schedule_sof(void);
+static sim_usb_instance_t *sim_usb_get_instance(uint32_t instance);
+static int sim_usb_control(uint32_t instance, uint8_t event, uint8_t selector, uint8_t *buffer, uint32_t size);
+static void sim_usb_transfer(uint32_t instance);
+
+
+/*****************************************************************************
+* Function Name: USBD_Init
+******************************************************************************
+* Summary:
+*  Initialize the USB device stack.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_Init(void)
+{
+    sim_usb_num_endpoints = 0U;
+    sim_usb_num_instances = 0U;
+    sim_usb_hooks = NULL;
+    sim_usb_state = 0U;
+    sim_usb_started = false;
+}
+
+/*****************************************************************************
+* Function Name: USBD_Start
+******************************************************************************
+* Summary:
+*  Start the USB device stack. The device gets attached and configured if
+*  the host is connected.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_Start(void)
+{
+    sim_usb_started = true;
+
+    if (sim_usb_attached)
+    {
+        sim_usb_connect();
+    }
+}
+
+/*****************************************************************************
+* Function Name: USBD_GetState
+******************************************************************************
+* Summary:
+*  Get the state of the device.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: USB_STAT_x bits
+*
+*****************************************************************************/
+int USBD_GetState(void)
+{
+    return (int) sim_usb_state;
+}
+
+/*****************************************************************************
+* Function Name: USBD_AddEPEx
+******************************************************************************
+* Summary:
+*  Add an endpoint.
+*
+* Parameters:
+*  pInfo: Settings of the endpoint
+*  pBuffer: Unused, IN endpoints have no buffer
+*  BufferSize: Unused
+*
+* Return:
+*  U8: Address of the endpoint
+*
+*****************************************************************************/
+U8 USBD_AddEPEx(const USB_ADD_EP_INFO *pInfo, U8 *pBuffer, unsigned BufferSize)
+{
+    CY_UNUSED_PARAMETER(pBuffer);
+    CY_UNUSED_PARAMETER(BufferSize);
+
+    CY_ASSERT((sim_usb_num_endpoints < (SIM_USB_MAX_ENDPOINTS)) && (USB_DIR_IN == pInfo->InDir));
+
+    sim_usb_endpoints[sim_usb_num_endpoints] = *pInfo;
+    sim_usb_num_endpoints++;
+
+    return SIM_USB_EP_IN_ADDR(sim_usb_num_endpoints - 1U);
+}
+
+/*****************************************************************************
+* Function Name: USBD_SetDeviceInfo
+******************************************************************************
+* Summary:
+*  Set the strings and IDs of the device descriptor.
+*
+* Parameters:
+*  pDeviceInfo: Device information
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_SetDeviceInfo(const USB_DEVICE_INFO *pDeviceInfo)
+{
+    CY_UNUSED_PARAMETER(pDeviceInfo);
+}
+
+/*****************************************************************************
+* Function Name: USBD_RegisterSCHook
+******************************************************************************
+* Summary:
+*  Register a callback notified of the changes of the device state.
+*
+* Parameters:
+*  pHook: Storage of the hook
+*  cb: Callback
+*  pContext: Argument of the callback
+*
+* Return:
+*  int: 0
+*
+*****************************************************************************/
+int USBD_RegisterSCHook(USB_HOOK *pHook, USB_STATE_CALLBACK *cb, void *pContext)
+{
+    pHook->cb = cb;
+    pHook->pContext = pContext;
+    pHook->pNext = sim_usb_hooks;
+    sim_usb_hooks = pHook;
+
+    return 0;
+}
+
+/*****************************************************************************
+* Function Name: USBD_AUDIO_Add
+******************************************************************************
+* Summary:
+*  Add an audio class instance and assign the IDs of its units, the first
+*  interface number of instance i is 2 * i (control, then streaming).
+*
+* Parameters:
+*  pInitData: Settings of the instance
+*
+* Return:
+*  USBD_AUDIO_HANDLE: Handle of the instance
+*
+*****************************************************************************/
+USBD_AUDIO_HANDLE USBD_AUDIO_Add(const USBD_AUDIO_INIT_DATA *pInitData)
+{
+    sim_usb_instance_t *instance;
+    U8 first_id = (U8) ((SIM_USB_FIRST_UNIT_ID) + (sim_usb_num_instances * (SIM_USB_UNITS_PER_INSTANCE)));
+    U8 i;
+
+    CY_ASSERT(sim_usb_num_instances < (SIM_USB_MAX_INSTANCES));
+
+    instance = &sim_usb_instances[sim_usb_num_instances];
+    memset(instance, 0, sizeof(*instance));
+    instance->init_data = *pInitData;
+
+    for (i = 0U; i < pInitData->NumInterfaces; i++)
+    {
+        pInitData->paInterfaces[i].pUnits->InputTerminalID = first_id;
+        pInitData->paInterfaces[i].pUnits->FeatureUnitID = first_id + 1U;
+        pInitData->paInterfaces[i].pUnits->OutputTerminalID = first_id + 2U;
+    }
+
+    sim_usb_num_instances++;
+
+    return (USBD_AUDIO_HANDLE) (sim_usb_num_instances - 1U);
+}
+
+/*****************************************************************************
+* Function Name: USBD_AUDIO_Set_Timeouts
+******************************************************************************
+* Summary:
+*  Set the timeouts of the transfers, the simulated host never times out.
+*
+* Parameters:
+*  hInst: Handle of the instance
+*  ReadTimeout: Unused
+*  WriteTimeout: Unused
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_AUDIO_Set_Timeouts(USBD_AUDIO_HANDLE hInst, unsigned ReadTimeout, unsigned WriteTimeout)
+{
+    CY_UNUSED_PARAMETER(ReadTimeout);
+    CY_UNUSED_PARAMETER(WriteTimeout);
+
+    (void) sim_usb_get_instance((uint32_t) hInst);
+}
+
+/*****************************************************************************
+* Function Name: USBD_AUDIO_Start_Play
+******************************************************************************
+* Summary:
+*  Start sending packets on the IN endpoint of an instance, while the host
+*  selects an alternate setting.
+*
+* Parameters:
+*  hInst: Handle of the instance
+*  pBuffer: Unused, packets come from the IN callback
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_AUDIO_Start_Play(USBD_AUDIO_HANDLE hInst, const U8 *pBuffer)
+{
+    CY_UNUSED_PARAMETER(pBuffer);
+
+    sim_usb_get_instance((uint32_t) hInst)->playing = true;
+}
+
+/*****************************************************************************
+* Function Name: USBD_AUDIO_Stop_Play
+******************************************************************************
+* Summary:
+*  Stop sending packets on the IN endpoint of an instance.
+*
+* Parameters:
+*  hInst: Handle of the instance
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_AUDIO_Stop_Play(USBD_AUDIO_HANDLE hInst)
+{
+    sim_usb_get_instance((uint32_t) hInst)->playing = false;
+}
+
+/*****************************************************************************
+* Function Name: USBD_AUDIO_Write_Task
+******************************************************************************
+* Summary:
+*  Send one packet per start of frame on the IN endpoint of each instance
+*  playing with a streaming alternate setting. The IN callback provides the
+*  packet, a zero-length packet is sent if it provides none. Never returns.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void USBD_AUDIO_Write_Task(void)
+{
+    uint32_t events;
+    uint32_t i;
+
+    sim_usb_write_task = xTaskGetCurrentTaskHandle();
+
+    for (;;)
+    {
+        (void) xTaskNotifyWait(0U, SIM_USB_EVENT_SOF, &events, portMAX_DELAY);
+
+        for (i = 0U; i < sim_usb_num_instances; i++)
+        {
+            sim_usb_transfer(i);
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_transfer
+******************************************************************************
+* Summary:
+*  Get a packet of an instance from its IN callback and hand it to the host.
+*
+*****************************************************************************/
+static void sim_usb_transfer(uint32_t instance)
+{
+    sim_usb_instance_t *inst = &sim_usb_instances[instance];
+    const U8 *buffer = NULL;
+    U32 size = 0U;
+
+    if (!inst->playing || (0U == inst->alt_setting) || (0U == (sim_usb_state & USB_STAT_CONFIGURED)) ||
+        (0U != (sim_usb_state & USB_STAT_SUSPENDED)))
+    {
+        return;
+    }
+
+    inst->init_data.pfOnIn(inst->init_data.pInUserContext, &buffer, &size);
+    if (NULL == buffer)
+    {
+        size = 0U;
+    }
+
+    inst->stats.packets++;
+    inst->stats.bytes += size;
+    if (0U == size)
+    {
+        inst->stats.empty_packets++;
+    }
+    else if ((0U == inst->stats.min_size) || (size < inst->stats.min_size))
+    {
+        inst->stats.min_size = size;
+    }
+    if (size > inst->stats.max_size)
+    {
+        inst->stats.max_size = size;
+    }
+    if (size > sim_usb_get_max_packet_size(instance))
+    {
+        inst->stats.oversized++;
+    }
+
+    if (NULL != sim_usb_sink)
+    {
+        sim_usb_sink(sim_usb_sink_arg, instance, buffer, size);
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_get_instance
+******************************************************************************
+* Summary:
+*  Get an audio instance, asserting it exists.
+*
+*****************************************************************************/
+static sim_usb_instance_t *sim_usb_get_instance(uint32_t instance)
+{
+    CY_ASSERT(instance < sim_usb_num_instances);
+
+    return &sim_usb_instances[instance];
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_set_state
+******************************************************************************
+* Summary:
+*  Change the device state and notify the hooks.
+*
+*****************************************************************************/
+static void sim_usb_set_state(uint8_t state)
+{
+    USB_HOOK *hook;
+
+    if (state == sim_usb_state)
+    {
+        return;
+    }
+    sim_usb_state = state;
+
+    for (hook = sim_usb_hooks; NULL != hook; hook = hook->pNext)
+    {
+        hook->cb(hook->pContext, state);
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_schedule_sof
+******************************************************************************
+* Summary:
+*  Schedule the next start of frame, on the next millisecond.
+*
+*****************************************************************************/
+static void sim_usb_schedule_sof(void)
+{
+    uint64_t next = ((sim_now_ns() / (SIM_NS_PER_MS)) + 1U) * (SIM_NS_PER_MS);
+
+    sim_event_schedule(&sim_usb_sof_event, next, sim_usb_sof, NULL);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_sof
+******************************************************************************
+* Summary:
+*  Start of frame interrupt, wakes up the write task.
+*
+*****************************************************************************/
+static void sim_usb_sof(void *arg)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    if (NULL != sim_usb_write_task)
+    {
+        xTaskNotifyFromISR(sim_usb_write_task, SIM_USB_EVENT_SOF, eSetBits, &higher_priority_task_woken);
+    }
+
+    sim_usb_schedule_sof();
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_control
+******************************************************************************
+* Summary:
+*  Issue a request to the control callback of an instance. Host requests
+*  are issued between two sim_run(), where the control callback runs like
+*  in the interrupt of the control endpoint.
+*
+*****************************************************************************/
+static int sim_usb_control(uint32_t instance, uint8_t event, uint8_t selector, uint8_t *buffer, uint32_t size)
+{
+    sim_usb_instance_t *inst = sim_usb_get_instance(instance);
+    U8 unit = 0U;
+
+    if ((USB_AUDIO_RECORD_START != event) && (USB_AUDIO_RECORD_STOP != event))
+    {
+        unit = inst->init_data.paInterfaces[0].pUnits->FeatureUnitID;
+    }
+
+    return inst->init_data.pfOnControl(inst->init_data.pControlUserContext, event, unit, selector, buffer, size,
+                                       (U8) ((2U * instance) + 1U), inst->alt_setting);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_set_sink
+******************************************************************************
+* Summary:
+*  Set the function receiving the packets of the IN endpoints.
+*
+* Parameters:
+*  sink: Function called for each packet, NULL to drop them
+*  arg: Argument of the function
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_set_sink(sim_usb_sink_t sink, void *arg)
+{
+    sim_usb_sink = sink;
+    sim_usb_sink_arg = arg;
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_connect
+******************************************************************************
+* Summary:
+*  Plug the device to the host, which enumerates and configures it. The
+*  start of frame runs from then on.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_connect(void)
+{
+    sim_usb_attached = true;
+
+    if (!sim_usb_started)
+    {
+        return;
+    }
+
+    sim_usb_set_state(USB_STAT_ATTACHED | USB_STAT_READY | USB_STAT_ADDRESSED | USB_STAT_CONFIGURED);
+    sim_usb_schedule_sof();
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_disconnect
+******************************************************************************
+* Summary:
+*  Unplug the device. The streaming interfaces go back to alternate setting 0
+*  without any request, like after a detach.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_disconnect(void)
+{
+    uint32_t i;
+
+    sim_usb_attached = false;
+    sim_event_cancel(&sim_usb_sof_event);
+
+    for (i = 0U; i < sim_usb_num_instances; i++)
+    {
+        sim_usb_instances[i].alt_setting = 0U;
+    }
+
+    sim_usb_set_state(0U);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_suspend
+******************************************************************************
+* Summary:
+*  Suspend the bus, no start of frame while suspended.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_suspend(void)
+{
+    sim_event_cancel(&sim_usb_sof_event);
+    sim_usb_set_state(sim_usb_state | USB_STAT_SUSPENDED);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_resume
+******************************************************************************
+* Summary:
+*  Resume the bus.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_resume(void)
+{
+    sim_usb_set_state(sim_usb_state & (uint8_t) ~(USB_STAT_SUSPENDED));
+    if (0U != (sim_usb_state & USB_STAT_CONFIGURED))
+    {
+        sim_usb_schedule_sof();
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_set_interface
+******************************************************************************
+* Summary:
+*  Select an alternate setting of the streaming interface of an instance,
+*  0 stops the stream.
+*
+* Parameters:
+*  instance: Audio instance
+*  alt_setting: Alternate setting, 1 + index of the format
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_set_interface(uint32_t instance, uint8_t alt_setting)
+{
+    sim_usb_instance_t *inst = sim_usb_get_instance(instance);
+
+    CY_ASSERT(alt_setting <= inst->init_data.paInterfaces[0].NumFormats);
+
+    inst->alt_setting = alt_setting;
+    (void) sim_usb_control(instance, (0U != alt_setting) ? USB_AUDIO_RECORD_START : USB_AUDIO_RECORD_STOP,
+                           0U, NULL, 0U);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_set_cur
+******************************************************************************
+* Summary:
+*  Send a SET_CUR request to the feature unit of an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*  selector: Control selector (USB_AUDIO_x_CONTROL)
+*  buffer: Setting
+*  size: Size of the setting
+*
+* Return:
+*  int: 0 if handled, the request stalls otherwise
+*
+*****************************************************************************/
+int sim_usb_set_cur(uint32_t instance, uint8_t selector, const uint8_t *buffer, uint32_t size)
+{
+    uint8_t data[SIM_USB_MAX_CONTROL_SIZE];
+
+    CY_ASSERT(size <= sizeof(data));
+    memcpy(data, buffer, size);
+
+    return sim_usb_control(instance, USB_AUDIO_SET_CUR, selector, data, size);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_get_cur
+******************************************************************************
+* Summary:
+*  Send a GET_CUR request to the feature unit of an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*  selector: Control selector (USB_AUDIO_x_CONTROL)
+*  buffer: Reply
+*  size: Size of the reply
+*
+* Return:
+*  int: 0 if handled, the request stalls otherwise
+*
+*****************************************************************************/
+int sim_usb_get_cur(uint32_t instance, uint8_t selector, uint8_t *buffer, uint32_t size)
+{
+    return sim_usb_control(instance, USB_AUDIO_GET_CUR, selector, buffer, size);
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_set_volume
+******************************************************************************
+* Summary:
+*  Set the volume of the feature unit of an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*  volume: Volume in 1/256 dB
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_set_volume(uint32_t instance, int16_t volume)
+{
+    uint8_t data[2];
+
+    data[0] = (uint8_t) ((uint16_t) volume & 0xFFU);
+    data[1] = (uint8_t) ((uint16_t) volume >> 8);
+
+    if (0 != sim_usb_set_cur(instance, USB_AUDIO_VOLUME_CONTROL, data, sizeof(data)))
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_set_mute
+******************************************************************************
+* Summary:
+*  Mute or unmute the feature unit of an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*  mute: 1 to mute
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_set_mute(uint32_t instance, uint8_t mute)
+{
+    if (0 != sim_usb_set_cur(instance, USB_AUDIO_MUTE_CONTROL, &mute, 1U))
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_get_max_packet_size
+******************************************************************************
+* Summary:
+*  Get the wMaxPacketSize of the IN endpoint of an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*
+* Return:
+*  uint32_t: Size in bytes
+*
+*****************************************************************************/
+uint32_t sim_usb_get_max_packet_size(uint32_t instance)
+{
+    return sim_usb_endpoints[SIM_USB_EP_INDEX(sim_usb_get_instance(instance)->init_data.EPIn)].MaxPacketSize;
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_get_stats
+******************************************************************************
+* Summary:
+*  Get the statistics of the packets received from an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*  stats: Statistics
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_get_stats(uint32_t instance, sim_usb_stats_t *stats)
+{
+    *stats = sim_usb_get_instance(instance)->stats;
+}
+
+/*****************************************************************************
+* Function Name: sim_usb_clear_stats
+******************************************************************************
+* Summary:
+*  Clear the statistics of the packets received from an instance.
+*
+* Parameters:
+*  instance: Audio instance
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void sim_usb_clear_stats(uint32_t instance)
+{
+    memset(&sim_usb_get_instance(instance)->stats, 0, sizeof(sim_usb_stats_t));
+}
+
+/* [] END OF FILE */
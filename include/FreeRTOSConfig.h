@@ -73,7 +73,11 @@ extern uint32_t SystemCoreClock;
 #define configENABLE_BACKWARD_COMPATIBILITY     0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
 
-/* Memory allocation related definitions. */
+/* Memory allocation related definitions. The tasks of the application are
+ * allocated statically. Dynamic allocation remains for the middleware; with
+ * heap_3 it is served by the C library heap and configTOTAL_HEAP_SIZE is not
+ * used.
+ */
 #define configSUPPORT_STATIC_ALLOCATION         1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
 #define configTOTAL_HEAP_SIZE                   10240
@@ -86,11 +90,29 @@ extern uint32_t SystemCoreClock;
 #define configUSE_MALLOC_FAILED_HOOK            1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
-/* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+/* Run time and task stats gathering related definitions.
+ * Set RTOS_STATS_ENABLE to 1 to account the CPU time of each task with the
+ * CPU cycle counter (see rtos_stats.c), reported by the console.
+ */
+#ifndef RTOS_STATS_ENABLE
+#define RTOS_STATS_ENABLE                       0
+#endif
+
+#define configGENERATE_RUN_TIME_STATS           RTOS_STATS_ENABLE
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+#if (RTOS_STATS_ENABLE)
+extern void rtos_stats_init(void);
+extern uint32_t rtos_stats_get_counter(void);
+extern void rtos_stats_task_switched_in(void);
+extern void rtos_stats_task_switched_out(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() rtos_stats_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()        rtos_stats_get_counter()
+#define traceTASK_SWITCHED_IN()                 rtos_stats_task_switched_in()
+#define traceTASK_SWITCHED_OUT()                rtos_stats_task_switched_out()
+#endif
+
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
@@ -99,7 +121,7 @@ extern uint32_t SystemCoreClock;
 #define configUSE_TIMERS                        1
 #define configTIMER_TASK_PRIORITY               3
 #define configTIMER_QUEUE_LENGTH                10
-#define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
+#define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 4 ) /* Runs the telemetry sampling */
 
 /*
 Interrupt nesting behavior configuration.
@@ -157,8 +179,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
-#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
 #define INCLUDE_xTimerPendFunctionCall          1
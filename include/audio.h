@@ -47,49 +47,167 @@ extern "C" {
 /******************************************************************************
 * Constants from USB Audio Descriptor
 ******************************************************************************/
+#define AUDIO_SAMPLING_RATE_8KHZ                (8000U)
 #define AUDIO_SAMPLING_RATE_16KHZ               (16000U)
 #define AUDIO_SAMPLING_RATE_22KHZ               (22050U)
 #define AUDIO_SAMPLING_RATE_32KHZ               (32000U)
 #define AUDIO_SAMPLING_RATE_44KHZ               (44100U)
+#define AUDIO_SAMPLING_RATE_48KHZ               (48000U)
+#define AUDIO_SAMPLING_RATE_96KHZ               (96000U)
+
+/* Microphones captured by the PDM/PCM block, left and right */
+#define AUDIO_IN_MIC_CHANNELS                   (2U)
+
+/* Microphones sent in a format (see microphone_layouts[]): both of them, a
+ * single one captured alone by the PDM/PCM block, or the average of both
+ */
+#define AUDIO_IN_LAYOUT_STEREO                  (0U)
+#define AUDIO_IN_LAYOUT_LEFT                    (1U)
+#define AUDIO_IN_LAYOUT_RIGHT                   (2U)
+#define AUDIO_IN_LAYOUT_DOWNMIX                 (3U)
+
+/* Beamforming. Set to 1 to combine the two microphones on the device into
+ * one channel steered towards a direction (see source/dsp_beam.c): the
+ * stream sent to the host becomes mono. Also set DSP_CHAIN_ENABLE_BEAM to 1
+ * in include/dsp_chain.h.
+ */
+#ifndef AUDIO_IN_BEAMFORMER
+#define AUDIO_IN_BEAMFORMER                     (0U)
+#endif
+
+/* Second stream. Set to 1 to add a second microphone interface sending the
+ * same capture at AUDIO_IN_SECOND_SAMPLE_FREQ, mono, 16 bits, e.g. for speech
+ * recognition next to a recording at 48 KHz. The decimator of
+ * source/dsp_decim.c derives it from the output of the DSP chain when the
+ * sample rate of the first stream is a multiple of it; silence is sent
+ * otherwise. While the first stream is closed, the capture runs at
+ * AUDIO_IN_SECOND_CAPTURE_FREQ.
+ */
+#ifndef AUDIO_IN_SECOND_STREAM
+#define AUDIO_IN_SECOND_STREAM                  (0U)
+#endif
+#define AUDIO_IN_SECOND_SAMPLE_FREQ             AUDIO_SAMPLING_RATE_16KHZ
+#define AUDIO_IN_SECOND_CAPTURE_FREQ            AUDIO_SAMPLING_RATE_48KHZ
+#define AUDIO_IN_SECOND_NUM_CHANNELS            (1U)
+#define AUDIO_IN_SECOND_CHANNEL_CONFIG          (0x0004U)   /* Center Front */
 
 /* Initialization data for a single audio format */
-#define AUDIO_IN_NUM_CHANNELS                   (2U)
+#if (AUDIO_IN_BEAMFORMER)
+#define AUDIO_IN_NUM_CHANNELS                   (1U)
+#define AUDIO_IN_CHANNEL_CONFIG                 (0x0004U)   /* Center Front */
+#else
+#define AUDIO_IN_NUM_CHANNELS                   (AUDIO_IN_MIC_CHANNELS)
+#define AUDIO_IN_CHANNEL_CONFIG                 (0x0003U)   /* Left Front, Right Front */
+#endif /* AUDIO_IN_BEAMFORMER */
 #define AUDIO_IN_SUB_FRAME_SIZE                 (2U)   /* In bytes */
 #define AUDIO_IN_BIT_RESOLUTION                 (16U)
+
+/* Mono interface. Without the beamformer, the formats sending a single
+ * microphone or the average of both are the alternate settings of a second
+ * microphone interface, whose terminal has one Center Front channel, with
+ * its own Audio IN endpoint sized for them (16 bits, up to 48 KHz).
+ */
+#if (AUDIO_IN_BEAMFORMER)
+#define AUDIO_IN_MONO_INTERFACE                 (0U)
+#else
+#define AUDIO_IN_MONO_INTERFACE                 (1U)
+#endif /* AUDIO_IN_BEAMFORMER */
+#define AUDIO_IN_MONO_NUM_CHANNELS              (1U)
+#define AUDIO_IN_MONO_CHANNEL_CONFIG            (0x0004U)   /* Center Front */
+#define AUDIO_IN_MONO_MAX_SAMPLE_FREQ           AUDIO_SAMPLING_RATE_48KHZ
+
+/* Wide formats. The PDM/PCM block produces up to 24 bits per sample, packed
+ * in 3 bytes or left-justified in 4 bytes (lowest 8 bits are zero).
+ */
+#define AUDIO_IN_SUB_FRAME_SIZE_24BIT           (3U)   /* In bytes */
+#define AUDIO_IN_BIT_RESOLUTION_24BIT           (24U)
+#define AUDIO_IN_SUB_FRAME_SIZE_32BIT           (4U)   /* In bytes */
+#define AUDIO_IN_BIT_RESOLUTION_32BIT           (32U)
+
+/* Largest subframe of microphone_formats[]. Captured samples of the wide
+ * formats also take 4 bytes in memory before they are packed.
+ */
+#define AUDIO_IN_MAX_SUB_FRAME_SIZE             AUDIO_IN_SUB_FRAME_SIZE_32BIT
+
+/* Sample rate selected at startup. The host can switch to any other rate of
+ * microphone_formats[] at runtime by selecting its alternate setting.
+ */
 #define AUDIO_IN_SAMPLE_FREQ                    AUDIO_SAMPLING_RATE_44KHZ
 
+/* Highest sample rate of microphone_formats[]. Sizes the Audio IN endpoint
+ * and the capture buffers.
+ */
+#define AUDIO_IN_MAX_SAMPLE_FREQ                AUDIO_SAMPLING_RATE_96KHZ
+
 /* VendorID */
 #define AUDIO_DEVICE_VENDOR_ID                  (0x058B)
 
-/* ProductIDs */
-#if (AUDIO_SAMPLING_RATE_16KHZ == AUDIO_IN_SAMPLE_FREQ)
-#define AUDIO_DEVICE_PRODUCT_ID                 (0x0276)
-#elif (AUDIO_SAMPLING_RATE_22KHZ == AUDIO_IN_SAMPLE_FREQ)
-#define AUDIO_DEVICE_PRODUCT_ID                 (0x0277)
-#elif (AUDIO_SAMPLING_RATE_32KHZ == AUDIO_IN_SAMPLE_FREQ)
-#define AUDIO_DEVICE_PRODUCT_ID                 (0x0278)
-#elif (AUDIO_SAMPLING_RATE_44KHZ == AUDIO_IN_SAMPLE_FREQ)
+/* ProductID. All the formats are advertised whatever the startup rate is,
+ * so the descriptors, and the ProductID, do not depend on it.
+ */
 #define AUDIO_DEVICE_PRODUCT_ID                 (0x0279)
-#else
+
+#if !((AUDIO_SAMPLING_RATE_8KHZ == AUDIO_IN_SAMPLE_FREQ) || \
+      (AUDIO_SAMPLING_RATE_16KHZ == AUDIO_IN_SAMPLE_FREQ) || \
+      (AUDIO_SAMPLING_RATE_22KHZ == AUDIO_IN_SAMPLE_FREQ) || \
+      (AUDIO_SAMPLING_RATE_32KHZ == AUDIO_IN_SAMPLE_FREQ) || \
+      (AUDIO_SAMPLING_RATE_44KHZ == AUDIO_IN_SAMPLE_FREQ) || \
+      (AUDIO_SAMPLING_RATE_48KHZ == AUDIO_IN_SAMPLE_FREQ) || \
+      (AUDIO_SAMPLING_RATE_96KHZ == AUDIO_IN_SAMPLE_FREQ))
 #error "Sample rate not supported in this code example."
 #endif
 
 
 /*
- * Has to match the configured values in Microphone Configuration
- * For a sample rate of 44100, 16 bits per sample, 2 channels:
- * (44100 * ((16/8) * 2)) / 1000 = 176 bytes
- * Additional sample size is added to make sure we can send odd sized frames if necessary:
- * 176 bytes + ((16/8) * 2) = 180
+ * Has to match the configured values in Microphone Configuration.
+ * The Audio IN endpoint is sized for the largest format of microphone_formats[],
+ * 96000 Hz, 32 bits per sample, 2 channels:
+ * (96000 * (2 * 4)) / 1000 = 768 bytes
+ * One additional frame is added to make sure we can send odd sized frames if necessary:
+ * 768 bytes + (2 * 4) = 776 bytes
+ */
+
+/* Size of one frame (all channels of a stereo format) for a given subframe
+ * size. The mono formats send half of it.
+ */
+#define AUDIO_IN_FRAME_SIZE_BYTES(sub_frame)    ((AUDIO_IN_NUM_CHANNELS) * (sub_frame)) /* In bytes */
+
+/* Additional frame of the widest format */
+#define ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_BYTES   AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_MAX_SUB_FRAME_SIZE) /* In bytes */
+
+/* Largest packet of a given sample rate and subframe size */
+#define AUDIO_IN_PACKET_SIZE_BYTES(freq, sub_frame) \
+    ((((freq) * AUDIO_IN_FRAME_SIZE_BYTES(sub_frame)) / 1000U) + AUDIO_IN_FRAME_SIZE_BYTES(sub_frame)) /* In bytes */
+
+#define MAX_AUDIO_IN_PACKET_SIZE_BYTES          AUDIO_IN_PACKET_SIZE_BYTES(AUDIO_IN_MAX_SAMPLE_FREQ, AUDIO_IN_MAX_SUB_FRAME_SIZE) /* In bytes */
+
+#define ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_WORDS   ((ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_BYTES) / (AUDIO_IN_MAX_SUB_FRAME_SIZE)) /* In samples */
+
+#define MAX_AUDIO_IN_PACKET_SIZE_WORDS          ((MAX_AUDIO_IN_PACKET_SIZE_BYTES) / (AUDIO_IN_MAX_SUB_FRAME_SIZE)) /* In samples */
+
+/* Largest captured period, all the microphones: the frames of the largest
+ * packet, 32 bits per sample
  */
+#define MAX_AUDIO_IN_CAPTURE_SIZE_WORDS         (((MAX_AUDIO_IN_PACKET_SIZE_WORDS) / (AUDIO_IN_NUM_CHANNELS)) * (AUDIO_IN_MIC_CHANNELS)) /* In samples */
 
-#define ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_BYTES   (((AUDIO_IN_BIT_RESOLUTION) / 8U) * (AUDIO_IN_SUB_FRAME_SIZE)) /* In bytes */
+/* Largest packet of the mono interface, 16 bits per sample, with the
+ * additional frame: (48 + 1) * 2 = 98 bytes
+ */
+#define AUDIO_IN_MONO_PACKET_SIZE_BYTES         \
+    ((((AUDIO_IN_MONO_MAX_SAMPLE_FREQ) / 1000U) + 1U) * (AUDIO_IN_MONO_NUM_CHANNELS) * (AUDIO_IN_SUB_FRAME_SIZE)) /* In bytes */
 
-#define MAX_AUDIO_IN_PACKET_SIZE_BYTES          ((((AUDIO_IN_SAMPLE_FREQ) * (((AUDIO_IN_BIT_RESOLUTION) / 8U) * (AUDIO_IN_NUM_CHANNELS))) / 1000U) + (ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_BYTES)) /* In bytes */
+/* Largest packet of the second stream, 16 bits per sample */
+#define AUDIO_IN_SECOND_PACKET_SIZE_BYTES       \
+    ((((AUDIO_IN_SECOND_SAMPLE_FREQ) / 1000U) + 1U) * (AUDIO_IN_SECOND_NUM_CHANNELS) * (AUDIO_IN_SUB_FRAME_SIZE)) /* In bytes */
 
-#define ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_WORDS   ((ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_BYTES) / (AUDIO_IN_SUB_FRAME_SIZE)) /* In words */
+/* Largest isochronous packet of a full-speed endpoint, sent once per 1 ms frame.
+ * At 96000 Hz, 32 bits per sample, 2 channels: 768 bytes + 8 bytes = 776 bytes.
+ */
+#define AUDIO_IN_MAX_ISO_PACKET_SIZE_BYTES      (1023U)
 
-#define MAX_AUDIO_IN_PACKET_SIZE_WORDS          ((MAX_AUDIO_IN_PACKET_SIZE_BYTES) / (AUDIO_IN_SUB_FRAME_SIZE)) /* In words */
+#if (MAX_AUDIO_IN_PACKET_SIZE_BYTES > AUDIO_IN_MAX_ISO_PACKET_SIZE_BYTES)
+#error "The largest format does not fit in the 1 ms packet budget of the Audio IN endpoint."
+#endif
 
 
 #if defined(__cplusplus)
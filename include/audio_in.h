@@ -45,15 +45,71 @@
 extern "C" {
 #endif
 
-#include "cyhal.h"
+#include <stdbool.h>
+#include <stdint.h>
 #include "Global.h"
+#include "period_queue.h"
+#include "latency_hist.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Capture mode of the Audio In path:
+ * 1 - The DMA drains the PDM/PCM RX FIFO into a queue of periods and the
+ *     Audio IN endpoint callback only hands completed periods to the host.
+ * 0 - The Audio IN endpoint callback reads the PDM/PCM RX FIFO into the
+ *     queue of periods.
+ */
+#ifndef AUDIO_IN_CAPTURE_DMA
+#define AUDIO_IN_CAPTURE_DMA            (1U)
+#endif
+
+/* Number of captured periods waiting in the queue before the first one is
+ * sent to the host.
+ */
+#define AUDIO_IN_QUEUE_PREFILL_PERIODS  (1U)
+
+/* Voice activity gating, with the VAD stage of the DSP chain:
+ * 1 - Silence is sent while no speech is detected. After
+ *     AUDIO_IN_VAD_GATE_MS without speech, the PDM/PCM block is powered down
+ *     and only wakes up periodically to listen for speech.
+ * 0 - The captured audio is always sent.
+ */
+#ifndef AUDIO_IN_VAD_GATING
+#define AUDIO_IN_VAD_GATING             (0U)
+#endif
+
+/* Volume range reported to the host, in 1/256 dB. It matches the gain range
+ * of the PDM/PCM block; the host setting is rounded to AUDIO_IN_VOLUME_RES.
+ */
+#define AUDIO_IN_VOLUME_MIN             (-12 * 256)
+#define AUDIO_IN_VOLUME_MAX             (21 * 128)
+#define AUDIO_IN_VOLUME_RES             (128)
+#define AUDIO_IN_VOLUME_DEFAULT         AUDIO_IN_VOLUME_MAX
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/* Power gating statistics of the capture path */
+typedef struct
+{
+    bool     capturing;         /* PDM/PCM block running */
+    uint32_t active_ms;         /* Time spent capturing */
+    uint32_t idle_ms;           /* Time spent with the capture stopped */
+    uint32_t resumes;           /* Captures started */
+    uint32_t last_resume_us;    /* Start of the last capture to its first valid packet */
+    uint32_t max_resume_us;     /* Longest start since the last reset */
+    uint32_t vad_gates;         /* Captures stopped on sustained silence */
+} audio_in_power_stats_t;
 
 
 /******************************************************************************
 * Externs
 ******************************************************************************/
-extern cyhal_pdm_pcm_t pdm_pcm;
 extern U8 mic_mute;
+extern U8 mic_second_mute;
 
 
 /******************************************************************************
@@ -62,9 +118,23 @@ extern U8 mic_mute;
 void audio_in_init(void);
 void audio_in_enable(void);
 void audio_in_disable(void);
+void audio_in_set_format(uint8_t format_index);
+uint8_t audio_in_get_format(void);
+void audio_in_set_volume(int16_t volume);
+int16_t audio_in_get_volume(void);
+void audio_in_get_queue_stats(period_queue_stats_t *stats);
+void audio_in_get_latency(latency_hist_t *hist);
+void audio_in_reset_stats(void);
+void audio_in_power_down(void);
+bool audio_in_is_active(void);
+void audio_in_get_power_stats(audio_in_power_stats_t *stats);
 void audio_in_process(void *arg);
 void audio_in_endpoint_callback(void *pUserContext, const U8 **ppNextBuffer, U32 *pNextPacketSize);
-void audio_clock_init(void);
+void audio_in_mono_endpoint_callback(void *pUserContext, const U8 **ppNextBuffer, U32 *pNextPacketSize);
+bool audio_in_is_streaming(void);
+void audio_in_second_enable(void);
+void audio_in_second_disable(void);
+void audio_in_second_endpoint_callback(void *pUserContext, const U8 **ppNextBuffer, U32 *pNextPacketSize);
 
 
 #if defined(__cplusplus)
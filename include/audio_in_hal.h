@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name   : audio_in_hal.h
+*
+* Description : This file contains the function prototypes of the hardware
+*               access layer used by the Audio In path.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef AUDIO_IN_HAL_H
+#define AUDIO_IN_HAL_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Widest word produced by the PDM/PCM block, in bits */
+#define AUDIO_IN_HAL_MAX_WORD_LENGTH            (24U)
+
+/* Depth of the PDM/PCM RX FIFO, in samples (words) */
+#define AUDIO_IN_HAL_FIFO_SAMPLES               (254U)
+
+/* Bytes taken in memory by a captured sample. Words up to 16 bits are read
+ * as halfwords, wider words as right-aligned 32-bit words.
+ */
+#define AUDIO_IN_HAL_SAMPLE_SIZE(bit_resolution) (((bit_resolution) > 16U) ? 4U : 2U)
+
+/* Range and step of the programmable gain of the PDM/PCM block, in 0.5 dB
+ * (-12 dB to +10.5 dB in 1.5 dB steps)
+ */
+#define AUDIO_IN_HAL_GAIN_MIN                   (-24)
+#define AUDIO_IN_HAL_GAIN_MAX                   (21)
+#define AUDIO_IN_HAL_GAIN_STEP                  (3)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/* Called in interrupt context when a period started with
+ * audio_in_hal_read_period() has been completely written by the DMA.
+ */
+typedef void (*audio_in_hal_period_callback_t)(void);
+
+
+/******************************************************************************
+* Audio In HAL Functions
+******************************************************************************/
+void audio_clock_init(void);
+void audio_in_hal_init(void);
+void audio_in_hal_set_format(uint32_t sample_rate, uint8_t bit_resolution, uint8_t layout);
+void audio_in_hal_set_gain(int32_t gain);
+void audio_in_hal_start(void);
+void audio_in_hal_stop(void);
+void audio_in_hal_clear(void);
+uint32_t audio_in_hal_get_fifo_level(void);
+void audio_in_hal_read(void *buffer, size_t *count);
+void audio_in_hal_register_period_callback(audio_in_hal_period_callback_t callback);
+void audio_in_hal_read_period(void *buffer, size_t count);
+void audio_in_hal_abort_period(void);
+void audio_in_hal_power_down(void);
+void audio_in_hal_power_up(void);
+void audio_in_hal_set_led(bool on);
+void audio_in_hal_toggle_led(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* AUDIO_IN_HAL_H */
+
+/* [] END OF FILE */
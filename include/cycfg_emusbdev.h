@@ -45,13 +45,28 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
 #include "USB_Audio.h"
+#include "audio.h"
 
 
 /******************************************************************************
 * Macros
 ******************************************************************************/
-#define USB_NUM_AUDIO_INTERFACES    (1)
+/* Microphone interface, then the mono interface and the interface of the
+ * second stream if any
+ */
+#define USB_NUM_AUDIO_INTERFACES    (1 + (AUDIO_IN_MONO_INTERFACE) + (AUDIO_IN_SECOND_STREAM))
+#define AUDIO_IF_MICROPHONE         (0U)
+#define AUDIO_IF_MONO               (1U)
+#define AUDIO_IF_SECOND             (1U + (AUDIO_IN_MONO_INTERFACE))
+
+/* Formats of microphone_formats[]: those of the microphone interface, then
+ * those of the mono interface
+ */
+#define AUDIO_IN_NUM_MIC_FORMATS    (13U)
+#define AUDIO_IN_NUM_MONO_FORMATS   (6U * (AUDIO_IN_MONO_INTERFACE))
+#define AUDIO_IN_NUM_FORMATS        ((AUDIO_IN_NUM_MIC_FORMATS) + (AUDIO_IN_NUM_MONO_FORMATS))
 
 
 /******************************************************************************
@@ -59,6 +74,8 @@ extern "C" {
 ******************************************************************************/
 extern const USB_DEVICE_INFO usb_deviceInfo;
 extern const USBD_AUDIO_IF_CONF audio_interfaces[USB_NUM_AUDIO_INTERFACES];
+extern const USBD_AUDIO_FORMAT microphone_formats[AUDIO_IN_NUM_FORMATS];
+extern const uint8_t microphone_layouts[AUDIO_IN_NUM_FORMATS];
 
 
 #if defined(__cplusplus)
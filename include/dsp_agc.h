@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name   : dsp_agc.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_agc.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_AGC_H
+#define DSP_AGC_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Levels and gains are in 1/256 dB, levels relative to the full scale */
+
+/* RMS level the gain brings the speech to */
+#ifndef DSP_AGC_TARGET_RMS
+#define DSP_AGC_TARGET_RMS              (-20 * 256)
+#endif
+
+/* Peak level the gain never pushes a period above */
+#ifndef DSP_AGC_MAX_PEAK
+#define DSP_AGC_MAX_PEAK                (-3 * 256)
+#endif
+
+/* Below this RMS level before the gain, the period is taken as background
+ * noise and the gain is held
+ */
+#ifndef DSP_AGC_GATE_RMS
+#define DSP_AGC_GATE_RMS                (-65 * 256)
+#endif
+
+/* Range of the gain, and gain at the start of a stream. The default range
+ * covers the gain range of the PDM/PCM block (-12 dB to +10.5 dB) and 12 dB
+ * of attenuation below it.
+ */
+#ifndef DSP_AGC_GAIN_MIN
+#define DSP_AGC_GAIN_MIN                (-24 * 256)
+#endif
+#ifndef DSP_AGC_GAIN_MAX
+#define DSP_AGC_GAIN_MAX                (21 * 128)
+#endif
+#ifndef DSP_AGC_GAIN_INITIAL
+#define DSP_AGC_GAIN_INITIAL            (0)
+#endif
+
+/* Resolution of the gain reported by dsp_agc_get_gain() */
+#define DSP_AGC_GAIN_RES                (128)
+
+/* Smoothing of the gain, once per period: the gain covers 2^-shift of the
+ * distance to its target. The attack (gain going down) takes about 8
+ * periods, the release (gain going up) about 512 periods.
+ */
+#ifndef DSP_AGC_ATTACK_SHIFT
+#define DSP_AGC_ATTACK_SHIFT            (3U)
+#endif
+#ifndef DSP_AGC_RELEASE_SHIFT
+#define DSP_AGC_RELEASE_SHIFT           (9U)
+#endif
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/* Levels of the last period and gain, in 1/256 dB */
+typedef struct
+{
+    int32_t rms;
+    int32_t peak;
+    int32_t gain;
+} dsp_agc_status_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_agc_reset(void);
+void dsp_agc_process(dsp_block_t *block);
+int32_t dsp_agc_get_gain(void);
+void dsp_agc_set_period_gain(int32_t gain);
+void dsp_agc_get_status(dsp_agc_status_t *status);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_AGC_H */
+
+/* [] END OF FILE */
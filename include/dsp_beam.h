@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name   : dsp_beam.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_beam.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_BEAM_H
+#define DSP_BEAM_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Distance between the two microphones. Measure it on the board. */
+#ifndef DSP_BEAM_MIC_SPACING_MM
+#define DSP_BEAM_MIC_SPACING_MM         (20U)
+#endif
+
+/* Direction the beam is steered to at startup, in degrees: 0 is broadside
+ * (in front of the pair), +90 towards the left microphone (channel 0), -90
+ * towards the right microphone.
+ */
+#ifndef DSP_BEAM_ANGLE_DEG
+#define DSP_BEAM_ANGLE_DEG              (0)
+#endif
+
+/* Speed of sound, in m/s */
+#define DSP_BEAM_SPEED_OF_SOUND         (343.0f)
+
+/* Samples kept per microphone for the delay. Bounds the steering delay to
+ * DSP_BEAM_HISTORY - 4 samples (12 samples: 42 mm of spacing at 96 ksps).
+ */
+#define DSP_BEAM_HISTORY                (16U)
+
+/* Fractional bits of the interpolator coefficients */
+#define DSP_BEAM_Q                      (14U)
+
+/* Delay added to the samples, in frames */
+#define DSP_BEAM_LATENCY                (1U)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_beam_configure(uint32_t sample_rate);
+void dsp_beam_reset(void);
+void dsp_beam_process(dsp_block_t *block);
+void dsp_beam_set_angle(int32_t degrees);
+int32_t dsp_beam_get_angle(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_BEAM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+/******************************************************************************
+* File Name   : dsp_chain.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_chain.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_CHAIN_H
+#define DSP_CHAIN_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Stages compiled in the chain, in processing order. A disabled stage costs
+ * no code, no data and no cycles.
+ */
+/* The sample rate converter produces the 44.1 KHz family from a capture in
+ * the 48 KHz family, so the audio subsystem clock never changes. It runs
+ * first, the other stages see the sample rate of the host.
+ */
+#ifndef DSP_CHAIN_ENABLE_SRC
+#define DSP_CHAIN_ENABLE_SRC            (0U)
+#endif
+/* The beamformer combines the two microphones into one channel; it goes
+ * with AUDIO_IN_BEAMFORMER in include/audio.h.
+ */
+#ifndef DSP_CHAIN_ENABLE_BEAM
+#define DSP_CHAIN_ENABLE_BEAM           (0U)
+#endif
+#ifndef DSP_CHAIN_ENABLE_DC_BLOCK
+#define DSP_CHAIN_ENABLE_DC_BLOCK       (1U)
+#endif
+#ifndef DSP_CHAIN_ENABLE_EQ
+#define DSP_CHAIN_ENABLE_EQ             (1U)
+#endif
+#ifndef DSP_CHAIN_ENABLE_GAIN
+#define DSP_CHAIN_ENABLE_GAIN           (1U)
+#endif
+/* The AGC drives the gain of the capture path for speech; it replaces the
+ * volume control as the main gain, see audio_in_apply_volume().
+ */
+#ifndef DSP_CHAIN_ENABLE_AGC
+#define DSP_CHAIN_ENABLE_AGC            (0U)
+#endif
+#ifndef DSP_CHAIN_ENABLE_VAD
+#define DSP_CHAIN_ENABLE_VAD            (1U)
+#endif
+/* The limiter delays the samples by its look-ahead and runs on every frame;
+ * enable it when loud sources would clip the output.
+ */
+#ifndef DSP_CHAIN_ENABLE_LIMITER
+#define DSP_CHAIN_ENABLE_LIMITER        (0U)
+#endif
+
+#define DSP_CHAIN_NUM_STAGES            ((DSP_CHAIN_ENABLE_SRC) + (DSP_CHAIN_ENABLE_BEAM) + \
+                                         (DSP_CHAIN_ENABLE_DC_BLOCK) + (DSP_CHAIN_ENABLE_EQ) + \
+                                         (DSP_CHAIN_ENABLE_GAIN) + (DSP_CHAIN_ENABLE_AGC) + \
+                                         (DSP_CHAIN_ENABLE_VAD) + (DSP_CHAIN_ENABLE_LIMITER))
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/* Block of interleaved samples, processed in place */
+typedef struct
+{
+    void *samples;
+    uint32_t frames;                /* The sample rate converter reduces it */
+    uint32_t channels;              /* A stage may reduce it, e.g. the beamformer */
+    uint32_t sample_size;           /* 2: int16_t, 4: 24-bit right-aligned in int32_t */
+} dsp_block_t;
+
+/* Processing stage of the chain */
+typedef struct
+{
+    const char *name;
+    void (*configure)(uint32_t sample_rate);    /* New format, NULL if not needed */
+    void (*reset)(void);                        /* New stream, NULL if stateless */
+    void (*process)(dsp_block_t *block);
+    uint32_t latency;                           /* Delay added to the samples, in frames */
+} dsp_stage_t;
+
+/* CPU cycles spent by a stage */
+typedef struct
+{
+    const char *name;
+    uint32_t calls;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} dsp_stage_stats_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_chain_configure(uint32_t sample_rate);
+void dsp_chain_reset(void);
+void dsp_chain_process(dsp_block_t *block);
+uint32_t dsp_chain_get_num_stages(void);
+uint32_t dsp_chain_get_latency(void);
+uint32_t dsp_chain_get_stage_delay(void (*process)(dsp_block_t *block));
+void dsp_chain_get_stats(uint32_t index, dsp_stage_stats_t *stats);
+void dsp_chain_reset_stats(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_CHAIN_H */
+
+/* [] END OF FILE */
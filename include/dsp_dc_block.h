@@ -0,0 +1,81 @@
+/******************************************************************************
+* File Name   : dsp_dc_block.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_dc_block.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_DC_BLOCK_H
+#define DSP_DC_BLOCK_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* -3 dB cutoff frequency of the high-pass filter */
+#ifndef DSP_DC_BLOCK_CUTOFF_HZ
+#define DSP_DC_BLOCK_CUTOFF_HZ          (20U)
+#endif
+
+/* Channels filtered, one state per channel */
+#define DSP_DC_BLOCK_MAX_CHANNELS       (2U)
+
+/* Fractional bits of the coefficient and of the accumulators */
+#define DSP_DC_BLOCK_Q                  (14U)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_dc_block_configure(uint32_t sample_rate);
+void dsp_dc_block_reset(void);
+void dsp_dc_block_process(dsp_block_t *block);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_DC_BLOCK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name   : dsp_decim.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_decim.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_DECIM_H
+#define DSP_DECIM_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Largest decimation factor, e.g. 96 KHz to 16 KHz */
+#define DSP_DECIM_MAX_FACTOR            (6U)
+
+/* Coefficients of the lowpass per unit of the decimation factor. The band
+ * kept and the transition band scale with the output rate, so the filter
+ * grows with the factor.
+ */
+#define DSP_DECIM_TAPS_PER_FACTOR       (24U)
+#define DSP_DECIM_MAX_TAPS              ((DSP_DECIM_MAX_FACTOR) * (DSP_DECIM_TAPS_PER_FACTOR))
+
+/* Fractional bits of the coefficients */
+#define DSP_DECIM_Q                     (14U)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+uint32_t dsp_decim_configure(uint32_t in_rate, uint32_t out_rate);
+void dsp_decim_reset(void);
+uint32_t dsp_decim_process(const dsp_block_t *block, int16_t *output);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_DECIM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name   : dsp_eq.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_eq.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_EQ_H
+#define DSP_EQ_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Biquad sections per channel */
+#ifndef DSP_EQ_MAX_SECTIONS
+#define DSP_EQ_MAX_SECTIONS             (8U)
+#endif
+
+/* Channels equalized, each with its own bands */
+#define DSP_EQ_MAX_CHANNELS             (2U)
+
+/* Fractional bits of the coefficients. Coefficients range from -2 to 2. */
+#define DSP_EQ_Q                        (14U)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef enum
+{
+    DSP_EQ_NONE,                    /* Flat section */
+    DSP_EQ_PEAKING,
+    DSP_EQ_LOW_SHELF,
+    DSP_EQ_HIGH_SHELF,
+    DSP_EQ_LOW_PASS,
+    DSP_EQ_HIGH_PASS,
+} dsp_eq_type_t;
+
+/* Band of the equalizer, designed for the sample rate of the stream */
+typedef struct
+{
+    dsp_eq_type_t type;
+    float freq_hz;                  /* Center, corner or cutoff frequency */
+    float q;                        /* Quality factor (shelf slope for shelves) */
+    float gain_db;                  /* Peaking and shelves only */
+} dsp_eq_band_t;
+
+/* Coefficients of a biquad section, Q14, normalized by a0 */
+typedef struct
+{
+    int16_t b0;
+    int16_t b1;
+    int16_t b2;
+    int16_t a1;
+    int16_t a2;
+} dsp_eq_coefs_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_eq_configure(uint32_t sample_rate);
+void dsp_eq_reset(void);
+void dsp_eq_process(dsp_block_t *block);
+void dsp_eq_set_band(uint32_t channel, uint32_t index, const dsp_eq_band_t *band);
+void dsp_eq_set_coefs(uint32_t channel, uint32_t index, const dsp_eq_coefs_t *coefs);
+uint32_t dsp_eq_get_num_sections(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_EQ_H */
+
+/* [] END OF FILE */
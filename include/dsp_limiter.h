@@ -0,0 +1,114 @@
+/******************************************************************************
+* File Name   : dsp_limiter.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_limiter.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_LIMITER_H
+#define DSP_LIMITER_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Peak level never exceeded at the output, Q15 of the full scale. The
+ * default is -1 dBFS.
+ */
+#ifndef DSP_LIMITER_THRESHOLD_Q15
+#define DSP_LIMITER_THRESHOLD_Q15       (29204U)
+#endif
+
+/* Look-ahead, in frames. The samples are delayed by the look-ahead so the
+ * gain is already reduced when a peak reaches the output. Capped to
+ * DSP_LIMITER_MAX_LOOKAHEAD_FRAMES to bound the added latency.
+ */
+#ifndef DSP_LIMITER_LOOKAHEAD_FRAMES
+#define DSP_LIMITER_LOOKAHEAD_FRAMES    (32U)
+#endif
+#ifndef DSP_LIMITER_MAX_LOOKAHEAD_FRAMES
+#define DSP_LIMITER_MAX_LOOKAHEAD_FRAMES (48U)
+#endif
+
+/* Attack of the envelope, as a shift: the envelope covers 1 - 2^-shift of
+ * the distance to a new peak per frame. Must reach the peak within the
+ * look-ahead.
+ */
+#ifndef DSP_LIMITER_ATTACK_SHIFT
+#define DSP_LIMITER_ATTACK_SHIFT        (2U)
+#endif
+
+/* Release time constant of the envelope, rounded down to a power of two of
+ * frames for the sample rate.
+ */
+#ifndef DSP_LIMITER_RELEASE_MS
+#define DSP_LIMITER_RELEASE_MS          (50U)
+#endif
+
+/* Channels limited together, so the stereo image does not move */
+#define DSP_LIMITER_MAX_CHANNELS        (2U)
+
+#if ((DSP_LIMITER_LOOKAHEAD_FRAMES < 1U) || (DSP_LIMITER_LOOKAHEAD_FRAMES > DSP_LIMITER_MAX_LOOKAHEAD_FRAMES))
+#error "DSP_LIMITER_LOOKAHEAD_FRAMES must be between 1 and DSP_LIMITER_MAX_LOOKAHEAD_FRAMES."
+#endif
+#if ((DSP_LIMITER_THRESHOLD_Q15 < 8192U) || (DSP_LIMITER_THRESHOLD_Q15 > 32767U))
+#error "DSP_LIMITER_THRESHOLD_Q15 must be between -12 dBFS (8192) and full scale (32767)."
+#endif
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_limiter_configure(uint32_t sample_rate);
+void dsp_limiter_reset(void);
+void dsp_limiter_process(dsp_block_t *block);
+uint32_t dsp_limiter_get_min_gain(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_LIMITER_H */
+
+/* [] END OF FILE */
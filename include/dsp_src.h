@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name   : dsp_src.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_src.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_SRC_H
+#define DSP_SRC_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Conversion ratio of the 44.1 KHz family: the PDM/PCM block captures at
+ * sample_rate * DSP_SRC_DOWN / DSP_SRC_UP (48 KHz for 44.1 KHz, 24 KHz for
+ * 22.05 KHz) and the converter produces sample_rate.
+ */
+#define DSP_SRC_UP                      (147U)
+#define DSP_SRC_DOWN                    (160U)
+
+/* Coefficients per polyphase branch, generated by scripts/src_coefs.py */
+#define DSP_SRC_TAPS                    (48U)
+
+/* Fractional bits of the coefficients */
+#define DSP_SRC_Q                       (14U)
+
+/* Delay added to the samples when converting, in captured frames: half of
+ * a branch. dsp_src_get_latency() gives it in frames of the host.
+ */
+#define DSP_SRC_LATENCY                 ((DSP_SRC_TAPS) / 2U)
+
+
+/******************************************************************************
+* Externs
+******************************************************************************/
+extern const int16_t dsp_src_coefs_147_160[(DSP_SRC_UP) * (DSP_SRC_TAPS)];
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+uint32_t dsp_src_get_capture_rate(uint32_t sample_rate);
+void dsp_src_configure(uint32_t sample_rate);
+void dsp_src_reset(void);
+void dsp_src_process(dsp_block_t *block);
+uint32_t dsp_src_plan(uint32_t frames);
+uint32_t dsp_src_get_output_frames(uint32_t frames);
+uint32_t dsp_src_get_latency(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_SRC_H */
+
+/* [] END OF FILE */
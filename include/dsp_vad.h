@@ -0,0 +1,134 @@
+/******************************************************************************
+* File Name   : dsp_vad.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in dsp_vad.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_VAD_H
+#define DSP_VAD_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "dsp_chain.h"
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* A period is active when its energy is 2^shift times the noise floor
+ * (shift 3: 9 dB). During speech, a period twice the noise floor (3 dB)
+ * with the zero-crossing rate of an unvoiced sound is also active.
+ */
+#ifndef DSP_VAD_SNR_SHIFT
+#define DSP_VAD_SNR_SHIFT               (3U)
+#endif
+
+/* Zero crossings per 1 ms period of an unvoiced sound (fricatives above
+ * 2.5 kHz)
+ */
+#ifndef DSP_VAD_UNVOICED_CROSSINGS
+#define DSP_VAD_UNVOICED_CROSSINGS      (5U)
+#endif
+
+/* Smoothing of the energy of the periods, as a shift: the decision and the
+ * noise floor see the energy averaged over about 2^shift periods. A 1 ms
+ * period of low-pass noise (fans, rumble) holds few independent samples,
+ * so its energy alone swings far above and below the mean.
+ */
+#ifndef DSP_VAD_SMOOTH_SHIFT
+#define DSP_VAD_SMOOTH_SHIFT            (2U)
+#endif
+
+/* Lowest noise floor, mean square of 16-bit samples (-70 dBFS) */
+#ifndef DSP_VAD_NOISE_MIN
+#define DSP_VAD_NOISE_MIN               (107U)
+#endif
+
+/* Tracking of the noise floor, once per period: it covers 2^-shift of the
+ * distance to the energy of the period, down in about 16 periods, up in
+ * about 1 s.
+ */
+#define DSP_VAD_NOISE_DOWN_SHIFT        (4U)
+#define DSP_VAD_NOISE_UP_SHIFT          (10U)
+
+/* Active periods in a row starting speech, and periods speech lasts after
+ * the last active period
+ */
+#ifndef DSP_VAD_ONSET_PERIODS
+#define DSP_VAD_ONSET_PERIODS           (3U)
+#endif
+#ifndef DSP_VAD_HANGOVER_PERIODS
+#define DSP_VAD_HANGOVER_PERIODS        (200U)
+#endif
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef struct
+{
+    bool     speech;                /* Current decision */
+    uint32_t periods;               /* Periods processed */
+    uint32_t speech_periods;        /* Periods decided as speech */
+    uint32_t onsets;                /* Transitions to speech */
+    uint32_t energy;                /* Mean square of the last period, 16-bit scale */
+    uint32_t noise;                 /* Noise floor, 16-bit scale */
+    uint32_t crossings;             /* Zero crossings of the last period */
+} dsp_vad_stats_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_vad_reset(void);
+void dsp_vad_process(dsp_block_t *block);
+bool dsp_vad_is_speech(void);
+void dsp_vad_get_stats(dsp_vad_stats_t *stats);
+void dsp_vad_reset_stats(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_VAD_H */
+
+/* [] END OF FILE */
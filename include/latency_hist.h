@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name   : latency_hist.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in latency_hist.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Fixed buckets of the histogram. The last bucket collects every latency
+ * above the range of the others.
+ */
+#define LATENCY_HIST_NUM_BUCKETS        (32U)
+#define LATENCY_HIST_BUCKET_US          (250U)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef struct
+{
+    uint32_t buckets[LATENCY_HIST_NUM_BUCKETS];
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} latency_hist_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p99_us;                /* Upper edge of the bucket holding the 99th percentile */
+    uint32_t max_us;
+} latency_hist_summary_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void latency_hist_reset(latency_hist_t *hist);
+void latency_hist_add(latency_hist_t *hist, uint32_t latency_us);
+void latency_hist_get_summary(const latency_hist_t *hist, latency_hist_summary_t *summary);
+void latency_hist_print(const latency_hist_t *hist, const char *name);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* LATENCY_HIST_H */
+
+/* [] END OF FILE */
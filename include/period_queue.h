@@ -0,0 +1,127 @@
+/******************************************************************************
+* File Name   : period_queue.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in period_queue.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef PERIOD_QUEUE_H
+#define PERIOD_QUEUE_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Number of periods in the queue. One period is being written by the
+ * producer, one is still owned by the consumer (in flight on the USB bus),
+ * the others hold captured audio. Must be a power of two, at least 4.
+ */
+#ifndef PERIOD_QUEUE_DEPTH
+#define PERIOD_QUEUE_DEPTH          (4U)
+#endif
+
+#if ((PERIOD_QUEUE_DEPTH) < 4U) || (((PERIOD_QUEUE_DEPTH) & ((PERIOD_QUEUE_DEPTH) - 1U)) != 0U)
+#error "PERIOD_QUEUE_DEPTH must be a power of two, at least 4."
+#endif
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef struct
+{
+    uint32_t *buffer;               /* Period samples (halfwords or words, see AUDIO_IN_HAL_SAMPLE_SIZE) */
+    uint32_t count;                 /* Number of samples in the period */
+    uint32_t timestamp;             /* Cycle counter when the period was captured */
+    int32_t gain;                   /* Gain of the PDM/PCM block it was captured with, in 0.5 dB */
+    uint32_t gain_offset;           /* Samples at the start still captured with the gain of the previous period */
+} period_t;
+
+typedef struct
+{
+    uint32_t level;                 /* Periods waiting to be consumed */
+    uint32_t peak_level;            /* Highest level reached */
+    uint32_t produced;              /* Periods published by the producer */
+    uint32_t overruns;              /* Periods dropped because the queue was full */
+    uint32_t underruns;             /* Requests made while the queue was empty */
+    uint32_t level_counts[PERIOD_QUEUE_DEPTH]; /* Level seen by each request of the consumer */
+} period_queue_stats_t;
+
+typedef struct
+{
+    period_t periods[PERIOD_QUEUE_DEPTH];
+    volatile uint32_t head;         /* Periods completed by the producer, written by the producer only */
+    volatile uint32_t tail;         /* Periods handed to the consumer, written by the consumer only */
+
+    /* Producer side statistics */
+    uint32_t produced;
+    uint32_t overruns;
+    uint32_t peak_level;
+
+    /* Consumer side statistics */
+    uint32_t underruns;
+    uint32_t level_counts[PERIOD_QUEUE_DEPTH];
+} period_queue_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void period_queue_init(period_queue_t *queue, uint32_t *storage, uint32_t period_words);
+void period_queue_reset(period_queue_t *queue);
+void period_queue_clear_stats(period_queue_t *queue);
+uint32_t period_queue_level(const period_queue_t *queue);
+uint32_t period_queue_samples(const period_queue_t *queue);
+period_t *period_queue_producer_period(period_queue_t *queue);
+bool period_queue_produce(period_queue_t *queue, uint32_t count);
+period_t *period_queue_consume(period_queue_t *queue);
+void period_queue_get_stats(const period_queue_t *queue, period_queue_stats_t *stats);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PERIOD_QUEUE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name   : rate_ctrl.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in rate_ctrl.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef RATE_CTRL_H
+#define RATE_CTRL_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Fixed point format of the rate controller (frames in Q8.24) */
+#define RATE_CTRL_FRAC_BITS             (24U)
+
+/* Proportional and integral gains, expressed as right shifts of the depth
+ * error. The loop settles in about 2^RATE_CTRL_KP_SHIFT packets and stays
+ * critically damped with KI = KP^2 / 4.
+ */
+#define RATE_CTRL_KP_SHIFT              (8U)
+#define RATE_CTRL_KI_SHIFT              ((2U * (RATE_CTRL_KP_SHIFT)) + 2U)
+
+/* Largest correction applied to the nominal packet size, in frames */
+#define RATE_CTRL_MAX_CORRECTION_FRAMES (1)
+
+/* Packets of a cadence cycle (20 ms). Every sample rate that is a multiple
+ * of 50 Hz sends a whole number of frames in a cycle.
+ */
+#define RATE_CTRL_CADENCE_PACKETS       (20U)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+typedef struct
+{
+    int32_t nominal;                /* Nominal frames per packet (Q8.24) */
+    int32_t target_depth;           /* Buffer depth to maintain, in frames */
+    int32_t integral;               /* Integral term (Q8.24) */
+    volatile int32_t correction;    /* Frames added to each packet (Q8.24) */
+    int64_t phase;                  /* Fractional frames carried over (Q8.24) */
+    uint32_t min_frames;            /* Smallest packet, in frames */
+    uint32_t max_frames;            /* Largest packet, in frames */
+    const uint8_t *cadence;         /* Frames of each packet of a cycle, NULL if the rate has none */
+    uint32_t cadence_index;         /* Next packet of the cycle */
+} rate_ctrl_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void rate_ctrl_init(rate_ctrl_t *ctrl, uint32_t sample_rate, uint32_t target_depth, uint32_t max_frames);
+void rate_ctrl_reset(rate_ctrl_t *ctrl);
+void rate_ctrl_update(rate_ctrl_t *ctrl, uint32_t depth);
+uint32_t rate_ctrl_next_frames(rate_ctrl_t *ctrl);
+int32_t rate_ctrl_get_drift_ppm(const rate_ctrl_t *ctrl);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RATE_CTRL_H */
+
+/* [] END OF FILE */
@@ -55,14 +55,30 @@ extern "C" {
 ******************************************************************************/
 #define AUDIO_APP_TASK_PRIORITY     ((configMAX_PRIORITIES) - 3)
 #define AUDIO_WRITE_TASK_PRIORITY   ((configMAX_PRIORITIES) - 2)
+#define CONSOLE_TASK_PRIORITY       ((tskIDLE_PRIORITY) + 1)
 
-#define AUDIO_TASK_STACK_DEPTH      (512U)
+/* Stack depth of each task, in words. The stacks and the task control blocks
+ * are allocated statically by the module owning the task, so they show up in
+ * the memory report (see scripts/memory_report.py). Check the high-water
+ * marks printed by the console ('m') before shrinking them.
+ */
+#ifndef AUDIO_APP_TASK_STACK_DEPTH
+#define AUDIO_APP_TASK_STACK_DEPTH  (512U)
+#endif
+#ifndef AUDIO_IN_TASK_STACK_DEPTH
+#define AUDIO_IN_TASK_STACK_DEPTH   (512U)
+#endif
+#ifndef CONSOLE_TASK_STACK_DEPTH
+#define CONSOLE_TASK_STACK_DEPTH    (512U)
+#endif
 
 /******************************************************************************
 * Externs
 ******************************************************************************/
 /* Task Handlers */
+extern TaskHandle_t rtos_audio_app_task;
 extern TaskHandle_t rtos_audio_in_task;
+extern TaskHandle_t rtos_console_task;
 
 
 #if defined(__cplusplus)
@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name   : rtos_stats.h
+*
+* Description : This file contains the function prototypes and constants used
+*               in rtos_stats.c.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef RTOS_STATS_H
+#define RTOS_STATS_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* The run time counter of FreeRTOS counts the CPU cycles divided by
+ * 2^RTOS_STATS_COUNTER_SHIFT. At 150 MHz it counts at 586 KHz and the
+ * 32-bit run time of a task wraps around after about 2 hours.
+ */
+#define RTOS_STATS_COUNTER_SHIFT        (8U)
+
+/* Thread local storage pointer holding the longest run of each task */
+#define RTOS_STATS_TLS_INDEX            ((configNUM_THREAD_LOCAL_STORAGE_POINTERS) - 1)
+
+/* Largest number of tasks reported by rtos_stats_print() */
+#define RTOS_STATS_MAX_TASKS            (8U)
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void rtos_stats_init(void);
+uint32_t rtos_stats_get_counter(void);
+void rtos_stats_task_switched_in(void);
+void rtos_stats_task_switched_out(void);
+void rtos_stats_reset(void);
+void rtos_stats_print(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RTOS_STATS_H */
+
+/* [] END OF FILE */
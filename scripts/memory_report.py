@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+#******************************************************************************
+# File Name   : memory_report.py
+#
+# Description : Memory budget report of the application. Parses the map file
+#               generated by the GCC_ARM linker and reports the flash and SRAM
+#               used per symbol and per subsystem.
+#
+# Note        : See README.md
+#
+#******************************************************************************
+# Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+"""Usage: memory_report.py <application.map> [--top N] [--output report.md]
+
+The application is built with -ffunction-sections and -fdata-sections, so
+each input section of the map file holds a single function or variable. The
+sections are attributed to a subsystem from the path of their object file.
+"""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+
+#******************************************************************************
+# Subsystems, matched in order against the path of the object files
+#******************************************************************************
+SUBSYSTEMS = [
+    ("emUSB-Device",    re.compile(r"emusb-device")),
+    ("FreeRTOS",        re.compile(r"freertos|abstraction-rtos")),
+    ("HAL",             re.compile(r"mtb-hal")),
+    ("PDL",             re.compile(r"mtb-pdl|core-lib|cmsis")),
+    ("BSP",             re.compile(r"bsps?/|TARGET_|GeneratedSource")),
+    ("retarget-io",     re.compile(r"retarget-io")),
+    ("C library",       re.compile(r"lib(c|g|gcc|m|nosys|stdc\+\+)[_a-z-]*\.a")),
+]
+
+# Input sections: (prefix, flash bytes, SRAM bytes) per byte of section
+SECTION_KINDS = [
+    (".text",   1, 0),
+    (".rodata", 1, 0),
+    (".data",   1, 1),  # Initial values copied from flash at startup
+    (".ram",    1, 1),
+    (".bss",    0, 1),
+    (".noinit", 0, 1),
+    ("COMMON",  0, 1),
+]
+
+# Input section, alone on its line when its name is long
+SECTION_RE = re.compile(r"^ (\.[\w.$]+|COMMON)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*))?$")
+# Address, size and object file following a long section name
+CONTINUATION_RE = re.compile(r"^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*)$")
+# Symbol of a COMMON section
+SYMBOL_RE = re.compile(r"^\s+0x[0-9a-f]+\s+([A-Za-z_]\w*)$")
+
+
+def subsystem_of(obj):
+    """Return the subsystem owning an object file."""
+    for name, pattern in SUBSYSTEMS:
+        if pattern.search(obj):
+            return name
+    match = re.search(r"(?:^|/)source/(\w+)\.o", obj)
+    if match:
+        return "app: " + match.group(1)
+    return "other"
+
+
+def kind_of(section):
+    """Return (flash, sram) weights of an input section, None if not loaded."""
+    for prefix, flash, sram in SECTION_KINDS:
+        if section == prefix or section.startswith(prefix + "."):
+            return flash, sram
+    return None
+
+
+def symbol_of(section, obj):
+    """Name of the function or variable of an input section."""
+    for prefix, _, _ in SECTION_KINDS:
+        if section.startswith(prefix + "."):
+            return section[len(prefix) + 1:]
+    return "%s(%s)" % (section, obj.split("/")[-1])
+
+
+def parse_map(lines):
+    """Yield (section, size, object) for each loaded input section."""
+    in_memory_map = False
+    pending = None
+    held = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+
+        if not in_memory_map:
+            in_memory_map = line.startswith("Linker script and memory map")
+            continue
+
+        if pending is not None:
+            match = CONTINUATION_RE.match(line)
+            if match:
+                held = (pending, int(match.group(2), 16), match.group(3))
+            pending = None
+            continue
+
+        match = SECTION_RE.match(line)
+        if match:
+            if held is not None:
+                yield held
+                held = None
+            if match.group(2) is None:
+                pending = match.group(1)
+            else:
+                held = (match.group(1), int(match.group(3), 16), match.group(4))
+            continue
+
+        # Name the COMMON variables after their first symbol
+        match = SYMBOL_RE.match(line)
+        if match and held is not None and held[0] == "COMMON":
+            held = ("COMMON." + match.group(1), held[1], held[2])
+
+    if held is not None:
+        yield held
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map_file", help="map file generated by the linker")
+    parser.add_argument("--top", type=int, default=30, help="number of symbols listed per memory")
+    parser.add_argument("--output", help="write the report to this file instead of stdout")
+    args = parser.parse_args()
+
+    flash = defaultdict(int)
+    sram = defaultdict(int)
+    symbols = []
+
+    with open(args.map_file, encoding="utf-8", errors="replace") as map_file:
+        for section, size, obj in parse_map(map_file):
+            kind = kind_of(section)
+            if kind is None or size == 0:
+                continue
+            subsystem = subsystem_of(obj)
+            flash[subsystem] += size * kind[0]
+            sram[subsystem] += size * kind[1]
+            symbols.append((symbol_of(section, obj), subsystem, size * kind[0], size * kind[1]))
+
+    out = open(args.output, "w", encoding="utf-8") if args.output else sys.stdout
+
+    out.write("# Memory report of %s\n\n" % args.map_file)
+    out.write("## Per subsystem\n\n")
+    out.write("| Subsystem | Flash (bytes) | SRAM (bytes) |\n")
+    out.write("| :-------- | ------------: | -----------: |\n")
+    for subsystem in sorted(set(flash) | set(sram), key=lambda name: (-sram[name], -flash[name])):
+        out.write("| %s | %d | %d |\n" % (subsystem, flash[subsystem], sram[subsystem]))
+    out.write("| **Total** | **%d** | **%d** |\n" % (sum(flash.values()), sum(sram.values())))
+
+    for title, column in (("SRAM", 3), ("Flash", 2)):
+        out.write("\n## Largest symbols in %s\n\n" % title)
+        out.write("| Symbol | Subsystem | Bytes |\n")
+        out.write("| :----- | :-------- | ----: |\n")
+        largest = sorted((entry for entry in symbols if entry[column] > 0), key=lambda entry: -entry[column])
+        for entry in largest[:args.top]:
+            out.write("| %s | %s | %d |\n" % (entry[0], entry[1], entry[column]))
+
+    if args.output:
+        out.close()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
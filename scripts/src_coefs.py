@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+#******************************************************************************
+# File Name   : src_coefs.py
+#
+# Description : Coefficient generator of the polyphase sample rate converter
+#               (source/dsp_src.c). Designs the Kaiser-windowed lowpass of a
+#               conversion ratio, splits it in polyphase branches, quantizes
+#               them to Q14, checks the response of the quantized filter and
+#               writes the table as a C source file.
+#
+# Note        : See README.md
+#
+#******************************************************************************
+# Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+#******************************************************************************
+"""Usage: src_coefs.py [--up 147] [--down 160] [--taps 48] [--output dsp_src_coefs.c]
+
+The converter reads the captured samples at rate R and produces samples at
+rate R * up / down. The lowpass runs at R * up and is split in `up` branches
+of `taps` coefficients; each output sample uses one branch. The band edges
+are given at the capture rate of 48000 Hz and scale with it.
+"""
+
+import argparse
+import math
+import sys
+
+
+#******************************************************************************
+# Design defaults: 48000 Hz captured, 44100 Hz produced
+#******************************************************************************
+CAPTURE_RATE = 48000.0
+
+# Audio band kept flat, and start of the band rejected. Input above the
+# output Nyquist frequency (22050 Hz) folds above PASSBAND_HZ, outside of the
+# audio band, as long as it is rejected from STOPBAND_HZ.
+PASSBAND_HZ = 20000.0
+STOPBAND_HZ = 24000.0
+
+# Kaiser window shape, trades the stopband rejection for the transition width
+KAISER_BETA = 6.0
+
+# Fixed point format of the coefficients. Q14 keeps the sum of a branch
+# applied to full-scale 16-bit samples within a 32-bit accumulator.
+COEF_FRAC_BITS = 14
+
+# Largest passband ripple and smallest stopband rejection accepted, in dB
+MAX_RIPPLE_DB = 0.05
+MIN_REJECTION_DB = 60.0
+
+# Frequencies at which the quantized response is checked
+CHECK_POINTS = 1000
+
+
+def bessel_i0(x):
+    """Modified Bessel function of the first kind, order 0."""
+    total = 1.0
+    term = 1.0
+    k = 1
+    while term > 1e-12 * total:
+        term *= (x / (2.0 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def design(up, taps, cutoff):
+    """Kaiser-windowed sinc of up * taps coefficients, cutoff in cycles per sample."""
+    length = up * taps
+    center = (length - 1) / 2.0
+    norm = bessel_i0(KAISER_BETA)
+    proto = []
+    for n in range(length):
+        t = n - center
+        sinc = 2.0 * cutoff if t == 0 else math.sin(2.0 * math.pi * cutoff * t) / (math.pi * t)
+        window = bessel_i0(KAISER_BETA * math.sqrt(max(0.0, 1.0 - (t / center) ** 2))) / norm
+        proto.append(sinc * window)
+    return proto
+
+
+def quantize(proto, up, taps):
+    """Split in branches, oldest sample first, each with a gain of exactly 1."""
+    one = 1 << COEF_FRAC_BITS
+    branches = []
+    for phase in range(up):
+        branch = [proto[phase + (taps - 1 - i) * up] for i in range(taps)]
+        scale = one / sum(branch)
+        coefs = [int(round(c * scale)) for c in branch]
+        # Put the rounding residue on the largest coefficient
+        largest = max(range(taps), key=lambda i: abs(coefs[i]))
+        coefs[largest] += one - sum(coefs)
+        if (sum(abs(c) for c in coefs) << 15) >= (1 << 31):
+            sys.exit("error: branch %d overflows the 32-bit accumulation" % phase)
+        branches.append(coefs)
+    return branches
+
+
+def response_db(branches, up, taps, freq):
+    """Gain of the quantized filter at freq (in cycles per sample at the capture rate)."""
+    acc_re = 0.0
+    acc_im = 0.0
+    step = 2.0 * math.pi * freq / up
+    for phase, coefs in enumerate(branches):
+        for i, coef in enumerate(coefs):
+            n = phase + (taps - 1 - i) * up
+            acc_re += coef * math.cos(step * n)
+            acc_im -= coef * math.sin(step * n)
+    gain = math.hypot(acc_re, acc_im) / (up * (1 << COEF_FRAC_BITS))
+    return 20.0 * math.log10(max(gain, 1e-12))
+
+
+def check(branches, up, taps):
+    """Passband ripple and stopband rejection of the quantized filter, in dB."""
+    passband = PASSBAND_HZ / CAPTURE_RATE
+    stopband = STOPBAND_HZ / CAPTURE_RATE
+    # Up to the first image of the captured band, around the capture rate.
+    # The sidelobes of the window only decrease further away.
+    span = 2.0
+
+    gains = [response_db(branches, up, taps, passband * i / CHECK_POINTS) for i in range(CHECK_POINTS + 1)]
+    ripple = max(gains) - min(gains)
+    rejection = -max(response_db(branches, up, taps, stopband + ((span - stopband) * i / CHECK_POINTS))
+                     for i in range(CHECK_POINTS + 1))
+    return ripple, rejection
+
+
+def write_table(out, branches, up, down, taps, ripple, rejection):
+    """Write the C source file of the table."""
+    out.write("/" + "*" * 77 + "\n")
+    out.write("* File Name    : dsp_src_coefs.c\n")
+    out.write("*\n")
+    out.write("* Description  : Coefficients of the polyphase sample rate converter,\n")
+    out.write("*                generated by scripts/src_coefs.py. Do not edit.\n")
+    out.write("*\n")
+    out.write("*                Ratio %d/%d, %d branches of %d taps (Q%d), Kaiser beta %.1f.\n"
+              % (up, down, up, taps, COEF_FRAC_BITS, KAISER_BETA))
+    out.write("*                From %.0f Hz: passband ripple %.3f dB up to %.0f Hz,\n"
+              % (CAPTURE_RATE, ripple, PASSBAND_HZ))
+    out.write("*                rejection %.1f dB from %.0f Hz.\n" % (rejection, STOPBAND_HZ))
+    out.write("*\n")
+    out.write("* Note         : See README.md\n")
+    out.write("*\n")
+    out.write("*" * 78 + "\n")
+    with open(__file__, encoding="utf-8") as script:
+        lines = script.read().splitlines()
+    start = next(i for i, line in enumerate(lines) if line.startswith("# Copyright"))
+    end = next(i for i in range(start, len(lines)) if lines[i].startswith("#****"))
+    for line in lines[start:end]:
+        out.write(("*" + line[1:]).rstrip() + "\n")
+    out.write("*" * 77 + "/\n")
+    out.write("#include \"dsp_src.h\"\n\n\n")
+    out.write("/*****************************************************************************\n")
+    out.write("* Static const data\n")
+    out.write("*****************************************************************************/\n")
+    out.write("/* One branch per phase, oldest sample first */\n")
+    out.write("const int16_t dsp_src_coefs_%d_%d[(%dU) * (DSP_SRC_TAPS)] =\n{\n" % (up, down, up))
+    for phase, coefs in enumerate(branches):
+        out.write("    /* Phase %d */\n" % phase)
+        for i in range(0, taps, 12):
+            out.write("    " + " ".join("%6d," % c for c in coefs[i:i + 12]) + "\n")
+    out.write("};\n\n/* [] END OF FILE */\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--up", type=int, default=147, help="interpolation factor (branches)")
+    parser.add_argument("--down", type=int, default=160, help="decimation factor")
+    parser.add_argument("--taps", type=int, default=48, help="coefficients per branch, even")
+    parser.add_argument("--output", help="write the table to this file instead of stdout")
+    args = parser.parse_args()
+
+    if (args.taps % 2) != 0 or args.down < args.up:
+        sys.exit("error: the taps must be even and the converter must not upsample")
+
+    # Lowpass halfway through the transition band, at the rate of the branches
+    cutoff = (PASSBAND_HZ + STOPBAND_HZ) / (2.0 * CAPTURE_RATE * args.up)
+    branches = quantize(design(args.up, args.taps, cutoff), args.up, args.taps)
+
+    ripple, rejection = check(branches, args.up, args.taps)
+    print("ratio %d/%d, %d taps: ripple %.3f dB, rejection %.1f dB"
+          % (args.up, args.down, args.taps, ripple, rejection), file=sys.stderr)
+    if ripple > MAX_RIPPLE_DB or rejection < MIN_REJECTION_DB:
+        sys.exit("error: the quantized filter misses its specification")
+
+    out = open(args.output, "w", encoding="utf-8") if args.output else sys.stdout
+    write_table(out, branches, args.up, args.down, args.taps, ripple, rejection)
+    if args.output:
+        out.close()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -40,13 +40,16 @@
 ******************************************************************************/
 #include "audio_app.h"
 #include "audio_in.h"
+#include "audio_in_hal.h"
 #include "audio.h"
-#include "cybsp.h"
+#include "cy_utils.h"
 #include "cycfg_emusbdev.h"
 #include "cy_retarget_io.h"
 
 #include "rtos.h"
 
+#include <string.h>
+
 
 /*******************************************************************************
 * Macros
@@ -55,9 +58,18 @@
 #define EP_IN_INTERVAL               (8U)
 
 #define ONE_BYTE                     (1)
+#define TWO_BYTES                    (2)
 #define THREE_BYTES                  (3)
 #define DELAY_TICKS                  (50U)
 
+/* USB state bits for which the device streams audio */
+#define USB_STATE_ACTIVE_MASK        (USB_STAT_CONFIGURED | USB_STAT_SUSPENDED)
+
+/* Events notified to the "Audio App Task" */
+#define AUDIO_APP_EVENT_USB_STATE    (1UL << 0)  /* USB state changed */
+#define AUDIO_APP_EVENT_STREAM_STOP  (1UL << 1)  /* Host stopped the Audio IN stream */
+#define AUDIO_APP_EVENT_ALL          (AUDIO_APP_EVENT_USB_STATE | AUDIO_APP_EVENT_STREAM_STOP)
+
 
 /*******************************************************************************
 * Global Variables
@@ -72,17 +84,37 @@ TaskHandle_t rtos_audio_in_task;
 *******************************************************************************/
 static USBD_AUDIO_HANDLE handle;
 static USBD_AUDIO_INIT_DATA init_data;
-static USBD_AUDIO_IF_CONF* microphone_config = (USBD_AUDIO_IF_CONF *) &audio_interfaces[0];
-static uint8_t current_mic_format_index;
-static volatile bool usb_suspend_flag = false;
+static USBD_AUDIO_IF_CONF* microphone_config = (USBD_AUDIO_IF_CONF *) &audio_interfaces[AUDIO_IF_MICROPHONE];
+static USB_HOOK usb_state_hook;
+
+#if (AUDIO_IN_MONO_INTERFACE)
+/* Mono interface: own audio instance and Audio IN endpoint, sized for the
+ * mono formats, sharing the capture path of the microphone interface
+ */
+static USBD_AUDIO_HANDLE handle_mono;
+static USBD_AUDIO_INIT_DATA init_data_mono;
+static USBD_AUDIO_IF_CONF* microphone_mono_config = (USBD_AUDIO_IF_CONF *) &audio_interfaces[AUDIO_IF_MONO];
+#endif /* AUDIO_IN_MONO_INTERFACE */
+
+#if (AUDIO_IN_SECOND_STREAM)
+/* Second stream: own audio instance, Audio IN endpoint and interface */
+static USBD_AUDIO_HANDLE handle_second;
+static USBD_AUDIO_INIT_DATA init_data_second;
+static USBD_AUDIO_IF_CONF* microphone_second_config = (USBD_AUDIO_IF_CONF *) &audio_interfaces[AUDIO_IF_SECOND];
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+/* Memory of the "Audio App Task" */
+static StackType_t audio_app_task_stack[AUDIO_APP_TASK_STACK_DEPTH];
+static StaticTask_t audio_app_task_tcb;
 
 
 /********************************************************************************
  * Function Name: vApplicationTickHook
  ********************************************************************************
  * Summary:
- *  Tick hook function called at every tick (1ms). It checks for the activity in 
- *  the USB bus.
+ *  Tick hook function called at every tick (1ms). It runs the supervisor of
+ *  the USB driver, which detects the suspend conditions on the bus. The
+ *  changes of the USB state are reported by usb_state_callback().
  *
  * Parameters:
  *  None
@@ -97,17 +129,72 @@ void vApplicationTickHook(void)
 #if defined (COMPONENT_CAT1A)
     USB_DRIVER_Cypress_PSoC6_SysTick();
 #endif /* COMPONENT_CAT1A */
+}
 
-    if (USBD_GetState() & USB_STAT_SUSPENDED)
-    {
-        /* Suspend condition on USB bus is detected */
-        usb_suspend_flag = true;
-    }
-    else
-    {
-        /* Clear suspend conditions */
-        usb_suspend_flag = false;
-    }
+/*******************************************************************************
+* Function Name: usb_state_callback
+********************************************************************************
+* Summary:
+*  Callback called by emUSB-Device, possibly in ISR context, when the USB
+*  state changes (attach, reset, enumeration, suspend and resume). Notifies
+*  the "Audio App Task", which reads the new state.
+*
+* Parameters:
+*  pContext: User context which is passed to the callback.
+*  NewState: New USB state (USB_STAT_* bits).
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void usb_state_callback(void *pContext, U8 NewState)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    CY_UNUSED_PARAMETER(pContext);
+    CY_UNUSED_PARAMETER(NewState);
+
+    xTaskNotifyFromISR(rtos_audio_app_task, AUDIO_APP_EVENT_USB_STATE, eSetBits, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+* Function Name: audio_app_put_volume
+********************************************************************************
+* Summary:
+*  Write a volume setting in the reply to a volume control request.
+*
+* Parameters:
+*  pBuffer: Reply buffer, at least 2 bytes
+*  volume: Volume in 1/256 dB
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void audio_app_put_volume(U8 *pBuffer, int16_t volume)
+{
+    pBuffer[0] = (U8) ((uint16_t) volume & 0xffU);
+    pBuffer[1] = (U8) ((uint16_t) volume >> 8);
+}
+
+/*******************************************************************************
+* Function Name: audio_app_first_format
+********************************************************************************
+* Summary:
+*  Get the index in microphone_formats[] of the format of alternate setting 1
+*  of an interface.
+*
+* Parameters:
+*  config: Microphone or mono interface
+*
+* Return:
+*  uint8_t: Index of the format
+*
+*******************************************************************************/
+static uint8_t audio_app_first_format(const USBD_AUDIO_IF_CONF *config)
+{
+    return (uint8_t) (config->paFormats - microphone_formats);
 }
 
 /*******************************************************************************
@@ -116,10 +203,12 @@ void vApplicationTickHook(void)
 * Summary:
 *  Callback called in ISR context.
 *  Receives audio class control commands and sends appropriate responses
-*  where necessary.
+*  where necessary. Serves the microphone interface and the mono interface,
+*  which share the capture path: the format is selected by the last
+*  interface the host opened, and closing the other one leaves it running.
 *
 * Parameters:
-*  pUserContext: User context which is passed to the callback.
+*  pUserContext: Interface of the instance (USBD_AUDIO_IF_CONF).
 *  Event: Audio event ID.
 *  Unit: ID of the feature unit. In case of USB_AUDIO_PLAYBACK_*
 *        and USB_AUDIO_RECORD_*: 0.
@@ -151,21 +240,35 @@ static int audio_control_callback(void *pUserContext,
                                   U8   AltSetting)
 {
     int retVal;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    const USBD_AUDIO_IF_CONF *config = (const USBD_AUDIO_IF_CONF *) pUserContext;
+    uint8_t first_format = audio_app_first_format(config);
 
-    CY_UNUSED_PARAMETER(pUserContext);
     CY_UNUSED_PARAMETER(InterfaceNo);
 
     retVal = 0;
     switch (Event)
     {
         case USB_AUDIO_RECORD_START:
-            /* Host enabled reception */
+            /* Host enabled reception, the alternate setting selects the format */
+            if ((AltSetting > 0) && (AltSetting <= config->NumFormats))
+            {
+                audio_in_set_format(first_format + AltSetting - 1);
+            }
             audio_in_enable();
             break;
 
         case USB_AUDIO_RECORD_STOP:
             /* Host disabled reception. Some hosts do not always send this! */
-            audio_in_disable();
+            if ((audio_in_get_format() >= first_format) &&
+                (audio_in_get_format() < (first_format + config->NumFormats)))
+            {
+                audio_in_disable();
+            }
+
+            /* Let the "Audio App Task" power down the capture path */
+            xTaskNotifyFromISR(rtos_audio_app_task, AUDIO_APP_EVENT_STREAM_STOP, eSetBits,
+                               &higher_priority_task_woken);
             break;
 
         case USB_AUDIO_PLAYBACK_START:
@@ -178,7 +281,7 @@ static int audio_control_callback(void *pUserContext,
                 case USB_AUDIO_MUTE_CONTROL:
                     if (ONE_BYTE == NumBytes) 
                     {
-                        if (Unit == microphone_config->pUnits->FeatureUnitID) 
+                        if (Unit == config->pUnits->FeatureUnitID)
                         {
                             mic_mute = *pBuffer;
                         }
@@ -186,16 +289,23 @@ static int audio_control_callback(void *pUserContext,
                     break;
 
                 case USB_AUDIO_VOLUME_CONTROL:
+                    if (TWO_BYTES == NumBytes)
+                    {
+                        if (Unit == config->pUnits->FeatureUnitID)
+                        {
+                            audio_in_set_volume((int16_t) ((uint16_t) pBuffer[0] | ((uint16_t) pBuffer[1] << 8)));
+                        }
+                    }
                     break;
 
                 case USB_AUDIO_SAMPLING_FREQ_CONTROL:
                     if (THREE_BYTES == NumBytes)
                     {
-                        if (Unit == microphone_config->pUnits->FeatureUnitID)
+                        if (Unit == config->pUnits->FeatureUnitID)
                         {
-                            if ((AltSetting > 0) && (AltSetting < microphone_config->NumFormats))
+                            if ((AltSetting > 0) && (AltSetting <= config->NumFormats))
                             {
-                                current_mic_format_index = AltSetting-1;
+                                audio_in_set_format(first_format + AltSetting - 1);
                             }
                         }
                     }
@@ -215,16 +325,15 @@ static int audio_control_callback(void *pUserContext,
                     break;
 
                 case USB_AUDIO_VOLUME_CONTROL:
-                    pBuffer[0] = 0;
-                    pBuffer[1] = 0;
+                    audio_app_put_volume(pBuffer, audio_in_get_volume());
                     break;
 
                 case USB_AUDIO_SAMPLING_FREQ_CONTROL:
-                    if (Unit == microphone_config->pUnits->FeatureUnitID)
+                    if (Unit == config->pUnits->FeatureUnitID)
                     {
-                        pBuffer[0] = microphone_config->paFormats[current_mic_format_index].SamFreq & 0xff;
-                        pBuffer[1] = (microphone_config->paFormats[current_mic_format_index].SamFreq >> 8) & 0xff;
-                        pBuffer[2] = (microphone_config->paFormats[current_mic_format_index].SamFreq >> 16) & 0xff;
+                        pBuffer[0] = microphone_formats[audio_in_get_format()].SamFreq & 0xff;
+                        pBuffer[1] = (microphone_formats[audio_in_get_format()].SamFreq >> 8) & 0xff;
+                        pBuffer[2] = (microphone_formats[audio_in_get_format()].SamFreq >> 16) & 0xff;
                     }
                     break;
 
@@ -244,8 +353,7 @@ static int audio_control_callback(void *pUserContext,
             switch (ControlSelector)
             {
                 case USB_AUDIO_VOLUME_CONTROL:
-                    pBuffer[0] = 0;
-                    pBuffer[1] = 0xf1;
+                    audio_app_put_volume(pBuffer, AUDIO_IN_VOLUME_MIN);
                     break;
 
                 default:
@@ -259,8 +367,7 @@ static int audio_control_callback(void *pUserContext,
             switch (ControlSelector)
             {
                 case USB_AUDIO_VOLUME_CONTROL:
-                    pBuffer[0] = 0;
-                    pBuffer[1] = 0;
+                    audio_app_put_volume(pBuffer, AUDIO_IN_VOLUME_MAX);
                     break;
 
                 default:
@@ -274,8 +381,7 @@ static int audio_control_callback(void *pUserContext,
             switch (ControlSelector)
             {
                 case USB_AUDIO_VOLUME_CONTROL:
-                    pBuffer[0] = 0;
-                    pBuffer[1] = 1;
+                    audio_app_put_volume(pBuffer, AUDIO_IN_VOLUME_RES);
                     break;
 
                 default:
@@ -290,6 +396,8 @@ static int audio_control_callback(void *pUserContext,
             break;
     }
 
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+
     return retVal;
 }
 
@@ -299,6 +407,13 @@ static int audio_control_callback(void *pUserContext,
 * Summary:
 *  Add a USB Audio interface to the USB stack.
 *
+*  emUSB-Device writes the wMaxPacketSize of the single endpoint of an
+*  instance (USB_ADD_EP_INFO) in every alternate setting of its interface,
+*  so each format of the microphone interface reserves the largest packet,
+*  MAX_AUDIO_IN_PACKET_SIZE_BYTES, whatever its rate and size. Only a
+*  separate interface with its own endpoint reserves less (see
+*  add_audio_mono()).
+*
 * Parameters:
 *  None
 *
@@ -327,9 +442,9 @@ static USBD_AUDIO_HANDLE add_audio(void)
     init_data.pfOnOut                = NULL;
     init_data.pfOnIn                 = audio_in_endpoint_callback;
     init_data.pfOnControl            = audio_control_callback;
-    init_data.pControlUserContext    = NULL;
-    init_data.NumInterfaces          = SEGGER_COUNTOF(audio_interfaces);
-    init_data.paInterfaces           = audio_interfaces;
+    init_data.pControlUserContext    = microphone_config;
+    init_data.NumInterfaces          = 1U;                                   /* Microphone interface only */
+    init_data.paInterfaces           = microphone_config;
     init_data.pOutUserContext        = NULL;
     init_data.pInUserContext         = NULL;
 
@@ -338,6 +453,202 @@ static USBD_AUDIO_HANDLE add_audio(void)
     return handle;
 }
 
+#if (AUDIO_IN_MONO_INTERFACE)
+/*******************************************************************************
+* Function Name: add_audio_mono
+********************************************************************************
+* Summary:
+*  Add the mono interface to the USB stack, as a second audio instance with
+*  its own Audio IN endpoint of AUDIO_IN_MONO_PACKET_SIZE_BYTES. Its control
+*  requests go to audio_control_callback(). Must be called after add_audio().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  USBD_AUDIO_HANDLE
+*
+*******************************************************************************/
+static USBD_AUDIO_HANDLE add_audio_mono(void)
+{
+    USB_ADD_EP_INFO       EPIn;
+
+    memset(&EPIn, 0x0, sizeof(EPIn));
+
+    EPIn.MaxPacketSize               = AUDIO_IN_MONO_PACKET_SIZE_BYTES;      /* Max packet size for IN endpoint (in bytes) */
+    EPIn.Interval                    = EP_IN_INTERVAL;                       /* Interval of 1 ms (8 * 125us) */
+    EPIn.Flags                       = USB_ADD_EP_FLAG_USE_ISO_SYNC_TYPES;   /* Optional parameters */
+    EPIn.InDir                       = USB_DIR_IN;                           /* IN direction (Device to Host) */
+    EPIn.TransferType                = USB_TRANSFER_TYPE_ISO;                /* Endpoint type - Isochronous. */
+    EPIn.ISO_Type                    = USB_ISO_SYNC_TYPE_ASYNCHRONOUS;       /* Async for isochronous endpoints */
+
+    /* Same settings as the microphone interface */
+    init_data_mono                   = init_data;
+    init_data_mono.EPIn              = USBD_AddEPEx(&EPIn, NULL, 0);
+    init_data_mono.pfOnIn            = audio_in_mono_endpoint_callback;
+    init_data_mono.pControlUserContext = microphone_mono_config;
+    init_data_mono.NumInterfaces     = 1U;
+    init_data_mono.paInterfaces      = microphone_mono_config;
+
+    return USBD_AUDIO_Add(&init_data_mono);
+}
+#endif /* AUDIO_IN_MONO_INTERFACE */
+
+#if (AUDIO_IN_SECOND_STREAM)
+/*******************************************************************************
+* Function Name: audio_second_control_callback
+********************************************************************************
+* Summary:
+*  Callback called in ISR context.
+*  Receives audio class control commands of the second stream. Its single
+*  format has no sampling frequency to select and its feature unit only has
+*  a mute control.
+*
+* Parameters:
+*  See audio_control_callback().
+*
+* Return:
+*  int: =0 Audio command was handled by the callback, ≠ 0 Audio command was
+*       not handled by the callback. The stack will STALL the request.
+*
+*******************************************************************************/
+static int audio_second_control_callback(void *pUserContext,
+                                         U8   Event,
+                                         U8   Unit,
+                                         U8   ControlSelector,
+                                         U8   *pBuffer,
+                                         U32  NumBytes,
+                                         U8   InterfaceNo,
+                                         U8   AltSetting)
+{
+    int retVal;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    CY_UNUSED_PARAMETER(pUserContext);
+    CY_UNUSED_PARAMETER(InterfaceNo);
+    CY_UNUSED_PARAMETER(AltSetting);
+
+    retVal = 0;
+    switch (Event)
+    {
+        case USB_AUDIO_RECORD_START:
+            audio_in_second_enable();
+            break;
+
+        case USB_AUDIO_RECORD_STOP:
+            audio_in_second_disable();
+
+            /* Let the "Audio App Task" power down the capture path */
+            xTaskNotifyFromISR(rtos_audio_app_task, AUDIO_APP_EVENT_STREAM_STOP, eSetBits,
+                               &higher_priority_task_woken);
+            break;
+
+        case USB_AUDIO_PLAYBACK_START:
+        case USB_AUDIO_PLAYBACK_STOP:
+            break;
+
+        case USB_AUDIO_SET_CUR:
+            switch (ControlSelector)
+            {
+                case USB_AUDIO_MUTE_CONTROL:
+                    if ((ONE_BYTE == NumBytes) && (Unit == microphone_second_config->pUnits->FeatureUnitID))
+                    {
+                        mic_second_mute = *pBuffer;
+                    }
+                    break;
+
+                case USB_AUDIO_SAMPLING_FREQ_CONTROL:
+                    /* Single sample rate */
+                    break;
+
+                default:
+                    retVal = 1;
+                    break;
+            }
+            break;
+
+        case USB_AUDIO_GET_CUR:
+            switch (ControlSelector)
+            {
+                case USB_AUDIO_MUTE_CONTROL:
+                    pBuffer[0] = mic_second_mute;
+                    break;
+
+                case USB_AUDIO_SAMPLING_FREQ_CONTROL:
+                    pBuffer[0] = microphone_second_config->paFormats[0].SamFreq & 0xff;
+                    pBuffer[1] = (microphone_second_config->paFormats[0].SamFreq >> 8) & 0xff;
+                    pBuffer[2] = (microphone_second_config->paFormats[0].SamFreq >> 16) & 0xff;
+                    break;
+
+                default:
+                    pBuffer[0] = 0;
+                    pBuffer[1] = 0;
+                    break;
+            }
+            break;
+
+        case USB_AUDIO_SET_MIN:
+        case USB_AUDIO_SET_MAX:
+        case USB_AUDIO_SET_RES:
+            break;
+
+        case USB_AUDIO_GET_MIN:
+        case USB_AUDIO_GET_MAX:
+        case USB_AUDIO_GET_RES:
+            pBuffer[0] = 0;
+            pBuffer[1] = 0;
+            break;
+
+        default:
+            retVal = 1;
+            break;
+    }
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+
+    return retVal;
+}
+
+/*******************************************************************************
+* Function Name: add_audio_second
+********************************************************************************
+* Summary:
+*  Add the USB Audio interface of the second stream to the USB stack, as a
+*  second audio instance with its own Audio IN endpoint. USBD_AUDIO_Write_Task
+*  serves both instances. Must be called after add_audio().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  USBD_AUDIO_HANDLE
+*
+*******************************************************************************/
+static USBD_AUDIO_HANDLE add_audio_second(void)
+{
+    USB_ADD_EP_INFO       EPIn;
+
+    memset(&EPIn, 0x0, sizeof(EPIn));
+
+    EPIn.MaxPacketSize               = AUDIO_IN_SECOND_PACKET_SIZE_BYTES;    /* Max packet size for IN endpoint (in bytes) */
+    EPIn.Interval                    = EP_IN_INTERVAL;                       /* Interval of 1 ms (8 * 125us) */
+    EPIn.Flags                       = USB_ADD_EP_FLAG_USE_ISO_SYNC_TYPES;   /* Optional parameters */
+    EPIn.InDir                       = USB_DIR_IN;                           /* IN direction (Device to Host) */
+    EPIn.TransferType                = USB_TRANSFER_TYPE_ISO;                /* Endpoint type - Isochronous. */
+    EPIn.ISO_Type                    = USB_ISO_SYNC_TYPE_ASYNCHRONOUS;       /* Async for isochronous endpoints */
+
+    /* Same settings as the microphone interface */
+    init_data_second                 = init_data;
+    init_data_second.EPIn            = USBD_AddEPEx(&EPIn, NULL, 0);
+    init_data_second.pfOnIn          = audio_in_second_endpoint_callback;
+    init_data_second.pfOnControl     = audio_second_control_callback;
+    init_data_second.NumInterfaces   = 1U;
+    init_data_second.paInterfaces    = microphone_second_config;
+
+    return USBD_AUDIO_Add(&init_data_second);
+}
+#endif /* AUDIO_IN_SECOND_STREAM */
+
 /*******************************************************************************
 * Function Name: audio_app_init
 ********************************************************************************
@@ -354,15 +665,13 @@ static USBD_AUDIO_HANDLE add_audio(void)
 *******************************************************************************/
 void audio_app_init(void)
 {
-    BaseType_t rtos_task_status;
-
     /* Initialize the audio clock based on audio sample rate */
     audio_clock_init();
 
     /* Create the AUDIO APP RTOS task */
-    rtos_task_status = xTaskCreate(audio_app_task, "Audio App Task", AUDIO_TASK_STACK_DEPTH, NULL,
-                       AUDIO_APP_TASK_PRIORITY, &rtos_audio_app_task);
-    if (pdPASS != rtos_task_status)
+    rtos_audio_app_task = xTaskCreateStatic(audio_app_task, "Audio App Task", AUDIO_APP_TASK_STACK_DEPTH, NULL,
+                       AUDIO_APP_TASK_PRIORITY, audio_app_task_stack, &audio_app_task_tcb);
+    if (NULL == rtos_audio_app_task)
     {
         CY_ASSERT(0);
     }
@@ -373,8 +682,10 @@ void audio_app_init(void)
 ********************************************************************************
 * Summary:
 *  Main audio task. Initializes the USB communication and the audio application.
-*  In the main loop, checks USB device connectivity and based on that start/stop
-*  providing audio data to the host.
+*  In the main loop, waits for the changes of the USB state notified by
+*  usb_state_callback() and based on that start/stop providing audio data to
+*  the host. The capture path is powered down while the bus is suspended or
+*  no stream is open.
 *
 * Parameters:
 *  arg
@@ -385,69 +696,112 @@ void audio_app_init(void)
 *******************************************************************************/
 void audio_app_task(void *arg)
 {
-    volatile bool usb_suspended = false;
-    volatile bool usb_connected = false;
+    bool usb_enumerated = false;
+    bool usb_playing = false;
+    uint32_t usb_state;
+    uint32_t events;
 
     CY_UNUSED_PARAMETER(arg);
 
     USBD_Init();
 
     handle = add_audio();
+#if (AUDIO_IN_MONO_INTERFACE)
+    handle_mono = add_audio_mono();
+#endif /* AUDIO_IN_MONO_INTERFACE */
+#if (AUDIO_IN_SECOND_STREAM)
+    handle_second = add_audio_second();
+#endif /* AUDIO_IN_SECOND_STREAM */
 
     USBD_SetDeviceInfo(&usb_deviceInfo);
 
     USBD_AUDIO_Set_Timeouts(handle, 0, WRITE_TIMEOUT);
+#if (AUDIO_IN_MONO_INTERFACE)
+    USBD_AUDIO_Set_Timeouts(handle_mono, 0, WRITE_TIMEOUT);
+#endif /* AUDIO_IN_MONO_INTERFACE */
+#if (AUDIO_IN_SECOND_STREAM)
+    USBD_AUDIO_Set_Timeouts(handle_second, 0, WRITE_TIMEOUT);
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+    /* Get notified of the changes of the USB state */
+    USBD_RegisterSCHook(&usb_state_hook, usb_state_callback, NULL);
 
     /* Init the audio IN application */
     audio_in_init();
 
-    USBD_Start();
+    /* Keep the capture path powered down until the host opens a stream */
+    audio_in_power_down();
 
-    /* Make device appear on the bus. This function call is blocking,
-     * toggle the kit user LED until device gets enumerated.
-     */
-    while (USB_STAT_CONFIGURED != (USBD_GetState() & (USB_STAT_CONFIGURED | USB_STAT_SUSPENDED)))
-    {
-        cyhal_gpio_toggle(CYBSP_USER_LED);
-        USB_OS_Delay(50);
-    }
-   
-    cyhal_gpio_write(CYBSP_USER_LED, CYBSP_LED_STATE_OFF);
+    USBD_Start();
 
-    /* Start providing audio data to the host */
-    USBD_AUDIO_Start_Play(handle, NULL);
+    usb_state = USBD_GetState();
 
     for (;;)
     {
-        /* Check if suspend condition is detected on the bus */
-        if (usb_suspend_flag)
+        if (USB_STAT_CONFIGURED == (usb_state & (USB_STATE_ACTIVE_MASK)))
         {
-            if (!usb_suspended)
+            if (!usb_enumerated)
             {
-                usb_suspended = true;
-                usb_connected = false;
-
-                /* Stop providing audio data to the host */
-                USBD_AUDIO_Stop_Play(handle);
-
-                printf("APP_LOG: USB Audio Device Disconnected\r\n");
+                usb_enumerated = true;
+                audio_in_hal_set_led(false);
             }
-        }
-        else /* USB device connected */
-        {
-            if (!usb_connected)
+
+            if (!usb_playing)
             {
-                usb_connected = true;
-                usb_suspended = false;
+                usb_playing = true;
 
                 /* Start providing audio data to the host */
                 USBD_AUDIO_Start_Play(handle, NULL);
+#if (AUDIO_IN_MONO_INTERFACE)
+                USBD_AUDIO_Start_Play(handle_mono, NULL);
+#endif /* AUDIO_IN_MONO_INTERFACE */
+#if (AUDIO_IN_SECOND_STREAM)
+                USBD_AUDIO_Start_Play(handle_second, NULL);
+#endif /* AUDIO_IN_SECOND_STREAM */
 
                 printf("APP_LOG: USB Audio Device Connected\r\n");
             }
         }
+        else if (usb_playing) /* Suspended, reset or detached */
+        {
+            usb_playing = false;
 
-        vTaskDelay(pdMS_TO_TICKS(DELAY_TICKS));
+            /* Stop providing audio data to the host */
+            USBD_AUDIO_Stop_Play(handle);
+#if (AUDIO_IN_MONO_INTERFACE)
+            USBD_AUDIO_Stop_Play(handle_mono);
+#endif /* AUDIO_IN_MONO_INTERFACE */
+#if (AUDIO_IN_SECOND_STREAM)
+            USBD_AUDIO_Stop_Play(handle_second);
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+            /* No SOF while suspended, stop the PDM/PCM block and its clocks */
+            audio_in_power_down();
+
+            printf("APP_LOG: USB Audio Device Disconnected\r\n");
+        }
+
+        /* Wait for the next change of the USB state. Toggle the kit user LED
+         * until the device gets enumerated.
+         */
+        if (pdTRUE == xTaskNotifyWait(0U, AUDIO_APP_EVENT_ALL, &events,
+                                      usb_enumerated ? portMAX_DELAY : pdMS_TO_TICKS(DELAY_TICKS)))
+        {
+            if (0U != (events & AUDIO_APP_EVENT_USB_STATE))
+            {
+                usb_state = USBD_GetState();
+            }
+
+            /* Both streams share the capture path */
+            if ((0U != (events & AUDIO_APP_EVENT_STREAM_STOP)) && !audio_in_is_streaming())
+            {
+                audio_in_power_down();
+            }
+        }
+        else
+        {
+            audio_in_hal_toggle_led();
+        }
     }
 }
 
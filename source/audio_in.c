@@ -39,81 +39,1117 @@
 * so agrees to indemnify Cypress against all liability.
 *****************************************************************************/
 #include "audio_in.h"
+#include "audio_in_hal.h"
+#include "audio_pack.h"
+#include "cycle_counter.h"
+#include "dsp_chain.h"
+#include "dsp_decim.h"
+#include "dsp_gain.h"
+#if (DSP_CHAIN_ENABLE_AGC)
+#include "dsp_agc.h"
+#endif /* DSP_CHAIN_ENABLE_AGC */
+#if (DSP_CHAIN_ENABLE_VAD)
+#include "dsp_vad.h"
+#endif /* DSP_CHAIN_ENABLE_VAD */
+#if (DSP_CHAIN_ENABLE_SRC)
+#include "dsp_src.h"
+#endif /* DSP_CHAIN_ENABLE_SRC */
+#include "latency_hist.h"
+#include "period_queue.h"
+#include "rate_ctrl.h"
 #include "audio.h"
 #include "cycfg_emusbdev.h"
-#include "cy_retarget_io.h"
-#include "cyhal.h"
-#include "cybsp.h"
+#include "cy_utils.h"
 
+#include <string.h>
 #include "rtos.h"
 
 
 /*****************************************************************************
 * Macros
 *****************************************************************************/
-/* PDM/PCM Pins */
-#ifndef CYBSP_PDM_DATA
-    #define CYBSP_PDM_DATA          CYBSP_A5
+/* Frames in a 1 ms USB frame, rounded down */
+#define AUDIO_IN_NOMINAL_FRAMES(freq)   ((freq) / 1000U)
+
+/* Additional frame sent when the PDM/PCM clock runs ahead of the host */
+#define AUDIO_IN_ADDITIONAL_FRAMES      ((ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_WORDS) / (AUDIO_IN_NUM_CHANNELS))
+
+/* Buffer depth kept by the rate controller, in frames. In DMA mode the depth
+ * is sampled right after a period is taken, so half a period keeps the queue
+ * balanced between its prefill level and its capacity. In FIFO mode the
+ * depth is sampled before reading, so the FIFO holds one packet plus half
+ * a packet of margin, or half of the room the FIFO has left above a packet
+ * when that is less (96 KHz stereo: 96 + 15 of 127 frames).
+ */
+#if (AUDIO_IN_CAPTURE_DMA)
+#define AUDIO_IN_TARGET_DEPTH(frames, channels)     ((frames) / 2U)
+#else
+#define AUDIO_IN_FIFO_FRAMES(channels)              ((AUDIO_IN_HAL_FIFO_SAMPLES) / (channels))
+#define AUDIO_IN_TARGET_DEPTH(frames, channels)     ((frames) + \
+        ((((frames) / 2U) < ((AUDIO_IN_FIFO_FRAMES(channels) - (frames)) / 2U)) ? \
+         ((frames) / 2U) : ((AUDIO_IN_FIFO_FRAMES(channels) - (frames)) / 2U)))
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+/* No format applied yet */
+#define AUDIO_IN_NO_FORMAT              (0xFFU)
+
+/* Volume units (1/256 dB) per gain unit of the PDM/PCM block (0.5 dB) */
+#define AUDIO_IN_VOLUME_PER_HAL_GAIN    (128)
+
+#if ((AUDIO_IN_BEAMFORMER) && !(DSP_CHAIN_ENABLE_BEAM)) || (!(AUDIO_IN_BEAMFORMER) && (DSP_CHAIN_ENABLE_BEAM))
+#error "AUDIO_IN_BEAMFORMER and DSP_CHAIN_ENABLE_BEAM must be set together."
+#endif
+
+#if (DSP_CHAIN_ENABLE_AGC) && (DSP_AGC_GAIN_MAX > AUDIO_IN_VOLUME_MAX)
+#error "DSP_AGC_GAIN_MAX exceeds the gain range of the PDM/PCM block."
+#endif
+
+/* Packets replaced by silence after the capture starts, while the
+ * microphones and the decimation filters of the PDM/PCM block settle
+ * (one packet per ms).
+ */
+#ifndef AUDIO_IN_WARMUP_MS
+#define AUDIO_IN_WARMUP_MS              (10U)
+#endif
+
+#if (AUDIO_IN_VAD_GATING)
+#if !(DSP_CHAIN_ENABLE_VAD)
+#error "AUDIO_IN_VAD_GATING needs the VAD stage of the DSP chain."
+#endif
+
+/* Voice activity gating: time without speech before the PDM/PCM block is
+ * powered down, time it stays down, and time it listens for speech after
+ * waking up (warm-up included). Speech starting while the block is down is
+ * detected within AUDIO_IN_VAD_SLEEP_MS + AUDIO_IN_WARMUP_MS + the onset
+ * of the VAD.
+ */
+#ifndef AUDIO_IN_VAD_GATE_MS
+#define AUDIO_IN_VAD_GATE_MS            (2000U)
 #endif
-#ifndef CYBSP_PDM_CLK
-    #define CYBSP_PDM_CLK           CYBSP_A4
+#ifndef AUDIO_IN_VAD_SLEEP_MS
+#define AUDIO_IN_VAD_SLEEP_MS           (200U)
 #endif
+#ifndef AUDIO_IN_VAD_LISTEN_MS
+#define AUDIO_IN_VAD_LISTEN_MS          (40U)
+#endif
+
+#if (AUDIO_IN_VAD_LISTEN_MS <= AUDIO_IN_WARMUP_MS)
+#error "AUDIO_IN_VAD_LISTEN_MS must leave time to listen after the warm-up."
+#endif
+#endif /* AUDIO_IN_VAD_GATING */
+
+#if (AUDIO_IN_SECOND_STREAM)
+/* Packet of the second stream in 32-bit words of its queue */
+#define AUDIO_IN_SECOND_PERIOD_WORDS    (((AUDIO_IN_SECOND_PACKET_SIZE_BYTES) + 3U) / 4U)
+
+/* Size (in bytes) of a frame of the second stream */
+#define AUDIO_IN_SECOND_FRAME_SIZE      ((AUDIO_IN_SECOND_NUM_CHANNELS) * (AUDIO_IN_SUB_FRAME_SIZE))
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Queue of captured periods between the capture side and the Audio IN
+ * endpoint (16-bits or 32-bits samples)
+ */
+static uint32_t audio_in_queue_storage[(PERIOD_QUEUE_DEPTH) * (MAX_AUDIO_IN_CAPTURE_SIZE_WORDS)];
+static period_queue_t audio_in_queue;
+
+#if (AUDIO_IN_CAPTURE_DMA)
+/* Number of samples of the period being written by the DMA */
+static volatile uint32_t audio_in_dma_count;
+
+/* Set once the queue holds AUDIO_IN_QUEUE_PREFILL_PERIODS periods */
+static bool audio_in_queue_primed = false;
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+/* Audio IN flags */
+volatile bool audio_in_start_recording = false;
+volatile bool audio_in_is_recording    = false;
+
+/* Mic mute status */
+U8 mic_mute;
+
+#if (AUDIO_IN_SECOND_STREAM)
+/* Packets of the second stream. The decimator reads the processed periods
+ * of the capture queue in place, only the decimated samples are stored.
+ */
+static uint32_t audio_in_second_storage[(PERIOD_QUEUE_DEPTH) * (AUDIO_IN_SECOND_PERIOD_WORDS)];
+static period_queue_t audio_in_second_queue;
+
+/* Set once the queue holds AUDIO_IN_QUEUE_PREFILL_PERIODS packets */
+static bool audio_in_second_primed = false;
+
+/* Second stream flags and mute status */
+static volatile bool audio_in_second_start_recording = false;
+static volatile bool audio_in_second_is_recording    = false;
+U8 mic_second_mute;
+
+/* Format the capture runs at while the first stream is closed */
+static uint8_t audio_in_second_capture_index = 0U;
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+/* Time spent by the periods between their capture and their hand-off to the
+ * Audio IN endpoint
+ */
+static latency_hist_t audio_in_latency;
+
+/* Delay added by the DSP chain at the sample rate of the session */
+static uint32_t audio_in_dsp_latency_us = 0U;
+
+/* Set by audio_in_reset_stats(), handled by the "Audio In Task" */
+static volatile bool audio_in_reset_stats_request = false;
+
+/* Rate matching between the PDM/PCM clock and the USB SOF */
+static rate_ctrl_t audio_in_rate_ctrl;
+
+/* Format requested by the host and format of the recording session
+ * (index in the formats of the microphone interface)
+ */
+static volatile uint8_t audio_in_format_index = 0U;
+static uint8_t audio_in_active_format_index = AUDIO_IN_NO_FORMAT;
+
+/* Volume requested by the host and volume applied, in 1/256 dB */
+static volatile int16_t audio_in_volume = AUDIO_IN_VOLUME_DEFAULT;
+static int16_t audio_in_active_volume = AUDIO_IN_VOLUME_DEFAULT;
+
+/* Gain of the PDM/PCM block requested for the volume, and gain applied, in
+ * 0.5 dB. The producer of the periods applies a new gain between two
+ * periods, and tags each period with the gain it was captured with.
+ */
+static volatile int32_t audio_in_hal_gain_request = AUDIO_IN_HAL_GAIN_MAX;
+static int32_t audio_in_hal_gain = AUDIO_IN_HAL_GAIN_MAX;
+
+/* Samples left in the RX FIFO when the gain of the PDM/PCM block last
+ * changed, still captured with the previous gain
+ */
+static uint32_t audio_in_hal_gain_offset = 0U;
+
+#if (DSP_CHAIN_ENABLE_GAIN)
+/* Gain of the capture path requested and gain of the gain stage at the end
+ * of the last period, in 1/256 dB, and gain of the PDM/PCM block of the last
+ * period, in 0.5 dB
+ */
+static int32_t audio_in_total_gain = AUDIO_IN_VOLUME_DEFAULT;
+static int32_t audio_in_dsp_gain = 0;
+static int32_t audio_in_period_gain = AUDIO_IN_HAL_GAIN_MAX;
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+
+#if (DSP_CHAIN_ENABLE_AGC)
+/* Gain of the AGC applied, in 1/256 dB */
+static int32_t audio_in_active_agc_gain = DSP_AGC_GAIN_INITIAL;
+#endif /* DSP_CHAIN_ENABLE_AGC */
+
+/* Frames of a regular packet of the active format */
+static uint32_t audio_in_nominal_frames;
+
+/* Subframe size (in bytes) of the active format */
+static uint8_t audio_in_sub_frame_size;
+
+/* Microphones of the active format (AUDIO_IN_LAYOUT_x), microphones captured
+ * by the PDM/PCM block for it, and size (in bytes) of a frame sent to the
+ * host
+ */
+static uint8_t audio_in_layout = AUDIO_IN_LAYOUT_STEREO;
+static uint32_t audio_in_capture_channels = AUDIO_IN_MIC_CHANNELS;
+static uint32_t audio_in_frame_size;
+
+/* Set while the PDM/PCM block runs. The audio subsystem is powered down
+ * otherwise.
+ */
+static volatile bool audio_in_capturing = false;
+
+/* Packets left before the captured audio is sent to the host */
+static uint32_t audio_in_warmup_periods;
+
+/* Time from the start of the capture to the first valid packet */
+static uint32_t audio_in_resume_cycles;
+static bool audio_in_resume_pending = false;
+static uint32_t audio_in_resumes;
+static uint32_t audio_in_last_resume_us;
+static uint32_t audio_in_max_resume_us;
+
+/* Captures stopped on sustained silence */
+static uint32_t audio_in_vad_gates;
+
+#if (AUDIO_IN_VAD_GATING)
+/* Packets without speech in a row, and packets left with the PDM/PCM block
+ * powered down
+ */
+static uint32_t audio_in_vad_silent_ms;
+static uint32_t audio_in_vad_sleep_ms;
+#endif /* AUDIO_IN_VAD_GATING */
+
+/* Memory of the "Audio In Task" */
+static StackType_t audio_in_task_stack[AUDIO_IN_TASK_STACK_DEPTH];
+static StaticTask_t audio_in_task_tcb;
+
+/* Time spent capturing and powered down, in RTOS ticks */
+static TickType_t audio_in_power_ticks;
+static TickType_t audio_in_active_ticks;
+static TickType_t audio_in_idle_ticks;
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+const unsigned char silent_frame[MAX_AUDIO_IN_PACKET_SIZE_BYTES] = {0};
+
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void audio_in_apply_format(void);
+static void audio_in_apply_volume(void);
+static void audio_in_clear_stats(void);
+static void audio_in_handover_gain(period_t *period);
+#if (DSP_CHAIN_ENABLE_GAIN)
+static void audio_in_compensate_gain(int32_t hal_gain, uint32_t offset);
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+#if (DSP_CHAIN_ENABLE_AGC)
+static void audio_in_set_agc_period_gain(int32_t hal_gain);
+#endif /* DSP_CHAIN_ENABLE_AGC */
+static uint32_t audio_in_capture_frames(uint32_t frames);
+static uint32_t audio_in_depth_frames(uint32_t samples);
+#if (AUDIO_IN_VAD_GATING)
+static bool audio_in_vad_gate(void);
+#endif /* AUDIO_IN_VAD_GATING */
+static uint32_t audio_in_pack(uint32_t *buffer, uint32_t count);
+static void audio_in_account_power(void);
+#if (AUDIO_IN_SECOND_STREAM)
+static bool audio_in_second_drives(void);
+static void audio_in_second_start(void);
+static void audio_in_second_produce(const dsp_block_t *block);
+#endif /* AUDIO_IN_SECOND_STREAM */
+static void audio_in_service(const U8 **ppNextBuffer, U32 *pNextPacketSize);
+static void audio_in_start_capture(void);
+static void audio_in_stop_capture(void);
+static period_t *audio_in_capture_period(void);
+#if (AUDIO_IN_CAPTURE_DMA)
+static void audio_in_period_complete(void);
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+
+/*****************************************************************************
+* Function Name: audio_in_init
+******************************************************************************
+* Summary:
+*  Initialize the PDM/PCM block and create the "Audio In Task" which will
+*  process the Audio IN endpoint transactions.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_init(void)
+{
+    uint8_t index;
+
+    /* Initialize the PDM PCM block */
+    audio_in_hal_init();
+
+    /* Start with the 16-bits format of the microphone interface matching AUDIO_IN_SAMPLE_FREQ */
+    for (index = 0U; index < (AUDIO_IN_NUM_MIC_FORMATS); index++)
+    {
+        if (((AUDIO_IN_SAMPLE_FREQ) == microphone_formats[index].SamFreq) &&
+            ((AUDIO_IN_BIT_RESOLUTION) == microphone_formats[index].BitResolution))
+        {
+            audio_in_format_index = index;
+        }
+    }
+
+#if (AUDIO_IN_SECOND_STREAM)
+    /* The second stream alone runs the 16-bits format at AUDIO_IN_SECOND_CAPTURE_FREQ */
+    for (index = 0U; index < (AUDIO_IN_NUM_MIC_FORMATS); index++)
+    {
+        if (((AUDIO_IN_SECOND_CAPTURE_FREQ) == microphone_formats[index].SamFreq) &&
+            ((AUDIO_IN_BIT_RESOLUTION) == microphone_formats[index].BitResolution))
+        {
+            audio_in_second_capture_index = index;
+            break;
+        }
+    }
+    period_queue_init(&audio_in_second_queue, audio_in_second_storage, (AUDIO_IN_SECOND_PERIOD_WORDS));
+#endif /* AUDIO_IN_SECOND_STREAM */
+    audio_in_apply_format();
+    audio_in_apply_volume();
+
+    /* Split the capture queue in periods */
+    period_queue_init(&audio_in_queue, audio_in_queue_storage, (MAX_AUDIO_IN_CAPTURE_SIZE_WORDS));
+    latency_hist_reset(&audio_in_latency);
+
+#if (AUDIO_IN_CAPTURE_DMA)
+    /* Get notified of each DMA period */
+    audio_in_hal_register_period_callback(audio_in_period_complete);
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+    /* Create the AUDIO Write RTOS task */
+    rtos_audio_in_task = xTaskCreateStatic(audio_in_process, "Audio In Task", AUDIO_IN_TASK_STACK_DEPTH, NULL,
+            AUDIO_WRITE_TASK_PRIORITY, audio_in_task_stack, &audio_in_task_tcb);
+    if (NULL == rtos_audio_in_task)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_in_enable
+******************************************************************************
+* Summary:
+*  Start a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_enable(void)
+{
+    audio_in_start_recording = true;
+    /* Turn ON the kit LED to indicate start of a recording session */
+    audio_in_hal_set_led(true);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_disable
+******************************************************************************
+* Summary:
+*  Stop a recording session.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_disable(void)
+{
+    audio_in_is_recording = false;
+    /* Turn OFF the kit LED to indicate the end of the recording session,
+     * unless the second stream still records
+     */
+    audio_in_hal_set_led(audio_in_is_streaming());
+}
+
+/*****************************************************************************
+* Function Name: audio_in_is_streaming
+******************************************************************************
+* Summary:
+*  Check if a recording session is active on any of the streams. The
+*  capture path must stay powered while one is.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while recording
+*
+*****************************************************************************/
+bool audio_in_is_streaming(void)
+{
+#if (AUDIO_IN_SECOND_STREAM)
+    return (audio_in_is_recording || audio_in_second_is_recording);
+#else
+    return audio_in_is_recording;
+#endif /* AUDIO_IN_SECOND_STREAM */
+}
+
+#if (AUDIO_IN_SECOND_STREAM)
+/*****************************************************************************
+* Function Name: audio_in_second_enable
+******************************************************************************
+* Summary:
+*  Start a recording session of the second stream.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_second_enable(void)
+{
+    audio_in_second_start_recording = true;
+    audio_in_hal_set_led(true);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_second_disable
+******************************************************************************
+* Summary:
+*  Stop the recording session of the second stream.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_second_disable(void)
+{
+    audio_in_second_is_recording = false;
+    audio_in_hal_set_led(audio_in_is_streaming());
+}
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+/*****************************************************************************
+* Function Name: audio_in_set_format
+******************************************************************************
+* Summary:
+*  Select the format of the next recording session. Can be called from the
+*  USB control callback (interrupt context); the format is applied by the
+*  Audio In Task, which restarts the recording session if needed.
+*
+* Parameters:
+*  format_index: Index of the format in microphone_formats[]
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_set_format(uint8_t format_index)
+{
+    if (format_index < (AUDIO_IN_NUM_FORMATS))
+    {
+        audio_in_format_index = format_index;
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_in_get_format
+******************************************************************************
+* Summary:
+*  Get the format selected by the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t: Index of the format in microphone_formats[]
+*
+*****************************************************************************/
+uint8_t audio_in_get_format(void)
+{
+    return audio_in_format_index;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_set_volume
+******************************************************************************
+* Summary:
+*  Set the volume requested by the host. Can be called from the USB control
+*  callback (interrupt context); the volume is applied by the "Audio In
+*  Task" before the next period.
+*
+* Parameters:
+*  volume: Volume in 1/256 dB, clamped to the range of the microphone and
+*          rounded to AUDIO_IN_VOLUME_RES
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_set_volume(int16_t volume)
+{
+    int32_t steps;
+
+    if (volume < (AUDIO_IN_VOLUME_MIN))
+    {
+        volume = (AUDIO_IN_VOLUME_MIN);
+    }
+    else if (volume > (AUDIO_IN_VOLUME_MAX))
+    {
+        volume = (AUDIO_IN_VOLUME_MAX);
+    }
+
+    steps = (((int32_t) volume - (AUDIO_IN_VOLUME_MIN)) + ((AUDIO_IN_VOLUME_RES) / 2)) / (AUDIO_IN_VOLUME_RES);
+    audio_in_volume = (int16_t) ((AUDIO_IN_VOLUME_MIN) + (steps * (AUDIO_IN_VOLUME_RES)));
+}
+
+/*****************************************************************************
+* Function Name: audio_in_get_volume
+******************************************************************************
+* Summary:
+*  Get the volume requested by the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int16_t: Volume in 1/256 dB
+*
+*****************************************************************************/
+int16_t audio_in_get_volume(void)
+{
+    return audio_in_volume;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_get_queue_stats
+******************************************************************************
+* Summary:
+*  Get the fill level statistics of the capture queue since the start of the
+*  recording session.
+*
+* Parameters:
+*  stats: Snapshot of the statistics
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_queue_stats(period_queue_stats_t *stats)
+{
+    period_queue_get_stats(&audio_in_queue, stats);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_get_latency
+******************************************************************************
+* Summary:
+*  Get a copy of the histogram of the capture-to-USB latency since the start
+*  of the recording session. The latency of a period is measured from the
+*  end of its capture to its hand-off to the Audio IN endpoint, plus the
+*  delay added by the DSP chain (look-ahead of the limiter).
+*
+* Parameters:
+*  hist: Copy of the histogram
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_latency(latency_hist_t *hist)
+{
+    taskENTER_CRITICAL();
+    *hist = audio_in_latency;
+    taskEXIT_CRITICAL();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_reset_stats
+******************************************************************************
+* Summary:
+*  Request the reset of the latency histogram and of the capture queue
+*  statistics. The reset is done by the "Audio In Task" before it sends the
+*  next packet.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_reset_stats(void)
+{
+    audio_in_reset_stats_request = true;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_power_down
+******************************************************************************
+* Summary:
+*  Stop the capture and power down the audio subsystem (PDM/PCM block,
+*  audio clock and PLL) when the host stopped the stream or suspended the
+*  bus. The capture starts again with the next recording session.
+*  Must be called from task context.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_power_down(void)
+{
+    /* Keep the "Audio In Task" out of the capture state meanwhile */
+    vTaskSuspendAll();
+
+    audio_in_stop_capture();
+    audio_in_hal_power_down();
+
+    (void) xTaskResumeAll();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_is_active
+******************************************************************************
+* Summary:
+*  Check if the PDM/PCM block is capturing.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while capturing
+*
+*****************************************************************************/
+bool audio_in_is_active(void)
+{
+    return audio_in_capturing;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_get_power_stats
+******************************************************************************
+* Summary:
+*  Get the time spent capturing and powered down, and the time taken by the
+*  capture to deliver valid audio after it starts.
+*
+* Parameters:
+*  stats: Snapshot of the statistics
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_get_power_stats(audio_in_power_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    audio_in_account_power();
+    stats->capturing      = audio_in_capturing;
+    stats->active_ms      = (uint32_t) (audio_in_active_ticks * portTICK_PERIOD_MS);
+    stats->idle_ms        = (uint32_t) (audio_in_idle_ticks * portTICK_PERIOD_MS);
+    stats->resumes        = audio_in_resumes;
+    stats->last_resume_us = audio_in_last_resume_us;
+    stats->max_resume_us  = audio_in_max_resume_us;
+    stats->vad_gates      = audio_in_vad_gates;
+    taskEXIT_CRITICAL();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_apply_format
+******************************************************************************
+* Summary:
+*  Reconfigure the capture path (audio subsystem clock, PDM/PCM block,
+*  microphones captured, packet sizing and sample packing) for the format
+*  requested by the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_apply_format(void)
+{
+    uint8_t index = audio_in_format_index;
+    const USBD_AUDIO_FORMAT *format = &microphone_formats[index];
+    uint32_t sample_rate = format->SamFreq;
+    uint32_t capture_rate = sample_rate;
+
+#if (DSP_CHAIN_ENABLE_SRC)
+    /* The 44.1 KHz family is converted from a capture in the 48 KHz family */
+    capture_rate = dsp_src_get_capture_rate(sample_rate);
+#endif /* DSP_CHAIN_ENABLE_SRC */
+
+    audio_in_layout = microphone_layouts[index];
+    audio_in_hal_set_format(capture_rate, format->BitResolution, audio_in_layout);
+
+    audio_in_capture_channels = ((AUDIO_IN_LAYOUT_LEFT == audio_in_layout) || (AUDIO_IN_LAYOUT_RIGHT == audio_in_layout)) ?
+                                1U : (AUDIO_IN_MIC_CHANNELS);
+    audio_in_sub_frame_size = format->SubFrameSize;
+    audio_in_frame_size = (uint32_t) format->NrChannels * format->SubFrameSize;
+    audio_in_nominal_frames = AUDIO_IN_NOMINAL_FRAMES(sample_rate);
+    rate_ctrl_init(&audio_in_rate_ctrl, sample_rate,
+                   AUDIO_IN_TARGET_DEPTH(audio_in_nominal_frames, audio_in_capture_channels),
+                   audio_in_nominal_frames + (AUDIO_IN_ADDITIONAL_FRAMES));
+    dsp_chain_configure(sample_rate);
+
+    /* Delay of the chain at the new rate, the sample rate converter included
+     * while it converts (dsp_src_get_latency())
+     */
+    audio_in_dsp_latency_us = (dsp_chain_get_latency() * 1000000UL) / sample_rate;
+#if (AUDIO_IN_SECOND_STREAM)
+    (void) dsp_decim_configure(sample_rate, AUDIO_IN_SECOND_SAMPLE_FREQ);
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+    audio_in_active_format_index = index;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_apply_volume
+******************************************************************************
+* Summary:
+*  Split the volume requested by the host between the gain of the PDM/PCM
+*  block and the gain stage of the DSP chain. The PDM/PCM block takes the
+*  gain step at or above the volume, and the gain stage attenuates the
+*  remainder. The gain steps are 1.5 dB and the volume resolution 0.5 dB,
+*  so only one volume setting in three costs no CPU per sample; the other
+*  two run the gain stage at 0.5 or 1 dB of attenuation. The new gain
+*  of the PDM/PCM block is applied between two periods, see
+*  audio_in_handover_gain(), and the gain stage follows it period by period,
+*  see audio_in_compensate_gain().
+*  Without the gain stage, the volume is rounded to the nearest gain step.
+*
+*  With the AGC, the gain computed by the AGC is split the same way, and the
+*  volume attenuates it (no attenuation at AUDIO_IN_VOLUME_MAX). Below the
+*  lowest gain of the PDM/PCM block, the gain stage attenuates the rest.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_apply_volume(void)
+{
+    int16_t volume = audio_in_volume;
+    int32_t gain = volume;
+    int32_t steps;
+    int32_t hal_gain;
+
+#if (DSP_CHAIN_ENABLE_AGC)
+    audio_in_active_agc_gain = dsp_agc_get_gain();
+    gain += audio_in_active_agc_gain - (AUDIO_IN_VOLUME_MAX);
+#endif /* DSP_CHAIN_ENABLE_AGC */
+
+    /* Gain in 0.5 dB, from the lowest gain of the PDM/PCM block */
+    steps = (gain / (AUDIO_IN_VOLUME_PER_HAL_GAIN)) - (AUDIO_IN_HAL_GAIN_MIN);
+
+#if (DSP_CHAIN_ENABLE_GAIN)
+    hal_gain = (AUDIO_IN_HAL_GAIN_MIN) + (((steps + (AUDIO_IN_HAL_GAIN_STEP) - 1) / (AUDIO_IN_HAL_GAIN_STEP)) * (AUDIO_IN_HAL_GAIN_STEP));
+    if (steps < 0)
+    {
+        hal_gain = (AUDIO_IN_HAL_GAIN_MIN);
+    }
+    audio_in_total_gain = (steps + (AUDIO_IN_HAL_GAIN_MIN)) * (AUDIO_IN_VOLUME_PER_HAL_GAIN);
+#else
+    hal_gain = (AUDIO_IN_HAL_GAIN_MIN) + (((steps + ((AUDIO_IN_HAL_GAIN_STEP) / 2)) / (AUDIO_IN_HAL_GAIN_STEP)) * (AUDIO_IN_HAL_GAIN_STEP));
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+
+    audio_in_hal_gain_request = hal_gain;
+
+    audio_in_active_volume = volume;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_handover_gain
+******************************************************************************
+* Summary:
+*  Tag a period just captured with the gain of the PDM/PCM block, then
+*  apply the gain requested, if new. The samples then left in the RX FIFO
+*  (below the trigger level of the DMA, or the margin kept by the rate
+*  controller in FIFO mode) were converted with the previous gain: the next
+*  period is tagged with their number, so the gain stage steps on the first
+*  sample converted with the new gain. Called by the producer of the
+*  periods, in interrupt context with the DMA.
+*
+* Parameters:
+*  period: Period just captured
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_handover_gain(period_t *period)
+{
+    int32_t request = audio_in_hal_gain_request;
+
+    period->gain = audio_in_hal_gain;
+    period->gain_offset = audio_in_hal_gain_offset;
+    audio_in_hal_gain_offset = 0U;
+
+    if (request != audio_in_hal_gain)
+    {
+        audio_in_hal_gain = request;
+        audio_in_hal_set_gain(request);
+        audio_in_hal_gain_offset = audio_in_hal_get_fifo_level();
+    }
+}
+
+#if (DSP_CHAIN_ENABLE_GAIN)
+/*****************************************************************************
+* Function Name: audio_in_compensate_gain
+******************************************************************************
+* Summary:
+*  Set the gain stage for the next period, captured with the gain hal_gain
+*  of the PDM/PCM block from the frame offset on. When that gain differs
+*  from the one of the previous period, the gain stage steps by the opposite
+*  amount on that frame, so the gain of the capture path does not step. It
+*  then ramps over the rest of the period to the gain requested. The frame
+*  reaches the gain stage later by the delay of the stages ahead of it, e.g.
+*  the beamformer.
+*
+* Parameters:
+*  hal_gain: Gain of the PDM/PCM block of the period, in 0.5 dB
+*  offset: First frame of the period captured with hal_gain
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_compensate_gain(int32_t hal_gain, uint32_t offset)
+{
+    int32_t gain;
+
+    if (hal_gain != audio_in_period_gain)
+    {
+        audio_in_dsp_gain += (audio_in_period_gain - hal_gain) * (AUDIO_IN_VOLUME_PER_HAL_GAIN);
+        dsp_gain_jump(dsp_gain_db_to_q15(audio_in_dsp_gain), offset + dsp_chain_get_stage_delay(dsp_gain_process));
+        audio_in_period_gain = hal_gain;
+    }
+
+    /* The gain stage only attenuates: until the PDM/PCM block catches up,
+     * a higher gain stops at unity
+     */
+    gain = audio_in_total_gain - (hal_gain * (AUDIO_IN_VOLUME_PER_HAL_GAIN));
+    audio_in_dsp_gain = (gain > 0) ? 0 : gain;
+    dsp_gain_set(dsp_gain_db_to_q15(audio_in_dsp_gain));
+}
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+
+#if (DSP_CHAIN_ENABLE_AGC)
+/*****************************************************************************
+* Function Name: audio_in_set_agc_period_gain
+******************************************************************************
+* Summary:
+*  Tell the AGC the share of its gain in the gain applied to the next
+*  period: the gain of the PDM/PCM block the period was captured with and
+*  the gain of the gain stage, without the attenuation of the volume.
+*
+* Parameters:
+*  hal_gain: Gain of the PDM/PCM block of the period, in 0.5 dB
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_set_agc_period_gain(int32_t hal_gain)
+{
+    int32_t gain = hal_gain * (AUDIO_IN_VOLUME_PER_HAL_GAIN);
+
+#if (DSP_CHAIN_ENABLE_GAIN)
+    gain += audio_in_dsp_gain;
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+
+    dsp_agc_set_period_gain(gain + (AUDIO_IN_VOLUME_MAX) - audio_in_active_volume);
+}
+#endif /* DSP_CHAIN_ENABLE_AGC */
+
+/*****************************************************************************
+* Function Name: audio_in_clear_stats
+******************************************************************************
+* Summary:
+*  Clear the latency histogram, the capture queue statistics and the
+*  statistics of the DSP stages. Called by the "Audio In Task" when a stream
+*  opens and on request of audio_in_reset_stats(), not when the capture
+*  restarts within a stream (mute, suspend, voice activity gating).
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_clear_stats(void)
+{
+    latency_hist_reset(&audio_in_latency);
+    period_queue_clear_stats(&audio_in_queue);
+    dsp_chain_reset_stats();
+    audio_in_max_resume_us = 0U;
+#if (DSP_CHAIN_ENABLE_VAD)
+    dsp_vad_reset_stats();
+#endif /* DSP_CHAIN_ENABLE_VAD */
+}
+
+/*****************************************************************************
+* Function Name: audio_in_capture_frames
+******************************************************************************
+* Summary:
+*  Get the number of frames to capture for a packet. With the sample rate
+*  converter, the capture runs faster than the packets it produces.
+*
+* Parameters:
+*  frames: Frames of the packet
+*
+* Return:
+*  uint32_t: Frames to capture
+*
+*****************************************************************************/
+static uint32_t audio_in_capture_frames(uint32_t frames)
+{
+#if (DSP_CHAIN_ENABLE_SRC)
+    return dsp_src_plan(frames);
+#else
+    return frames;
+#endif /* DSP_CHAIN_ENABLE_SRC */
+}
+
+/*****************************************************************************
+* Function Name: audio_in_depth_frames
+******************************************************************************
+* Summary:
+*  Get the depth of the capture buffer in frames at the sample rate of the
+*  host, as steered by the rate controller.
+*
+* Parameters:
+*  samples: Captured samples not yet sent
+*
+* Return:
+*  uint32_t: Depth in frames
+*
+*****************************************************************************/
+static uint32_t audio_in_depth_frames(uint32_t samples)
+{
+#if (DSP_CHAIN_ENABLE_SRC)
+    return dsp_src_get_output_frames(samples / audio_in_capture_channels);
+#else
+    return (samples / audio_in_capture_channels);
+#endif /* DSP_CHAIN_ENABLE_SRC */
+}
+
+#if (AUDIO_IN_VAD_GATING)
+/*****************************************************************************
+* Function Name: audio_in_vad_gate
+******************************************************************************
+* Summary:
+*  Power the PDM/PCM block down after AUDIO_IN_VAD_GATE_MS without speech,
+*  and keep it down for AUDIO_IN_VAD_SLEEP_MS. The capture then starts again
+*  and listens for speech during AUDIO_IN_VAD_LISTEN_MS before the next
+*  power down. Called once per packet.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while the PDM/PCM block is powered down
+*
+*****************************************************************************/
+static bool audio_in_vad_gate(void)
+{
+    if (audio_in_vad_sleep_ms > 0U)
+    {
+        audio_in_vad_sleep_ms--;
+        return true;
+    }
+
+    if (audio_in_capturing && (audio_in_vad_silent_ms >= (AUDIO_IN_VAD_GATE_MS)))
+    {
+        audio_in_stop_capture();
+        audio_in_hal_power_down();
+        audio_in_vad_gates++;
+
+        audio_in_vad_sleep_ms = (AUDIO_IN_VAD_SLEEP_MS);
+        audio_in_vad_silent_ms = (AUDIO_IN_VAD_GATE_MS) - (AUDIO_IN_VAD_LISTEN_MS - AUDIO_IN_WARMUP_MS);
+        return true;
+    }
+
+    return false;
+}
+#endif /* AUDIO_IN_VAD_GATING */
+
+/*****************************************************************************
+* Function Name: audio_in_pack
+******************************************************************************
+* Summary:
+*  Convert captured samples, in place, to the subframe size of the active
+*  format.
+*
+* Parameters:
+*  buffer: Captured samples, converted samples on return
+*  count: Number of samples
+*
+* Return:
+*  uint32_t: Number of bytes to send to the Audio IN endpoint
+*
+*****************************************************************************/
+static uint32_t audio_in_pack(uint32_t *buffer, uint32_t count)
+{
+    switch (audio_in_sub_frame_size)
+    {
+        case AUDIO_IN_SUB_FRAME_SIZE_24BIT:
+            return audio_pack_s24_3(buffer, count);
+
+        case AUDIO_IN_SUB_FRAME_SIZE_32BIT:
+            return audio_pack_s32(buffer, count);
+
+        default:
+            /* 16-bits samples are captured as sent */
+            return (count * (AUDIO_IN_SUB_FRAME_SIZE));
+    }
+}
 
-/* Decimation Rate of the PDM/PCM block */
-#define DECIMATION_RATE             (64U)
+/*****************************************************************************
+* Function Name: audio_in_process
+******************************************************************************
+* Summary:
+*  Wrapper task for USBD_AUDIO_Write_Task (audio in endpoint).
+*
+* Parameters:
+*  arg
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_process(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
 
-/* Audio Subsystem Clock. Typical values depends on the desired sample rate:
- * 8KHz / 16 KHz / 32 KHz / 48 KHz    : 24.576 MHz
- * 22.05 KHz / 44.1 KHz               : 22.579 MHz 
- */
-#if ((AUDIO_SAMPLING_RATE_22KHZ == AUDIO_IN_SAMPLE_FREQ) || (AUDIO_SAMPLING_RATE_44KHZ == AUDIO_IN_SAMPLE_FREQ))
-#define AUDIO_SYS_CLOCK_HZ                  (22579200U)
-#else 
-#define AUDIO_SYS_CLOCK_HZ                  (24576000U) 
-#endif /* ((AUDIO_SAMPLING_RATE_22KHZ == AUDIO_IN_SAMPLE_FREQ) || (AUDIO_SAMPLING_RATE_44KHZ == AUDIO_IN_SAMPLE_FREQ)) */
+    USBD_AUDIO_Write_Task();
 
+    for (;;)
+    {
+    }
+}
 
+#if (AUDIO_IN_CAPTURE_DMA)
 /*****************************************************************************
-* Global Variables
+* Function Name: audio_in_period_complete
+******************************************************************************
+* Summary:
+*  Called in interrupt context when the DMA completed a period. Publishes the
+*  period to the queue and re-arms the DMA on the next free period, sized by
+*  the rate controller.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
 *****************************************************************************/
-/* PCM buffer data (16-bits) */
-uint16_t audio_in_pcm_buffer_ping[(MAX_AUDIO_IN_PACKET_SIZE_WORDS)];
-uint16_t audio_in_pcm_buffer_pong[(MAX_AUDIO_IN_PACKET_SIZE_WORDS)];
-
-/* Audio IN flags */
-volatile bool audio_in_start_recording = false;
-volatile bool audio_in_is_recording    = false;
-
-/* Mic mute status */
-U8 mic_mute;
-
-/* HAL object */
-cyhal_pdm_pcm_t pdm_pcm;
-static cyhal_clock_t audio_clock;
-
-/* HAL Config for pdm_pcm */
-const cyhal_pdm_pcm_cfg_t pdm_pcm_cfg =
+static void audio_in_period_complete(void)
 {
-    .sample_rate     = AUDIO_IN_SAMPLE_FREQ,
-    .decimation_rate = DECIMATION_RATE,
-    .mode            = CYHAL_PDM_PCM_MODE_STEREO,
-    .word_length     = AUDIO_IN_BIT_RESOLUTION,  /* bits */
-    .left_gain       = CYHAL_PDM_PCM_MAX_GAIN,   /* dB */
-    .right_gain      = CYHAL_PDM_PCM_MAX_GAIN,   /* dB */
-};
+    period_t *period;
 
+    period = period_queue_producer_period(&audio_in_queue);
+    period->timestamp = cycle_counter_get();
+    audio_in_handover_gain(period);
+    period_queue_produce(&audio_in_queue, audio_in_dma_count);
 
-/*****************************************************************************
-* Static const data
-*****************************************************************************/
-const unsigned char silent_frame[MAX_AUDIO_IN_PACKET_SIZE_BYTES] = {0};
+    if (audio_in_capturing)
+    {
+        audio_in_dma_count = audio_in_capture_frames(rate_ctrl_next_frames(&audio_in_rate_ctrl)) * audio_in_capture_channels;
+
+        period = period_queue_producer_period(&audio_in_queue);
+        audio_in_hal_read_period(period->buffer, audio_in_dma_count);
+    }
+}
+#endif /* AUDIO_IN_CAPTURE_DMA */
 
 /*****************************************************************************
-* Function Name: audio_in_init
+* Function Name: audio_in_account_power
 ******************************************************************************
 * Summary:
-*  Initialize the PDM/PCM block and create the "Audio In Task" which will
-*  process the Audio IN endpoint transactions.
+*  Add the time spent since the previous transition to the active (capturing)
+*  or idle (powered down) time.
 *
 * Parameters:
 *  None
@@ -122,27 +1158,29 @@ const unsigned char silent_frame[MAX_AUDIO_IN_PACKET_SIZE_BYTES] = {0};
 *  None
 *
 *****************************************************************************/
-void audio_in_init(void)
+static void audio_in_account_power(void)
 {
-    BaseType_t rtos_task_status;
-
-    /* Initialize the PDM PCM block */
-    cyhal_pdm_pcm_init(&pdm_pcm, CYBSP_PDM_DATA, CYBSP_PDM_CLK, &audio_clock, &pdm_pcm_cfg);
+    TickType_t now = xTaskGetTickCount();
 
-    /* Create the AUDIO Write RTOS task */
-    rtos_task_status = xTaskCreate(audio_in_process, "Audio In Task", AUDIO_TASK_STACK_DEPTH, NULL,
-            AUDIO_WRITE_TASK_PRIORITY, &rtos_audio_in_task);
-    if (pdPASS != rtos_task_status)
+    if (audio_in_capturing)
     {
-        CY_ASSERT(0);
+        audio_in_active_ticks += (now - audio_in_power_ticks);
+    }
+    else
+    {
+        audio_in_idle_ticks += (now - audio_in_power_ticks);
     }
+    audio_in_power_ticks = now;
 }
 
 /*****************************************************************************
-* Function Name: audio_in_enable
+* Function Name: audio_in_start_capture
 ******************************************************************************
 * Summary:
-*  Start a recording session.
+*  Power up the audio subsystem, reconfigure it if the host selected another
+*  format, and start the PDM/PCM conversion. The first AUDIO_IN_WARMUP_MS of
+*  audio are replaced by silence while the microphones and the decimation
+*  filters settle.
 *
 * Parameters:
 *  None
@@ -151,18 +1189,69 @@ void audio_in_init(void)
 *  None
 *
 *****************************************************************************/
-void audio_in_enable(void)
+static void audio_in_start_capture(void)
 {
-    audio_in_start_recording = true;
-    /* Turn ON the kit LED to indicate start of a recording session */
-    cyhal_gpio_write(CYBSP_USER_LED, CYBSP_LED_STATE_ON);
+#if (AUDIO_IN_CAPTURE_DMA)
+    period_t *period;
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+    audio_in_resume_cycles = cycle_counter_get();
+    audio_in_resume_pending = true;
+
+    audio_in_hal_power_up();
+
+    if (audio_in_format_index != audio_in_active_format_index)
+    {
+        audio_in_apply_format();
+    }
+    audio_in_apply_volume();
+
+    /* Nothing captured yet, the gain applies from the first period */
+    audio_in_hal_gain = audio_in_hal_gain_request;
+    audio_in_hal_set_gain(audio_in_hal_gain);
+    audio_in_hal_gain_offset = 0U;
+#if (DSP_CHAIN_ENABLE_GAIN)
+    audio_in_period_gain = audio_in_hal_gain;
+    audio_in_compensate_gain(audio_in_hal_gain, 0U);
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+
+    /* Drop any period left over from the previous capture */
+    period_queue_reset(&audio_in_queue);
+    rate_ctrl_reset(&audio_in_rate_ctrl);
+    dsp_chain_reset();
+#if (AUDIO_IN_SECOND_STREAM)
+    dsp_decim_reset();
+    period_queue_reset(&audio_in_second_queue);
+    audio_in_second_primed = false;
+#endif /* AUDIO_IN_SECOND_STREAM */
+    audio_in_warmup_periods = (AUDIO_IN_WARMUP_MS);
+#if (AUDIO_IN_CAPTURE_DMA)
+    audio_in_queue_primed = false;
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+    /* Clear PDM/PCM RX FIFO */
+    audio_in_hal_clear();
+
+    /* Start PDM/PCM */
+    audio_in_hal_start();
+
+    audio_in_account_power();
+    audio_in_capturing = true;
+
+#if (AUDIO_IN_CAPTURE_DMA)
+    /* Let the DMA drain the RX FIFO into the first period */
+    audio_in_dma_count = audio_in_capture_frames(audio_in_nominal_frames) * audio_in_capture_channels;
+    period = period_queue_producer_period(&audio_in_queue);
+    audio_in_hal_read_period(period->buffer, audio_in_dma_count);
+#endif /* AUDIO_IN_CAPTURE_DMA */
 }
 
 /*****************************************************************************
-* Function Name: audio_in_disable
+* Function Name: audio_in_stop_capture
 ******************************************************************************
 * Summary:
-*  Stop a recording session.
+*  Stop the PDM/PCM conversion and the DMA. The audio subsystem stays
+*  powered.
 *
 * Parameters:
 *  None
@@ -171,35 +1260,83 @@ void audio_in_enable(void)
 *  None
 *
 *****************************************************************************/
-void audio_in_disable(void)
+static void audio_in_stop_capture(void)
 {
-    audio_in_is_recording = false;
-    /* Turn OFF the kit LED to indicate the end of the recording session */
-    cyhal_gpio_write(CYBSP_USER_LED, CYBSP_LED_STATE_OFF);
+    if (!audio_in_capturing)
+    {
+        return;
+    }
+
+    audio_in_account_power();
+    audio_in_capturing = false;
+
+    audio_in_hal_abort_period();
+    audio_in_hal_stop();
 }
 
 /*****************************************************************************
-* Function Name: audio_in_process
+* Function Name: audio_in_capture_period
 ******************************************************************************
 * Summary:
-*  Wrapper task for USBD_AUDIO_Write_Task (audio in endpoint).
+*  Get the next captured period to send to the host and steer the capture
+*  towards the target buffer depth.
 *
 * Parameters:
-*  arg
+*  None
 *
 * Return:
-*  None
+*  period_t*: Captured period, NULL if none is available yet
 *
 *****************************************************************************/
-void audio_in_process(void *arg)
+static period_t *audio_in_capture_period(void)
 {
-    CY_UNUSED_PARAMETER(arg);
+    period_t *period;
+#if (AUDIO_IN_CAPTURE_DMA)
 
-    USBD_AUDIO_Write_Task();
+    /* Wait for the prefill level before sending the first period */
+    if (!audio_in_queue_primed)
+    {
+        audio_in_queue_primed = (period_queue_level(&audio_in_queue) >= (AUDIO_IN_QUEUE_PREFILL_PERIODS));
+    }
 
-    for (;;)
+    period = audio_in_queue_primed ? period_queue_consume(&audio_in_queue) : NULL;
+
+    if (NULL == period)
     {
+        /* Queue ran dry, prefill it again */
+        audio_in_queue_primed = false;
     }
+    else
+    {
+        /* Steer the length of the next DMA periods towards the target depth */
+        rate_ctrl_update(&audio_in_rate_ctrl, audio_in_depth_frames(period_queue_samples(&audio_in_queue)));
+    }
+#else
+    size_t audio_in_count;
+
+    /* Setup the number of bytes to transfer from the rate controller, which
+     * keeps the FIFO level close to its target depth.
+     */
+    rate_ctrl_update(&audio_in_rate_ctrl, audio_in_depth_frames(audio_in_hal_get_fifo_level()));
+    audio_in_count = audio_in_capture_frames(rate_ctrl_next_frames(&audio_in_rate_ctrl)) * audio_in_capture_channels;
+
+    /* Read all the data in the PDM/PCM buffer into the next free period.
+     * The period sent in the previous frames is never reused while the
+     * USB controller may still be sending it.
+     */
+    period = period_queue_producer_period(&audio_in_queue);
+    audio_in_hal_read((void *) period->buffer, &audio_in_count);
+    period->timestamp = cycle_counter_get();
+    audio_in_handover_gain(period);
+    period_queue_produce(&audio_in_queue, audio_in_count);
+
+    /* The queue is drained on every frame, so the period just read is
+     * the oldest one.
+     */
+    period = period_queue_consume(&audio_in_queue);
+#endif /* AUDIO_IN_CAPTURE_DMA */
+
+    return period;
 }
 
 /*****************************************************************************
@@ -223,83 +1360,321 @@ void audio_in_endpoint_callback(void *pUserContext,
                                 const U8 **ppNextBuffer,
                                 U32 *pNextPacketSize)
 {
-    unsigned int sample_size;
-    size_t audio_in_count;
-    static uint16_t *audio_in_pcm_buffer = NULL;
+    CY_UNUSED_PARAMETER(pUserContext);
+
+#if (AUDIO_IN_SECOND_STREAM)
+    /* The second stream runs the capture while this one is closed */
+    if (audio_in_second_drives())
+    {
+        return;
+    }
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+    /* The host streams a format of the mono interface */
+    if (audio_in_format_index >= (AUDIO_IN_NUM_MIC_FORMATS))
+    {
+        return;
+    }
+
+    audio_in_service(ppNextBuffer, pNextPacketSize);
+}
 
+#if (AUDIO_IN_MONO_INTERFACE)
+/*****************************************************************************
+* Function Name: audio_in_mono_endpoint_callback
+******************************************************************************
+* Summary:
+*  Callback called in the context of USBD_AUDIO_Write_Task.
+*  Handles data of the mono interface sent to the host (IN direction). The
+*  mono interface and the microphone interface share the capture path, which
+*  runs for the interface of the format selected last.
+*
+* Parameters:
+*  pUserContext: User context which is passed to the callback.
+*  ppNextBuffer: Buffer containing audio samples which should match the
+*                configuration from the mono USBD_AUDIO_IF_CONF.
+*  pNextPacketSize: Size of the next buffer.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_mono_endpoint_callback(void *pUserContext,
+                                     const U8 **ppNextBuffer,
+                                     U32 *pNextPacketSize)
+{
     CY_UNUSED_PARAMETER(pUserContext);
 
-    /*
-     * Packet size minus the additional audio frames reserved in MAX_AUDIO_IN_PACKET_SIZE_BYTES.
-     * The application can periodically increase SampleSize to counterbalance differences between the
-     * regular sample size and the actual byte rate.
-     */
-    sample_size = ((MAX_AUDIO_IN_PACKET_SIZE_BYTES) - (ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_BYTES));
+#if (AUDIO_IN_SECOND_STREAM)
+    /* The second stream runs the capture while this one is closed */
+    if (audio_in_second_drives())
+    {
+        return;
+    }
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+    /* The host streams a format of the microphone interface */
+    if (audio_in_format_index < (AUDIO_IN_NUM_MIC_FORMATS))
+    {
+        return;
+    }
+
+    audio_in_service(ppNextBuffer, pNextPacketSize);
+}
+#endif /* AUDIO_IN_MONO_INTERFACE */
+
+/*****************************************************************************
+* Function Name: audio_in_service
+******************************************************************************
+* Summary:
+*  Run the capture path for one packet of the first stream.
+*
+*  The PDM/PCM block only runs while a recording session is active and the
+*  microphone is not muted. Silence is sent in the other cases. With
+*  AUDIO_IN_VAD_GATING, silence is also sent while no speech is detected,
+*  and the PDM/PCM block is powered down during sustained silence. With
+*  AUDIO_IN_SECOND_STREAM, each processed period is also decimated into a
+*  packet of the second stream.
+*
+* Parameters:
+*  ppNextBuffer: Packet of the first stream, unchanged if none
+*  pNextPacketSize: Size of the packet
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_service(const U8 **ppNextBuffer, U32 *pNextPacketSize)
+{
+    period_t *period = NULL;
+    dsp_block_t block;
+    uint32_t resume_us;
+
+    /* Reset the statistics on request of the console */
+    if (audio_in_reset_stats_request)
+    {
+        audio_in_reset_stats_request = false;
+        audio_in_clear_stats();
+    }
+
+    /* Restart the recording session when the host selected another format */
+    if ((audio_in_format_index != audio_in_active_format_index) && audio_in_is_recording)
+    {
+        audio_in_start_recording = true;
+    }
 
-    
     if (audio_in_start_recording)
     {
         audio_in_start_recording = false;
         audio_in_is_recording = true;
+        audio_in_stop_capture();
 
-        /* Clear Audio In buffer */
-        memset(audio_in_pcm_buffer_ping, 0, (MAX_AUDIO_IN_PACKET_SIZE_BYTES));
-
-        audio_in_pcm_buffer = audio_in_pcm_buffer_ping;
+        /* New stream, the capture restarts of a session keep the statistics */
+        audio_in_clear_stats();
+#if (AUDIO_IN_VAD_GATING)
+        audio_in_vad_silent_ms = 0U;
+        audio_in_vad_sleep_ms = 0U;
+#endif /* AUDIO_IN_VAD_GATING */
+    }
 
-        /* Clear PDM/PCM RX FIFO */
-        cyhal_pdm_pcm_clear(&pdm_pcm);
+#if (AUDIO_IN_SECOND_STREAM)
+    audio_in_second_start();
+#endif /* AUDIO_IN_SECOND_STREAM */
 
-        /* Start PDM/PCM */
-        cyhal_pdm_pcm_start(&pdm_pcm);
+    if (!audio_in_is_streaming())
+    {
+        return;
+    }
 
-        /* Start a transfer to the Audio IN endpoint */
-        *ppNextBuffer = (uint8_t *) audio_in_pcm_buffer;
-        *pNextPacketSize = sample_size;
+    /* Keep the audio subsystem powered down while the microphone is muted,
+     * start the capture again once it is unmuted or after a suspend. The
+     * second stream keeps it running.
+     */
+#if (AUDIO_IN_SECOND_STREAM)
+    if ((1U == mic_mute) && !audio_in_second_is_recording)
+#else
+    if (1U == mic_mute)
+#endif /* AUDIO_IN_SECOND_STREAM */
+    {
+        audio_in_stop_capture();
+        audio_in_hal_power_down();
+    }
+#if (AUDIO_IN_VAD_GATING)
+    else if (audio_in_vad_gate())
+    {
+        /* No speech for a while, the PDM/PCM block stays powered down */
+    }
+#endif /* AUDIO_IN_VAD_GATING */
+    else if (!audio_in_capturing)
+    {
+        audio_in_start_capture();
     }
-    else if (audio_in_is_recording) /* Check if should keep recording */
+    else
     {
-        if (audio_in_pcm_buffer == audio_in_pcm_buffer_ping)
+        if (audio_in_volume != audio_in_active_volume)
         {
-            audio_in_pcm_buffer = audio_in_pcm_buffer_pong;
+            audio_in_apply_volume();
         }
-        else
+#if (DSP_CHAIN_ENABLE_AGC)
+        else if (dsp_agc_get_gain() != audio_in_active_agc_gain)
         {
-            audio_in_pcm_buffer = audio_in_pcm_buffer_ping;
+            audio_in_apply_volume();
         }
+#endif /* DSP_CHAIN_ENABLE_AGC */
 
-        /* Setup the number of bytes to transfer based on the current FIFO level */
-        if (Cy_PDM_PCM_GetNumInFifo(pdm_pcm.base) > (MAX_AUDIO_IN_PACKET_SIZE_WORDS))
-        {
-            audio_in_count = (MAX_AUDIO_IN_PACKET_SIZE_WORDS);
-        }
-        else
+        period = audio_in_capture_period();
+    }
+
+    if (NULL != period)
+    {
+        /* Run the DSP chain on the period, in place. Also during the warm-up
+         * so the state of the stages settles with the microphones.
+         */
+        block.samples = period->buffer;
+        block.frames = period->count / audio_in_capture_channels;
+        block.channels = audio_in_capture_channels;
+        block.sample_size = (audio_in_sub_frame_size > (AUDIO_IN_SUB_FRAME_SIZE)) ? sizeof(int32_t) : sizeof(int16_t);
+
+        /* Average the microphones first, so the DSP chain only runs on the
+         * mono samples
+         */
+        if (AUDIO_IN_LAYOUT_DOWNMIX == audio_in_layout)
         {
-            audio_in_count = ((MAX_AUDIO_IN_PACKET_SIZE_WORDS) - (ADDITIONAL_AUDIO_IN_SAMPLE_SIZE_WORDS));
+            if (sizeof(int16_t) == block.sample_size)
+            {
+                audio_pack_downmix_s16(period->buffer, block.frames);
+            }
+            else
+            {
+                audio_pack_downmix_s32(period->buffer, block.frames);
+            }
+            block.channels = 1U;
         }
 
-        /* Read all the data in the PDM/PCM buffer */
-        cyhal_pdm_pcm_read(&pdm_pcm, (void *) audio_in_pcm_buffer, &audio_in_count);
+#if (DSP_CHAIN_ENABLE_GAIN)
+        /* Frames at the host rate, as seen by the gain stage */
+        audio_in_compensate_gain(period->gain, audio_in_depth_frames(period->gain_offset));
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+#if (DSP_CHAIN_ENABLE_AGC)
+        audio_in_set_agc_period_gain(period->gain);
+#endif /* DSP_CHAIN_ENABLE_AGC */
+        dsp_chain_process(&block);
 
-        if (1U == mic_mute)
+#if (AUDIO_IN_VAD_GATING)
+        if (1U == audio_in_warmup_periods)
         {
-            /* Send silent frames in case of mute */
-            *ppNextBuffer = silent_frame;
+            /* Drop the decisions taken while the microphones settled */
+            dsp_vad_reset();
+        }
+        else if (0U == audio_in_warmup_periods)
+        {
+            audio_in_vad_silent_ms = dsp_vad_is_speech() ? 0U : (audio_in_vad_silent_ms + 1U);
         }
         else
         {
-            /* Send captured audio samples to the Audio IN endpoint */
-            *ppNextBuffer = (uint8_t *) audio_in_pcm_buffer;
+            /* Warm-up */
+        }
+#endif /* AUDIO_IN_VAD_GATING */
+
+#if (AUDIO_IN_SECOND_STREAM)
+        audio_in_second_produce(&block);
+#endif /* AUDIO_IN_SECOND_STREAM */
+    }
+
+    if (NULL == period)
+    {
+        /* Nothing captured, send silence. The length of the packets follows
+         * the rate controller, so the host sees the same average rate.
+         */
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = (audio_in_capturing ? audio_in_nominal_frames : rate_ctrl_next_frames(&audio_in_rate_ctrl))
+                           * audio_in_frame_size;
+    }
+    else if (audio_in_warmup_periods > 0U)
+    {
+        /* Microphones and decimation filters still settling, send silence */
+        audio_in_warmup_periods--;
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = block.frames * audio_in_frame_size;
+    }
+#if (AUDIO_IN_SECOND_STREAM)
+    else if (1U == mic_mute)
+    {
+        /* Muted, the capture only runs for the second stream */
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = block.frames * audio_in_frame_size;
+    }
+#endif /* AUDIO_IN_SECOND_STREAM */
+#if (AUDIO_IN_VAD_GATING)
+    else if (!dsp_vad_is_speech())
+    {
+        /* No speech, spare the host the background noise */
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = block.frames * audio_in_frame_size;
+    }
+#endif /* AUDIO_IN_VAD_GATING */
+    else
+    {
+        /* Pack the period in place to the subframe size of the format. The
+         * downmix or the DSP chain may have combined the microphones into
+         * fewer channels.
+         */
+        *pNextPacketSize = audio_in_pack(period->buffer, block.frames * block.channels);
+
+        /* Send the captured period to the Audio IN endpoint */
+        *ppNextBuffer = (uint8_t *) period->buffer;
+
+        /* Time spent in the device by the period, and by its samples in the
+         * DSP chain
+         */
+        latency_hist_add(&audio_in_latency,
+                         cycle_counter_to_us(cycle_counter_get() - period->timestamp) + audio_in_dsp_latency_us);
+
+        /* Time from the start of the capture to the first valid audio */
+        if (audio_in_resume_pending)
+        {
+            audio_in_resume_pending = false;
+            resume_us = cycle_counter_to_us(cycle_counter_get() - audio_in_resume_cycles);
+
+            audio_in_resumes++;
+            audio_in_last_resume_us = resume_us;
+            if (resume_us > audio_in_max_resume_us)
+            {
+                audio_in_max_resume_us = resume_us;
+            }
         }
-        *pNextPacketSize = audio_in_count * (AUDIO_IN_SUB_FRAME_SIZE);
     }
 }
 
-/*******************************************************************************
-* Function Name: audio_clock_init
-********************************************************************************
+#if (AUDIO_IN_SECOND_STREAM)
+/*****************************************************************************
+* Function Name: audio_in_second_drives
+******************************************************************************
+* Summary:
+*  Check if the second stream runs the capture path: it does while it
+*  records and the first stream is closed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true if the endpoint callback of the second stream runs the
+*        capture path
+*
+*****************************************************************************/
+static bool audio_in_second_drives(void)
+{
+    return ((audio_in_second_is_recording || audio_in_second_start_recording) &&
+            !(audio_in_is_recording || audio_in_start_recording));
+}
+
+/*****************************************************************************
+* Function Name: audio_in_second_start
+******************************************************************************
 * Summary:
-*  Initializes clock for audio subsystem.
+*  Start the recording session of the second stream on request of the host,
+*  and keep the capture at AUDIO_IN_SECOND_CAPTURE_FREQ while the first
+*  stream is closed. The capture restarts when its format changes.
 *
 * Parameters:
 *  None
@@ -307,66 +1682,140 @@ void audio_in_endpoint_callback(void *pUserContext,
 * Return:
 *  None
 *
-*******************************************************************************/
-void audio_clock_init(void)
+*****************************************************************************/
+static void audio_in_second_start(void)
 {
-    cy_rslt_t result;
-    cyhal_clock_t clock_pll;
+    if (audio_in_second_start_recording)
+    {
+        audio_in_second_start_recording = false;
+        audio_in_second_is_recording = true;
+        dsp_decim_reset();
+        period_queue_reset(&audio_in_second_queue);
+        audio_in_second_primed = false;
+    }
 
-    /* Initialize, take ownership of PLL0/PLL */
-    result = cyhal_clock_reserve(&clock_pll, &CYHAL_CLOCK_PLL[0]);
-    if (CY_RSLT_SUCCESS != result)
+    if (audio_in_second_is_recording && !audio_in_is_recording &&
+        (audio_in_format_index != audio_in_second_capture_index))
     {
-        CY_ASSERT(0);
+        audio_in_format_index = audio_in_second_capture_index;
+        audio_in_stop_capture();
     }
+}
 
-    /* Set the PLL0/PLL frequency to AUDIO_SYS_CLOCK_HZ based on AUDIO_IN_SAMPLE_FREQ */
-    result = cyhal_clock_set_frequency(&clock_pll, AUDIO_SYS_CLOCK_HZ, NULL);
-    if (CY_RSLT_SUCCESS != result)
+/*****************************************************************************
+* Function Name: audio_in_second_produce
+******************************************************************************
+* Summary:
+*  Decimate a processed period into the next packet of the second stream.
+*  The packet is silent whenever the first stream sends silence (warm-up,
+*  voice activity gating). Nothing is produced when the sample rate of the
+*  first stream is not a multiple of AUDIO_IN_SECOND_SAMPLE_FREQ, the
+*  second stream then sends silence.
+*
+* Parameters:
+*  block: Period at the output of the DSP chain
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_second_produce(const dsp_block_t *block)
+{
+    period_t *period;
+    uint32_t count;
+
+    if (!audio_in_second_is_recording)
     {
-        CY_ASSERT(0);
+        return;
     }
 
-    /* If the PLL0/PLL clock is not already enabled, enable it */
-    if (!cyhal_clock_is_enabled(&clock_pll))
+    period = period_queue_producer_period(&audio_in_second_queue);
+    count = dsp_decim_process(block, (int16_t *) period->buffer);
+    if (0U == count)
     {
-        result = cyhal_clock_set_enabled(&clock_pll, true, true);
-        if (CY_RSLT_SUCCESS != result)
-        {
-            CY_ASSERT(0);
-        }
+        return;
     }
 
-    /* Initialize, take ownership of CLK_HF1 */
-    result = cyhal_clock_reserve(&audio_clock, &CYHAL_CLOCK_HF[1]);
-    if (CY_RSLT_SUCCESS != result)
+#if (AUDIO_IN_VAD_GATING)
+    if ((audio_in_warmup_periods > 0U) || !dsp_vad_is_speech())
+#else
+    if (audio_in_warmup_periods > 0U)
+#endif /* AUDIO_IN_VAD_GATING */
     {
-        CY_ASSERT(0);
+        memset(period->buffer, 0, count * sizeof(int16_t));
     }
 
-    /* Source the audio subsystem clock (CLK_HF1) from PLL0/PLL */
-    result = cyhal_clock_set_source(&audio_clock, &clock_pll);
-    if (CY_RSLT_SUCCESS != result)
+    period->timestamp = cycle_counter_get();
+    period_queue_produce(&audio_in_second_queue, count);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_second_endpoint_callback
+******************************************************************************
+* Summary:
+*  Callback called in the context of USBD_AUDIO_Write_Task.
+*  Handles data of the second stream sent to the host (IN direction). The
+*  packets are decimated by the capture path of the first stream, or by
+*  this callback while the first stream is closed. Silence is sent until
+*  a packet is available and while the second stream is muted.
+*
+* Parameters:
+*  pUserContext: User context which is passed to the callback.
+*  ppNextBuffer: Buffer containing audio samples which should match the
+*                configuration from the second USBD_AUDIO_IF_CONF.
+*  pNextPacketSize: Size of the next buffer.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_second_endpoint_callback(void *pUserContext,
+                                       const U8 **ppNextBuffer,
+                                       U32 *pNextPacketSize)
+{
+    const U8 *first_buffer;
+    U32 first_size;
+    period_t *period;
+
+    CY_UNUSED_PARAMETER(pUserContext);
+
+    /* The packet of the first stream is not sent */
+    if (audio_in_second_drives())
     {
-        CY_ASSERT(0);
+        audio_in_service(&first_buffer, &first_size);
     }
 
-    /* Set the divider for audio subsystem clock (CLK_HF1) */
-    result = cyhal_clock_set_divider(&audio_clock, 1);
-    if (CY_RSLT_SUCCESS != result)
+    if (!audio_in_second_is_recording)
     {
-        CY_ASSERT(0);
+        return;
     }
 
-    /* If the audio subsystem clock (CLK_HF1) is not already enabled, enable it */
-    if (!cyhal_clock_is_enabled(&audio_clock))
+    /* Wait for the prefill level before sending the first packet */
+    if (!audio_in_second_primed)
     {
-        result = cyhal_clock_set_enabled(&audio_clock, true, true);
-        if (CY_RSLT_SUCCESS != result)
-        {
-            CY_ASSERT(0);
-        }
+        audio_in_second_primed = (period_queue_level(&audio_in_second_queue) >= (AUDIO_IN_QUEUE_PREFILL_PERIODS));
+    }
+
+    period = audio_in_second_primed ? period_queue_consume(&audio_in_second_queue) : NULL;
+
+    if (NULL == period)
+    {
+        /* Queue ran dry, prefill it again */
+        audio_in_second_primed = false;
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = AUDIO_IN_NOMINAL_FRAMES(AUDIO_IN_SECOND_SAMPLE_FREQ) * (AUDIO_IN_SECOND_FRAME_SIZE);
+    }
+    else if (1U == mic_second_mute)
+    {
+        *ppNextBuffer = silent_frame;
+        *pNextPacketSize = period->count * (AUDIO_IN_SUB_FRAME_SIZE);
+    }
+    else
+    {
+        *ppNextBuffer = (uint8_t *) period->buffer;
+        *pNextPacketSize = period->count * (AUDIO_IN_SUB_FRAME_SIZE);
     }
 }
+#endif /* AUDIO_IN_SECOND_STREAM */
 
 /* [] END OF FILE */
@@ -0,0 +1,695 @@
+/*****************************************************************************
+* File Name    : audio_in_hal.c
+*
+* Description  : This file contains the hardware access layer of the Audio In
+*                path (PDM/PCM block, DMA and audio subsystem clock).
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_in_hal.h"
+#include "audio_in.h"
+#include "audio.h"
+#include "dsp_chain.h"
+#if (DSP_CHAIN_ENABLE_SRC)
+#include "dsp_src.h"
+#endif /* DSP_CHAIN_ENABLE_SRC */
+#include "cyhal.h"
+#include "cybsp.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* PDM/PCM Pins */
+#ifndef CYBSP_PDM_DATA
+    #define CYBSP_PDM_DATA          CYBSP_A5
+#endif
+#ifndef CYBSP_PDM_CLK
+    #define CYBSP_PDM_CLK           CYBSP_A4
+#endif
+
+/* Decimation Rate of the PDM/PCM block. The rate is adjusted at both ends of
+ * the sample rate range to keep the PDM clock within the 1.0 MHz - 3.2 MHz
+ * range of typical PDM microphones:
+ * 8 KHz  x 128 = 1.024 MHz
+ * 48 KHz x 64  = 3.072 MHz
+ * 96 KHz x 32  = 3.072 MHz
+ */
+#define DECIMATION_RATE             (64U)
+#define DECIMATION_RATE_LOW         (128U)
+#define DECIMATION_RATE_HIGH        (32U)
+
+/* Audio Subsystem Clock. Typical values depends on the desired sample rate:
+ * 8KHz / 16 KHz / 32 KHz / 48 KHz    : 24.576 MHz
+ * 22.05 KHz / 44.1 KHz               : 22.579 MHz
+ */
+#define AUDIO_SYS_CLOCK_48KHZ_HZ    (24576000U)
+#define AUDIO_SYS_CLOCK_44KHZ_HZ    (22579200U)
+
+/* Sample rates of the 44.1 KHz family are multiples of this rate */
+#define AUDIO_SAMPLING_RATE_11KHZ   (11025U)
+
+/* Capture rate at startup. With the sample rate converter, the capture
+ * always runs in the 48 KHz family.
+ */
+#if (DSP_CHAIN_ENABLE_SRC)
+#define AUDIO_IN_HAL_INITIAL_FREQ   ((0U == ((AUDIO_IN_SAMPLE_FREQ) % (AUDIO_SAMPLING_RATE_11KHZ))) ? \
+                                     (((AUDIO_IN_SAMPLE_FREQ) / (DSP_SRC_UP)) * (DSP_SRC_DOWN)) : (AUDIO_IN_SAMPLE_FREQ))
+#else
+#define AUDIO_IN_HAL_INITIAL_FREQ   (AUDIO_IN_SAMPLE_FREQ)
+#endif /* DSP_CHAIN_ENABLE_SRC */
+
+/* Priority of the DMA channel draining the PDM/PCM RX FIFO */
+#define AUDIO_IN_DMA_PRIORITY       (CYHAL_DMA_PRIORITY_DEFAULT)
+
+/* Priority of the PDM/PCM interrupt signaling the end of a DMA period */
+#define AUDIO_IN_DMA_ISR_PRIORITY   (CYHAL_ISR_PRIORITY_DEFAULT)
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* HAL object */
+static cyhal_pdm_pcm_t pdm_pcm;
+static cyhal_clock_t audio_clock;
+static cyhal_clock_t clock_pll;
+
+/* HAL Config for pdm_pcm, the sample rate and word length are updated at runtime */
+static cyhal_pdm_pcm_cfg_t pdm_pcm_cfg =
+{
+    .sample_rate     = AUDIO_IN_HAL_INITIAL_FREQ,
+    .decimation_rate = DECIMATION_RATE,
+    .mode            = CYHAL_PDM_PCM_MODE_STEREO,
+    .word_length     = AUDIO_IN_BIT_RESOLUTION,  /* bits */
+    .left_gain       = CYHAL_PDM_PCM_MAX_GAIN,   /* 0.5 dB */
+    .right_gain      = CYHAL_PDM_PCM_MAX_GAIN,   /* 0.5 dB */
+};
+
+/* Period completion callback registered by the Audio In path */
+static audio_in_hal_period_callback_t period_callback = NULL;
+
+/* Set while PLL0/PLL and the audio subsystem clock (CLK_HF1) run */
+static bool audio_in_hal_powered = false;
+
+
+/*****************************************************************************
+* Function Name: audio_in_hal_get_sys_clock
+******************************************************************************
+* Summary:
+*  Get the audio subsystem clock frequency required by a sample rate.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*
+* Return:
+*  uint32_t: PLL0/PLL frequency in Hz
+*
+*****************************************************************************/
+static uint32_t audio_in_hal_get_sys_clock(uint32_t sample_rate)
+{
+    if (0U == (sample_rate % (AUDIO_SAMPLING_RATE_11KHZ)))
+    {
+        return (AUDIO_SYS_CLOCK_44KHZ_HZ);
+    }
+
+    return (AUDIO_SYS_CLOCK_48KHZ_HZ);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_get_decimation_rate
+******************************************************************************
+* Summary:
+*  Get the PDM/PCM decimation rate used for a sample rate.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*
+* Return:
+*  uint8_t: Decimation rate
+*
+*****************************************************************************/
+static uint8_t audio_in_hal_get_decimation_rate(uint32_t sample_rate)
+{
+    if (sample_rate <= (AUDIO_SAMPLING_RATE_8KHZ))
+    {
+        return (DECIMATION_RATE_LOW);
+    }
+    if (sample_rate > (AUDIO_SAMPLING_RATE_48KHZ))
+    {
+        return (DECIMATION_RATE_HIGH);
+    }
+
+    return (DECIMATION_RATE);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_event_handler
+******************************************************************************
+* Summary:
+*  PDM/PCM event handler. Forwards the completion of a DMA period to the
+*  callback registered with audio_in_hal_register_period_callback().
+*
+* Parameters:
+*  arg: Not used
+*  event: PDM/PCM event
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void audio_in_hal_event_handler(void *arg, cyhal_pdm_pcm_event_t event)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    if ((0U != (event & CYHAL_PDM_PCM_ASYNC_COMPLETE)) && (NULL != period_callback))
+    {
+        period_callback();
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_init
+******************************************************************************
+* Summary:
+*  Initialize the PDM/PCM block. When the DMA capture mode is selected, the
+*  PDM/PCM asynchronous transfers are also routed through a DMA channel.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_init(void)
+{
+    cy_rslt_t result;
+
+    /* Initialize the PDM PCM block */
+    pdm_pcm_cfg.decimation_rate = audio_in_hal_get_decimation_rate(pdm_pcm_cfg.sample_rate);
+    result = cyhal_pdm_pcm_init(&pdm_pcm, CYBSP_PDM_DATA, CYBSP_PDM_CLK, &audio_clock, &pdm_pcm_cfg);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+#if (AUDIO_IN_CAPTURE_DMA)
+    /* Let the DMA drain the RX FIFO for asynchronous reads */
+    result = cyhal_pdm_pcm_set_async_mode(&pdm_pcm, CYHAL_ASYNC_DMA, AUDIO_IN_DMA_PRIORITY);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    cyhal_pdm_pcm_register_callback(&pdm_pcm, audio_in_hal_event_handler, NULL);
+    cyhal_pdm_pcm_enable_event(&pdm_pcm, CYHAL_PDM_PCM_ASYNC_COMPLETE, AUDIO_IN_DMA_ISR_PRIORITY, true);
+#endif /* AUDIO_IN_CAPTURE_DMA */
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_set_format
+******************************************************************************
+* Summary:
+*  Reconfigure the audio subsystem clock and the PDM/PCM block for a new
+*  sample rate and resolution. Resolutions above AUDIO_IN_HAL_MAX_WORD_LENGTH
+*  are captured with the widest word of the PDM/PCM block. The layouts with
+*  a single microphone capture it alone (mono mode of the PDM/PCM block),
+*  the others capture both. The PDM/PCM conversion is left stopped. Must be
+*  called from a task, never while a DMA period is in progress.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*  bit_resolution: Bits per sample
+*  layout: Microphones of the format, AUDIO_IN_LAYOUT_x
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_set_format(uint32_t sample_rate, uint8_t bit_resolution, uint8_t layout)
+{
+    cy_rslt_t result;
+    uint32_t sys_clock_hz;
+    uint8_t word_length;
+    cyhal_pdm_pcm_mode_t mode;
+
+    word_length = (bit_resolution > (AUDIO_IN_HAL_MAX_WORD_LENGTH)) ? (AUDIO_IN_HAL_MAX_WORD_LENGTH) : bit_resolution;
+
+    switch (layout)
+    {
+        case AUDIO_IN_LAYOUT_LEFT:
+            mode = CYHAL_PDM_PCM_MODE_LEFT;
+            break;
+
+        case AUDIO_IN_LAYOUT_RIGHT:
+            mode = CYHAL_PDM_PCM_MODE_RIGHT;
+            break;
+
+        default:
+            mode = CYHAL_PDM_PCM_MODE_STEREO;
+            break;
+    }
+
+    if ((sample_rate == pdm_pcm_cfg.sample_rate) && (word_length == pdm_pcm_cfg.word_length) &&
+        (mode == pdm_pcm_cfg.mode))
+    {
+        return;
+    }
+
+    cyhal_pdm_pcm_stop(&pdm_pcm);
+    cyhal_pdm_pcm_free(&pdm_pcm);
+
+    /* Only retune PLL0/PLL when switching between the 44.1 KHz and 48 KHz families */
+    sys_clock_hz = audio_in_hal_get_sys_clock(sample_rate);
+    if (sys_clock_hz != cyhal_clock_get_frequency(&clock_pll))
+    {
+        result = cyhal_clock_set_frequency(&clock_pll, sys_clock_hz, NULL);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            CY_ASSERT(0);
+        }
+    }
+
+    pdm_pcm_cfg.sample_rate = sample_rate;
+    pdm_pcm_cfg.word_length = word_length;
+    pdm_pcm_cfg.mode = mode;
+    audio_in_hal_init();
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_set_gain
+******************************************************************************
+* Summary:
+*  Set the gain of both channels of the PDM/PCM block. The gain is kept
+*  across the changes of format.
+*
+* Parameters:
+*  gain: Gain in 0.5 dB, multiple of AUDIO_IN_HAL_GAIN_STEP between
+*        AUDIO_IN_HAL_GAIN_MIN and AUDIO_IN_HAL_GAIN_MAX
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_set_gain(int32_t gain)
+{
+    cy_rslt_t result;
+
+    if (gain < (AUDIO_IN_HAL_GAIN_MIN))
+    {
+        gain = (AUDIO_IN_HAL_GAIN_MIN);
+    }
+    else if (gain > (AUDIO_IN_HAL_GAIN_MAX))
+    {
+        gain = (AUDIO_IN_HAL_GAIN_MAX);
+    }
+
+    if ((gain == pdm_pcm_cfg.left_gain) && (gain == pdm_pcm_cfg.right_gain))
+    {
+        return;
+    }
+
+    pdm_pcm_cfg.left_gain = (int16_t) gain;
+    pdm_pcm_cfg.right_gain = (int16_t) gain;
+
+    result = cyhal_pdm_pcm_set_gain(&pdm_pcm, (int16_t) gain, (int16_t) gain);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_start
+******************************************************************************
+* Summary:
+*  Start the PDM/PCM conversion.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_start(void)
+{
+    cyhal_pdm_pcm_start(&pdm_pcm);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_stop
+******************************************************************************
+* Summary:
+*  Stop the PDM/PCM conversion.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_stop(void)
+{
+    cyhal_pdm_pcm_stop(&pdm_pcm);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_clear
+******************************************************************************
+* Summary:
+*  Clear the PDM/PCM RX FIFO.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_clear(void)
+{
+    cyhal_pdm_pcm_clear(&pdm_pcm);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_get_fifo_level
+******************************************************************************
+* Summary:
+*  Get the number of samples (words) waiting in the PDM/PCM RX FIFO.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: FIFO level in words
+*
+*****************************************************************************/
+uint32_t audio_in_hal_get_fifo_level(void)
+{
+    return Cy_PDM_PCM_GetNumInFifo(pdm_pcm.base);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_read
+******************************************************************************
+* Summary:
+*  Copy samples out of the PDM/PCM RX FIFO.
+*
+* Parameters:
+*  buffer: Destination buffer
+*  count: In - number of samples (words) to read.
+*         Out - number of samples (words) actually read.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_read(void *buffer, size_t *count)
+{
+    cyhal_pdm_pcm_read(&pdm_pcm, buffer, count);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_register_period_callback
+******************************************************************************
+* Summary:
+*  Register the function called when a DMA period is complete.
+*
+* Parameters:
+*  callback: Period completion callback
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_register_period_callback(audio_in_hal_period_callback_t callback)
+{
+    period_callback = callback;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_read_period
+******************************************************************************
+* Summary:
+*  Arm the DMA to move the next period out of the PDM/PCM RX FIFO. The
+*  registered period callback is invoked once the period is complete.
+*
+* Parameters:
+*  buffer: Destination buffer of the period
+*  count: Number of samples (words) in the period
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_read_period(void *buffer, size_t count)
+{
+    cyhal_pdm_pcm_read_async(&pdm_pcm, buffer, count);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_abort_period
+******************************************************************************
+* Summary:
+*  Abort the DMA period in progress, if any.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_abort_period(void)
+{
+    if (cyhal_pdm_pcm_is_pending(&pdm_pcm))
+    {
+        cyhal_pdm_pcm_abort_async(&pdm_pcm);
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_power_down
+******************************************************************************
+* Summary:
+*  Stop the PDM/PCM conversion, gate the audio subsystem clock (CLK_HF1) and
+*  disable PLL0/PLL. The PDM/PCM configuration is kept. Must be called from
+*  a task, never while a DMA period is in progress.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_power_down(void)
+{
+    cy_rslt_t result;
+
+    if (!audio_in_hal_powered)
+    {
+        return;
+    }
+
+    cyhal_pdm_pcm_stop(&pdm_pcm);
+
+    result = cyhal_clock_set_enabled(&audio_clock, false, false);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    result = cyhal_clock_set_enabled(&clock_pll, false, false);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    audio_in_hal_powered = false;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_power_up
+******************************************************************************
+* Summary:
+*  Enable PLL0/PLL, wait for it to lock, and ungate the audio subsystem
+*  clock (CLK_HF1). The PDM/PCM conversion is left stopped.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_power_up(void)
+{
+    cy_rslt_t result;
+
+    if (audio_in_hal_powered)
+    {
+        return;
+    }
+
+    result = cyhal_clock_set_enabled(&clock_pll, true, true);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    result = cyhal_clock_set_enabled(&audio_clock, true, true);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    audio_in_hal_powered = true;
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_set_led
+******************************************************************************
+* Summary:
+*  Turn the kit user LED ON or OFF.
+*
+* Parameters:
+*  on: true to turn the LED ON
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_set_led(bool on)
+{
+    cyhal_gpio_write(CYBSP_USER_LED, on ? CYBSP_LED_STATE_ON : CYBSP_LED_STATE_OFF);
+}
+
+/*****************************************************************************
+* Function Name: audio_in_hal_toggle_led
+******************************************************************************
+* Summary:
+*  Toggle the kit user LED.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_in_hal_toggle_led(void)
+{
+    cyhal_gpio_toggle(CYBSP_USER_LED);
+}
+
+/*******************************************************************************
+* Function Name: audio_clock_init
+********************************************************************************
+* Summary:
+*  Initializes clock for audio subsystem.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void audio_clock_init(void)
+{
+    cy_rslt_t result;
+
+    /* Initialize, take ownership of PLL0/PLL */
+    result = cyhal_clock_reserve(&clock_pll, &CYHAL_CLOCK_PLL[0]);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Set the PLL0/PLL frequency based on the capture rate of AUDIO_IN_SAMPLE_FREQ */
+    result = cyhal_clock_set_frequency(&clock_pll, audio_in_hal_get_sys_clock(AUDIO_IN_HAL_INITIAL_FREQ), NULL);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* If the PLL0/PLL clock is not already enabled, enable it */
+    if (!cyhal_clock_is_enabled(&clock_pll))
+    {
+        result = cyhal_clock_set_enabled(&clock_pll, true, true);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            CY_ASSERT(0);
+        }
+    }
+
+    /* Initialize, take ownership of CLK_HF1 */
+    result = cyhal_clock_reserve(&audio_clock, &CYHAL_CLOCK_HF[1]);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Source the audio subsystem clock (CLK_HF1) from PLL0/PLL */
+    result = cyhal_clock_set_source(&audio_clock, &clock_pll);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Set the divider for audio subsystem clock (CLK_HF1) */
+    result = cyhal_clock_set_divider(&audio_clock, 1);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* If the audio subsystem clock (CLK_HF1) is not already enabled, enable it */
+    if (!cyhal_clock_is_enabled(&audio_clock))
+    {
+        result = cyhal_clock_set_enabled(&audio_clock, true, true);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            CY_ASSERT(0);
+        }
+    }
+
+    audio_in_hal_powered = true;
+}
+
+/* [] END OF FILE */
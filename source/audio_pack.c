@@ -0,0 +1,241 @@
+/*****************************************************************************
+* File Name    : audio_pack.c
+*
+* Description  : This file contains the kernels converting captured samples
+*                to the wide formats of the Audio IN endpoint.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_pack.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Samples converted per iteration of the unrolled loops. Four 24-bit samples
+ * fill exactly three 32-bit words once packed.
+ */
+#define AUDIO_PACK_BLOCK_SAMPLES    (4U)
+
+/* Stereo frames averaged per iteration of the unrolled downmix loops. Two
+ * 16-bit frames give one word of mono samples.
+ */
+#define AUDIO_PACK_DOWNMIX_FRAMES   (2U)
+
+/* Mask of a right-aligned 24-bit sample */
+#define AUDIO_PACK_S24_MASK         (0x00FFFFFFUL)
+
+
+/*****************************************************************************
+* Function Name: audio_pack_s24_3
+******************************************************************************
+* Summary:
+*  Pack right-aligned 24-bit samples held in 32-bit words into 3-byte
+*  little-endian samples, in place and in a single pass. The packed samples
+*  never overtake the words still to be read, so no second buffer is needed.
+*
+*  With the DSP extension, four samples are packed into three words with
+*  word stores. The portable version packs one byte at a time.
+*
+* Parameters:
+*  buffer: Samples to pack, packed samples on return
+*  count: Number of samples
+*
+* Return:
+*  uint32_t: Number of bytes of packed samples
+*
+*****************************************************************************/
+uint32_t audio_pack_s24_3(uint32_t *buffer, uint32_t count)
+{
+    uint8_t *out = (uint8_t *) buffer;
+    uint32_t i = 0U;
+    uint32_t sample;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    uint32_t *out_words = buffer;
+    uint32_t w0;
+    uint32_t w1;
+    uint32_t w2;
+    uint32_t w3;
+
+    for (; (i + AUDIO_PACK_BLOCK_SAMPLES) <= count; i += AUDIO_PACK_BLOCK_SAMPLES)
+    {
+        w0 = buffer[i];
+        w1 = buffer[i + 1U];
+        w2 = buffer[i + 2U];
+        w3 = buffer[i + 3U];
+
+        /* | w1[7:0]  w0[23:0] | w2[15:0] w1[23:8] | w3[23:0] w2[23:16] | */
+        *out_words++ = (w0 & AUDIO_PACK_S24_MASK) | (w1 << 24);
+        *out_words++ = __PKHBT((w1 >> 8), w2, 16);
+        *out_words++ = ((w2 >> 16) & 0xFFUL) | (w3 << 8);
+    }
+
+    out = (uint8_t *) out_words;
+#endif /* __ARM_FEATURE_DSP */
+
+    for (; i < count; i++)
+    {
+        sample = buffer[i];
+        *out++ = (uint8_t) sample;
+        *out++ = (uint8_t) (sample >> 8);
+        *out++ = (uint8_t) (sample >> 16);
+    }
+
+    return (count * 3U);
+}
+
+/*****************************************************************************
+* Function Name: audio_pack_s32
+******************************************************************************
+* Summary:
+*  Left-justify right-aligned 24-bit samples held in 32-bit words, in place
+*  and in a single pass. The lowest 8 bits of each sample are zero.
+*
+* Parameters:
+*  buffer: Samples to convert, converted samples on return
+*  count: Number of samples
+*
+* Return:
+*  uint32_t: Number of bytes of converted samples
+*
+*****************************************************************************/
+uint32_t audio_pack_s32(uint32_t *buffer, uint32_t count)
+{
+    uint32_t i = 0U;
+
+    for (; (i + AUDIO_PACK_BLOCK_SAMPLES) <= count; i += AUDIO_PACK_BLOCK_SAMPLES)
+    {
+        buffer[i]      <<= 8;
+        buffer[i + 1U] <<= 8;
+        buffer[i + 2U] <<= 8;
+        buffer[i + 3U] <<= 8;
+    }
+
+    for (; i < count; i++)
+    {
+        buffer[i] <<= 8;
+    }
+
+    return (count * 4U);
+}
+
+/*****************************************************************************
+* Function Name: audio_pack_downmix_s16
+******************************************************************************
+* Summary:
+*  Average the left and right 16-bit samples of each stereo frame into one
+*  mono sample, in place and in a single pass. The mono samples never
+*  overtake the frames still to be read.
+*
+*  With the DSP extension, two frames are regrouped per channel with
+*  halfword packing and averaged by one halving SIMD addition. The portable
+*  version averages one frame at a time. Both round towards minus infinity.
+*
+* Parameters:
+*  buffer: Stereo frames, one per 32-bit word, mono samples on return
+*  frames: Number of frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_pack_downmix_s16(uint32_t *buffer, uint32_t frames)
+{
+    int16_t *out = (int16_t *) buffer;
+    const int16_t *in = (const int16_t *) buffer;
+    uint32_t i = 0U;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    uint32_t *out_words = buffer;
+    uint32_t w0;
+    uint32_t w1;
+
+    for (; (i + AUDIO_PACK_DOWNMIX_FRAMES) <= frames; i += AUDIO_PACK_DOWNMIX_FRAMES)
+    {
+        w0 = buffer[i];
+        w1 = buffer[i + 1U];
+
+        /* | L1 L0 | + | R1 R0 |, halved */
+        *out_words++ = __SHADD16(__PKHBT(w0, w1, 16), __PKHTB(w1, w0, 16));
+    }
+
+    out = (int16_t *) out_words;
+#endif /* __ARM_FEATURE_DSP */
+
+    for (; i < frames; i++)
+    {
+        *out++ = (int16_t) (((int32_t) in[2U * i] + in[(2U * i) + 1U]) >> 1);
+    }
+}
+
+/*****************************************************************************
+* Function Name: audio_pack_downmix_s32
+******************************************************************************
+* Summary:
+*  Average the left and right samples, held in 32-bit words, of each stereo
+*  frame into one mono sample, in place and in a single pass. The samples
+*  have at most 24 significant bits, so their sum cannot overflow.
+*
+* Parameters:
+*  buffer: Stereo frames, two words each, mono samples on return
+*  frames: Number of frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void audio_pack_downmix_s32(uint32_t *buffer, uint32_t frames)
+{
+    int32_t *samples = (int32_t *) buffer;
+    uint32_t i = 0U;
+
+    for (; (i + AUDIO_PACK_DOWNMIX_FRAMES) <= frames; i += AUDIO_PACK_DOWNMIX_FRAMES)
+    {
+        samples[i]      = (samples[2U * i] + samples[(2U * i) + 1U]) >> 1;
+        samples[i + 1U] = (samples[(2U * i) + 2U] + samples[(2U * i) + 3U]) >> 1;
+    }
+
+    for (; i < frames; i++)
+    {
+        samples[i] = (samples[2U * i] + samples[(2U * i) + 1U]) >> 1;
+    }
+}
+
+/* [] END OF FILE */
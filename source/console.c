@@ -0,0 +1,418 @@
+/*****************************************************************************
+* File Name    : console.c
+*
+* Description  : This file contains the debug UART console used to dump the
+*                runtime statistics.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "console.h"
+#include "audio_in.h"
+#include "cycle_counter.h"
+#include "dsp_chain.h"
+#if (DSP_CHAIN_ENABLE_BEAM)
+#include "dsp_beam.h"
+#endif /* DSP_CHAIN_ENABLE_BEAM */
+#if (DSP_CHAIN_ENABLE_AGC)
+#include "dsp_agc.h"
+#endif /* DSP_CHAIN_ENABLE_AGC */
+#if (DSP_CHAIN_ENABLE_VAD)
+#include "dsp_vad.h"
+#endif /* DSP_CHAIN_ENABLE_VAD */
+#if (DSP_CHAIN_ENABLE_LIMITER)
+#include "dsp_limiter.h"
+#endif /* DSP_CHAIN_ENABLE_LIMITER */
+#include "latency_hist.h"
+#include "period_queue.h"
+#include "rtos_stats.h"
+#include "telemetry.h"
+#include "cy_utils.h"
+#include "cy_retarget_io.h"
+
+#include "rtos.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Priority of the RX interrupt of the debug UART */
+#define CONSOLE_UART_INTR_PRIORITY  (7U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    char key;
+    const char *help;
+    void (*handler)(void);
+} console_command_t;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void console_uart_callback(void *callback_arg, cyhal_uart_event_t event);
+static void console_print_help(void);
+static void console_print_dsp(void);
+static void console_print_latency(void);
+static void console_print_queue(void);
+static void console_print_power(void);
+static void console_reset_stats(void);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* RTOS task handle */
+TaskHandle_t rtos_console_task;
+
+/* Memory of the "Console Task" */
+static StackType_t console_task_stack[CONSOLE_TASK_STACK_DEPTH];
+static StaticTask_t console_task_tcb;
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+static const console_command_t console_commands[] =
+{
+    {'d', "Print the CPU cycles of the DSP stages",     console_print_dsp},
+    {'h', "Print this help",                            console_print_help},
+    {'l', "Print the capture-to-USB latency histogram", console_print_latency},
+    {'m', "Print the stack and heap telemetry",         telemetry_print},
+    {'p', "Print the power gating statistics",          console_print_power},
+    {'q', "Print the capture queue statistics",         console_print_queue},
+    {'r', "Reset the statistics",                       console_reset_stats},
+#if (configGENERATE_RUN_TIME_STATS)
+    {'t', "Print the CPU usage of the tasks",           rtos_stats_print},
+#endif /* configGENERATE_RUN_TIME_STATS */
+};
+
+
+/*****************************************************************************
+* Function Name: console_init
+******************************************************************************
+* Summary:
+*  Create the "Console Task" which runs the commands received on the debug
+*  UART.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void console_init(void)
+{
+    rtos_console_task = xTaskCreateStatic(console_task, "Console Task", CONSOLE_TASK_STACK_DEPTH, NULL,
+                                          CONSOLE_TASK_PRIORITY, console_task_stack, &console_task_tcb);
+    if (NULL == rtos_console_task)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: console_task
+******************************************************************************
+* Summary:
+*  Wait for keys on the debug UART and run the command matching each one.
+*  The task sleeps until the RX interrupt of the UART notifies it.
+*
+* Parameters:
+*  arg
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void console_task(void *arg)
+{
+    uint8_t key;
+    uint32_t i;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    cyhal_uart_register_callback(&cy_retarget_io_uart_obj, console_uart_callback, NULL);
+    cyhal_uart_enable_event(&cy_retarget_io_uart_obj, CYHAL_UART_IRQ_RX_NOT_EMPTY, CONSOLE_UART_INTR_PRIORITY, true);
+
+    for (;;)
+    {
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (0U != cyhal_uart_readable(&cy_retarget_io_uart_obj))
+        {
+            if (CY_RSLT_SUCCESS != cyhal_uart_getc(&cy_retarget_io_uart_obj, &key, 0U))
+            {
+                break;
+            }
+
+            for (i = 0U; i < (sizeof(console_commands) / sizeof(console_commands[0])); i++)
+            {
+                if ((char) key == console_commands[i].key)
+                {
+                    console_commands[i].handler();
+                    break;
+                }
+            }
+        }
+
+        /* RX FIFO drained, a key received meanwhile raises the interrupt again */
+        cyhal_uart_enable_event(&cy_retarget_io_uart_obj, CYHAL_UART_IRQ_RX_NOT_EMPTY, CONSOLE_UART_INTR_PRIORITY,
+                                true);
+    }
+}
+
+/*****************************************************************************
+* Function Name: console_uart_callback
+******************************************************************************
+* Summary:
+*  Called in interrupt context when the RX FIFO of the debug UART is not
+*  empty. The interrupt follows the level of the FIFO, so it is disabled
+*  until the "Console Task" has read the keys.
+*
+* Parameters:
+*  callback_arg: Unused
+*  event: Events raised
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_uart_callback(void *callback_arg, cyhal_uart_event_t event)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    CY_UNUSED_PARAMETER(callback_arg);
+
+    if (0U != (event & CYHAL_UART_IRQ_RX_NOT_EMPTY))
+    {
+        cyhal_uart_enable_event(&cy_retarget_io_uart_obj, CYHAL_UART_IRQ_RX_NOT_EMPTY, CONSOLE_UART_INTR_PRIORITY,
+                                false);
+        vTaskNotifyGiveFromISR(rtos_console_task, &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+}
+
+/*****************************************************************************
+* Function Name: console_print_help
+******************************************************************************
+* Summary:
+*  Print the list of commands.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_print_help(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(console_commands) / sizeof(console_commands[0])); i++)
+    {
+        printf("  %c : %s\r\n", console_commands[i].key, console_commands[i].help);
+    }
+}
+
+/*****************************************************************************
+* Function Name: console_print_dsp
+******************************************************************************
+* Summary:
+*  Print the CPU cycles spent by each stage of the DSP chain per period.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_print_dsp(void)
+{
+    dsp_stage_stats_t stats;
+#if (DSP_CHAIN_ENABLE_AGC)
+    dsp_agc_status_t agc;
+#endif /* DSP_CHAIN_ENABLE_AGC */
+#if (DSP_CHAIN_ENABLE_VAD)
+    dsp_vad_stats_t vad;
+#endif /* DSP_CHAIN_ENABLE_VAD */
+    uint32_t avg_cycles;
+    uint32_t i;
+
+    printf("DSP chain: %lu stages, %lu frames of latency\r\n", (unsigned long) dsp_chain_get_num_stages(),
+           (unsigned long) dsp_chain_get_latency());
+
+    for (i = 0U; i < dsp_chain_get_num_stages(); i++)
+    {
+        taskENTER_CRITICAL();
+        dsp_chain_get_stats(i, &stats);
+        taskEXIT_CRITICAL();
+
+        avg_cycles = (0U != stats.calls) ? (uint32_t) (stats.total_cycles / stats.calls) : 0U;
+        printf("  %-12s avg %6lu cycles, max %6lu cycles (%lu us), %lu periods\r\n", stats.name,
+               (unsigned long) avg_cycles, (unsigned long) stats.max_cycles,
+               (unsigned long) cycle_counter_to_us(stats.max_cycles), (unsigned long) stats.calls);
+    }
+
+#if (DSP_CHAIN_ENABLE_BEAM)
+    printf("  Beam steered to %ld degrees\r\n", (long) dsp_beam_get_angle());
+#endif /* DSP_CHAIN_ENABLE_BEAM */
+#if (DSP_CHAIN_ENABLE_AGC)
+    dsp_agc_get_status(&agc);
+    printf("  AGC gain %ld/256 dB, last period RMS %ld/256 dBFS, peak %ld/256 dBFS\r\n",
+           (long) agc.gain, (long) agc.rms, (long) agc.peak);
+#endif /* DSP_CHAIN_ENABLE_AGC */
+#if (DSP_CHAIN_ENABLE_VAD)
+    taskENTER_CRITICAL();
+    dsp_vad_get_stats(&vad);
+    taskEXIT_CRITICAL();
+    printf("  VAD %s: %lu onsets, speech in %lu of %lu periods, energy %lu, noise floor %lu\r\n",
+           vad.speech ? "speech" : "no speech", (unsigned long) vad.onsets, (unsigned long) vad.speech_periods,
+           (unsigned long) vad.periods, (unsigned long) vad.energy, (unsigned long) vad.noise);
+#endif /* DSP_CHAIN_ENABLE_VAD */
+#if (DSP_CHAIN_ENABLE_LIMITER)
+    printf("  Limiter lowest gain: %lu/32768\r\n", (unsigned long) dsp_limiter_get_min_gain());
+#endif /* DSP_CHAIN_ENABLE_LIMITER */
+}
+
+/*****************************************************************************
+* Function Name: console_print_latency
+******************************************************************************
+* Summary:
+*  Print the histogram of the time spent by the periods between their
+*  capture and their hand-off to the Audio IN endpoint.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_print_latency(void)
+{
+    static latency_hist_t hist;
+
+    audio_in_get_latency(&hist);
+    latency_hist_print(&hist, "Capture to USB latency");
+}
+
+/*****************************************************************************
+* Function Name: console_print_queue
+******************************************************************************
+* Summary:
+*  Print the fill level statistics of the capture queue.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_print_queue(void)
+{
+    static period_queue_stats_t stats;
+    uint32_t level;
+
+    audio_in_get_queue_stats(&stats);
+
+    printf("Capture queue: level %lu, peak %lu, produced %lu, overruns %lu, underruns %lu\r\n",
+           (unsigned long) stats.level, (unsigned long) stats.peak_level, (unsigned long) stats.produced,
+           (unsigned long) stats.overruns, (unsigned long) stats.underruns);
+
+    for (level = 0U; level < PERIOD_QUEUE_DEPTH; level++)
+    {
+        printf("  level %lu : %lu\r\n", (unsigned long) level, (unsigned long) stats.level_counts[level]);
+    }
+}
+
+/*****************************************************************************
+* Function Name: console_print_power
+******************************************************************************
+* Summary:
+*  Print the time spent capturing and powered down, and the time taken by
+*  the capture to deliver valid audio after it starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_print_power(void)
+{
+    audio_in_power_stats_t stats;
+
+    audio_in_get_power_stats(&stats);
+
+    printf("Capture %s: active %lu ms, idle %lu ms\r\n", stats.capturing ? "on" : "off",
+           (unsigned long) stats.active_ms, (unsigned long) stats.idle_ms);
+    printf("Resumes %lu: last %lu us, max %lu us\r\n", (unsigned long) stats.resumes,
+           (unsigned long) stats.last_resume_us, (unsigned long) stats.max_resume_us);
+    printf("Captures stopped on silence: %lu\r\n", (unsigned long) stats.vad_gates);
+}
+
+/*****************************************************************************
+* Function Name: console_reset_stats
+******************************************************************************
+* Summary:
+*  Reset the latency histogram, the capture queue statistics, the longest
+*  capture resume and the longest run of the tasks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void console_reset_stats(void)
+{
+    audio_in_reset_stats();
+#if (configGENERATE_RUN_TIME_STATS)
+    rtos_stats_reset();
+#endif /* configGENERATE_RUN_TIME_STATS */
+    printf("Statistics reset\r\n");
+}
+
+/* [] END OF FILE */
@@ -61,28 +61,116 @@ const USB_DEVICE_INFO usb_deviceInfo =
 /* When changing these values check
 *  https://wiki.segger.com/USB_Audio#Audio_class_issues_on_Windows
 *
-*  Also update MAX_AUDIO_IN_PACKET_SIZE_BYTES accordingly.
+*  Also update AUDIO_IN_MAX_SAMPLE_FREQ and AUDIO_IN_MAX_SUB_FRAME_SIZE
+*  accordingly.
+*
+*  Each format is exposed as an alternate setting of the microphone
+*  interface (alternate setting 1 is the first format).
+*
+*  The mono formats at the end are the alternate settings of the mono
+*  interface (alternate setting 1 is its first format), whose terminal has a
+*  single Center Front channel. Its Audio IN endpoint is sized for them, so
+*  a mono stream reserves 98 bytes per frame of the bus instead of 776. Their
+*  layout is in microphone_layouts[].
+*/
+const USBD_AUDIO_FORMAT microphone_formats[AUDIO_IN_NUM_FORMATS] =
+{
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_8KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_16KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_22KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_32KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_44KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_48KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_96KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE_24BIT, AUDIO_IN_BIT_RESOLUTION_24BIT, AUDIO_SAMPLING_RATE_44KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE_24BIT, AUDIO_IN_BIT_RESOLUTION_24BIT, AUDIO_SAMPLING_RATE_48KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE_24BIT, AUDIO_IN_BIT_RESOLUTION_24BIT, AUDIO_SAMPLING_RATE_96KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE_32BIT, AUDIO_IN_BIT_RESOLUTION_32BIT, AUDIO_SAMPLING_RATE_44KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE_32BIT, AUDIO_IN_BIT_RESOLUTION_32BIT, AUDIO_SAMPLING_RATE_48KHZ},
+    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE_32BIT, AUDIO_IN_BIT_RESOLUTION_32BIT, AUDIO_SAMPLING_RATE_96KHZ},
+#if (AUDIO_IN_MONO_INTERFACE)
+    {0, 1U, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_16KHZ},
+    {0, 1U, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_48KHZ},
+    {0, 1U, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_16KHZ},
+    {0, 1U, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_48KHZ},
+    {0, 1U, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_16KHZ},
+    {0, 1U, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_SAMPLING_RATE_48KHZ},
+#endif /* AUDIO_IN_MONO_INTERFACE */
+};
+
+/* Microphones sent in each format of microphone_formats[]. With the
+*  beamformer, the DSP chain combines both microphones in every format.
 */
-static const USBD_AUDIO_FORMAT microphone_formats[] =
+const uint8_t microphone_layouts[AUDIO_IN_NUM_FORMATS] =
 {
-    {0, AUDIO_IN_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SAMPLE_FREQ},
+    AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO,
+    AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO,
+    AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO,
+    AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO, AUDIO_IN_LAYOUT_STEREO,
+#if (AUDIO_IN_MONO_INTERFACE)
+    AUDIO_IN_LAYOUT_LEFT, AUDIO_IN_LAYOUT_LEFT,
+    AUDIO_IN_LAYOUT_RIGHT, AUDIO_IN_LAYOUT_RIGHT,
+    AUDIO_IN_LAYOUT_DOWNMIX, AUDIO_IN_LAYOUT_DOWNMIX,
+#endif /* AUDIO_IN_MONO_INTERFACE */
 };
 
 static USBD_AUDIO_UNITS microphone_units;
 
-const USBD_AUDIO_IF_CONF audio_interfaces[] =
+#if (AUDIO_IN_MONO_INTERFACE)
+static USBD_AUDIO_UNITS microphone_mono_units;
+#endif /* AUDIO_IN_MONO_INTERFACE */
+
+#if (AUDIO_IN_SECOND_STREAM)
+/* Single format of the second stream, decimated on the device from the
+*  capture of the microphone interface
+*/
+static const USBD_AUDIO_FORMAT microphone_second_formats[] =
+{
+    {0, AUDIO_IN_SECOND_NUM_CHANNELS, AUDIO_IN_SUB_FRAME_SIZE, AUDIO_IN_BIT_RESOLUTION, AUDIO_IN_SECOND_SAMPLE_FREQ},
+};
+
+static USBD_AUDIO_UNITS microphone_second_units;
+#endif /* AUDIO_IN_SECOND_STREAM */
+
+const USBD_AUDIO_IF_CONF audio_interfaces[USB_NUM_AUDIO_INTERFACES] =
 {
     /* Microphone config. */
     {
         0,                                  /* Flags */
         0x03,                               /* Controls */
-        2,                                  /* TotalNrChannels */
-        SEGGER_COUNTOF(microphone_formats), /* NumFormats */
+        AUDIO_IN_NUM_CHANNELS,              /* TotalNrChannels */
+        AUDIO_IN_NUM_MIC_FORMATS,           /* NumFormats */
         microphone_formats,                 /* paFormats */
-        0x0003,                             /* bmChannelConfig (0x3: Left Front, Right Front) */
+        AUDIO_IN_CHANNEL_CONFIG,            /* bmChannelConfig */
         USB_AUDIO_TERMTYPE_INPUT_MICROPHONE,/* TerminalType */
         &microphone_units                   /* pUnits */
-    }
+    },
+#if (AUDIO_IN_MONO_INTERFACE)
+    /* Mono config, same controls as the microphone */
+    {
+        0,                                  /* Flags */
+        0x03,                               /* Controls */
+        AUDIO_IN_MONO_NUM_CHANNELS,         /* TotalNrChannels */
+        AUDIO_IN_NUM_MONO_FORMATS,          /* NumFormats */
+        &microphone_formats[AUDIO_IN_NUM_MIC_FORMATS], /* paFormats */
+        AUDIO_IN_MONO_CHANNEL_CONFIG,       /* bmChannelConfig */
+        USB_AUDIO_TERMTYPE_INPUT_MICROPHONE,/* TerminalType */
+        &microphone_mono_units              /* pUnits */
+    },
+#endif /* AUDIO_IN_MONO_INTERFACE */
+#if (AUDIO_IN_SECOND_STREAM)
+    /* Second stream config, mute control only */
+    {
+        0,                                  /* Flags */
+        0x01,                               /* Controls */
+        AUDIO_IN_SECOND_NUM_CHANNELS,       /* TotalNrChannels */
+        SEGGER_COUNTOF(microphone_second_formats), /* NumFormats */
+        microphone_second_formats,          /* paFormats */
+        AUDIO_IN_SECOND_CHANNEL_CONFIG,     /* bmChannelConfig */
+        USB_AUDIO_TERMTYPE_INPUT_MICROPHONE,/* TerminalType */
+        &microphone_second_units            /* pUnits */
+    },
+#endif /* AUDIO_IN_SECOND_STREAM */
 };
 
 /* [] END OF FILE */
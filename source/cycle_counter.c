@@ -0,0 +1,110 @@
+/*****************************************************************************
+* File Name    : cycle_counter.c
+*
+* Description  : This file contains the access to the CPU cycle counter used
+*                for the timing measurements.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "cycle_counter.h"
+#include "cy_pdl.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define CYCLE_COUNTER_HZ_PER_MHZ    (1000000U)
+
+
+/*****************************************************************************
+* Function Name: cycle_counter_init
+******************************************************************************
+* Summary:
+*  Enable the DWT cycle counter of the CPU. The counter runs at the CPU clock
+*  and wraps around every 2^32 cycles (about 28 s at 150 MHz).
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void cycle_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*****************************************************************************
+* Function Name: cycle_counter_get
+******************************************************************************
+* Summary:
+*  Get the current value of the cycle counter. The difference of two values
+*  is the number of CPU cycles elapsed in between, as long as it is below
+*  2^32 cycles.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Cycle counter
+*
+*****************************************************************************/
+uint32_t cycle_counter_get(void)
+{
+    return DWT->CYCCNT;
+}
+
+/*****************************************************************************
+* Function Name: cycle_counter_to_us
+******************************************************************************
+* Summary:
+*  Convert a number of CPU cycles to microseconds.
+*
+* Parameters:
+*  cycles: Number of CPU cycles
+*
+* Return:
+*  uint32_t: Number of microseconds, rounded down
+*
+*****************************************************************************/
+uint32_t cycle_counter_to_us(uint32_t cycles)
+{
+    return (cycles / (SystemCoreClock / CYCLE_COUNTER_HZ_PER_MHZ));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,324 @@
+/*****************************************************************************
+* File Name    : dsp_agc.c
+*
+* Description  : This file contains the automatic gain control stage of the DSP
+*                chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_agc.h"
+
+#if defined(__ARM_ARCH)
+#include "cmsis_compiler.h"
+#else
+#define __CLZ(value)                    ((uint8_t) __builtin_clz(value))
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Fractional bits of the smoothed gain below 1/256 dB */
+#define DSP_AGC_GAIN_FRAC               (8U)
+
+/* dB per octave of power and of amplitude, in 1/256 dB */
+#define DSP_AGC_DB_PER_OCTAVE_POWER     (771)
+#define DSP_AGC_DB_PER_OCTAVE_AMPLITUDE (1541)
+
+/* log2 of the full scale of the mean square and of the peak (16-bit) */
+#define DSP_AGC_FULL_SCALE_POWER_LOG2   (30)
+#define DSP_AGC_FULL_SCALE_PEAK_LOG2    (15)
+
+/* Level of an empty period */
+#define DSP_AGC_LEVEL_SILENCE           (-120 * 256)
+
+/* Bits of the mantissa looked up in dsp_agc_log2_frac[] */
+#define DSP_AGC_LOG2_BITS               (5U)
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static int32_t dsp_agc_log2(uint32_t value);
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+/* log2(1 + k/32), Q8 */
+static const uint8_t dsp_agc_log2_frac[1U << DSP_AGC_LOG2_BITS] =
+{
+      0U,  11U,  22U,  33U,  44U,  54U,  63U,  73U,  82U,  92U, 100U, 109U, 118U, 126U, 134U, 142U,
+    150U, 157U, 165U, 172U, 179U, 186U, 193U, 200U, 207U, 213U, 220U, 226U, 232U, 238U, 244U, 250U
+};
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Smoothed gain, 1/256 dB with DSP_AGC_GAIN_FRAC more fractional bits */
+static int32_t dsp_agc_gain = (int32_t) (DSP_AGC_GAIN_INITIAL) << DSP_AGC_GAIN_FRAC;
+
+/* Gain reported, rounded to DSP_AGC_GAIN_RES */
+static volatile int32_t dsp_agc_gain_out = DSP_AGC_GAIN_INITIAL;
+
+/* Gain applied by the capture path to the next period */
+static int32_t dsp_agc_period_gain = DSP_AGC_GAIN_INITIAL;
+
+/* Levels of the last period */
+static volatile int32_t dsp_agc_rms = DSP_AGC_LEVEL_SILENCE;
+static volatile int32_t dsp_agc_peak = DSP_AGC_LEVEL_SILENCE;
+
+
+/*****************************************************************************
+* Function Name: dsp_agc_reset
+******************************************************************************
+* Summary:
+*  Start a new stream from the initial gain.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_agc_reset(void)
+{
+    dsp_agc_gain = (int32_t) (DSP_AGC_GAIN_INITIAL) << DSP_AGC_GAIN_FRAC;
+    dsp_agc_gain_out = DSP_AGC_GAIN_INITIAL;
+    dsp_agc_period_gain = DSP_AGC_GAIN_INITIAL;
+    dsp_agc_rms = DSP_AGC_LEVEL_SILENCE;
+    dsp_agc_peak = DSP_AGC_LEVEL_SILENCE;
+}
+
+/*****************************************************************************
+* Function Name: dsp_agc_get_gain
+******************************************************************************
+* Summary:
+*  Get the gain computed by the AGC, to be applied by the capture path
+*  (gain of the PDM/PCM block and gain stage).
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int32_t: Gain in 1/256 dB, multiple of DSP_AGC_GAIN_RES
+*
+*****************************************************************************/
+int32_t dsp_agc_get_gain(void)
+{
+    return dsp_agc_gain_out;
+}
+
+/*****************************************************************************
+* Function Name: dsp_agc_set_period_gain
+******************************************************************************
+* Summary:
+*  Set the gain the capture path applied to the next period processed. The
+*  gain computed by the AGC reaches the samples one or more periods later,
+*  in steps, so the levels before the gain are taken from the gain actually
+*  applied. Must be called from the context running dsp_chain_process().
+*
+* Parameters:
+*  gain: Gain applied to the period, in 1/256 dB
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_agc_set_period_gain(int32_t gain)
+{
+    dsp_agc_period_gain = gain;
+}
+
+/*****************************************************************************
+* Function Name: dsp_agc_get_status
+******************************************************************************
+* Summary:
+*  Get the levels of the last period and the gain of the AGC.
+*
+* Parameters:
+*  status: Levels and gain, in 1/256 dB
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_agc_get_status(dsp_agc_status_t *status)
+{
+    status->rms = dsp_agc_rms;
+    status->peak = dsp_agc_peak;
+    status->gain = dsp_agc_gain >> DSP_AGC_GAIN_FRAC;
+}
+
+/*****************************************************************************
+* Function Name: dsp_agc_process
+******************************************************************************
+* Summary:
+*  Measure the RMS and peak levels of a period and update the gain. The
+*  samples are not modified: the gain is applied by the capture path to the
+*  next periods, so the levels measured include the gain set with
+*  dsp_agc_set_period_gain().
+*
+*  The gain moves towards the gain bringing the RMS level to
+*  DSP_AGC_TARGET_RMS without pushing the peak level above
+*  DSP_AGC_MAX_PEAK, quickly when it goes down (attack) and slowly when it
+*  goes up (release). It is held during background noise. The cost is one
+*  multiply-accumulate per sample and two table lookups per period.
+*
+* Parameters:
+*  block: Block of samples
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_agc_process(dsp_block_t *block)
+{
+    uint32_t count = block->frames * block->channels;
+    uint64_t sum = 0U;
+    uint32_t peak = 0U;
+    uint32_t level;
+    int32_t x;
+    int32_t rms_db;
+    int32_t peak_db;
+    int32_t gain_db;
+    int32_t target;
+    int32_t i;
+
+    if (0U == count)
+    {
+        return;
+    }
+
+    /* Mean square and peak, on the 16-bit scale */
+    if (sizeof(int16_t) == block->sample_size)
+    {
+        const int16_t *samples = (const int16_t *) block->samples;
+
+        for (i = 0; i < (int32_t) count; i++)
+        {
+            x = samples[i];
+            sum += (uint32_t) (x * x);
+            level = (uint32_t) ((x < 0) ? -x : x);
+            peak = (level > peak) ? level : peak;
+        }
+    }
+    else
+    {
+        const int32_t *samples = (const int32_t *) block->samples;
+
+        for (i = 0; i < (int32_t) count; i++)
+        {
+            x = samples[i] >> 8;
+            sum += (uint32_t) (x * x);
+            level = (uint32_t) ((x < 0) ? -x : x);
+            peak = (level > peak) ? level : peak;
+        }
+    }
+
+    rms_db = (((dsp_agc_log2((uint32_t) (sum / count)) - ((DSP_AGC_FULL_SCALE_POWER_LOG2) << 8))
+               * (DSP_AGC_DB_PER_OCTAVE_POWER)) >> 8);
+    peak_db = (((dsp_agc_log2(peak) - ((DSP_AGC_FULL_SCALE_PEAK_LOG2) << 8))
+                * (DSP_AGC_DB_PER_OCTAVE_AMPLITUDE)) >> 8);
+    dsp_agc_rms = rms_db;
+    dsp_agc_peak = peak_db;
+
+    gain_db = dsp_agc_period_gain;
+
+    /* Hold the gain on background noise */
+    if ((rms_db - gain_db) < (DSP_AGC_GATE_RMS))
+    {
+        return;
+    }
+
+    /* Gain bringing the RMS to the target, without exceeding the peak */
+    target = gain_db + ((DSP_AGC_TARGET_RMS) - rms_db);
+    if (target > (gain_db + ((DSP_AGC_MAX_PEAK) - peak_db)))
+    {
+        target = gain_db + ((DSP_AGC_MAX_PEAK) - peak_db);
+    }
+    target = (target < (DSP_AGC_GAIN_MIN)) ? (DSP_AGC_GAIN_MIN) : target;
+    target = (target > (DSP_AGC_GAIN_MAX)) ? (DSP_AGC_GAIN_MAX) : target;
+    target <<= DSP_AGC_GAIN_FRAC;
+
+    if (target < dsp_agc_gain)
+    {
+        dsp_agc_gain -= (dsp_agc_gain - target) >> (DSP_AGC_ATTACK_SHIFT);
+    }
+    else
+    {
+        dsp_agc_gain += (target - dsp_agc_gain) >> (DSP_AGC_RELEASE_SHIFT);
+    }
+
+    /* Report the gain rounded to its resolution, down when in between */
+    gain_db = dsp_agc_gain >> DSP_AGC_GAIN_FRAC;
+    gain_db = (gain_db >= 0) ? ((gain_db / (DSP_AGC_GAIN_RES)) * (DSP_AGC_GAIN_RES))
+                             : -(((-gain_db + (DSP_AGC_GAIN_RES) - 1) / (DSP_AGC_GAIN_RES)) * (DSP_AGC_GAIN_RES));
+    dsp_agc_gain_out = gain_db;
+}
+
+/*****************************************************************************
+* Function Name: dsp_agc_log2
+******************************************************************************
+* Summary:
+*  Compute the base-2 logarithm of an integer, with a count of leading
+*  zeros for the integer part and a table lookup on the 5 bits following
+*  the leading one for the fractional part (error below 0.05).
+*
+* Parameters:
+*  value: Value
+*
+* Return:
+*  int32_t: log2(value), Q8. Very low for 0.
+*
+*****************************************************************************/
+static int32_t dsp_agc_log2(uint32_t value)
+{
+    uint32_t zeros;
+
+    if (0U == value)
+    {
+        return -(32 << 8);
+    }
+
+    zeros = __CLZ(value);
+    value <<= zeros;
+
+    return ((31 - (int32_t) zeros) << 8) + dsp_agc_log2_frac[(value >> (31U - (DSP_AGC_LOG2_BITS))) & ((1UL << (DSP_AGC_LOG2_BITS)) - 1U)];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,330 @@
+/*****************************************************************************
+* File Name    : dsp_beam.c
+*
+* Description  : This file contains the delay-and-sum beamformer stage of the
+*                DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_beam.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define DSP_BEAM_PI                     (3.14159265358979f)
+#define DSP_BEAM_MASK                   ((DSP_BEAM_HISTORY) - 1U)
+#define DSP_BEAM_TAPS                   (4U)
+#define DSP_BEAM_CHANNELS               (2U)
+
+#define DSP_BEAM_INT16_MAX              (32767L)
+#define DSP_BEAM_INT16_MIN              (-32768L)
+#define DSP_BEAM_INT24_MAX              (8388607L)
+#define DSP_BEAM_INT24_MIN              (-8388608L)
+
+/* Orders the writes of the pending steering against the flag handing it
+ * over. The DSP chain preempts the task steering the beam on the same core,
+ * so the compiler must not move them across the flag.
+ */
+#if defined(__ARM_ARCH)
+#define DSP_BEAM_BARRIER()              __COMPILER_BARRIER()
+#else
+#define DSP_BEAM_BARRIER()              __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#if ((DSP_BEAM_HISTORY & DSP_BEAM_MASK) != 0U)
+#error "DSP_BEAM_HISTORY must be a power of two."
+#endif
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/* Steering of the beam: the microphone the sound reaches first is delayed
+ * by base + 1 + fraction samples, with a 4-tap Lagrange interpolator; the
+ * other one by 1 sample.
+ */
+typedef struct
+{
+    int16_t coefs[DSP_BEAM_TAPS];   /* Q14, applied to x[n - base - k] */
+    uint32_t base;
+    uint32_t lead;                  /* Channel delayed by the interpolator */
+} dsp_beam_steer_t;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void dsp_beam_design(int32_t degrees, uint32_t sample_rate, dsp_beam_steer_t *steer);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static int32_t dsp_beam_angle = DSP_BEAM_ANGLE_DEG;
+static uint32_t dsp_beam_sample_rate = 48000U;
+
+/* Steering in use, and steering waiting for the next block */
+static dsp_beam_steer_t dsp_beam_active;
+static dsp_beam_steer_t dsp_beam_pending;
+static volatile bool dsp_beam_pending_ready = false;
+
+/* Last samples of each microphone */
+static int32_t dsp_beam_history[DSP_BEAM_CHANNELS][DSP_BEAM_HISTORY];
+static uint32_t dsp_beam_index = 0U;
+
+
+/*****************************************************************************
+* Function Name: dsp_beam_configure
+******************************************************************************
+* Summary:
+*  Compute the steering delay for a new sample rate.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_beam_configure(uint32_t sample_rate)
+{
+    dsp_beam_sample_rate = sample_rate;
+    dsp_beam_pending_ready = false;
+    dsp_beam_design(dsp_beam_angle, sample_rate, &dsp_beam_active);
+    dsp_beam_reset();
+}
+
+/*****************************************************************************
+* Function Name: dsp_beam_reset
+******************************************************************************
+* Summary:
+*  Clear the past samples of the microphones.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_beam_reset(void)
+{
+    memset(dsp_beam_history, 0, sizeof(dsp_beam_history));
+    dsp_beam_index = 0U;
+}
+
+/*****************************************************************************
+* Function Name: dsp_beam_set_angle
+******************************************************************************
+* Summary:
+*  Steer the beam towards a new direction, from the next block. Must be
+*  called from a task of lower priority than the one running the DSP chain.
+*
+* Parameters:
+*  degrees: Direction, from -90 (right microphone) to +90 (left microphone)
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_beam_set_angle(int32_t degrees)
+{
+    degrees = (degrees > 90) ? 90 : degrees;
+    degrees = (degrees < -90) ? -90 : degrees;
+
+    dsp_beam_pending_ready = false;
+    DSP_BEAM_BARRIER();
+    dsp_beam_angle = degrees;
+    dsp_beam_design(degrees, dsp_beam_sample_rate, &dsp_beam_pending);
+    DSP_BEAM_BARRIER();
+    dsp_beam_pending_ready = true;
+}
+
+/*****************************************************************************
+* Function Name: dsp_beam_get_angle
+******************************************************************************
+* Summary:
+*  Get the direction the beam is steered to.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int32_t: Direction in degrees
+*
+*****************************************************************************/
+int32_t dsp_beam_get_angle(void)
+{
+    return dsp_beam_angle;
+}
+
+/*****************************************************************************
+* Function Name: dsp_beam_process
+******************************************************************************
+* Summary:
+*  Combine the two microphones of a block into one channel, in place: the
+*  microphone the sound of the steered direction reaches first is delayed
+*  by the travel time between the microphones, and both are averaged. The
+*  sound of that direction adds in phase, the diffuse noise does not. The
+*  block holds one channel on return.
+*
+*  The fractional part of the delay is interpolated with a 4-tap Lagrange
+*  filter: 4 multiply-accumulates per frame.
+*
+* Parameters:
+*  block: Block of stereo samples, mono samples on return
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_beam_process(dsp_block_t *block)
+{
+    const dsp_beam_steer_t *steer;
+    const int32_t *lead;
+    const int32_t *other;
+    uint32_t index = dsp_beam_index;
+    uint32_t base;
+    uint32_t frame;
+    int64_t acc;
+    int64_t y;
+    bool wide = (sizeof(int16_t) != block->sample_size);
+
+    if (dsp_beam_pending_ready)
+    {
+        DSP_BEAM_BARRIER();
+        dsp_beam_active = dsp_beam_pending;
+        dsp_beam_pending_ready = false;
+    }
+
+    if ((DSP_BEAM_CHANNELS) != block->channels)
+    {
+        return;
+    }
+
+    steer = &dsp_beam_active;
+    base = steer->base;
+    lead = dsp_beam_history[steer->lead];
+    other = dsp_beam_history[1U - steer->lead];
+
+    for (frame = 0U; frame < block->frames; frame++)
+    {
+        /* The mono sample of a frame is written at or before the frame */
+        if (wide)
+        {
+            dsp_beam_history[0][index] = ((int32_t *) block->samples)[2U * frame];
+            dsp_beam_history[1][index] = ((int32_t *) block->samples)[(2U * frame) + 1U];
+        }
+        else
+        {
+            dsp_beam_history[0][index] = ((int16_t *) block->samples)[2U * frame];
+            dsp_beam_history[1][index] = ((int16_t *) block->samples)[(2U * frame) + 1U];
+        }
+
+        /* Half of the sum of both microphones, aligned */
+        acc = ((int64_t) other[(index - 1U) & (DSP_BEAM_MASK)] << DSP_BEAM_Q)
+            + ((int64_t) steer->coefs[0] * lead[(index - base) & (DSP_BEAM_MASK)])
+            + ((int64_t) steer->coefs[1] * lead[(index - base - 1U) & (DSP_BEAM_MASK)])
+            + ((int64_t) steer->coefs[2] * lead[(index - base - 2U) & (DSP_BEAM_MASK)])
+            + ((int64_t) steer->coefs[3] * lead[(index - base - 3U) & (DSP_BEAM_MASK)]);
+        y = acc >> ((DSP_BEAM_Q) + 1U);
+
+        if (wide)
+        {
+            y = (y > (DSP_BEAM_INT24_MAX)) ? (DSP_BEAM_INT24_MAX) : y;
+            y = (y < (DSP_BEAM_INT24_MIN)) ? (DSP_BEAM_INT24_MIN) : y;
+            ((int32_t *) block->samples)[frame] = (int32_t) y;
+        }
+        else
+        {
+            y = (y > (DSP_BEAM_INT16_MAX)) ? (DSP_BEAM_INT16_MAX) : y;
+            y = (y < (DSP_BEAM_INT16_MIN)) ? (DSP_BEAM_INT16_MIN) : y;
+            ((int16_t *) block->samples)[frame] = (int16_t) y;
+        }
+
+        index = (index + 1U) & (DSP_BEAM_MASK);
+    }
+
+    dsp_beam_index = index;
+    block->channels = 1U;
+}
+
+/*****************************************************************************
+* Function Name: dsp_beam_design
+******************************************************************************
+* Summary:
+*  Compute the delay between the microphones for a direction, and the
+*  coefficients of the Lagrange interpolator for its fractional part.
+*
+* Parameters:
+*  degrees: Direction of the beam
+*  sample_rate: Sample rate in Hz
+*  steer: Steering computed
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_beam_design(int32_t degrees, uint32_t sample_rate, dsp_beam_steer_t *steer)
+{
+    float delay = ((float) (DSP_BEAM_MIC_SPACING_MM) / 1000.0f) * sinf(((float) degrees * DSP_BEAM_PI) / 180.0f)
+                  * (float) sample_rate / (DSP_BEAM_SPEED_OF_SOUND);
+    float d;
+    float max_delay = (float) ((DSP_BEAM_HISTORY) - (DSP_BEAM_TAPS));
+
+    steer->lead = (delay >= 0.0f) ? 0U : 1U;
+    delay = fabsf(delay);
+    delay = (delay > max_delay) ? max_delay : delay;
+
+    /* Taps x[n - base - k], k = 0..3, delay of 1 + fraction from the first */
+    steer->base = (uint32_t) delay;
+    d = 1.0f + (delay - (float) steer->base);
+
+    steer->coefs[0] = (int16_t) lrintf((-(d - 1.0f) * (d - 2.0f) * (d - 3.0f) / 6.0f) * (float) (1UL << DSP_BEAM_Q));
+    steer->coefs[1] = (int16_t) lrintf((d * (d - 2.0f) * (d - 3.0f) / 2.0f) * (float) (1UL << DSP_BEAM_Q));
+    steer->coefs[2] = (int16_t) lrintf((-d * (d - 1.0f) * (d - 3.0f) / 2.0f) * (float) (1UL << DSP_BEAM_Q));
+    steer->coefs[3] = (int16_t) lrintf((d * (d - 1.0f) * (d - 2.0f) / 6.0f) * (float) (1UL << DSP_BEAM_Q));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,356 @@
+/*****************************************************************************
+* File Name    : dsp_chain.c
+*
+* Description  : This file contains the chain of processing stages run on each
+*                captured period before it is sent to the host.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_chain.h"
+#include "cycle_counter.h"
+
+#if (DSP_CHAIN_ENABLE_SRC)
+#include "dsp_src.h"
+#endif /* DSP_CHAIN_ENABLE_SRC */
+#if (DSP_CHAIN_ENABLE_BEAM)
+#include "dsp_beam.h"
+#endif /* DSP_CHAIN_ENABLE_BEAM */
+#if (DSP_CHAIN_ENABLE_DC_BLOCK)
+#include "dsp_dc_block.h"
+#endif /* DSP_CHAIN_ENABLE_DC_BLOCK */
+#if (DSP_CHAIN_ENABLE_EQ)
+#include "dsp_eq.h"
+#endif /* DSP_CHAIN_ENABLE_EQ */
+#if (DSP_CHAIN_ENABLE_GAIN)
+#include "dsp_gain.h"
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+#if (DSP_CHAIN_ENABLE_AGC)
+#include "dsp_agc.h"
+#endif /* DSP_CHAIN_ENABLE_AGC */
+#if (DSP_CHAIN_ENABLE_VAD)
+#include "dsp_vad.h"
+#endif /* DSP_CHAIN_ENABLE_VAD */
+#if (DSP_CHAIN_ENABLE_LIMITER)
+#include "dsp_limiter.h"
+#endif /* DSP_CHAIN_ENABLE_LIMITER */
+
+#include <string.h>
+
+
+#if (DSP_CHAIN_NUM_STAGES > 0)
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+/* Stages of the chain, in processing order */
+static const dsp_stage_t dsp_chain_stages[DSP_CHAIN_NUM_STAGES] =
+{
+#if (DSP_CHAIN_ENABLE_SRC)
+    {"SRC",         dsp_src_configure,      dsp_src_reset,      dsp_src_process,        0U},
+#endif /* DSP_CHAIN_ENABLE_SRC */
+#if (DSP_CHAIN_ENABLE_BEAM)
+    {"Beamformer",  dsp_beam_configure,     dsp_beam_reset,     dsp_beam_process,       DSP_BEAM_LATENCY},
+#endif /* DSP_CHAIN_ENABLE_BEAM */
+#if (DSP_CHAIN_ENABLE_DC_BLOCK)
+    {"DC block",    dsp_dc_block_configure, dsp_dc_block_reset, dsp_dc_block_process,   0U},
+#endif /* DSP_CHAIN_ENABLE_DC_BLOCK */
+#if (DSP_CHAIN_ENABLE_EQ)
+    {"EQ",          dsp_eq_configure,       dsp_eq_reset,       dsp_eq_process,         0U},
+#endif /* DSP_CHAIN_ENABLE_EQ */
+#if (DSP_CHAIN_ENABLE_GAIN)
+    {"Gain",        NULL,                   dsp_gain_reset,     dsp_gain_process,       0U},
+#endif /* DSP_CHAIN_ENABLE_GAIN */
+#if (DSP_CHAIN_ENABLE_AGC)
+    {"AGC",         NULL,                   dsp_agc_reset,      dsp_agc_process,        0U},
+#endif /* DSP_CHAIN_ENABLE_AGC */
+#if (DSP_CHAIN_ENABLE_VAD)
+    {"VAD",         NULL,                   dsp_vad_reset,      dsp_vad_process,        0U},
+#endif /* DSP_CHAIN_ENABLE_VAD */
+#if (DSP_CHAIN_ENABLE_LIMITER)
+    {"Limiter",     dsp_limiter_configure,  dsp_limiter_reset,  dsp_limiter_process,    DSP_LIMITER_LOOKAHEAD_FRAMES},
+#endif /* DSP_CHAIN_ENABLE_LIMITER */
+};
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* CPU cycles spent by each stage */
+static dsp_stage_stats_t dsp_chain_stats[DSP_CHAIN_NUM_STAGES];
+#endif /* DSP_CHAIN_NUM_STAGES */
+
+
+/*****************************************************************************
+* Function Name: dsp_chain_configure
+******************************************************************************
+* Summary:
+*  Configure the stages for a new sample rate and reset their state.
+*
+* Parameters:
+*  sample_rate: Sample rate sent to the host, in Hz. The blocks are captured
+*               at dsp_src_get_capture_rate() with the converter.
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_chain_configure(uint32_t sample_rate)
+{
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    uint32_t i;
+
+    for (i = 0U; i < (DSP_CHAIN_NUM_STAGES); i++)
+    {
+        if (NULL != dsp_chain_stages[i].configure)
+        {
+            dsp_chain_stages[i].configure(sample_rate);
+        }
+    }
+#else
+    (void) sample_rate;
+#endif /* DSP_CHAIN_NUM_STAGES */
+
+    dsp_chain_reset();
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_reset
+******************************************************************************
+* Summary:
+*  Clear the state (filter memories, envelopes) of the stages before a new
+*  stream, so no audio of the previous stream leaks into it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_chain_reset(void)
+{
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    uint32_t i;
+
+    for (i = 0U; i < (DSP_CHAIN_NUM_STAGES); i++)
+    {
+        if (NULL != dsp_chain_stages[i].reset)
+        {
+            dsp_chain_stages[i].reset();
+        }
+    }
+#endif /* DSP_CHAIN_NUM_STAGES */
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_process
+******************************************************************************
+* Summary:
+*  Run the stages of the chain, in order, on a block of samples. Each stage
+*  processes the block in place. The CPU cycles spent by each stage are
+*  accumulated in its statistics.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_chain_process(dsp_block_t *block)
+{
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    dsp_stage_stats_t *stats;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+
+    for (i = 0U; i < (DSP_CHAIN_NUM_STAGES); i++)
+    {
+        start = cycle_counter_get();
+        dsp_chain_stages[i].process(block);
+        cycles = cycle_counter_get() - start;
+
+        stats = &dsp_chain_stats[i];
+        stats->calls++;
+        stats->last_cycles = cycles;
+        stats->total_cycles += cycles;
+        if (cycles > stats->max_cycles)
+        {
+            stats->max_cycles = cycles;
+        }
+    }
+#else
+    (void) block;
+#endif /* DSP_CHAIN_NUM_STAGES */
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_get_num_stages
+******************************************************************************
+* Summary:
+*  Get the number of stages compiled in the chain.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Number of stages
+*
+*****************************************************************************/
+uint32_t dsp_chain_get_num_stages(void)
+{
+    return (DSP_CHAIN_NUM_STAGES);
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_get_latency
+******************************************************************************
+* Summary:
+*  Get the delay added to the samples by the stages of the chain, e.g. the
+*  look-ahead of the limiter, at the sample rate of the last
+*  dsp_chain_configure(). The delay of the sample rate converter depends on
+*  the rate, so it is not in the table of stages.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Delay in frames
+*
+*****************************************************************************/
+uint32_t dsp_chain_get_latency(void)
+{
+    uint32_t latency = 0U;
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    uint32_t i;
+
+    for (i = 0U; i < (DSP_CHAIN_NUM_STAGES); i++)
+    {
+        latency += dsp_chain_stages[i].latency;
+    }
+#endif /* DSP_CHAIN_NUM_STAGES */
+#if (DSP_CHAIN_ENABLE_SRC)
+    latency += dsp_src_get_latency();
+#endif /* DSP_CHAIN_ENABLE_SRC */
+
+    return latency;
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_get_stage_delay
+******************************************************************************
+* Summary:
+*  Get the delay added to the samples by the stages ahead of a stage, e.g.
+*  to place a change on the frame of the block it reaches that stage. The
+*  delay of the sample rate converter is not counted: it runs first and
+*  changes the frames.
+*
+* Parameters:
+*  process: Processing function of the stage
+*
+* Return:
+*  uint32_t: Delay in frames, of all the stages if the stage is not in the
+*            chain
+*
+*****************************************************************************/
+uint32_t dsp_chain_get_stage_delay(void (*process)(dsp_block_t *block))
+{
+    uint32_t latency = 0U;
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    uint32_t i;
+
+    for (i = 0U; (i < (DSP_CHAIN_NUM_STAGES)) && (process != dsp_chain_stages[i].process); i++)
+    {
+        latency += dsp_chain_stages[i].latency;
+    }
+#else
+    (void) process;
+#endif /* DSP_CHAIN_NUM_STAGES */
+
+    return latency;
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_get_stats
+******************************************************************************
+* Summary:
+*  Get the CPU cycles spent by a stage since the last reset of the
+*  statistics.
+*
+* Parameters:
+*  index: Index of the stage, in processing order
+*  stats: Statistics of the stage
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_chain_get_stats(uint32_t index, dsp_stage_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    if (index < (DSP_CHAIN_NUM_STAGES))
+    {
+        *stats = dsp_chain_stats[index];
+        stats->name = dsp_chain_stages[index].name;
+    }
+#else
+    (void) index;
+#endif /* DSP_CHAIN_NUM_STAGES */
+}
+
+/*****************************************************************************
+* Function Name: dsp_chain_reset_stats
+******************************************************************************
+* Summary:
+*  Reset the CPU cycles statistics of the stages. Must be called from the
+*  context running dsp_chain_process().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_chain_reset_stats(void)
+{
+#if (DSP_CHAIN_NUM_STAGES > 0)
+    memset(dsp_chain_stats, 0, sizeof(dsp_chain_stats));
+#endif /* DSP_CHAIN_NUM_STAGES */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,317 @@
+/*****************************************************************************
+* File Name    : dsp_dc_block.c
+*
+* Description  : This file contains the DC-blocking high-pass filter stage of
+*                the DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_dc_block.h"
+
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* 2 * pi in Q16, for the coefficient computation */
+#define DSP_DC_BLOCK_TWO_PI_Q16         (411775UL)
+
+/* Unity of the coefficients, and coefficient of the input difference */
+#define DSP_DC_BLOCK_ONE                (1L << DSP_DC_BLOCK_Q)
+
+#define DSP_DC_BLOCK_INT16_MAX          (32767L)
+#define DSP_DC_BLOCK_INT16_MIN          (-32768L)
+#define DSP_DC_BLOCK_INT24_MAX          (8388607L)
+#define DSP_DC_BLOCK_INT24_MIN          (-8388608L)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/* State of the filter of one channel */
+typedef struct
+{
+    int32_t x1;             /* Previous input */
+    int32_t y1;             /* Previous output */
+    int64_t acc;            /* Output with its fractional bits, Q14 */
+} dsp_dc_block_state_t;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void dsp_dc_block_s16(dsp_block_t *block);
+static void dsp_dc_block_s32(dsp_block_t *block);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Feedback coefficient (1 - pole), Q14 */
+static int32_t dsp_dc_block_k = 0;
+
+static dsp_dc_block_state_t dsp_dc_block_state[DSP_DC_BLOCK_MAX_CHANNELS];
+
+
+/*****************************************************************************
+* Function Name: dsp_dc_block_configure
+******************************************************************************
+* Summary:
+*  Compute the coefficient of the filter for a sample rate. The filter is
+*
+*    y[n] = x[n] - x[n-1] + (1 - k) * y[n-1],  k = 2 * pi * fc / fs
+*
+*  with fc = DSP_DC_BLOCK_CUTOFF_HZ.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_dc_block_configure(uint32_t sample_rate)
+{
+    uint64_t k;
+
+    k = ((uint64_t) (DSP_DC_BLOCK_TWO_PI_Q16) * (DSP_DC_BLOCK_CUTOFF_HZ) * (uint64_t) (DSP_DC_BLOCK_ONE))
+        / ((uint64_t) sample_rate << 16);
+
+    /* Keep a high-pass response at the lowest sample rates */
+    dsp_dc_block_k = (0U == k) ? 1 : (int32_t) k;
+}
+
+/*****************************************************************************
+* Function Name: dsp_dc_block_reset
+******************************************************************************
+* Summary:
+*  Clear the state of the filter.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_dc_block_reset(void)
+{
+    memset(dsp_dc_block_state, 0, sizeof(dsp_dc_block_state));
+}
+
+/*****************************************************************************
+* Function Name: dsp_dc_block_process
+******************************************************************************
+* Summary:
+*  Remove the DC offset of a block of samples, in place.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_dc_block_process(dsp_block_t *block)
+{
+    if (block->channels > (DSP_DC_BLOCK_MAX_CHANNELS))
+    {
+        return;
+    }
+
+    if (sizeof(int16_t) == block->sample_size)
+    {
+        dsp_dc_block_s16(block);
+    }
+    else
+    {
+        dsp_dc_block_s32(block);
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_dc_block_s16
+******************************************************************************
+* Summary:
+*  Filter 16-bit samples. The accumulator of each channel keeps the output
+*  with DSP_DC_BLOCK_Q fractional bits, so the truncation error is fed back
+*  instead of being lost (no limit cycle, no residual offset):
+*
+*    acc += d[n] * 2^14 - k * y[n-1],  d[n] = sat16(x[n] - x[n-1])
+*    y[n] = sat16(acc >> 14)
+*
+*  With the DSP extension, a stereo frame is processed as one word: QSUB16
+*  computes the input difference of both channels, and one SMLAD per channel
+*  does both products of the update.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_dc_block_s16(dsp_block_t *block)
+{
+    int16_t *samples = (int16_t *) block->samples;
+    uint32_t channels = block->channels;
+    uint32_t frames = block->frames;
+    int32_t k = dsp_dc_block_k;
+    uint32_t frame = 0U;
+    uint32_t channel;
+    dsp_dc_block_state_t *state;
+    int32_t x;
+    int32_t d;
+    int32_t acc;
+    int32_t y;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    if (2U == channels)
+    {
+        uint32_t *words = (uint32_t *) block->samples;
+        uint32_t coefs = __PKHBT(DSP_DC_BLOCK_ONE, -k, 16);
+        uint32_t x1 = __PKHBT(dsp_dc_block_state[0].x1, dsp_dc_block_state[1].x1, 16);
+        uint32_t y1 = __PKHBT(dsp_dc_block_state[0].y1, dsp_dc_block_state[1].y1, 16);
+        int32_t acc_l = (int32_t) dsp_dc_block_state[0].acc;
+        int32_t acc_r = (int32_t) dsp_dc_block_state[1].acc;
+        uint32_t xw;
+        uint32_t dw;
+
+        for (; frame < frames; frame++)
+        {
+            xw = words[frame];
+            dw = __QSUB16(xw, x1);
+            x1 = xw;
+
+            /* | y[n-1] d[n] | of each channel against | -k 2^14 | */
+            acc_l = (int32_t) __SMLAD(__PKHBT(dw, y1, 16), coefs, (uint32_t) acc_l);
+            acc_r = (int32_t) __SMLAD(__PKHTB(y1, dw, 16), coefs, (uint32_t) acc_r);
+
+            y1 = __PKHBT(__SSAT(acc_l >> DSP_DC_BLOCK_Q, 16), __SSAT(acc_r >> DSP_DC_BLOCK_Q, 16), 16);
+            words[frame] = y1;
+        }
+
+        dsp_dc_block_state[0].x1 = (int16_t) x1;
+        dsp_dc_block_state[1].x1 = (int16_t) (x1 >> 16);
+        dsp_dc_block_state[0].y1 = (int16_t) y1;
+        dsp_dc_block_state[1].y1 = (int16_t) (y1 >> 16);
+        dsp_dc_block_state[0].acc = acc_l;
+        dsp_dc_block_state[1].acc = acc_r;
+        return;
+    }
+#endif /* __ARM_FEATURE_DSP */
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        state = &dsp_dc_block_state[channel];
+        acc = (int32_t) state->acc;
+
+        for (frame = 0U; frame < frames; frame++)
+        {
+            x = samples[(frame * channels) + channel];
+
+            d = x - state->x1;
+            d = (d > (DSP_DC_BLOCK_INT16_MAX)) ? (DSP_DC_BLOCK_INT16_MAX) : d;
+            d = (d < (DSP_DC_BLOCK_INT16_MIN)) ? (DSP_DC_BLOCK_INT16_MIN) : d;
+            state->x1 = x;
+
+            acc += (d * (int32_t) (DSP_DC_BLOCK_ONE)) - (k * state->y1);
+
+            y = acc >> DSP_DC_BLOCK_Q;
+            y = (y > (DSP_DC_BLOCK_INT16_MAX)) ? (DSP_DC_BLOCK_INT16_MAX) : y;
+            y = (y < (DSP_DC_BLOCK_INT16_MIN)) ? (DSP_DC_BLOCK_INT16_MIN) : y;
+            state->y1 = y;
+
+            samples[(frame * channels) + channel] = (int16_t) y;
+        }
+
+        state->acc = acc;
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_dc_block_s32
+******************************************************************************
+* Summary:
+*  Filter 24-bit samples held in 32-bit words, with the same fraction
+*  saving accumulator as the 16-bit version. The output saturates to
+*  24 bits.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_dc_block_s32(dsp_block_t *block)
+{
+    int32_t *samples = (int32_t *) block->samples;
+    uint32_t channels = block->channels;
+    uint32_t frames = block->frames;
+    int32_t k = dsp_dc_block_k;
+    uint32_t frame;
+    uint32_t channel;
+    dsp_dc_block_state_t *state;
+    int32_t x;
+    int64_t y;
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        state = &dsp_dc_block_state[channel];
+
+        for (frame = 0U; frame < frames; frame++)
+        {
+            x = samples[(frame * channels) + channel];
+
+            state->acc += ((int64_t) (x - state->x1) * (DSP_DC_BLOCK_ONE)) - ((int64_t) k * state->y1);
+            state->x1 = x;
+
+            y = state->acc >> DSP_DC_BLOCK_Q;
+            y = (y > (DSP_DC_BLOCK_INT24_MAX)) ? (DSP_DC_BLOCK_INT24_MAX) : y;
+            y = (y < (DSP_DC_BLOCK_INT24_MIN)) ? (DSP_DC_BLOCK_INT24_MIN) : y;
+            state->y1 = (int32_t) y;
+
+            samples[(frame * channels) + channel] = state->y1;
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,409 @@
+/*****************************************************************************
+* File Name    : dsp_decim.c
+*
+* Description  : This file contains the decimator feeding the second Audio IN
+*                stream from the output of the DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_decim.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Frames decimated per pass: the input of a pass is appended to the last
+ * taps - 1 samples
+ */
+#define DSP_DECIM_CHUNK_FRAMES          (32U)
+#define DSP_DECIM_HISTORY               ((DSP_DECIM_MAX_TAPS) - 1U)
+
+/* Kaiser window shape. With DSP_DECIM_TAPS_PER_FACTOR, the lowpass is flat
+ * up to 0.4 times the output rate and rejects about 60 dB from 0.6 times
+ * the output rate: what folds back lands above the band kept.
+ */
+#define DSP_DECIM_KAISER_BETA           (6.0f)
+#define DSP_DECIM_PI                    (3.14159265358979f)
+
+#define DSP_DECIM_ONE                   (1L << (DSP_DECIM_Q))
+#define DSP_DECIM_ROUND                 (1L << ((DSP_DECIM_Q) - 1U))
+#define DSP_DECIM_INT16_MAX             (32767L)
+#define DSP_DECIM_INT16_MIN             (-32768L)
+
+#if (((DSP_DECIM_TAPS_PER_FACTOR) % 4U) != 0U)
+#error "DSP_DECIM_TAPS_PER_FACTOR must be a multiple of 4."
+#endif
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static float dsp_decim_bessel_i0(float x);
+static float dsp_decim_design(uint32_t n, uint32_t taps, uint32_t factor);
+static int16_t dsp_decim_mono(const dsp_block_t *block, uint32_t frame);
+static int32_t dsp_decim_mac(const int16_t *coefs, const int16_t *x, uint32_t taps);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Lowpass of the active factor, Q14 with a gain of exactly 1. The factor is
+ * 0 when the input rate is not a multiple of the output rate.
+ */
+static int16_t dsp_decim_coefs[DSP_DECIM_MAX_TAPS];
+static uint32_t dsp_decim_factor = 0U;
+static uint32_t dsp_decim_taps = 0U;
+
+/* Position of the newest input sample of the next output, relative to the
+ * start of the next pass
+ */
+static uint32_t dsp_decim_next;
+
+/* Last input samples followed by the input of the pass */
+static int16_t dsp_decim_history[(DSP_DECIM_HISTORY) + (DSP_DECIM_CHUNK_FRAMES)];
+
+
+/*****************************************************************************
+* Function Name: dsp_decim_configure
+******************************************************************************
+* Summary:
+*  Design the lowpass of a new input rate and reset the state. Only integer
+*  factors up to DSP_DECIM_MAX_FACTOR are supported. Takes some time in
+*  floating point, call it when the format changes only.
+*
+* Parameters:
+*  in_rate: Sample rate of the blocks, in Hz
+*  out_rate: Sample rate produced, in Hz
+*
+* Return:
+*  uint32_t: Decimation factor, 0 if the rates are not supported
+*
+*****************************************************************************/
+uint32_t dsp_decim_configure(uint32_t in_rate, uint32_t out_rate)
+{
+    uint32_t factor = 0U;
+    uint32_t taps;
+    uint32_t n;
+    int32_t total = 0;
+    float sum = 0.0f;
+
+    if ((out_rate > 0U) && (0U == (in_rate % out_rate)))
+    {
+        factor = in_rate / out_rate;
+    }
+
+    if ((0U == factor) || (factor > (DSP_DECIM_MAX_FACTOR)))
+    {
+        dsp_decim_factor = 0U;
+        return 0U;
+    }
+
+    dsp_decim_factor = factor;
+    dsp_decim_reset();
+
+    /* Same rate, the channels are only averaged */
+    if (1U == factor)
+    {
+        return factor;
+    }
+
+    taps = factor * (DSP_DECIM_TAPS_PER_FACTOR);
+    for (n = 0U; n < taps; n++)
+    {
+        sum += dsp_decim_design(n, taps, factor);
+    }
+
+    /* Quantize with a gain of 1, the rounding residue goes to a center tap */
+    for (n = 0U; n < taps; n++)
+    {
+        dsp_decim_coefs[n] = (int16_t) lrintf((dsp_decim_design(n, taps, factor) * (float) (DSP_DECIM_ONE)) / sum);
+        total += dsp_decim_coefs[n];
+    }
+    dsp_decim_coefs[taps / 2U] += (int16_t) ((DSP_DECIM_ONE) - total);
+    dsp_decim_taps = taps;
+
+    return factor;
+}
+
+/*****************************************************************************
+* Function Name: dsp_decim_reset
+******************************************************************************
+* Summary:
+*  Clear the past samples. Must be called before the capture starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_decim_reset(void)
+{
+    memset(dsp_decim_history, 0, sizeof(dsp_decim_history));
+    dsp_decim_next = 0U;
+}
+
+/*****************************************************************************
+* Function Name: dsp_decim_bessel_i0
+******************************************************************************
+* Summary:
+*  Modified Bessel function of the first kind, order 0, of the Kaiser
+*  window.
+*
+* Parameters:
+*  x: Argument
+*
+* Return:
+*  float: I0(x)
+*
+*****************************************************************************/
+static float dsp_decim_bessel_i0(float x)
+{
+    float total = 1.0f;
+    float term = 1.0f;
+    float k;
+
+    for (k = 1.0f; term > (1e-7f * total); k += 1.0f)
+    {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        total += term;
+    }
+
+    return total;
+}
+
+/*****************************************************************************
+* Function Name: dsp_decim_design
+******************************************************************************
+* Summary:
+*  Get a coefficient of the Kaiser-windowed lowpass, cut at half the output
+*  rate.
+*
+* Parameters:
+*  n: Index of the coefficient
+*  taps: Length of the filter, even
+*  factor: Decimation factor
+*
+* Return:
+*  float: Coefficient, not normalized
+*
+*****************************************************************************/
+static float dsp_decim_design(uint32_t n, uint32_t taps, uint32_t factor)
+{
+    float center = (float) (taps - 1U) / 2.0f;
+    float t = (float) n - center;
+    float ratio = t / center;
+    float sinc = sinf((DSP_DECIM_PI * t) / (float) factor) / (DSP_DECIM_PI * t);
+
+    /* The center falls between two taps, t is never 0 */
+    return (sinc * dsp_decim_bessel_i0((DSP_DECIM_KAISER_BETA) * sqrtf(fmaxf(0.0f, 1.0f - (ratio * ratio)))))
+           / dsp_decim_bessel_i0(DSP_DECIM_KAISER_BETA);
+}
+
+/*****************************************************************************
+* Function Name: dsp_decim_mono
+******************************************************************************
+* Summary:
+*  Get a frame of a block as one 16-bit sample, the average of its
+*  channels.
+*
+* Parameters:
+*  block: Block
+*  frame: Index of the frame
+*
+* Return:
+*  int16_t: Sample
+*
+*****************************************************************************/
+static int16_t dsp_decim_mono(const dsp_block_t *block, uint32_t frame)
+{
+    int32_t sum = 0;
+    uint32_t ch;
+
+    if (sizeof(int16_t) == block->sample_size)
+    {
+        const int16_t *samples = &((const int16_t *) block->samples)[frame * block->channels];
+
+        for (ch = 0U; ch < block->channels; ch++)
+        {
+            sum += samples[ch];
+        }
+    }
+    else
+    {
+        /* 24-bit samples, keep the 16 most significant bits */
+        const int32_t *samples = &((const int32_t *) block->samples)[frame * block->channels];
+
+        for (ch = 0U; ch < block->channels; ch++)
+        {
+            sum += samples[ch] >> 8;
+        }
+    }
+
+    return (int16_t) ((block->channels > 1U) ? (sum / (int32_t) block->channels) : sum);
+}
+
+/*****************************************************************************
+* Function Name: dsp_decim_mac
+******************************************************************************
+* Summary:
+*  Apply the lowpass to the last taps samples. With the DSP extension, two
+*  taps are accumulated per instruction; the coefficients are Q14 so the
+*  sum stays within the 32-bit accumulator.
+*
+* Parameters:
+*  coefs: Lowpass
+*  x: Samples, oldest first
+*  taps: Length of the lowpass, multiple of 4
+*
+* Return:
+*  int32_t: Filtered sample, Q14
+*
+*****************************************************************************/
+static int32_t dsp_decim_mac(const int16_t *coefs, const int16_t *x, uint32_t taps)
+{
+    int32_t acc = 0;
+    uint32_t i;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    uint32_t c0;
+    uint32_t c1;
+    uint32_t x0;
+    uint32_t x1;
+
+    for (i = 0U; i < taps; i += 4U)
+    {
+        /* Samples are not word aligned at every position */
+        memcpy(&c0, &coefs[i], sizeof(c0));
+        memcpy(&c1, &coefs[i + 2U], sizeof(c1));
+        memcpy(&x0, &x[i], sizeof(x0));
+        memcpy(&x1, &x[i + 2U], sizeof(x1));
+
+        acc = (int32_t) __SMLAD(c0, x0, (uint32_t) acc);
+        acc = (int32_t) __SMLAD(c1, x1, (uint32_t) acc);
+    }
+#else
+    for (i = 0U; i < taps; i++)
+    {
+        acc += (int32_t) coefs[i] * x[i];
+    }
+#endif /* __ARM_FEATURE_DSP */
+
+    return acc;
+}
+
+/*****************************************************************************
+* Function Name: dsp_decim_process
+******************************************************************************
+* Summary:
+*  Decimate a block of the DSP chain to a mono 16-bit output. The channels
+*  are averaged first, then one output sample is computed every factor
+*  input frames, so the lowpass only runs at the output rate. The block is
+*  left untouched.
+*
+* Parameters:
+*  block: Block at the input rate
+*  output: Output samples, room for block->frames / factor + 1 samples
+*
+* Return:
+*  uint32_t: Number of output samples, 0 if the rates are not supported
+*
+*****************************************************************************/
+uint32_t dsp_decim_process(const dsp_block_t *block, int16_t *output)
+{
+    uint32_t history;
+    uint32_t start;
+    uint32_t count;
+    uint32_t out = 0U;
+    uint32_t i;
+    int32_t acc;
+
+    if (0U == dsp_decim_factor)
+    {
+        return 0U;
+    }
+
+    if (1U == dsp_decim_factor)
+    {
+        for (i = 0U; i < block->frames; i++)
+        {
+            output[i] = dsp_decim_mono(block, i);
+        }
+        return block->frames;
+    }
+
+    history = dsp_decim_taps - 1U;
+    for (start = 0U; start < block->frames; start += count)
+    {
+        count = block->frames - start;
+        if (count > (DSP_DECIM_CHUNK_FRAMES))
+        {
+            count = (DSP_DECIM_CHUNK_FRAMES);
+        }
+
+        /* Append the input of the pass to the past samples */
+        for (i = 0U; i < count; i++)
+        {
+            dsp_decim_history[history + i] = dsp_decim_mono(block, start + i);
+        }
+
+        for (; dsp_decim_next < count; dsp_decim_next += dsp_decim_factor)
+        {
+            acc = dsp_decim_mac(dsp_decim_coefs, &dsp_decim_history[dsp_decim_next], dsp_decim_taps);
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+            acc = __SSAT((acc + DSP_DECIM_ROUND) >> (DSP_DECIM_Q), 16);
+#else
+            acc = (acc + DSP_DECIM_ROUND) >> (DSP_DECIM_Q);
+            acc = (acc > DSP_DECIM_INT16_MAX) ? DSP_DECIM_INT16_MAX : ((acc < DSP_DECIM_INT16_MIN) ? DSP_DECIM_INT16_MIN : acc);
+#endif /* __ARM_FEATURE_DSP */
+            output[out++] = (int16_t) acc;
+        }
+        dsp_decim_next -= count;
+
+        memmove(&dsp_decim_history[0], &dsp_decim_history[count], history * sizeof(int16_t));
+    }
+
+    return out;
+}
+
+/* [] END OF FILE */
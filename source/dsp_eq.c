@@ -0,0 +1,651 @@
+/*****************************************************************************
+* File Name    : dsp_eq.c
+*
+* Description  : This file contains the biquad cascade equalizer stage of the
+*                DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_eq.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH) || (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define DSP_EQ_ONE                      (1L << DSP_EQ_Q)
+#define DSP_EQ_ROUND                    (1L << (DSP_EQ_Q - 1U))
+#define DSP_EQ_PI                       (3.14159265358979f)
+
+#define DSP_EQ_COEF_MAX                 (32767L)
+#define DSP_EQ_INT16_MAX                (32767L)
+#define DSP_EQ_INT16_MIN                (-32768L)
+#define DSP_EQ_INT24_MAX                (8388607L)
+#define DSP_EQ_INT24_MIN                (-8388608L)
+
+/* Orders the writes of the pending coefficients against the flag handing
+ * them over. The DSP chain preempts the task setting the bands on the same
+ * core, so the compiler must not move them across the flag.
+ */
+#if defined(__ARM_ARCH)
+#define DSP_EQ_BARRIER()                __COMPILER_BARRIER()
+#else
+#define DSP_EQ_BARRIER()                __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/* Memories of a section of one channel (direct form I) */
+typedef struct
+{
+    int32_t x1;
+    int32_t x2;
+    int32_t y1;
+    int32_t y2;
+} dsp_eq_state_t;
+
+/* Set of coefficients of all the sections */
+typedef struct
+{
+    dsp_eq_coefs_t coefs[DSP_EQ_MAX_CHANNELS][DSP_EQ_MAX_SECTIONS];
+    uint32_t num_sections;
+} dsp_eq_bank_t;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void dsp_eq_design(const dsp_eq_band_t *band, uint32_t sample_rate, dsp_eq_coefs_t *coefs);
+static void dsp_eq_build(dsp_eq_bank_t *bank);
+static void dsp_eq_s16(dsp_block_t *block, uint32_t section);
+static void dsp_eq_s32(dsp_block_t *block, uint32_t section);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Bands requested, and sections set with raw coefficients */
+static dsp_eq_band_t dsp_eq_bands[DSP_EQ_MAX_CHANNELS][DSP_EQ_MAX_SECTIONS];
+static dsp_eq_coefs_t dsp_eq_custom_coefs[DSP_EQ_MAX_CHANNELS][DSP_EQ_MAX_SECTIONS];
+static bool dsp_eq_custom[DSP_EQ_MAX_CHANNELS][DSP_EQ_MAX_SECTIONS];
+
+/* Sample rate of the stream */
+static uint32_t dsp_eq_sample_rate = 48000U;
+
+/* Coefficients in use, and coefficients waiting for the next block */
+static dsp_eq_bank_t dsp_eq_active;
+static dsp_eq_bank_t dsp_eq_pending;
+static volatile bool dsp_eq_pending_ready = false;
+
+static dsp_eq_state_t dsp_eq_state[DSP_EQ_MAX_CHANNELS][DSP_EQ_MAX_SECTIONS];
+
+
+/*****************************************************************************
+* Function Name: dsp_eq_configure
+******************************************************************************
+* Summary:
+*  Design the sections for a new sample rate and reset their state.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_eq_configure(uint32_t sample_rate)
+{
+    dsp_eq_sample_rate = sample_rate;
+    dsp_eq_pending_ready = false;
+    dsp_eq_build(&dsp_eq_active);
+    dsp_eq_reset();
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_reset
+******************************************************************************
+* Summary:
+*  Clear the memories of the sections.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_eq_reset(void)
+{
+    memset(dsp_eq_state, 0, sizeof(dsp_eq_state));
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_set_band
+******************************************************************************
+* Summary:
+*  Set a band of the equalizer of a channel. The band is designed for the
+*  sample rate of the stream, and again after each change of sample rate.
+*  The new coefficients apply from the next block. Must be called from a
+*  task of lower priority than the one running the DSP chain.
+*
+* Parameters:
+*  channel: Channel of the band
+*  index: Section of the band, in processing order
+*  band: Band, DSP_EQ_NONE for a flat section
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_eq_set_band(uint32_t channel, uint32_t index, const dsp_eq_band_t *band)
+{
+    if ((channel >= (DSP_EQ_MAX_CHANNELS)) || (index >= (DSP_EQ_MAX_SECTIONS)))
+    {
+        return;
+    }
+
+    dsp_eq_pending_ready = false;
+    DSP_EQ_BARRIER();
+    dsp_eq_bands[channel][index] = *band;
+    dsp_eq_custom[channel][index] = false;
+    dsp_eq_build(&dsp_eq_pending);
+    DSP_EQ_BARRIER();
+    dsp_eq_pending_ready = true;
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_set_coefs
+******************************************************************************
+* Summary:
+*  Set the coefficients of a section of a channel, e.g. a correction
+*  measured for a microphone. They are kept as is across the changes of
+*  sample rate. Same context constraints as dsp_eq_set_band(). Like the
+*  designed sections, a1 and a2 are saturated to +/-DSP_EQ_COEF_MAX, so the
+*  stage can negate them in 16 bits.
+*
+* Parameters:
+*  channel: Channel of the section
+*  index: Section, in processing order
+*  coefs: Coefficients, Q14
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_eq_set_coefs(uint32_t channel, uint32_t index, const dsp_eq_coefs_t *coefs)
+{
+    if ((channel >= (DSP_EQ_MAX_CHANNELS)) || (index >= (DSP_EQ_MAX_SECTIONS)))
+    {
+        return;
+    }
+
+    dsp_eq_pending_ready = false;
+    DSP_EQ_BARRIER();
+    dsp_eq_custom_coefs[channel][index] = *coefs;
+    if (coefs->a1 < -(DSP_EQ_COEF_MAX))
+    {
+        dsp_eq_custom_coefs[channel][index].a1 = (int16_t) -(DSP_EQ_COEF_MAX);
+    }
+    if (coefs->a2 < -(DSP_EQ_COEF_MAX))
+    {
+        dsp_eq_custom_coefs[channel][index].a2 = (int16_t) -(DSP_EQ_COEF_MAX);
+    }
+    dsp_eq_custom[channel][index] = true;
+    dsp_eq_build(&dsp_eq_pending);
+    DSP_EQ_BARRIER();
+    dsp_eq_pending_ready = true;
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_get_num_sections
+******************************************************************************
+* Summary:
+*  Get the number of sections run on each channel: the last section set
+*  on any channel, flat sections included.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Number of sections
+*
+*****************************************************************************/
+uint32_t dsp_eq_get_num_sections(void)
+{
+    return dsp_eq_active.num_sections;
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_process
+******************************************************************************
+* Summary:
+*  Run the sections of the equalizer on a block of samples, in place, one
+*  section at a time over the whole block. Without any band set, the block
+*  is left untouched.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_eq_process(dsp_block_t *block)
+{
+    uint32_t section;
+
+    if (dsp_eq_pending_ready)
+    {
+        DSP_EQ_BARRIER();
+        dsp_eq_active = dsp_eq_pending;
+        dsp_eq_pending_ready = false;
+    }
+
+    if (block->channels > (DSP_EQ_MAX_CHANNELS))
+    {
+        return;
+    }
+
+    for (section = 0U; section < dsp_eq_active.num_sections; section++)
+    {
+        if (sizeof(int16_t) == block->sample_size)
+        {
+            dsp_eq_s16(block, section);
+        }
+        else
+        {
+            dsp_eq_s32(block, section);
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_build
+******************************************************************************
+* Summary:
+*  Compute the coefficients of all the sections for the sample rate of the
+*  stream.
+*
+* Parameters:
+*  bank: Coefficients computed
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_eq_build(dsp_eq_bank_t *bank)
+{
+    uint32_t channel;
+    uint32_t index;
+
+    bank->num_sections = 0U;
+
+    for (channel = 0U; channel < (DSP_EQ_MAX_CHANNELS); channel++)
+    {
+        for (index = 0U; index < (DSP_EQ_MAX_SECTIONS); index++)
+        {
+            if (dsp_eq_custom[channel][index])
+            {
+                bank->coefs[channel][index] = dsp_eq_custom_coefs[channel][index];
+            }
+            else
+            {
+                dsp_eq_design(&dsp_eq_bands[channel][index], dsp_eq_sample_rate, &bank->coefs[channel][index]);
+            }
+
+            if ((dsp_eq_custom[channel][index] || ((DSP_EQ_NONE) != dsp_eq_bands[channel][index].type)) &&
+                (bank->num_sections <= index))
+            {
+                bank->num_sections = index + 1U;
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_to_q14
+******************************************************************************
+* Summary:
+*  Convert a normalized coefficient to Q14, rounded and saturated.
+*
+* Parameters:
+*  value: Coefficient
+*
+* Return:
+*  int16_t: Coefficient in Q14
+*
+*****************************************************************************/
+static int16_t dsp_eq_to_q14(float value)
+{
+    float scaled = value * (float) (DSP_EQ_ONE);
+
+    if (scaled >= (float) (DSP_EQ_COEF_MAX))
+    {
+        return (int16_t) (DSP_EQ_COEF_MAX);
+    }
+    if (scaled <= -(float) (DSP_EQ_COEF_MAX))
+    {
+        return (int16_t) -(DSP_EQ_COEF_MAX);
+    }
+    return (int16_t) lrintf(scaled);
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_design
+******************************************************************************
+* Summary:
+*  Design a biquad section from a band, with the formulas of the Audio EQ
+*  Cookbook (R. Bristow-Johnson).
+*
+* Parameters:
+*  band: Band to design
+*  sample_rate: Sample rate in Hz
+*  coefs: Coefficients of the section
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_eq_design(const dsp_eq_band_t *band, uint32_t sample_rate, dsp_eq_coefs_t *coefs)
+{
+    float w0 = (2.0f * DSP_EQ_PI * band->freq_hz) / (float) sample_rate;
+    float cos_w0 = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * ((band->q > 0.0f) ? band->q : 0.707f));
+    float a = powf(10.0f, band->gain_db / 40.0f);
+    float sqrt_a = 2.0f * sqrtf(a) * alpha;
+    float b0;
+    float b1;
+    float b2;
+    float a0;
+    float a1;
+    float a2;
+
+    switch (band->type)
+    {
+        case DSP_EQ_PEAKING:
+            b0 = 1.0f + (alpha * a);
+            b1 = -2.0f * cos_w0;
+            b2 = 1.0f - (alpha * a);
+            a0 = 1.0f + (alpha / a);
+            a1 = -2.0f * cos_w0;
+            a2 = 1.0f - (alpha / a);
+            break;
+
+        case DSP_EQ_LOW_SHELF:
+            b0 = a * ((a + 1.0f) - ((a - 1.0f) * cos_w0) + sqrt_a);
+            b1 = 2.0f * a * ((a - 1.0f) - ((a + 1.0f) * cos_w0));
+            b2 = a * ((a + 1.0f) - ((a - 1.0f) * cos_w0) - sqrt_a);
+            a0 = (a + 1.0f) + ((a - 1.0f) * cos_w0) + sqrt_a;
+            a1 = -2.0f * ((a - 1.0f) + ((a + 1.0f) * cos_w0));
+            a2 = (a + 1.0f) + ((a - 1.0f) * cos_w0) - sqrt_a;
+            break;
+
+        case DSP_EQ_HIGH_SHELF:
+            b0 = a * ((a + 1.0f) + ((a - 1.0f) * cos_w0) + sqrt_a);
+            b1 = -2.0f * a * ((a - 1.0f) + ((a + 1.0f) * cos_w0));
+            b2 = a * ((a + 1.0f) + ((a - 1.0f) * cos_w0) - sqrt_a);
+            a0 = (a + 1.0f) - ((a - 1.0f) * cos_w0) + sqrt_a;
+            a1 = 2.0f * ((a - 1.0f) - ((a + 1.0f) * cos_w0));
+            a2 = (a + 1.0f) - ((a - 1.0f) * cos_w0) - sqrt_a;
+            break;
+
+        case DSP_EQ_LOW_PASS:
+            b0 = (1.0f - cos_w0) / 2.0f;
+            b1 = 1.0f - cos_w0;
+            b2 = (1.0f - cos_w0) / 2.0f;
+            a0 = 1.0f + alpha;
+            a1 = -2.0f * cos_w0;
+            a2 = 1.0f - alpha;
+            break;
+
+        case DSP_EQ_HIGH_PASS:
+            b0 = (1.0f + cos_w0) / 2.0f;
+            b1 = -(1.0f + cos_w0);
+            b2 = (1.0f + cos_w0) / 2.0f;
+            a0 = 1.0f + alpha;
+            a1 = -2.0f * cos_w0;
+            a2 = 1.0f - alpha;
+            break;
+
+        default:
+            /* Flat section */
+            b0 = 1.0f;
+            b1 = 0.0f;
+            b2 = 0.0f;
+            a0 = 1.0f;
+            a1 = 0.0f;
+            a2 = 0.0f;
+            break;
+    }
+
+    coefs->b0 = dsp_eq_to_q14(b0 / a0);
+    coefs->b1 = dsp_eq_to_q14(b1 / a0);
+    coefs->b2 = dsp_eq_to_q14(b2 / a0);
+    coefs->a1 = dsp_eq_to_q14(a1 / a0);
+    coefs->a2 = dsp_eq_to_q14(a2 / a0);
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_s16
+******************************************************************************
+* Summary:
+*  Run a section on 16-bit samples:
+*
+*    y[n] = sat16((b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+*                  + 2^13) >> 14)
+*
+*  The sum is accumulated on 64 bits: with coefficients up to 2 in Q14,
+*  the five products reach 5 x 2^30, and a treble boost of +12 dB on full
+*  scale noise already brings the sum over 2^31. A 32-bit accumulator would
+*  wrap around and flip the sign of the output instead of saturating it.
+*
+*  With the DSP extension, a stereo frame is processed as one word and the
+*  memories of both channels are kept packed in words: two SMLALD per
+*  channel compute four of the five products, so each instruction pair
+*  processes the left and the right channel.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*  section: Index of the section
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_eq_s16(dsp_block_t *block, uint32_t section)
+{
+    int16_t *samples = (int16_t *) block->samples;
+    uint32_t channels = block->channels;
+    uint32_t frames = block->frames;
+    uint32_t frame;
+    uint32_t channel;
+    const dsp_eq_coefs_t *coefs;
+    dsp_eq_state_t *state;
+    int32_t x;
+    int64_t acc;
+    int32_t y;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    if (2U == channels)
+    {
+        const dsp_eq_coefs_t *left = &dsp_eq_active.coefs[0][section];
+        const dsp_eq_coefs_t *right = &dsp_eq_active.coefs[1][section];
+        dsp_eq_state_t *state_l = &dsp_eq_state[0][section];
+        dsp_eq_state_t *state_r = &dsp_eq_state[1][section];
+        uint32_t *words = (uint32_t *) block->samples;
+
+        /* | b1 b0 | pairs with | x[n-1] x[n] |, | -a1 b2 | with | y[n-1] x[n-2] | */
+        uint32_t c0_l = __PKHBT(left->b0, left->b1, 16);
+        uint32_t c1_l = __PKHBT(left->b2, -left->a1, 16);
+        uint32_t c0_r = __PKHBT(right->b0, right->b1, 16);
+        uint32_t c1_r = __PKHBT(right->b2, -right->a1, 16);
+        int32_t na2_l = -left->a2;
+        int32_t na2_r = -right->a2;
+
+        /* | right left | memories */
+        uint32_t x1 = __PKHBT(state_l->x1, state_r->x1, 16);
+        uint32_t x2 = __PKHBT(state_l->x2, state_r->x2, 16);
+        uint32_t y1 = __PKHBT(state_l->y1, state_r->y1, 16);
+        uint32_t y2 = __PKHBT(state_l->y2, state_r->y2, 16);
+        uint32_t xw;
+        int64_t acc_l;
+        int64_t acc_r;
+
+        for (frame = 0U; frame < frames; frame++)
+        {
+            xw = words[frame];
+
+            acc_l = (int64_t) __SMLALD(__PKHBT(xw, x1, 16), c0_l, (uint64_t) (DSP_EQ_ROUND));
+            acc_r = (int64_t) __SMLALD(__PKHTB(x1, xw, 16), c0_r, (uint64_t) (DSP_EQ_ROUND));
+            acc_l = (int64_t) __SMLALD(__PKHBT(x2, y1, 16), c1_l, (uint64_t) acc_l);
+            acc_r = (int64_t) __SMLALD(__PKHTB(y1, x2, 16), c1_r, (uint64_t) acc_r);
+            acc_l += (int32_t) (int16_t) y2 * na2_l;
+            acc_r += (int32_t) (int16_t) (y2 >> 16) * na2_r;
+
+            x2 = x1;
+            x1 = xw;
+            y2 = y1;
+
+            /* |sum| < 5 x 2^30, so the sum shifted fits in 32 bits */
+            y1 = __PKHBT(__SSAT((int32_t) (acc_l >> DSP_EQ_Q), 16),
+                         __SSAT((int32_t) (acc_r >> DSP_EQ_Q), 16), 16);
+
+            words[frame] = y1;
+        }
+
+        state_l->x1 = (int16_t) x1;
+        state_l->x2 = (int16_t) x2;
+        state_l->y1 = (int16_t) y1;
+        state_l->y2 = (int16_t) y2;
+        state_r->x1 = (int16_t) (x1 >> 16);
+        state_r->x2 = (int16_t) (x2 >> 16);
+        state_r->y1 = (int16_t) (y1 >> 16);
+        state_r->y2 = (int16_t) (y2 >> 16);
+        return;
+    }
+#endif /* __ARM_FEATURE_DSP */
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        coefs = &dsp_eq_active.coefs[channel][section];
+        state = &dsp_eq_state[channel][section];
+
+        for (frame = 0U; frame < frames; frame++)
+        {
+            x = samples[(frame * channels) + channel];
+
+            acc = (DSP_EQ_ROUND) + ((int64_t) coefs->b0 * x) + ((int64_t) coefs->b1 * state->x1)
+                  + ((int64_t) coefs->b2 * state->x2) - ((int64_t) coefs->a1 * state->y1)
+                  - ((int64_t) coefs->a2 * state->y2);
+
+            y = (int32_t) (acc >> DSP_EQ_Q);
+            y = (y > (DSP_EQ_INT16_MAX)) ? (DSP_EQ_INT16_MAX) : y;
+            y = (y < (DSP_EQ_INT16_MIN)) ? (DSP_EQ_INT16_MIN) : y;
+
+            state->x2 = state->x1;
+            state->x1 = x;
+            state->y2 = state->y1;
+            state->y1 = y;
+
+            samples[(frame * channels) + channel] = (int16_t) y;
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_eq_s32
+******************************************************************************
+* Summary:
+*  Run a section on 24-bit samples held in 32-bit words, with 64-bit
+*  accumulation. The output saturates to 24 bits.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*  section: Index of the section
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_eq_s32(dsp_block_t *block, uint32_t section)
+{
+    int32_t *samples = (int32_t *) block->samples;
+    uint32_t channels = block->channels;
+    uint32_t frames = block->frames;
+    uint32_t frame;
+    uint32_t channel;
+    const dsp_eq_coefs_t *coefs;
+    dsp_eq_state_t *state;
+    int32_t x;
+    int64_t acc;
+    int64_t y;
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        coefs = &dsp_eq_active.coefs[channel][section];
+        state = &dsp_eq_state[channel][section];
+
+        for (frame = 0U; frame < frames; frame++)
+        {
+            x = samples[(frame * channels) + channel];
+
+            acc = (DSP_EQ_ROUND) + ((int64_t) coefs->b0 * x) + ((int64_t) coefs->b1 * state->x1)
+                  + ((int64_t) coefs->b2 * state->x2) - ((int64_t) coefs->a1 * state->y1)
+                  - ((int64_t) coefs->a2 * state->y2);
+
+            y = acc >> DSP_EQ_Q;
+            y = (y > (DSP_EQ_INT24_MAX)) ? (DSP_EQ_INT24_MAX) : y;
+            y = (y < (DSP_EQ_INT24_MIN)) ? (DSP_EQ_INT24_MIN) : y;
+
+            state->x2 = state->x1;
+            state->x1 = x;
+            state->y2 = state->y1;
+            state->y1 = (int32_t) y;
+
+            samples[(frame * channels) + channel] = (int32_t) y;
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,428 @@
+/*****************************************************************************
+* File Name    : dsp_gain.c
+*
+* Description  : This file contains the gain stage of the DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_gain.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#if defined(__ARM_ARCH)
+/* SMULWB and SMULWT are not part of CMSIS-Core, take them from the ACLE */
+#include <arm_acle.h>
+#define __SMULWB(op1, op2)              __smulwb((int32_t) (op1), (int32_t) (op2))
+#define __SMULWT(op1, op2)              __smulwt((int32_t) (op1), (int32_t) (op2))
+#endif /* __ARM_ARCH */
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Attenuation steps of dsp_gain_db_to_q15(), 0.5 dB in 1/256 dB */
+#define DSP_GAIN_DB_STEP                (128)
+#define DSP_GAIN_DB_BITS                (7U)
+
+/* Fraction bits added to the gain accumulated by the ramp */
+#define DSP_GAIN_RAMP_SHIFT             (15U)
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void dsp_gain_apply(dsp_block_t *block, int32_t target);
+static void dsp_gain_scale(dsp_block_t *block, int32_t gain);
+static void dsp_gain_ramp(dsp_block_t *block, int32_t from, int32_t to);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Gain requested, Q15 */
+static volatile uint32_t dsp_gain_target_q15 = DSP_GAIN_UNITY;
+
+/* Gain applied to the last sample, Q15 */
+static int32_t dsp_gain_current_q15 = (int32_t) (DSP_GAIN_UNITY);
+
+/* Gain set by dsp_gain_jump() from the frame dsp_gain_jump_frame of the
+ * next block, Q15. No jump pending when the frame is 0.
+ */
+static int32_t dsp_gain_jump_q15 = (int32_t) (DSP_GAIN_UNITY);
+static uint32_t dsp_gain_jump_frame = 0U;
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+/* Attenuation of each bit of a count of 0.5 dB steps (0.5, 1, 2, ... 32 dB),
+ * Q15
+ */
+static const uint16_t dsp_gain_db_bits[DSP_GAIN_DB_BITS] =
+{
+    30935U, 29205U, 26029U, 20675U, 13045U, 5193U, 823U
+};
+
+
+/*****************************************************************************
+* Function Name: dsp_gain_set
+******************************************************************************
+* Summary:
+*  Set the gain of the stage. Can be called from any context. The gain
+*  ramps from its current value to the new one over the next block.
+*
+* Parameters:
+*  gain_q15: Gain in Q15, clamped to DSP_GAIN_UNITY
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_gain_set(uint32_t gain_q15)
+{
+    dsp_gain_target_q15 = (gain_q15 > (DSP_GAIN_UNITY)) ? (DSP_GAIN_UNITY) : gain_q15;
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_jump
+******************************************************************************
+* Summary:
+*  Set the gain of the stage from a frame of the next block, without ramp,
+*  to compensate a gain step upstream on that same frame. The frames before
+*  keep the gain of the previous block. Must be called from the context
+*  running dsp_chain_process().
+*
+* Parameters:
+*  gain_q15: Gain in Q15, clamped to DSP_GAIN_UNITY
+*  frame: First frame of the next block with the new gain
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_gain_jump(uint32_t gain_q15, uint32_t frame)
+{
+    dsp_gain_set(gain_q15);
+
+    if (0U == frame)
+    {
+        dsp_gain_current_q15 = (int32_t) dsp_gain_target_q15;
+    }
+    else
+    {
+        dsp_gain_jump_q15 = (int32_t) dsp_gain_target_q15;
+        dsp_gain_jump_frame = frame;
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_get
+******************************************************************************
+* Summary:
+*  Get the gain requested for the stage.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Gain in Q15
+*
+*****************************************************************************/
+uint32_t dsp_gain_get(void)
+{
+    return dsp_gain_target_q15;
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_db_to_q15
+******************************************************************************
+* Summary:
+*  Convert an attenuation in dB to a gain for dsp_gain_set(), without
+*  floating point: the attenuation is rounded to 0.5 dB steps, and the
+*  attenuations of the bits of the step count are multiplied together.
+*
+* Parameters:
+*  gain: Gain in 1/256 dB, from 0 down to -63.5 dB
+*
+* Return:
+*  uint32_t: Gain in Q15
+*
+*****************************************************************************/
+uint32_t dsp_gain_db_to_q15(int32_t gain)
+{
+    uint32_t steps;
+    uint32_t gain_q15 = DSP_GAIN_UNITY;
+    uint32_t i;
+
+    if (gain >= 0)
+    {
+        return (DSP_GAIN_UNITY);
+    }
+
+    steps = (uint32_t) ((-gain + ((DSP_GAIN_DB_STEP) / 2)) / (DSP_GAIN_DB_STEP));
+    if (steps >= (1UL << (DSP_GAIN_DB_BITS)))
+    {
+        steps = (1UL << (DSP_GAIN_DB_BITS)) - 1U;
+    }
+
+    for (i = 0U; i < (DSP_GAIN_DB_BITS); i++)
+    {
+        if (0U != (steps & (1UL << i)))
+        {
+            gain_q15 = ((gain_q15 * dsp_gain_db_bits[i]) + (1UL << ((DSP_GAIN_Q15_SHIFT) - 1U))) >> (DSP_GAIN_Q15_SHIFT);
+        }
+    }
+
+    return gain_q15;
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_reset
+******************************************************************************
+* Summary:
+*  Apply the requested gain from the first sample of the next stream,
+*  without ramp.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_gain_reset(void)
+{
+    dsp_gain_current_q15 = (int32_t) dsp_gain_target_q15;
+    dsp_gain_jump_frame = 0U;
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_process
+******************************************************************************
+* Summary:
+*  Scale a block of samples by the gain of the stage, in place. At unity the
+*  block is left untouched. After a change of gain, the gain ramps linearly
+*  over the block so the change does not click. A gain set by
+*  dsp_gain_jump() applies from its frame.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_gain_process(dsp_block_t *block)
+{
+    dsp_block_t rest = *block;
+    uint32_t frames;
+
+    if (dsp_gain_jump_frame > 0U)
+    {
+        /* Frames before the jump, at the gain of the previous block */
+        frames = (dsp_gain_jump_frame < block->frames) ? dsp_gain_jump_frame : block->frames;
+        rest.frames = frames;
+        dsp_gain_apply(&rest, dsp_gain_current_q15);
+
+        rest.samples = (uint8_t *) block->samples + (frames * block->channels * block->sample_size);
+        rest.frames = block->frames - frames;
+        dsp_gain_current_q15 = dsp_gain_jump_q15;
+        dsp_gain_jump_frame = 0U;
+    }
+
+    if (rest.frames > 0U)
+    {
+        dsp_gain_apply(&rest, (int32_t) dsp_gain_target_q15);
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_apply
+******************************************************************************
+* Summary:
+*  Scale a block of samples from the current gain to a target gain: with a
+*  ramp if they differ, nothing at unity.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*  target: Gain at the end of the block, Q15
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_gain_apply(dsp_block_t *block, int32_t target)
+{
+    if (target != dsp_gain_current_q15)
+    {
+        dsp_gain_ramp(block, dsp_gain_current_q15, target);
+        dsp_gain_current_q15 = target;
+    }
+    else if ((int32_t) (DSP_GAIN_UNITY) != target)
+    {
+        dsp_gain_scale(block, target);
+    }
+    else
+    {
+        /* Unity, nothing to do */
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_scale
+******************************************************************************
+* Summary:
+*  Scale a block of samples by a constant gain below unity. Products are
+*  rounded down; no saturation is needed.
+*
+*  With the DSP extension, a stereo frame of 16-bit samples is loaded and
+*  stored as a single word: SMULWB and SMULWT multiply each halfword by the
+*  gain in Q16, and PKHBT packs both products.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*  gain: Gain in Q15, below DSP_GAIN_UNITY
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_gain_scale(dsp_block_t *block, int32_t gain)
+{
+    uint32_t count = block->frames * block->channels;
+    uint32_t i = 0U;
+
+    if (sizeof(int16_t) == block->sample_size)
+    {
+        int16_t *samples = (int16_t *) block->samples;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+        int32_t gain_q16 = gain << 1;
+        uint32_t *words;
+        uint32_t word;
+
+        /* A block split by dsp_gain_jump() may start on a halfword */
+        if ((0U != ((uintptr_t) samples & 2U)) && (count > 0U))
+        {
+            samples[0] = (int16_t) ((samples[0] * gain) >> DSP_GAIN_Q15_SHIFT);
+            i = 1U;
+        }
+        words = (uint32_t *) &samples[i];
+
+        for (; (i + 2U) <= count; i += 2U)
+        {
+            word = *words;
+            *words++ = __PKHBT(__SMULWB(gain_q16, word), __SMULWT(gain_q16, word), 16);
+        }
+#endif /* __ARM_FEATURE_DSP */
+
+        for (; i < count; i++)
+        {
+            samples[i] = (int16_t) ((samples[i] * gain) >> DSP_GAIN_Q15_SHIFT);
+        }
+    }
+    else
+    {
+        int32_t *samples = (int32_t *) block->samples;
+
+        for (; i < count; i++)
+        {
+            samples[i] = (int32_t) (((int64_t) samples[i] * gain) >> DSP_GAIN_Q15_SHIFT);
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_gain_ramp
+******************************************************************************
+* Summary:
+*  Scale a block of samples by a gain moving linearly from one value to
+*  another. All the channels of a frame get the same gain; the last frame
+*  gets the final gain. The step of the gain is divided once per block and
+*  accumulated with DSP_GAIN_RAMP_SHIFT fraction bits.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*  from: Gain before the block, Q15
+*  to: Gain at the end of the block, Q15
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_gain_ramp(dsp_block_t *block, int32_t from, int32_t to)
+{
+    uint32_t frames = block->frames;
+    uint32_t channels = block->channels;
+    int32_t step;
+    int32_t acc = from * (1 << DSP_GAIN_RAMP_SHIFT);
+    int32_t gain;
+    uint32_t frame;
+    uint32_t channel;
+
+    if (0U == frames)
+    {
+        return;
+    }
+    step = ((to - from) * (1 << DSP_GAIN_RAMP_SHIFT)) / (int32_t) frames;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        acc += step;
+        gain = ((frame + 1U) < frames) ? (acc >> DSP_GAIN_RAMP_SHIFT) : to;
+
+        if (sizeof(int16_t) == block->sample_size)
+        {
+            int16_t *samples = (int16_t *) block->samples + (frame * channels);
+
+            for (channel = 0U; channel < channels; channel++)
+            {
+                samples[channel] = (int16_t) ((samples[channel] * gain) >> DSP_GAIN_Q15_SHIFT);
+            }
+        }
+        else
+        {
+            int32_t *samples = (int32_t *) block->samples + (frame * channels);
+
+            for (channel = 0U; channel < channels; channel++)
+            {
+                samples[channel] = (int32_t) (((int64_t) samples[channel] * gain) >> DSP_GAIN_Q15_SHIFT);
+            }
+        }
+    }
+}
+
+/* [] END OF FILE */
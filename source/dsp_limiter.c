@@ -0,0 +1,365 @@
+/*****************************************************************************
+* File Name    : dsp_limiter.c
+*
+* Description  : This file contains the look-ahead peak limiter stage of the
+*                DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_limiter.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "cmsis_compiler.h"
+#else
+#define __CLZ(value)                    ((uint8_t) __builtin_clz(value))
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Gains are Q15, levels are Q31 of the full scale */
+#define DSP_LIMITER_UNITY               (1UL << 15U)
+#define DSP_LIMITER_THRESHOLD_Q31       ((uint32_t) (DSP_LIMITER_THRESHOLD_Q15) << 16U)
+
+/* Level of a 16-bit and of a 24-bit sample, Q31 */
+#define DSP_LIMITER_LEVEL_S16(x)        ((uint32_t) (((x) < 0) ? -(x) : (x)) << 16U)
+#define DSP_LIMITER_LEVEL_S24(x)        ((uint32_t) (((x) < 0) ? -(x) : (x)) << 8U)
+
+/* Initial estimate of 1/m for m in [0.5, 1): 48/17 - 32/17 m, Q30 */
+#define DSP_LIMITER_RECIP_A_Q30         (3031741621UL)
+#define DSP_LIMITER_RECIP_B_Q30         (2021161080UL)
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint32_t dsp_limiter_detect(const dsp_block_t *block, uint32_t frame);
+static uint32_t dsp_limiter_gain(uint32_t level);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Look-ahead delay line, one frame per entry */
+static int32_t dsp_limiter_delay[DSP_LIMITER_LOOKAHEAD_FRAMES][DSP_LIMITER_MAX_CHANNELS];
+static uint32_t dsp_limiter_delay_index = 0U;
+
+/* Highest level of the look-ahead, and frames left before it expires */
+static uint32_t dsp_limiter_hold = 0U;
+static uint32_t dsp_limiter_hold_frames = 0U;
+
+/* Envelope followed by the gain, Q31 */
+static uint32_t dsp_limiter_envelope = 0U;
+static uint32_t dsp_limiter_release_shift = 11U;
+
+/* Lowest gain applied since the start of the stream, Q15 */
+static volatile uint32_t dsp_limiter_min_gain = DSP_LIMITER_UNITY;
+
+
+/*****************************************************************************
+* Function Name: dsp_limiter_configure
+******************************************************************************
+* Summary:
+*  Compute the release of the envelope for a new sample rate.
+*
+* Parameters:
+*  sample_rate: Sample rate in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_limiter_configure(uint32_t sample_rate)
+{
+    uint32_t frames = (sample_rate * (DSP_LIMITER_RELEASE_MS)) / 1000U;
+
+    dsp_limiter_release_shift = 0U;
+    while ((2UL << dsp_limiter_release_shift) <= frames)
+    {
+        dsp_limiter_release_shift++;
+    }
+
+    dsp_limiter_reset();
+}
+
+/*****************************************************************************
+* Function Name: dsp_limiter_reset
+******************************************************************************
+* Summary:
+*  Clear the look-ahead and the envelope before a new stream.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_limiter_reset(void)
+{
+    memset(dsp_limiter_delay, 0, sizeof(dsp_limiter_delay));
+    dsp_limiter_delay_index = 0U;
+    dsp_limiter_hold = 0U;
+    dsp_limiter_hold_frames = 0U;
+    dsp_limiter_envelope = 0U;
+    dsp_limiter_min_gain = DSP_LIMITER_UNITY;
+}
+
+/*****************************************************************************
+* Function Name: dsp_limiter_get_min_gain
+******************************************************************************
+* Summary:
+*  Get the lowest gain applied since the start of the stream.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Gain in Q15
+*
+*****************************************************************************/
+uint32_t dsp_limiter_get_min_gain(void)
+{
+    return dsp_limiter_min_gain;
+}
+
+/*****************************************************************************
+* Function Name: dsp_limiter_process
+******************************************************************************
+* Summary:
+*  Limit the peaks of a block of samples to DSP_LIMITER_THRESHOLD_Q15, in
+*  place. The channels share one gain. The peak level of the incoming
+*  frames is held for the look-ahead, the envelope follows it with a fast
+*  attack and a slow release, and the gain brings the envelope down to the
+*  threshold. The gain is applied to the frames leaving the look-ahead, and
+*  a final clip catches the residual overshoot of the attack.
+*
+* Parameters:
+*  block: Block of samples, processed in place
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_limiter_process(dsp_block_t *block)
+{
+    int16_t *samples_16 = (int16_t *) block->samples;
+    int32_t *samples_32 = (int32_t *) block->samples;
+    uint32_t channels = block->channels;
+    bool wide = (sizeof(int16_t) != block->sample_size);
+    int32_t ceiling = wide ? ((int32_t) (DSP_LIMITER_THRESHOLD_Q15) << 8U) : (int32_t) (DSP_LIMITER_THRESHOLD_Q15);
+    int32_t *delayed;
+    uint32_t level;
+    uint32_t gain;
+    uint32_t min_gain = dsp_limiter_min_gain;
+    uint32_t frame;
+    uint32_t channel;
+    int32_t x;
+    int32_t y;
+
+    if (channels > (DSP_LIMITER_MAX_CHANNELS))
+    {
+        return;
+    }
+
+    for (frame = 0U; frame < block->frames; frame++)
+    {
+        /* Peak level held for the look-ahead */
+        level = dsp_limiter_detect(block, frame);
+        if (level >= dsp_limiter_hold)
+        {
+            dsp_limiter_hold = level;
+            dsp_limiter_hold_frames = (DSP_LIMITER_LOOKAHEAD_FRAMES);
+        }
+        else if (dsp_limiter_hold_frames > 0U)
+        {
+            dsp_limiter_hold_frames--;
+        }
+        else
+        {
+            dsp_limiter_hold = level;
+        }
+
+        /* Envelope: fast attack, slow release */
+        if (dsp_limiter_hold > dsp_limiter_envelope)
+        {
+            dsp_limiter_envelope += (dsp_limiter_hold - dsp_limiter_envelope) >> (DSP_LIMITER_ATTACK_SHIFT);
+        }
+        else
+        {
+            dsp_limiter_envelope -= (dsp_limiter_envelope - dsp_limiter_hold) >> dsp_limiter_release_shift;
+        }
+
+        gain = dsp_limiter_gain(dsp_limiter_envelope);
+        if (gain < min_gain)
+        {
+            min_gain = gain;
+        }
+
+        /* Swap the incoming frame with the frame leaving the look-ahead */
+        delayed = dsp_limiter_delay[dsp_limiter_delay_index];
+        dsp_limiter_delay_index = (dsp_limiter_delay_index < ((DSP_LIMITER_LOOKAHEAD_FRAMES) - 1U)) ?
+                                  (dsp_limiter_delay_index + 1U) : 0U;
+
+        for (channel = 0U; channel < channels; channel++)
+        {
+            if (wide)
+            {
+                x = samples_32[(frame * channels) + channel];
+                samples_32[(frame * channels) + channel] = delayed[channel];
+            }
+            else
+            {
+                x = samples_16[(frame * channels) + channel];
+                samples_16[(frame * channels) + channel] = (int16_t) delayed[channel];
+            }
+            delayed[channel] = x;
+        }
+
+        /* Gain of the frame leaving the look-ahead, now in the block. The
+         * envelope may still be a few LSB short of a peak just above the
+         * threshold (unity gain), the clip applies while one is held. */
+        if ((gain < (DSP_LIMITER_UNITY)) || (dsp_limiter_hold > (DSP_LIMITER_THRESHOLD_Q31)))
+        {
+            for (channel = 0U; channel < channels; channel++)
+            {
+                y = wide ? samples_32[(frame * channels) + channel] : samples_16[(frame * channels) + channel];
+                y = (int32_t) (((int64_t) y * (int32_t) gain) >> 15U);
+                y = (y > ceiling) ? ceiling : y;
+                y = (y < -ceiling) ? -ceiling : y;
+
+                if (wide)
+                {
+                    samples_32[(frame * channels) + channel] = y;
+                }
+                else
+                {
+                    samples_16[(frame * channels) + channel] = (int16_t) y;
+                }
+            }
+        }
+    }
+
+    dsp_limiter_min_gain = min_gain;
+}
+
+/*****************************************************************************
+* Function Name: dsp_limiter_detect
+******************************************************************************
+* Summary:
+*  Get the peak level of the channels of a frame.
+*
+* Parameters:
+*  block: Block of samples
+*  frame: Index of the frame in the block
+*
+* Return:
+*  uint32_t: Peak level, Q31
+*
+*****************************************************************************/
+static uint32_t dsp_limiter_detect(const dsp_block_t *block, uint32_t frame)
+{
+    uint32_t channels = block->channels;
+    uint32_t peak = 0U;
+    uint32_t level;
+    uint32_t channel;
+    int32_t x;
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        if (sizeof(int16_t) == block->sample_size)
+        {
+            x = ((const int16_t *) block->samples)[(frame * channels) + channel];
+            level = DSP_LIMITER_LEVEL_S16(x);
+        }
+        else
+        {
+            x = ((const int32_t *) block->samples)[(frame * channels) + channel];
+            level = DSP_LIMITER_LEVEL_S24(x);
+        }
+        peak = (level > peak) ? level : peak;
+    }
+
+    return peak;
+}
+
+/*****************************************************************************
+* Function Name: dsp_limiter_gain
+******************************************************************************
+* Summary:
+*  Compute the gain bringing a level down to the threshold, threshold /
+*  level, without divide: the level is normalized to m in [0.5, 1) with a
+*  count of leading zeros, and 1/m is refined from a linear estimate with
+*  two Newton-Raphson iterations (within 2 LSB of the exact gain).
+*
+* Parameters:
+*  level: Level, Q31
+*
+* Return:
+*  uint32_t: Gain in Q15, DSP_LIMITER_UNITY below the threshold
+*
+*****************************************************************************/
+static uint32_t dsp_limiter_gain(uint32_t level)
+{
+    uint32_t shift;
+    uint32_t m;
+    uint32_t r;
+    uint32_t e;
+
+    if (level <= (DSP_LIMITER_THRESHOLD_Q31))
+    {
+        return (DSP_LIMITER_UNITY);
+    }
+
+    /* level = m * 2^(32 - shift), m in [0.5, 1) as Q32 */
+    shift = __CLZ(level);
+    m = level << shift;
+
+    /* r = 1/m, Q30, in (1, 2] */
+    r = (DSP_LIMITER_RECIP_A_Q30) - (uint32_t) (((uint64_t) (DSP_LIMITER_RECIP_B_Q30) * m) >> 32U);
+    e = (uint32_t) (0x80000000UL - (((uint64_t) m * r) >> 32U));      /* 2 - m r, Q30 */
+    r = (uint32_t) (((uint64_t) r * e) >> 30U);
+    e = (uint32_t) (0x80000000UL - (((uint64_t) m * r) >> 32U));
+    r = (uint32_t) (((uint64_t) r * e) >> 30U);
+
+    /* threshold / level, Q15 */
+    return (uint32_t) (((uint64_t) (DSP_LIMITER_THRESHOLD_Q31) * r) >> (47U - shift));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,493 @@
+/*****************************************************************************
+* File Name    : dsp_src.c
+*
+* Description  : This file contains the polyphase sample rate converter stage
+*                of the DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_src.h"
+
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Sample rates of the 44.1 KHz family are multiples of this rate */
+#define DSP_SRC_FAMILY_RATE             (11025U)
+
+/* Frames converted per pass: the input of a pass is appended to the last
+ * DSP_SRC_TAPS - 1 samples of each channel.
+ */
+#define DSP_SRC_CHUNK_FRAMES            (32U)
+#define DSP_SRC_HISTORY                 ((DSP_SRC_TAPS) - 1U)
+#define DSP_SRC_CHANNELS                (2U)
+
+#define DSP_SRC_ROUND                   (1L << ((DSP_SRC_Q) - 1U))
+#define DSP_SRC_INT16_MAX               (32767L)
+#define DSP_SRC_INT16_MIN               (-32768L)
+#define DSP_SRC_INT24_MAX               (8388607L)
+#define DSP_SRC_INT24_MIN               (-8388608L)
+
+#if (((DSP_SRC_TAPS) % 4U) != 0U)
+#error "DSP_SRC_TAPS must be a multiple of 4."
+#endif
+
+#if ((DSP_SRC_DOWN) < (DSP_SRC_UP))
+#error "The converter only reduces the sample rate."
+#endif
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/* Position of the next output frame: newest input frame it uses (relative
+ * to the start of the next input) and branch of the filter
+ */
+typedef struct
+{
+    uint32_t index;
+    uint32_t phase;
+} dsp_src_cursor_t;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void dsp_src_advance(dsp_src_cursor_t *cursor, uint32_t frames);
+static int32_t dsp_src_mac_s16(const int16_t *coefs, const int16_t *x);
+static int32_t dsp_src_mac_s32(const int16_t *coefs, const int32_t *x);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Coefficients of the active conversion, NULL when the rate is captured as
+ * is
+ */
+static const int16_t *dsp_src_coefs = NULL;
+
+/* Cursor of the conversion, and cursor of the planning of the capture,
+ * which runs ahead of the conversion by the periods in flight
+ */
+static dsp_src_cursor_t dsp_src_cursor;
+static dsp_src_cursor_t dsp_src_plan_cursor;
+
+/* Last input samples of each channel followed by the input of the pass */
+static union
+{
+    int16_t s16[DSP_SRC_CHANNELS][(DSP_SRC_HISTORY) + (DSP_SRC_CHUNK_FRAMES)];
+    int32_t s32[DSP_SRC_CHANNELS][(DSP_SRC_HISTORY) + (DSP_SRC_CHUNK_FRAMES)];
+} dsp_src_history;
+
+
+/*****************************************************************************
+* Function Name: dsp_src_get_capture_rate
+******************************************************************************
+* Summary:
+*  Get the rate the PDM/PCM block captures at to produce a sample rate. The
+*  rates of the 44.1 KHz family are converted from the 48 KHz family, so the
+*  audio subsystem clock never changes.
+*
+* Parameters:
+*  sample_rate: Sample rate sent to the host, in Hz
+*
+* Return:
+*  uint32_t: Capture rate in Hz
+*
+*****************************************************************************/
+uint32_t dsp_src_get_capture_rate(uint32_t sample_rate)
+{
+    if (0U == (sample_rate % (DSP_SRC_FAMILY_RATE)))
+    {
+        return (sample_rate / (DSP_SRC_UP)) * (DSP_SRC_DOWN);
+    }
+
+    return sample_rate;
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_configure
+******************************************************************************
+* Summary:
+*  Select the conversion of a new sample rate, if any, and reset the state.
+*
+* Parameters:
+*  sample_rate: Sample rate sent to the host, in Hz
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_src_configure(uint32_t sample_rate)
+{
+    dsp_src_coefs = (dsp_src_get_capture_rate(sample_rate) != sample_rate) ? dsp_src_coefs_147_160 : NULL;
+    dsp_src_reset();
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_reset
+******************************************************************************
+* Summary:
+*  Clear the past samples and restart the conversion and its planning from
+*  the first branch. Must be called before the capture starts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_src_reset(void)
+{
+    memset(&dsp_src_history, 0, sizeof(dsp_src_history));
+    dsp_src_cursor.index = 0U;
+    dsp_src_cursor.phase = 0U;
+    dsp_src_plan_cursor = dsp_src_cursor;
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_plan
+******************************************************************************
+* Summary:
+*  Get the number of frames to capture so that the conversion of the period
+*  produces exactly a number of frames. The periods must then be converted
+*  in the order they were planned; a shorter period only produces fewer
+*  frames. Can be called from interrupt context.
+*
+* Parameters:
+*  frames: Frames to produce
+*
+* Return:
+*  uint32_t: Frames to capture
+*
+*****************************************************************************/
+uint32_t dsp_src_plan(uint32_t frames)
+{
+    uint32_t needed;
+
+    if ((NULL == dsp_src_coefs) || (0U == frames))
+    {
+        return frames;
+    }
+
+    /* The last frame produced uses input frame index + ((phase + (frames - 1) * DOWN) / UP) */
+    needed = dsp_src_plan_cursor.index +
+             ((dsp_src_plan_cursor.phase + ((frames - 1U) * (DSP_SRC_DOWN))) / (DSP_SRC_UP)) + 1U;
+
+    dsp_src_advance(&dsp_src_plan_cursor, frames);
+    dsp_src_plan_cursor.index -= needed;
+
+    return needed;
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_get_output_frames
+******************************************************************************
+* Summary:
+*  Get the number of frames produced on average from captured frames, e.g.
+*  to express the depth of the capture buffer at the sample rate of the
+*  host.
+*
+* Parameters:
+*  frames: Captured frames
+*
+* Return:
+*  uint32_t: Frames produced
+*
+*****************************************************************************/
+uint32_t dsp_src_get_output_frames(uint32_t frames)
+{
+    if (NULL == dsp_src_coefs)
+    {
+        return frames;
+    }
+
+    return (frames * (DSP_SRC_UP)) / (DSP_SRC_DOWN);
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_get_latency
+******************************************************************************
+* Summary:
+*  Get the delay added to the samples by the active conversion: the
+*  DSP_SRC_LATENCY captured frames, 22 frames at the rate of the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Delay in frames of the host, 0 when the rate is captured as is
+*
+*****************************************************************************/
+uint32_t dsp_src_get_latency(void)
+{
+    if (NULL == dsp_src_coefs)
+    {
+        return 0U;
+    }
+
+    return ((DSP_SRC_LATENCY) * (DSP_SRC_UP)) / (DSP_SRC_DOWN);
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_advance
+******************************************************************************
+* Summary:
+*  Move a cursor by a number of output frames.
+*
+* Parameters:
+*  cursor: Cursor to move
+*  frames: Output frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void dsp_src_advance(dsp_src_cursor_t *cursor, uint32_t frames)
+{
+    uint32_t phase = cursor->phase + (frames * (DSP_SRC_DOWN));
+
+    cursor->index += phase / (DSP_SRC_UP);
+    cursor->phase = phase % (DSP_SRC_UP);
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_mac_s16
+******************************************************************************
+* Summary:
+*  Apply a branch of the filter to DSP_SRC_TAPS 16-bit samples. With the
+*  DSP extension, two taps are accumulated per instruction; the branches
+*  are short enough for the 32-bit accumulator (see scripts/src_coefs.py).
+*
+* Parameters:
+*  coefs: Branch, oldest sample first
+*  x: Samples, oldest first
+*
+* Return:
+*  int32_t: Filtered sample, Q14
+*
+*****************************************************************************/
+static int32_t dsp_src_mac_s16(const int16_t *coefs, const int16_t *x)
+{
+    int32_t acc = 0;
+    uint32_t i;
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    uint32_t c0;
+    uint32_t c1;
+    uint32_t x0;
+    uint32_t x1;
+
+    for (i = 0U; i < (DSP_SRC_TAPS); i += 4U)
+    {
+        /* Samples are not word aligned at every position */
+        memcpy(&c0, &coefs[i], sizeof(c0));
+        memcpy(&c1, &coefs[i + 2U], sizeof(c1));
+        memcpy(&x0, &x[i], sizeof(x0));
+        memcpy(&x1, &x[i + 2U], sizeof(x1));
+
+        acc = (int32_t) __SMLAD(c0, x0, (uint32_t) acc);
+        acc = (int32_t) __SMLAD(c1, x1, (uint32_t) acc);
+    }
+#else
+    for (i = 0U; i < (DSP_SRC_TAPS); i++)
+    {
+        acc += (int32_t) coefs[i] * x[i];
+    }
+#endif /* __ARM_FEATURE_DSP */
+
+    return acc;
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_mac_s32
+******************************************************************************
+* Summary:
+*  Apply a branch of the filter to DSP_SRC_TAPS 24-bit samples.
+*
+* Parameters:
+*  coefs: Branch, oldest sample first
+*  x: Samples, oldest first
+*
+* Return:
+*  int32_t: Filtered sample, rounded
+*
+*****************************************************************************/
+static int32_t dsp_src_mac_s32(const int16_t *coefs, const int32_t *x)
+{
+    int64_t acc = DSP_SRC_ROUND;
+    uint32_t i;
+
+    for (i = 0U; i < (DSP_SRC_TAPS); i += 4U)
+    {
+        acc += (int64_t) coefs[i] * x[i];
+        acc += (int64_t) coefs[i + 1U] * x[i + 1U];
+        acc += (int64_t) coefs[i + 2U] * x[i + 2U];
+        acc += (int64_t) coefs[i + 3U] * x[i + 3U];
+    }
+
+    acc >>= (DSP_SRC_Q);
+    if (acc > DSP_SRC_INT24_MAX)
+    {
+        acc = DSP_SRC_INT24_MAX;
+    }
+    else if (acc < DSP_SRC_INT24_MIN)
+    {
+        acc = DSP_SRC_INT24_MIN;
+    }
+
+    return (int32_t) acc;
+}
+
+/*****************************************************************************
+* Function Name: dsp_src_process
+******************************************************************************
+* Summary:
+*  Convert a block to the sample rate of the host, in place: the block
+*  holds fewer frames on return. Each output frame applies the branch of its
+*  phase to the last DSP_SRC_TAPS input frames. The output never overtakes
+*  the input still to be read, since the converter only reduces the rate.
+*  Blocks captured at the sample rate of the host are left untouched.
+*
+* Parameters:
+*  block: Block to convert
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_src_process(dsp_block_t *block)
+{
+    const int16_t *coefs = dsp_src_coefs;
+    uint32_t channels = block->channels;
+    uint32_t start;
+    uint32_t count;
+    uint32_t out = 0U;
+    uint32_t ch;
+    uint32_t i;
+    int32_t acc;
+
+    if ((NULL == coefs) || (channels > (DSP_SRC_CHANNELS)))
+    {
+        return;
+    }
+
+    for (start = 0U; start < block->frames; start += count)
+    {
+        count = block->frames - start;
+        if (count > (DSP_SRC_CHUNK_FRAMES))
+        {
+            count = (DSP_SRC_CHUNK_FRAMES);
+        }
+
+        if (sizeof(int16_t) == block->sample_size)
+        {
+            int16_t *samples = (int16_t *) block->samples;
+
+            /* Append the input of the pass to the past samples */
+            for (ch = 0U; ch < channels; ch++)
+            {
+                for (i = 0U; i < count; i++)
+                {
+                    dsp_src_history.s16[ch][(DSP_SRC_HISTORY) + i] = samples[((start + i) * channels) + ch];
+                }
+            }
+
+            for (; dsp_src_cursor.index < count; out++)
+            {
+                for (ch = 0U; ch < channels; ch++)
+                {
+                    acc = dsp_src_mac_s16(&coefs[dsp_src_cursor.phase * (DSP_SRC_TAPS)],
+                                          &dsp_src_history.s16[ch][dsp_src_cursor.index]);
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+                    acc = __SSAT((acc + DSP_SRC_ROUND) >> (DSP_SRC_Q), 16);
+#else
+                    acc = (acc + DSP_SRC_ROUND) >> (DSP_SRC_Q);
+                    acc = (acc > DSP_SRC_INT16_MAX) ? DSP_SRC_INT16_MAX : ((acc < DSP_SRC_INT16_MIN) ? DSP_SRC_INT16_MIN : acc);
+#endif /* __ARM_FEATURE_DSP */
+                    samples[(out * channels) + ch] = (int16_t) acc;
+                }
+                dsp_src_advance(&dsp_src_cursor, 1U);
+            }
+
+            for (ch = 0U; ch < channels; ch++)
+            {
+                memmove(&dsp_src_history.s16[ch][0], &dsp_src_history.s16[ch][count],
+                        (DSP_SRC_HISTORY) * sizeof(int16_t));
+            }
+        }
+        else
+        {
+            int32_t *samples = (int32_t *) block->samples;
+
+            for (ch = 0U; ch < channels; ch++)
+            {
+                for (i = 0U; i < count; i++)
+                {
+                    dsp_src_history.s32[ch][(DSP_SRC_HISTORY) + i] = samples[((start + i) * channels) + ch];
+                }
+            }
+
+            for (; dsp_src_cursor.index < count; out++)
+            {
+                for (ch = 0U; ch < channels; ch++)
+                {
+                    samples[(out * channels) + ch] = dsp_src_mac_s32(&coefs[dsp_src_cursor.phase * (DSP_SRC_TAPS)],
+                                                                     &dsp_src_history.s32[ch][dsp_src_cursor.index]);
+                }
+                dsp_src_advance(&dsp_src_cursor, 1U);
+            }
+
+            for (ch = 0U; ch < channels; ch++)
+            {
+                memmove(&dsp_src_history.s32[ch][0], &dsp_src_history.s32[ch][count],
+                        (DSP_SRC_HISTORY) * sizeof(int32_t));
+            }
+        }
+
+        dsp_src_cursor.index -= count;
+    }
+
+    block->frames = out;
+}
+
+/* [] END OF FILE */
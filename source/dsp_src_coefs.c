@@ -0,0 +1,791 @@
+/*****************************************************************************
+* File Name    : dsp_src_coefs.c
+*
+* Description  : Coefficients of the polyphase sample rate converter,
+*                generated by scripts/src_coefs.py. Do not edit.
+*
+*                Ratio 147/160, 147 branches of 48 taps (Q14), Kaiser beta 6.0.
+*                From 48000 Hz: passband ripple 0.010 dB up to 20000 Hz,
+*                rejection 62.8 dB from 24000 Hz.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_src.h"
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+/* One branch per phase, oldest sample first */
+const int16_t dsp_src_coefs_147_160[(147U) * (DSP_SRC_TAPS)] =
+{
+    /* Phase 0 */
+        -2,      5,    -12,     21,    -33,     47,    -61,     71,    -74,     66,    -42,     -2,
+        69,   -161,    278,   -415,    569,   -730,    890,  -1039,   1165,  -1255,   1290,  15017,
+      1397,  -1303,   1191,  -1053,    897,   -731,    566,   -411,    273,   -156,     65,      2,
+       -45,     69,    -76,     72,    -61,     47,    -33,     21,    -12,      5,     -2,      0,
+    /* Phase 1 */
+        -2,      6,    -12,     22,    -34,     47,    -60,     70,    -73,     64,    -39,     -6,
+        74,   -167,    283,   -419,    570,   -729,    884,  -1025,   1138,  -1207,   1183,  15017,
+      1506,  -1351,   1216,  -1066,    903,   -732,    564,   -407,    268,   -151,     60,      6,
+       -49,     71,    -78,     73,    -62,     47,    -33,     21,    -11,      5,     -1,      0,
+    /* Phase 2 */
+        -2,      6,    -12,     22,    -34,     47,    -60,     69,    -71,     61,    -36,    -10,
+        79,   -172,    287,   -423,    572,   -727,    877,  -1010,   1112,  -1159,   1078,  15015,
+      1615,  -1399,   1241,  -1080,    908,   -733,    561,   -402,    262,   -146,     55,     10,
+       -52,     73,    -79,     74,    -62,     48,    -33,     21,    -11,      5,     -1,      0,
+    /* Phase 3 */
+        -2,      6,    -12,     22,    -34,     47,    -59,     68,    -69,     59,    -32,    -14,
+        84,   -177,    292,   -426,    574,   -725,    870,   -995,   1085,  -1111,    973,  15003,
+      1725,  -1446,   1266,  -1092,    913,   -733,    559,   -398,    257,   -140,     50,     14,
+       -55,     76,    -81,     75,    -62,     48,    -33,     21,    -11,      5,     -1,      0,
+    /* Phase 4 */
+        -2,      6,    -13,     22,    -34,     47,    -59,     67,    -68,     56,    -29,    -18,
+        88,   -181,    297,   -430,    575,   -723,    862,   -980,   1058,  -1062,    870,  14999,
+      1836,  -1493,   1291,  -1105,    918,   -733,    556,   -393,    251,   -135,     45,     19,
+       -58,     78,    -82,     76,    -63,     48,    -33,     20,    -11,      5,     -1,      0,
+    /* Phase 5 */
+        -2,      6,    -13,     22,    -34,     47,    -58,     66,    -66,     54,    -26,    -22,
+        93,   -186,    301,   -433,    576,   -720,    855,   -965,   1030,  -1014,    767,  14992,
+      1948,  -1540,   1315,  -1117,    923,   -733,    552,   -388,    246,   -129,     40,     23,
+       -62,     80,    -84,     76,    -63,     48,    -33,     20,    -11,      4,     -1,      0,
+    /* Phase 6 */
+        -2,      6,    -13,     22,    -34,     46,    -58,     65,    -64,     51,    -22,    -26,
+        97,   -191,    305,   -436,    577,   -718,    847,   -949,   1002,   -965,    666,  14980,
+      2061,  -1587,   1339,  -1129,    927,   -732,    549,   -383,    240,   -124,     35,     27,
+       -65,     83,    -85,     77,    -63,     48,    -33,     20,    -10,      4,     -1,      0,
+    /* Phase 7 */
+        -2,      7,    -13,     22,    -34,     46,    -57,     64,    -63,     49,    -19,    -30,
+       102,   -195,    309,   -439,    577,   -715,    838,   -933,    975,   -917,    566,  14964,
+      2175,  -1633,   1362,  -1140,    931,   -731,    545,   -378,    234,   -118,     30,     31,
+       -68,     85,    -86,     78,    -64,     48,    -32,     20,    -10,      4,     -1,      0,
+    /* Phase 8 */
+        -3,      7,    -13,     23,    -34,     46,    -57,     63,    -61,     46,    -16,    -34,
+       106,   -200,    313,   -442,    578,   -711,    830,   -916,    946,   -868,    467,  14951,
+      2289,  -1679,   1385,  -1151,    934,   -730,    541,   -372,    228,   -112,     25,     35,
+       -71,     87,    -88,     79,    -64,     48,    -32,     19,    -10,      4,     -1,     -1,
+    /* Phase 9 */
+        -3,      7,    -13,     23,    -34,     46,    -56,     62,    -59,     44,    -13,    -38,
+       111,   -204,    317,   -444,    578,   -708,    821,   -899,    918,   -820,    368,  14933,
+      2405,  -1725,   1408,  -1161,    937,   -729,    537,   -367,    222,   -107,     20,     39,
+       -74,     89,    -89,     79,    -64,     47,    -32,     19,    -10,      4,      0,     -1,
+    /* Phase 10 */
+        -3,      7,    -14,     23,    -34,     45,    -55,     61,    -57,     41,     -9,    -42,
+       115,   -209,    321,   -447,    578,   -704,    811,   -882,    889,   -771,    271,  14913,
+      2521,  -1770,   1430,  -1171,    940,   -727,    533,   -361,    216,   -101,     15,     44,
+       -77,     91,    -90,     80,    -64,     47,    -32,     19,     -9,      3,      0,     -1,
+    /* Phase 11 */
+        -3,      7,    -14,     23,    -34,     45,    -55,     59,    -55,     39,     -6,    -46,
+       119,   -213,    325,   -449,    578,   -700,    802,   -865,    860,   -723,    176,  14893,
+      2638,  -1816,   1452,  -1181,    943,   -725,    528,   -355,    210,    -95,     10,     48,
+       -80,     93,    -92,     81,    -65,     47,    -31,     18,     -9,      3,      0,     -1,
+    /* Phase 12 */
+        -3,      7,    -14,     23,    -34,     45,    -54,     58,    -54,     36,     -3,    -50,
+       123,   -217,    328,   -451,    577,   -696,    792,   -848,    831,   -674,     81,  14874,
+      2755,  -1860,   1473,  -1190,    945,   -723,    523,   -349,    204,    -89,      4,     52,
+       -84,     96,    -93,     81,    -65,     47,    -31,     18,     -9,      3,      0,     -1,
+    /* Phase 13 */
+        -3,      7,    -14,     23,    -34,     44,    -53,     57,    -52,     34,      0,    -54,
+       128,   -221,    331,   -453,    576,   -691,    782,   -830,    802,   -626,    -13,  14849,
+      2873,  -1905,   1494,  -1199,    947,   -720,    518,   -343,    197,    -83,     -1,     56,
+       -87,     98,    -94,     82,    -65,     47,    -31,     18,     -9,      3,      0,     -1,
+    /* Phase 14 */
+        -3,      7,    -14,     23,    -34,     44,    -53,     56,    -50,     31,      4,    -58,
+       132,   -225,    335,   -454,    575,   -686,    772,   -812,    773,   -577,   -105,  14819,
+      2992,  -1949,   1514,  -1208,    948,   -717,    513,   -337,    191,    -77,     -6,     60,
+       -90,    100,    -95,     82,    -65,     47,    -31,     18,     -8,      3,      0,     -1,
+    /* Phase 15 */
+        -3,      7,    -14,     23,    -33,     44,    -52,     54,    -48,     29,      7,    -61,
+       136,   -229,    338,   -456,    574,   -681,    761,   -793,    743,   -529,   -196,  14790,
+      3112,  -1992,   1534,  -1216,    949,   -714,    507,   -330,    184,    -71,    -11,     64,
+       -93,    102,    -97,     83,    -65,     47,    -30,     17,     -8,      2,      0,     -1,
+    /* Phase 16 */
+        -3,      8,    -14,     23,    -33,     43,    -51,     53,    -46,     26,     10,    -65,
+       140,   -233,    341,   -457,    573,   -676,    750,   -775,    713,   -481,   -286,  14759,
+      3232,  -2035,   1554,  -1223,    950,   -711,    502,   -323,    178,    -65,    -16,     68,
+       -96,    104,    -98,     83,    -65,     46,    -30,     17,     -8,      2,      0,     -1,
+    /* Phase 17 */
+        -3,      8,    -14,     23,    -33,     43,    -50,     52,    -44,     24,     13,    -69,
+       144,   -236,    343,   -458,    571,   -670,    739,   -756,    684,   -433,   -375,  14724,
+      3353,  -2078,   1572,  -1230,    950,   -707,    496,   -317,    171,    -59,    -21,     72,
+       -99,    106,    -99,     84,    -65,     46,    -30,     17,     -7,      2,      1,     -1,
+    /* Phase 18 */
+        -3,      8,    -14,     23,    -33,     43,    -50,     51,    -42,     21,     17,    -72,
+       147,   -240,    346,   -459,    569,   -664,    728,   -737,    654,   -385,   -463,  14690,
+      3475,  -2120,   1591,  -1237,    950,   -703,    490,   -310,    164,    -52,    -27,     76,
+      -102,    107,   -100,     84,    -65,     46,    -29,     16,     -7,      2,      1,     -1,
+    /* Phase 19 */
+        -4,      8,    -15,     23,    -33,     42,    -49,     49,    -40,     18,     20,    -76,
+       151,   -243,    348,   -460,    567,   -658,    716,   -718,    624,   -338,   -549,  14657,
+      3597,  -2161,   1609,  -1243,    950,   -699,    483,   -303,    157,    -46,    -32,     80,
+      -104,    109,   -101,     85,    -65,     46,    -29,     16,     -7,      2,      1,     -1,
+    /* Phase 20 */
+        -4,      8,    -15,     23,    -33,     42,    -48,     48,    -38,     16,     23,    -80,
+       155,   -247,    351,   -460,    565,   -652,    704,   -698,    593,   -290,   -634,  14619,
+      3719,  -2203,   1626,  -1249,    949,   -694,    477,   -295,    150,    -40,    -37,     85,
+      -107,    111,   -102,     85,    -65,     45,    -29,     16,     -7,      1,      1,     -1,
+    /* Phase 21 */
+        -4,      8,    -15,     23,    -33,     41,    -47,     47,    -37,     13,     26,    -83,
+       158,   -250,    353,   -461,    562,   -645,    692,   -679,    563,   -243,   -718,  14580,
+      3842,  -2243,   1643,  -1254,    948,   -689,    470,   -288,    143,    -33,    -42,     89,
+      -110,    113,   -103,     85,    -65,     45,    -28,     15,     -6,      1,      1,     -1,
+    /* Phase 22 */
+        -4,      8,    -15,     23,    -32,     41,    -46,     45,    -35,     11,     29,    -87,
+       162,   -253,    355,   -461,    560,   -639,    680,   -659,    533,   -196,   -800,  14539,
+      3966,  -2283,   1659,  -1259,    946,   -684,    463,   -281,    136,    -27,    -48,     92,
+      -113,    115,   -104,     86,    -65,     45,    -28,     15,     -6,      1,      1,     -2,
+    /* Phase 23 */
+        -4,      8,    -15,     23,    -32,     40,    -45,     44,    -33,      8,     32,    -90,
+       166,   -256,    357,   -461,    557,   -632,    667,   -639,    503,   -149,   -881,  14497,
+      4090,  -2323,   1675,  -1263,    944,   -679,    456,   -273,    128,    -21,    -53,     96,
+      -116,    116,   -105,     86,    -65,     45,    -27,     14,     -6,      1,      1,     -2,
+    /* Phase 24 */
+        -4,      8,    -15,     23,    -32,     40,    -44,     43,    -31,      6,     35,    -94,
+       169,   -259,    359,   -461,    554,   -624,    655,   -619,    472,   -103,   -961,  14446,
+      4215,  -2361,   1690,  -1267,    942,   -673,    449,   -265,    121,    -14,    -58,    100,
+      -118,    118,   -106,     86,    -65,     44,    -27,     14,     -5,      1,      2,     -2,
+    /* Phase 25 */
+        -4,      8,    -15,     23,    -32,     39,    -44,     41,    -29,      3,     38,    -97,
+       172,   -262,    361,   -460,    550,   -617,    642,   -599,    442,    -56,  -1040,  14404,
+      4339,  -2400,   1704,  -1271,    939,   -667,    441,   -257,    114,     -8,    -63,    104,
+      -121,    120,   -106,     86,    -64,     44,    -27,     14,     -5,      0,      2,     -2,
+    /* Phase 26 */
+        -4,      8,    -15,     23,    -32,     39,    -43,     40,    -27,      1,     41,   -100,
+       176,   -265,    362,   -460,    547,   -609,    629,   -578,    411,    -10,  -1117,  14351,
+      4465,  -2437,   1718,  -1273,    936,   -661,    434,   -249,    106,     -1,    -68,    108,
+      -124,    121,   -107,     87,    -64,     43,    -26,     13,     -5,      0,      2,     -2,
+    /* Phase 27 */
+        -4,      9,    -15,     23,    -31,     38,    -42,     38,    -25,     -2,     44,   -103,
+       179,   -267,    363,   -459,    543,   -602,    615,   -558,    381,     35,  -1193,  14300,
+      4591,  -2474,   1732,  -1276,    933,   -654,    426,   -241,     99,      5,    -74,    112,
+      -126,    123,   -108,     87,    -64,     43,    -26,     13,     -4,      0,      2,     -2,
+    /* Phase 28 */
+        -4,      9,    -15,     23,    -31,     38,    -41,     37,    -23,     -4,     47,   -107,
+       182,   -270,    365,   -458,    539,   -593,    602,   -537,    350,     81,  -1268,  14249,
+      4717,  -2510,   1744,  -1278,    929,   -648,    418,   -233,     91,     11,    -79,    116,
+      -129,    124,   -109,     87,    -64,     43,    -25,     12,     -4,      0,      2,     -2,
+    /* Phase 29 */
+        -4,      9,    -15,     23,    -31,     37,    -40,     35,    -21,     -7,     50,   -110,
+       185,   -272,    366,   -457,    535,   -585,    588,   -516,    320,    126,  -1341,  14196,
+      4843,  -2546,   1756,  -1279,    925,   -641,    409,   -225,     84,     18,    -84,    120,
+      -131,    126,   -109,     87,    -64,     42,    -25,     12,     -4,     -1,      2,     -2,
+    /* Phase 30 */
+        -4,      9,    -15,     23,    -31,     37,    -39,     34,    -19,     -9,     53,   -113,
+       188,   -274,    367,   -456,    531,   -577,    574,   -495,    289,    170,  -1413,  14139,
+      4970,  -2581,   1768,  -1280,    920,   -633,    401,   -216,     76,     24,    -89,    123,
+      -134,    127,   -110,     87,    -63,     42,    -24,     11,     -3,     -1,      2,     -2,
+    /* Phase 31 */
+        -4,      9,    -15,     23,    -30,     36,    -38,     33,    -17,    -12,     56,   -116,
+       191,   -277,    367,   -455,    527,   -568,    560,   -474,    259,    215,  -1484,  14081,
+      5097,  -2615,   1779,  -1281,    916,   -626,    392,   -208,     68,     31,    -94,    127,
+      -136,    129,   -110,     87,    -63,     41,    -24,     11,     -3,     -1,      2,     -2,
+    /* Phase 32 */
+        -4,      9,    -15,     22,    -30,     36,    -37,     31,    -15,    -14,     59,   -119,
+       193,   -279,    368,   -453,    522,   -559,    546,   -453,    228,    259,  -1553,  14021,
+      5224,  -2648,   1789,  -1281,    910,   -618,    384,   -199,     60,     38,    -99,    131,
+      -139,    130,   -111,     87,    -63,     41,    -23,     11,     -3,     -1,      3,     -2,
+    /* Phase 33 */
+        -4,      9,    -15,     22,    -30,     35,    -36,     30,    -13,    -17,     62,   -122,
+       196,   -280,    369,   -451,    517,   -550,    531,   -432,    198,    302,  -1621,  13961,
+      5352,  -2681,   1799,  -1280,    905,   -610,    375,   -191,     52,     44,   -104,    134,
+      -141,    131,   -111,     87,    -62,     40,    -23,     10,     -2,     -2,      3,     -2,
+    /* Phase 34 */
+        -4,      9,    -15,     22,    -29,     34,    -35,     28,    -11,    -19,     65,   -125,
+       199,   -282,    369,   -450,    512,   -541,    517,   -410,    168,    346,  -1687,  13894,
+      5479,  -2713,   1808,  -1280,    899,   -601,    366,   -182,     45,     51,   -109,    138,
+      -143,    133,   -112,     87,    -62,     40,    -22,     10,     -2,     -2,      3,     -2,
+    /* Phase 35 */
+        -4,      9,    -15,     22,    -29,     34,    -34,     27,     -9,    -22,     67,   -128,
+       201,   -284,    369,   -447,    507,   -532,    502,   -389,    137,    389,  -1752,  13835,
+      5607,  -2744,   1816,  -1278,    892,   -593,    356,   -173,     37,     57,   -114,    142,
+      -146,    134,   -112,     87,    -61,     39,    -22,      9,     -2,     -2,      3,     -2,
+    /* Phase 36 */
+        -5,      9,    -15,     22,    -29,     33,    -33,     25,     -7,    -24,     70,   -130,
+       204,   -286,    369,   -445,    501,   -522,    487,   -367,    107,    431,  -1816,  13768,
+      5735,  -2774,   1824,  -1276,    886,   -584,    347,   -164,     29,     64,   -119,    145,
+      -148,    135,   -113,     87,    -61,     39,    -21,      9,     -1,     -2,      3,     -3,
+    /* Phase 37 */
+        -5,      9,    -15,     22,    -28,     33,    -32,     24,     -5,    -27,     73,   -133,
+       206,   -287,    369,   -443,    496,   -512,    472,   -346,     77,    473,  -1878,  13703,
+      5863,  -2804,   1831,  -1274,    878,   -575,    337,   -155,     21,     70,   -124,    149,
+      -150,    136,   -113,     86,    -60,     38,    -20,      8,     -1,     -3,      3,     -3,
+    /* Phase 38 */
+        -5,      9,    -15,     22,    -28,     32,    -31,     22,     -3,    -29,     75,   -136,
+       208,   -288,    369,   -440,    490,   -502,    457,   -324,     47,    514,  -1939,  13634,
+      5991,  -2832,   1837,  -1271,    871,   -565,    327,   -145,     13,     77,   -129,    152,
+      -152,    137,   -113,     86,    -60,     37,    -20,      8,     -1,     -3,      3,     -3,
+    /* Phase 39 */
+        -5,      9,    -15,     22,    -28,     31,    -30,     21,     -1,    -31,     78,   -138,
+       211,   -290,    369,   -438,    484,   -492,    442,   -302,     18,    556,  -1999,  13558,
+      6120,  -2860,   1843,  -1267,    863,   -556,    317,   -136,      5,     83,   -134,    155,
+      -154,    138,   -113,     86,    -59,     37,    -19,      7,      0,     -3,      4,     -3,
+    /* Phase 40 */
+        -5,      9,    -15,     21,    -27,     31,    -29,     19,      1,    -34,     81,   -141,
+       213,   -291,    368,   -435,    478,   -482,    426,   -281,    -12,    596,  -2057,  13490,
+      6248,  -2887,   1848,  -1263,    855,   -546,    307,   -127,     -3,     90,   -139,    159,
+      -156,    139,   -114,     86,    -59,     36,    -19,      7,      0,     -3,      4,     -3,
+    /* Phase 41 */
+        -5,      9,    -15,     21,    -27,     30,    -28,     18,      3,    -36,     83,   -144,
+       215,   -292,    367,   -432,    472,   -472,    411,   -259,    -42,    636,  -2114,  13418,
+      6376,  -2913,   1852,  -1259,    847,   -536,    297,   -117,    -11,     96,   -144,    162,
+      -158,    140,   -114,     85,    -58,     35,    -18,      6,      1,     -3,      4,     -3,
+    /* Phase 42 */
+        -5,      9,    -15,     21,    -26,     29,    -27,     16,      5,    -38,     86,   -146,
+       217,   -293,    367,   -428,    465,   -461,    395,   -237,    -71,    676,  -2169,  13337,
+      6505,  -2938,   1856,  -1254,    838,   -525,    287,   -108,    -19,    102,   -148,    165,
+      -160,    141,   -114,     85,    -58,     35,    -17,      6,      1,     -4,      4,     -3,
+    /* Phase 43 */
+        -5,      9,    -15,     21,    -26,     29,    -26,     15,      7,    -41,     88,   -148,
+       218,   -294,    366,   -425,    459,   -450,    380,   -215,   -100,    715,  -2223,  13263,
+      6633,  -2962,   1859,  -1248,    828,   -515,    276,    -98,    -28,    109,   -153,    168,
+      -162,    142,   -114,     84,    -57,     34,    -17,      5,      1,     -4,      4,     -3,
+    /* Phase 44 */
+        -5,      9,    -15,     21,    -26,     28,    -25,     13,      9,    -43,     90,   -151,
+       220,   -294,    365,   -422,    452,   -440,    364,   -194,   -129,    754,  -2275,  13187,
+      6761,  -2985,   1861,  -1242,    819,   -504,    265,    -89,    -36,    115,   -158,    171,
+      -164,    142,   -114,     84,    -56,     33,    -16,      5,      2,     -4,      4,     -3,
+    /* Phase 45 */
+        -5,      9,    -15,     20,    -25,     27,    -24,     12,     10,    -45,     93,   -153,
+       222,   -295,    364,   -418,    445,   -429,    348,   -172,   -158,    792,  -2326,  13105,
+      6889,  -3007,   1862,  -1236,    809,   -493,    255,    -79,    -44,    122,   -162,    174,
+      -165,    143,   -114,     84,    -56,     33,    -16,      4,      2,     -4,      4,     -3,
+    /* Phase 46 */
+        -5,      9,    -14,     20,    -25,     26,    -22,     10,     12,    -47,     95,   -155,
+       223,   -295,    362,   -414,    438,   -417,    332,   -150,   -187,    829,  -2376,  13023,
+      7017,  -3028,   1863,  -1229,    799,   -482,    244,    -69,    -52,    128,   -167,    177,
+      -167,    144,   -114,     83,    -55,     32,    -15,      4,      2,     -5,      5,     -3,
+    /* Phase 47 */
+        -5,      9,    -14,     20,    -24,     26,    -21,      9,     14,    -49,     97,   -157,
+       225,   -296,    361,   -410,    431,   -406,    316,   -128,   -215,    866,  -2424,  12937,
+      7145,  -3048,   1863,  -1221,    788,   -470,    233,    -59,    -60,    134,   -172,    180,
+      -169,    144,   -114,     82,    -54,     31,    -14,      3,      3,     -5,      5,     -3,
+    /* Phase 48 */
+        -5,      9,    -14,     20,    -24,     25,    -20,      7,     16,    -52,    100,   -159,
+       226,   -296,    359,   -406,    423,   -395,    300,   -107,   -244,    903,  -2471,  12854,
+      7273,  -3068,   1863,  -1213,    777,   -458,    221,    -49,    -68,    141,   -176,    183,
+      -170,    145,   -114,     82,    -53,     30,    -14,      3,      3,     -5,      5,     -3,
+    /* Phase 49 */
+        -5,      9,    -14,     20,    -24,     24,    -19,      6,     18,    -54,    102,   -161,
+       228,   -296,    357,   -402,    416,   -383,    284,    -85,   -272,    938,  -2516,  12769,
+      7400,  -3086,   1861,  -1205,    766,   -446,    210,    -40,    -76,    147,   -180,    186,
+      -172,    145,   -113,     81,    -53,     30,    -13,      2,      3,     -5,      5,     -3,
+    /* Phase 50 */
+        -5,      9,    -14,     19,    -23,     23,    -18,      4,     20,    -56,    104,   -163,
+       229,   -296,    356,   -397,    408,   -372,    267,    -63,   -300,    974,  -2560,  12681,
+      7528,  -3103,   1859,  -1196,    754,   -434,    199,    -30,    -85,    153,   -185,    189,
+      -173,    146,   -113,     81,    -52,     29,    -12,      2,      4,     -6,      5,     -3,
+    /* Phase 51 */
+        -5,      9,    -14,     19,    -23,     23,    -17,      3,     22,    -58,    106,   -165,
+       230,   -296,    354,   -393,    400,   -360,    251,    -42,   -327,   1008,  -2602,  12595,
+      7655,  -3119,   1856,  -1186,    742,   -422,    187,    -20,    -93,    159,   -189,    191,
+      -174,    146,   -113,     80,    -51,     28,    -11,      1,      4,     -6,      5,     -4,
+    /* Phase 52 */
+        -5,      9,    -14,     19,    -22,     22,    -16,      1,     23,    -60,    108,   -167,
+       231,   -295,    351,   -388,    393,   -348,    235,    -20,   -354,   1042,  -2643,  12501,
+      7782,  -3134,   1853,  -1176,    730,   -409,    176,    -10,   -101,    165,   -193,    194,
+      -176,    146,   -112,     79,    -50,     27,    -11,      1,      5,     -6,      5,     -4,
+    /* Phase 53 */
+        -5,      9,    -14,     19,    -22,     21,    -15,      0,     25,    -62,    110,   -168,
+       232,   -295,    349,   -383,    385,   -336,    218,      1,   -381,   1076,  -2683,  12411,
+      7908,  -3148,   1849,  -1166,    717,   -397,    164,      0,   -109,    171,   -197,    196,
+      -177,    147,   -112,     79,    -49,     26,    -10,      0,      5,     -6,      5,     -4,
+    /* Phase 54 */
+        -5,      9,    -14,     18,    -21,     20,    -14,     -2,     27,    -64,    112,   -170,
+       233,   -295,    347,   -378,    376,   -324,    202,     22,   -408,   1109,  -2721,  12321,
+      8034,  -3161,   1844,  -1155,    704,   -384,    152,     11,   -117,    177,   -202,    199,
+      -178,    147,   -112,     78,    -48,     25,     -9,     -1,      5,     -7,      6,     -4,
+    /* Phase 55 */
+        -5,      9,    -14,     18,    -21,     20,    -13,     -3,     29,    -66,    114,   -171,
+       233,   -294,    344,   -373,    368,   -312,    186,     44,   -435,   1141,  -2758,  12223,
+      8160,  -3172,   1838,  -1143,    691,   -370,    140,     21,   -125,    183,   -206,    201,
+      -179,    147,   -111,     77,    -48,     25,     -9,     -1,      6,     -7,      6,     -4,
+    /* Phase 56 */
+        -5,      9,    -13,     18,    -20,     19,    -11,     -4,     31,    -68,    116,   -173,
+       234,   -293,    342,   -368,    360,   -300,    169,     65,   -461,   1173,  -2793,  12126,
+      8285,  -3183,   1831,  -1131,    677,   -357,    128,     31,   -133,    189,   -210,    204,
+      -180,    147,   -111,     76,    -47,     24,     -8,     -2,      6,     -7,      6,     -4,
+    /* Phase 57 */
+        -5,      9,    -13,     17,    -20,     18,    -10,     -6,     32,    -70,    118,   -174,
+       235,   -293,    339,   -363,    351,   -288,    153,     86,   -487,   1204,  -2827,  12032,
+      8410,  -3192,   1824,  -1119,    663,   -344,    116,     41,   -141,    195,   -214,    206,
+      -181,    147,   -110,     75,    -46,     23,     -7,     -2,      7,     -7,      6,     -4,
+    /* Phase 58 */
+        -5,      9,    -13,     17,    -19,     17,     -9,     -7,     34,    -72,    120,   -176,
+       235,   -292,    336,   -357,    343,   -276,    136,    107,   -513,   1234,  -2859,  11934,
+      8535,  -3201,   1816,  -1106,    649,   -330,    104,     51,   -149,    201,   -217,    208,
+      -182,    147,   -109,     74,    -45,     22,     -6,     -3,      7,     -8,      6,     -4,
+    /* Phase 59 */
+        -5,      9,    -13,     17,    -19,     17,     -8,     -9,     36,    -73,    121,   -177,
+       236,   -291,    333,   -352,    334,   -263,    120,    128,   -538,   1264,  -2890,  11833,
+      8659,  -3208,   1807,  -1092,    635,   -316,     92,     61,   -157,    207,   -221,    210,
+      -183,    147,   -109,     73,    -44,     21,     -6,     -3,      7,     -8,      6,     -4,
+    /* Phase 60 */
+        -5,      9,    -13,     17,    -18,     16,     -7,    -10,     37,    -75,    123,   -178,
+       236,   -289,    330,   -346,    325,   -251,    103,    148,   -563,   1293,  -2920,  11735,
+      8782,  -3214,   1798,  -1078,    620,   -302,     79,     71,   -165,    212,   -225,    212,
+      -184,    147,   -108,     72,    -43,     20,     -5,     -4,      8,     -8,      6,     -4,
+    /* Phase 61 */
+        -5,      9,    -13,     16,    -18,     15,     -6,    -12,     39,    -77,    125,   -179,
+       236,   -288,    327,   -340,    316,   -238,     87,    169,   -588,   1321,  -2948,  11631,
+      8905,  -3219,   1788,  -1064,    605,   -288,     67,     82,   -173,    218,   -228,    214,
+      -184,    147,   -107,     71,    -42,     19,     -4,     -4,      8,     -8,      6,     -4,
+    /* Phase 62 */
+        -5,      9,    -13,     16,    -17,     14,     -5,    -13,     41,    -79,    126,   -180,
+       236,   -287,    323,   -334,    307,   -226,     71,    189,   -612,   1349,  -2975,  11531,
+      9028,  -3222,   1777,  -1049,    589,   -274,     54,     92,   -180,    223,   -232,    216,
+      -185,    146,   -107,     70,    -41,     18,     -3,     -5,      8,     -8,      7,     -4,
+    /* Phase 63 */
+        -5,      8,    -12,     16,    -17,     13,     -4,    -14,     42,    -80,    128,   -181,
+       236,   -285,    320,   -328,    298,   -213,     54,    209,   -636,   1376,  -3000,  11424,
+      9150,  -3224,   1765,  -1034,    574,   -259,     42,    102,   -188,    229,   -235,    218,
+      -185,    146,   -106,     69,    -40,     17,     -3,     -6,      9,     -9,      7,     -4,
+    /* Phase 64 */
+        -5,      8,    -12,     15,    -16,     13,     -3,    -16,     44,    -82,    129,   -182,
+       236,   -284,    316,   -322,    289,   -201,     38,    230,   -660,   1402,  -3024,  11321,
+      9271,  -3226,   1753,  -1018,    558,   -244,     29,    112,   -196,    234,   -239,    220,
+      -186,    146,   -105,     68,    -38,     16,     -2,     -6,      9,     -9,      7,     -4,
+    /* Phase 65 */
+        -5,      8,    -12,     15,    -16,     12,     -1,    -17,     45,    -84,    130,   -183,
+       236,   -282,    313,   -316,    279,   -188,     21,    250,   -683,   1427,  -3047,  11217,
+      9391,  -3225,   1739,  -1002,    541,   -230,     17,    122,   -203,    240,   -242,    221,
+      -186,    145,   -104,     67,    -37,     15,     -1,     -7,     10,     -9,      7,     -4,
+    /* Phase 66 */
+        -5,      8,    -12,     15,    -15,     11,      0,    -19,     47,    -85,    132,   -184,
+       236,   -280,    309,   -310,    270,   -175,      5,    269,   -706,   1452,  -3068,  11108,
+      9511,  -3224,   1725,   -985,    525,   -215,      4,    132,   -211,    245,   -245,    223,
+      -187,    145,   -103,     66,    -36,     14,      0,     -7,     10,     -9,      7,     -4,
+    /* Phase 67 */
+        -5,      8,    -12,     14,    -14,     10,      1,    -20,     49,    -87,    133,   -184,
+       235,   -278,    305,   -303,    261,   -162,    -11,    289,   -728,   1477,  -3088,  10997,
+      9631,  -3221,   1711,   -968,    508,   -200,     -9,    143,   -219,    250,   -248,    224,
+      -187,    144,   -102,     65,    -35,     13,      1,     -8,     10,     -9,      7,     -4,
+    /* Phase 68 */
+        -5,      8,    -12,     14,    -14,      9,      2,    -21,     50,    -88,    134,   -185,
+       235,   -277,    301,   -297,    251,   -150,    -27,    308,   -751,   1500,  -3106,  10892,
+      9749,  -3217,   1695,   -950,    491,   -185,    -21,    153,   -226,    255,   -251,    226,
+      -187,    143,   -101,     64,    -34,     12,      1,     -8,     11,    -10,      7,     -4,
+    /* Phase 69 */
+        -5,      8,    -11,     14,    -13,      9,      3,    -23,     52,    -90,    135,   -185,
+       234,   -274,    297,   -290,    241,   -137,    -43,    328,   -772,   1523,  -3124,  10778,
+      9867,  -3212,   1679,   -932,    474,   -169,    -34,    163,   -233,    260,   -254,    227,
+      -187,    143,   -100,     62,    -33,     11,      2,     -9,     11,    -10,      7,     -4,
+    /* Phase 70 */
+        -5,      8,    -11,     13,    -13,      8,      4,    -24,     53,    -91,    137,   -186,
+       234,   -272,    292,   -283,    232,   -124,    -59,    347,   -794,   1545,  -3139,  10670,
+      9984,  -3206,   1662,   -914,    456,   -154,    -47,    173,   -241,    265,   -257,    228,
+      -187,    142,    -99,     61,    -31,     10,      3,    -10,     11,    -10,      7,     -4,
+    /* Phase 71 */
+        -5,      8,    -11,     13,    -12,      7,      5,    -25,     54,    -92,    138,   -186,
+       233,   -270,    288,   -276,    222,   -111,    -75,    366,   -815,   1566,  -3154,  10555,
+     10101,  -3198,   1644,   -895,    439,   -138,    -60,    183,   -248,    270,   -260,    229,
+      -187,    141,    -98,     60,    -30,      9,      4,    -10,     12,    -10,      8,     -5,
+    /* Phase 72 */
+        -5,      8,    -11,     13,    -12,      6,      6,    -26,     56,    -94,    139,   -187,
+       232,   -268,    284,   -269,    212,    -98,    -91,    384,   -836,   1587,  -3167,  10446,
+     10216,  -3189,   1626,   -875,    421,   -123,    -73,    193,   -255,    274,   -263,    230,
+      -187,    140,    -96,     59,    -29,      8,      5,    -11,     12,    -11,      8,     -5,
+    /* Phase 73 */
+        -5,      8,    -11,     12,    -11,      5,      7,    -28,     57,    -95,    140,   -187,
+       231,   -265,    279,   -262,    202,    -85,   -107,    403,   -856,   1607,  -3179,  10333,
+     10331,  -3179,   1607,   -856,    403,   -107,    -85,    202,   -262,    279,   -265,    231,
+      -187,    140,    -95,     57,    -28,      7,      5,    -11,     12,    -11,      8,     -5,
+    /* Phase 74 */
+        -5,      8,    -11,     12,    -11,      5,      8,    -29,     59,    -96,    140,   -187,
+       230,   -263,    274,   -255,    193,    -73,   -123,    421,   -875,   1626,  -3189,  10216,
+     10446,  -3167,   1587,   -836,    384,    -91,    -98,    212,   -269,    284,   -268,    232,
+      -187,    139,    -94,     56,    -26,      6,      6,    -12,     13,    -11,      8,     -5,
+    /* Phase 75 */
+        -5,      8,    -10,     12,    -10,      4,      9,    -30,     60,    -98,    141,   -187,
+       229,   -260,    270,   -248,    183,    -60,   -138,    439,   -895,   1644,  -3198,  10101,
+     10555,  -3154,   1566,   -815,    366,    -75,   -111,    222,   -276,    288,   -270,    233,
+      -186,    138,    -92,     54,    -25,      5,      7,    -12,     13,    -11,      8,     -5,
+    /* Phase 76 */
+        -4,      7,    -10,     11,    -10,      3,     10,    -31,     61,    -99,    142,   -187,
+       228,   -257,    265,   -241,    173,    -47,   -154,    456,   -914,   1662,  -3206,   9984,
+     10670,  -3139,   1545,   -794,    347,    -59,   -124,    232,   -283,    292,   -272,    234,
+      -186,    137,    -91,     53,    -24,      4,      8,    -13,     13,    -11,      8,     -5,
+    /* Phase 77 */
+        -4,      7,    -10,     11,     -9,      2,     11,    -33,     62,   -100,    143,   -187,
+       227,   -254,    260,   -233,    163,    -34,   -169,    474,   -932,   1679,  -3212,   9867,
+     10778,  -3124,   1523,   -772,    328,    -43,   -137,    241,   -290,    297,   -274,    234,
+      -185,    135,    -90,     52,    -23,      3,      9,    -13,     14,    -11,      8,     -5,
+    /* Phase 78 */
+        -4,      7,    -10,     11,     -8,      1,     12,    -34,     64,   -101,    143,   -187,
+       226,   -251,    255,   -226,    153,    -21,   -185,    491,   -950,   1695,  -3217,   9749,
+     10892,  -3106,   1500,   -751,    308,    -27,   -150,    251,   -297,    301,   -277,    235,
+      -185,    134,    -88,     50,    -21,      2,      9,    -14,     14,    -12,      8,     -5,
+    /* Phase 79 */
+        -4,      7,     -9,     10,     -8,      1,     13,    -35,     65,   -102,    144,   -187,
+       224,   -248,    250,   -219,    143,     -9,   -200,    508,   -968,   1711,  -3221,   9631,
+     10997,  -3088,   1477,   -728,    289,    -11,   -162,    261,   -303,    305,   -278,    235,
+      -184,    133,    -87,     49,    -20,      1,     10,    -14,     14,    -12,      8,     -5,
+    /* Phase 80 */
+        -4,      7,     -9,     10,     -7,      0,     14,    -36,     66,   -103,    145,   -187,
+       223,   -245,    245,   -211,    132,      4,   -215,    525,   -985,   1725,  -3224,   9511,
+     11108,  -3068,   1452,   -706,    269,      5,   -175,    270,   -310,    309,   -280,    236,
+      -184,    132,    -85,     47,    -19,      0,     11,    -15,     15,    -12,      8,     -5,
+    /* Phase 81 */
+        -4,      7,     -9,     10,     -7,     -1,     15,    -37,     67,   -104,    145,   -186,
+       221,   -242,    240,   -203,    122,     17,   -230,    541,  -1002,   1739,  -3225,   9391,
+     11217,  -3047,   1427,   -683,    250,     21,   -188,    279,   -316,    313,   -282,    236,
+      -183,    130,    -84,     45,    -17,     -1,     12,    -16,     15,    -12,      8,     -5,
+    /* Phase 82 */
+        -4,      7,     -9,      9,     -6,     -2,     16,    -38,     68,   -105,    146,   -186,
+       220,   -239,    234,   -196,    112,     29,   -244,    558,  -1018,   1753,  -3226,   9271,
+     11321,  -3024,   1402,   -660,    230,     38,   -201,    289,   -322,    316,   -284,    236,
+      -182,    129,    -82,     44,    -16,     -3,     13,    -16,     15,    -12,      8,     -5,
+    /* Phase 83 */
+        -4,      7,     -9,      9,     -6,     -3,     17,    -40,     69,   -106,    146,   -185,
+       218,   -235,    229,   -188,    102,     42,   -259,    574,  -1034,   1765,  -3224,   9150,
+     11424,  -3000,   1376,   -636,    209,     54,   -213,    298,   -328,    320,   -285,    236,
+      -181,    128,    -80,     42,    -14,     -4,     13,    -17,     16,    -12,      8,     -5,
+    /* Phase 84 */
+        -4,      7,     -8,      8,     -5,     -3,     18,    -41,     70,   -107,    146,   -185,
+       216,   -232,    223,   -180,     92,     54,   -274,    589,  -1049,   1777,  -3222,   9028,
+     11531,  -2975,   1349,   -612,    189,     71,   -226,    307,   -334,    323,   -287,    236,
+      -180,    126,    -79,     41,    -13,     -5,     14,    -17,     16,    -13,      9,     -5,
+    /* Phase 85 */
+        -4,      6,     -8,      8,     -4,     -4,     19,    -42,     71,   -107,    147,   -184,
+       214,   -228,    218,   -173,     82,     67,   -288,    605,  -1064,   1788,  -3219,   8905,
+     11631,  -2948,   1321,   -588,    169,     87,   -238,    316,   -340,    327,   -288,    236,
+      -179,    125,    -77,     39,    -12,     -6,     15,    -18,     16,    -13,      9,     -5,
+    /* Phase 86 */
+        -4,      6,     -8,      8,     -4,     -5,     20,    -43,     72,   -108,    147,   -184,
+       212,   -225,    212,   -165,     71,     79,   -302,    620,  -1078,   1798,  -3214,   8782,
+     11735,  -2920,   1293,   -563,    148,    103,   -251,    325,   -346,    330,   -289,    236,
+      -178,    123,    -75,     37,    -10,     -7,     16,    -18,     17,    -13,      9,     -5,
+    /* Phase 87 */
+        -4,      6,     -8,      7,     -3,     -6,     21,    -44,     73,   -109,    147,   -183,
+       210,   -221,    207,   -157,     61,     92,   -316,    635,  -1092,   1807,  -3208,   8659,
+     11833,  -2890,   1264,   -538,    128,    120,   -263,    334,   -352,    333,   -291,    236,
+      -177,    121,    -73,     36,     -9,     -8,     17,    -19,     17,    -13,      9,     -5,
+    /* Phase 88 */
+        -4,      6,     -8,      7,     -3,     -6,     22,    -45,     74,   -109,    147,   -182,
+       208,   -217,    201,   -149,     51,    104,   -330,    649,  -1106,   1816,  -3201,   8535,
+     11934,  -2859,   1234,   -513,    107,    136,   -276,    343,   -357,    336,   -292,    235,
+      -176,    120,    -72,     34,     -7,     -9,     17,    -19,     17,    -13,      9,     -5,
+    /* Phase 89 */
+        -4,      6,     -7,      7,     -2,     -7,     23,    -46,     75,   -110,    147,   -181,
+       206,   -214,    195,   -141,     41,    116,   -344,    663,  -1119,   1824,  -3192,   8410,
+     12032,  -2827,   1204,   -487,     86,    153,   -288,    351,   -363,    339,   -293,    235,
+      -174,    118,    -70,     32,     -6,    -10,     18,    -20,     17,    -13,      9,     -5,
+    /* Phase 90 */
+        -4,      6,     -7,      6,     -2,     -8,     24,    -47,     76,   -111,    147,   -180,
+       204,   -210,    189,   -133,     31,    128,   -357,    677,  -1131,   1831,  -3183,   8285,
+     12126,  -2793,   1173,   -461,     65,    169,   -300,    360,   -368,    342,   -293,    234,
+      -173,    116,    -68,     31,     -4,    -11,     19,    -20,     18,    -13,      9,     -5,
+    /* Phase 91 */
+        -4,      6,     -7,      6,     -1,     -9,     25,    -48,     77,   -111,    147,   -179,
+       201,   -206,    183,   -125,     21,    140,   -370,    691,  -1143,   1838,  -3172,   8160,
+     12223,  -2758,   1141,   -435,     44,    186,   -312,    368,   -373,    344,   -294,    233,
+      -171,    114,    -66,     29,     -3,    -13,     20,    -21,     18,    -14,      9,     -5,
+    /* Phase 92 */
+        -4,      6,     -7,      5,     -1,     -9,     25,    -48,     78,   -112,    147,   -178,
+       199,   -202,    177,   -117,     11,    152,   -384,    704,  -1155,   1844,  -3161,   8034,
+     12321,  -2721,   1109,   -408,     22,    202,   -324,    376,   -378,    347,   -295,    233,
+      -170,    112,    -64,     27,     -2,    -14,     20,    -21,     18,    -14,      9,     -5,
+    /* Phase 93 */
+        -4,      5,     -6,      5,      0,    -10,     26,    -49,     79,   -112,    147,   -177,
+       196,   -197,    171,   -109,      0,    164,   -397,    717,  -1166,   1849,  -3148,   7908,
+     12411,  -2683,   1076,   -381,      1,    218,   -336,    385,   -383,    349,   -295,    232,
+      -168,    110,    -62,     25,      0,    -15,     21,    -22,     19,    -14,      9,     -5,
+    /* Phase 94 */
+        -4,      5,     -6,      5,      1,    -11,     27,    -50,     79,   -112,    146,   -176,
+       194,   -193,    165,   -101,    -10,    176,   -409,    730,  -1176,   1853,  -3134,   7782,
+     12501,  -2643,   1042,   -354,    -20,    235,   -348,    393,   -388,    351,   -295,    231,
+      -167,    108,    -60,     23,      1,    -16,     22,    -22,     19,    -14,      9,     -5,
+    /* Phase 95 */
+        -4,      5,     -6,      4,      1,    -11,     28,    -51,     80,   -113,    146,   -174,
+       191,   -189,    159,    -93,    -20,    187,   -422,    742,  -1186,   1856,  -3119,   7655,
+     12595,  -2602,   1008,   -327,    -42,    251,   -360,    400,   -393,    354,   -296,    230,
+      -165,    106,    -58,     22,      3,    -17,     23,    -23,     19,    -14,      9,     -5,
+    /* Phase 96 */
+        -3,      5,     -6,      4,      2,    -12,     29,    -52,     81,   -113,    146,   -173,
+       189,   -185,    153,    -85,    -30,    199,   -434,    754,  -1196,   1859,  -3103,   7528,
+     12681,  -2560,    974,   -300,    -63,    267,   -372,    408,   -397,    356,   -296,    229,
+      -163,    104,    -56,     20,      4,    -18,     23,    -23,     19,    -14,      9,     -5,
+    /* Phase 97 */
+        -3,      5,     -5,      3,      2,    -13,     30,    -53,     81,   -113,    145,   -172,
+       186,   -180,    147,    -76,    -40,    210,   -446,    766,  -1205,   1861,  -3086,   7400,
+     12769,  -2516,    938,   -272,    -85,    284,   -383,    416,   -402,    357,   -296,    228,
+      -161,    102,    -54,     18,      6,    -19,     24,    -24,     20,    -14,      9,     -5,
+    /* Phase 98 */
+        -3,      5,     -5,      3,      3,    -14,     30,    -53,     82,   -114,    145,   -170,
+       183,   -176,    141,    -68,    -49,    221,   -458,    777,  -1213,   1863,  -3068,   7273,
+     12854,  -2471,    903,   -244,   -107,    300,   -395,    423,   -406,    359,   -296,    226,
+      -159,    100,    -52,     16,      7,    -20,     25,    -24,     20,    -14,      9,     -5,
+    /* Phase 99 */
+        -3,      5,     -5,      3,      3,    -14,     31,    -54,     82,   -114,    144,   -169,
+       180,   -172,    134,    -60,    -59,    233,   -470,    788,  -1221,   1863,  -3048,   7145,
+     12937,  -2424,    866,   -215,   -128,    316,   -406,    431,   -410,    361,   -296,    225,
+      -157,     97,    -49,     14,      9,    -21,     26,    -24,     20,    -14,      9,     -5,
+    /* Phase 100 */
+        -3,      5,     -5,      2,      4,    -15,     32,    -55,     83,   -114,    144,   -167,
+       177,   -167,    128,    -52,    -69,    244,   -482,    799,  -1229,   1863,  -3028,   7017,
+     13023,  -2376,    829,   -187,   -150,    332,   -417,    438,   -414,    362,   -295,    223,
+      -155,     95,    -47,     12,     10,    -22,     26,    -25,     20,    -14,      9,     -5,
+    /* Phase 101 */
+        -3,      4,     -4,      2,      4,    -16,     33,    -56,     84,   -114,    143,   -165,
+       174,   -162,    122,    -44,    -79,    255,   -493,    809,  -1236,   1862,  -3007,   6889,
+     13105,  -2326,    792,   -158,   -172,    348,   -429,    445,   -418,    364,   -295,    222,
+      -153,     93,    -45,     10,     12,    -24,     27,    -25,     20,    -15,      9,     -5,
+    /* Phase 102 */
+        -3,      4,     -4,      2,      5,    -16,     33,    -56,     84,   -114,    142,   -164,
+       171,   -158,    115,    -36,    -89,    265,   -504,    819,  -1242,   1861,  -2985,   6761,
+     13187,  -2275,    754,   -129,   -194,    364,   -440,    452,   -422,    365,   -294,    220,
+      -151,     90,    -43,      9,     13,    -25,     28,    -26,     21,    -15,      9,     -5,
+    /* Phase 103 */
+        -3,      4,     -4,      1,      5,    -17,     34,    -57,     84,   -114,    142,   -162,
+       168,   -153,    109,    -28,    -98,    276,   -515,    828,  -1248,   1859,  -2962,   6633,
+     13263,  -2223,    715,   -100,   -215,    380,   -450,    459,   -425,    366,   -294,    218,
+      -148,     88,    -41,      7,     15,    -26,     29,    -26,     21,    -15,      9,     -5,
+    /* Phase 104 */
+        -3,      4,     -4,      1,      6,    -17,     35,    -58,     85,   -114,    141,   -160,
+       165,   -148,    102,    -19,   -108,    287,   -525,    838,  -1254,   1856,  -2938,   6505,
+     13337,  -2169,    676,    -71,   -237,    395,   -461,    465,   -428,    367,   -293,    217,
+      -146,     86,    -38,      5,     16,    -27,     29,    -26,     21,    -15,      9,     -5,
+    /* Phase 105 */
+        -3,      4,     -3,      1,      6,    -18,     35,    -58,     85,   -114,    140,   -158,
+       162,   -144,     96,    -11,   -117,    297,   -536,    847,  -1259,   1852,  -2913,   6376,
+     13418,  -2114,    636,    -42,   -259,    411,   -472,    472,   -432,    367,   -292,    215,
+      -144,     83,    -36,      3,     18,    -28,     30,    -27,     21,    -15,      9,     -5,
+    /* Phase 106 */
+        -3,      4,     -3,      0,      7,    -19,     36,    -59,     86,   -114,    139,   -156,
+       159,   -139,     90,     -3,   -127,    307,   -546,    855,  -1263,   1848,  -2887,   6248,
+     13490,  -2057,    596,    -12,   -281,    426,   -482,    478,   -435,    368,   -291,    213,
+      -141,     81,    -34,      1,     19,    -29,     31,    -27,     21,    -15,      9,     -5,
+    /* Phase 107 */
+        -3,      4,     -3,      0,      7,    -19,     37,    -59,     86,   -113,    138,   -154,
+       155,   -134,     83,      5,   -136,    317,   -556,    863,  -1267,   1843,  -2860,   6120,
+     13558,  -1999,    556,     18,   -302,    442,   -492,    484,   -438,    369,   -290,    211,
+      -138,     78,    -31,     -1,     21,    -30,     31,    -28,     22,    -15,      9,     -5,
+    /* Phase 108 */
+        -3,      3,     -3,     -1,      8,    -20,     37,    -60,     86,   -113,    137,   -152,
+       152,   -129,     77,     13,   -145,    327,   -565,    871,  -1271,   1837,  -2832,   5991,
+     13634,  -1939,    514,     47,   -324,    457,   -502,    490,   -440,    369,   -288,    208,
+      -136,     75,    -29,     -3,     22,    -31,     32,    -28,     22,    -15,      9,     -5,
+    /* Phase 109 */
+        -3,      3,     -3,     -1,      8,    -20,     38,    -60,     86,   -113,    136,   -150,
+       149,   -124,     70,     21,   -155,    337,   -575,    878,  -1274,   1831,  -2804,   5863,
+     13703,  -1878,    473,     77,   -346,    472,   -512,    496,   -443,    369,   -287,    206,
+      -133,     73,    -27,     -5,     24,    -32,     33,    -28,     22,    -15,      9,     -5,
+    /* Phase 110 */
+        -3,      3,     -2,     -1,      9,    -21,     39,    -61,     87,   -113,    135,   -148,
+       145,   -119,     64,     29,   -164,    347,   -584,    886,  -1276,   1824,  -2774,   5735,
+     13768,  -1816,    431,    107,   -367,    487,   -522,    501,   -445,    369,   -286,    204,
+      -130,     70,    -24,     -7,     25,    -33,     33,    -29,     22,    -15,      9,     -5,
+    /* Phase 111 */
+        -2,      3,     -2,     -2,      9,    -22,     39,    -61,     87,   -112,    134,   -146,
+       142,   -114,     57,     37,   -173,    356,   -593,    892,  -1278,   1816,  -2744,   5607,
+     13835,  -1752,    389,    137,   -389,    502,   -532,    507,   -447,    369,   -284,    201,
+      -128,     67,    -22,     -9,     27,    -34,     34,    -29,     22,    -15,      9,     -4,
+    /* Phase 112 */
+        -2,      3,     -2,     -2,     10,    -22,     40,    -62,     87,   -112,    133,   -143,
+       138,   -109,     51,     45,   -182,    366,   -601,    899,  -1280,   1808,  -2713,   5479,
+     13894,  -1687,    346,    168,   -410,    517,   -541,    512,   -450,    369,   -282,    199,
+      -125,     65,    -19,    -11,     28,    -35,     34,    -29,     22,    -15,      9,     -4,
+    /* Phase 113 */
+        -2,      3,     -2,     -2,     10,    -23,     40,    -62,     87,   -111,    131,   -141,
+       134,   -104,     44,     52,   -191,    375,   -610,    905,  -1280,   1799,  -2681,   5352,
+     13961,  -1621,    302,    198,   -432,    531,   -550,    517,   -451,    369,   -280,    196,
+      -122,     62,    -17,    -13,     30,    -36,     35,    -30,     22,    -15,      9,     -4,
+    /* Phase 114 */
+        -2,      3,     -1,     -3,     11,    -23,     41,    -63,     87,   -111,    130,   -139,
+       131,    -99,     38,     60,   -199,    384,   -618,    910,  -1281,   1789,  -2648,   5224,
+     14021,  -1553,    259,    228,   -453,    546,   -559,    522,   -453,    368,   -279,    193,
+      -119,     59,    -14,    -15,     31,    -37,     36,    -30,     22,    -15,      9,     -4,
+    /* Phase 115 */
+        -2,      2,     -1,     -3,     11,    -24,     41,    -63,     87,   -110,    129,   -136,
+       127,    -94,     31,     68,   -208,    392,   -626,    916,  -1281,   1779,  -2615,   5097,
+     14081,  -1484,    215,    259,   -474,    560,   -568,    527,   -455,    367,   -277,    191,
+      -116,     56,    -12,    -17,     33,    -38,     36,    -30,     23,    -15,      9,     -4,
+    /* Phase 116 */
+        -2,      2,     -1,     -3,     11,    -24,     42,    -63,     87,   -110,    127,   -134,
+       123,    -89,     24,     76,   -216,    401,   -633,    920,  -1280,   1768,  -2581,   4970,
+     14139,  -1413,    170,    289,   -495,    574,   -577,    531,   -456,    367,   -274,    188,
+      -113,     53,     -9,    -19,     34,    -39,     37,    -31,     23,    -15,      9,     -4,
+    /* Phase 117 */
+        -2,      2,     -1,     -4,     12,    -25,     42,    -64,     87,   -109,    126,   -131,
+       120,    -84,     18,     84,   -225,    409,   -641,    925,  -1279,   1756,  -2546,   4843,
+     14196,  -1341,    126,    320,   -516,    588,   -585,    535,   -457,    366,   -272,    185,
+      -110,     50,     -7,    -21,     35,    -40,     37,    -31,     23,    -15,      9,     -4,
+    /* Phase 118 */
+        -2,      2,      0,     -4,     12,    -25,     43,    -64,     87,   -109,    124,   -129,
+       116,    -79,     11,     91,   -233,    418,   -648,    929,  -1278,   1744,  -2510,   4717,
+     14249,  -1268,     81,    350,   -537,    602,   -593,    539,   -458,    365,   -270,    182,
+      -107,     47,     -4,    -23,     37,    -41,     38,    -31,     23,    -15,      9,     -4,
+    /* Phase 119 */
+        -2,      2,      0,     -4,     13,    -26,     43,    -64,     87,   -108,    123,   -126,
+       112,    -74,      5,     99,   -241,    426,   -654,    933,  -1276,   1732,  -2474,   4591,
+     14300,  -1193,     35,    381,   -558,    615,   -602,    543,   -459,    363,   -267,    179,
+      -103,     44,     -2,    -25,     38,    -42,     38,    -31,     23,    -15,      9,     -4,
+    /* Phase 120 */
+        -2,      2,      0,     -5,     13,    -26,     43,    -64,     87,   -107,    121,   -124,
+       108,    -68,     -1,    106,   -249,    434,   -661,    936,  -1273,   1718,  -2437,   4465,
+     14351,  -1117,    -10,    411,   -578,    629,   -609,    547,   -460,    362,   -265,    176,
+      -100,     41,      1,    -27,     40,    -43,     39,    -32,     23,    -15,      8,     -4,
+    /* Phase 121 */
+        -2,      2,      0,     -5,     14,    -27,     44,    -64,     86,   -106,    120,   -121,
+       104,    -63,     -8,    114,   -257,    441,   -667,    939,  -1271,   1704,  -2400,   4339,
+     14404,  -1040,    -56,    442,   -599,    642,   -617,    550,   -460,    361,   -262,    172,
+       -97,     38,      3,    -29,     41,    -44,     39,    -32,     23,    -15,      8,     -4,
+    /* Phase 122 */
+        -2,      2,      1,     -5,     14,    -27,     44,    -65,     86,   -106,    118,   -118,
+       100,    -58,    -14,    121,   -265,    449,   -673,    942,  -1267,   1690,  -2361,   4215,
+     14446,   -961,   -103,    472,   -619,    655,   -624,    554,   -461,    359,   -259,    169,
+       -94,     35,      6,    -31,     43,    -44,     40,    -32,     23,    -15,      8,     -4,
+    /* Phase 123 */
+        -2,      1,      1,     -6,     14,    -27,     45,    -65,     86,   -105,    116,   -116,
+        96,    -53,    -21,    128,   -273,    456,   -679,    944,  -1263,   1675,  -2323,   4090,
+     14497,   -881,   -149,    503,   -639,    667,   -632,    557,   -461,    357,   -256,    166,
+       -90,     32,      8,    -33,     44,    -45,     40,    -32,     23,    -15,      8,     -4,
+    /* Phase 124 */
+        -2,      1,      1,     -6,     15,    -28,     45,    -65,     86,   -104,    115,   -113,
+        92,    -48,    -27,    136,   -281,    463,   -684,    946,  -1259,   1659,  -2283,   3966,
+     14539,   -800,   -196,    533,   -659,    680,   -639,    560,   -461,    355,   -253,    162,
+       -87,     29,     11,    -35,     45,    -46,     41,    -32,     23,    -15,      8,     -4,
+    /* Phase 125 */
+        -1,      1,      1,     -6,     15,    -28,     45,    -65,     85,   -103,    113,   -110,
+        89,    -42,    -33,    143,   -288,    470,   -689,    948,  -1254,   1643,  -2243,   3842,
+     14580,   -718,   -243,    563,   -679,    692,   -645,    562,   -461,    353,   -250,    158,
+       -83,     26,     13,    -37,     47,    -47,     41,    -33,     23,    -15,      8,     -4,
+    /* Phase 126 */
+        -1,      1,      1,     -7,     16,    -29,     45,    -65,     85,   -102,    111,   -107,
+        85,    -37,    -40,    150,   -295,    477,   -694,    949,  -1249,   1626,  -2203,   3719,
+     14619,   -634,   -290,    593,   -698,    704,   -652,    565,   -460,    351,   -247,    155,
+       -80,     23,     16,    -38,     48,    -48,     42,    -33,     23,    -15,      8,     -4,
+    /* Phase 127 */
+        -1,      1,      2,     -7,     16,    -29,     46,    -65,     85,   -101,    109,   -104,
+        80,    -32,    -46,    157,   -303,    483,   -699,    950,  -1243,   1609,  -2161,   3597,
+     14657,   -549,   -338,    624,   -718,    716,   -658,    567,   -460,    348,   -243,    151,
+       -76,     20,     18,    -40,     49,    -49,     42,    -33,     23,    -15,      8,     -4,
+    /* Phase 128 */
+        -1,      1,      2,     -7,     16,    -29,     46,    -65,     84,   -100,    107,   -102,
+        76,    -27,    -52,    164,   -310,    490,   -703,    950,  -1237,   1591,  -2120,   3475,
+     14690,   -463,   -385,    654,   -737,    728,   -664,    569,   -459,    346,   -240,    147,
+       -72,     17,     21,    -42,     51,    -50,     43,    -33,     23,    -14,      8,     -3,
+    /* Phase 129 */
+        -1,      1,      2,     -7,     17,    -30,     46,    -65,     84,    -99,    106,    -99,
+        72,    -21,    -59,    171,   -317,    496,   -707,    950,  -1230,   1572,  -2078,   3353,
+     14724,   -375,   -433,    684,   -756,    739,   -670,    571,   -458,    343,   -236,    144,
+       -69,     13,     24,    -44,     52,    -50,     43,    -33,     23,    -14,      8,     -3,
+    /* Phase 130 */
+        -1,      0,      2,     -8,     17,    -30,     46,    -65,     83,    -98,    104,    -96,
+        68,    -16,    -65,    178,   -323,    502,   -711,    950,  -1223,   1554,  -2035,   3232,
+     14759,   -286,   -481,    713,   -775,    750,   -676,    573,   -457,    341,   -233,    140,
+       -65,     10,     26,    -46,     53,    -51,     43,    -33,     23,    -14,      8,     -3,
+    /* Phase 131 */
+        -1,      0,      2,     -8,     17,    -30,     47,    -65,     83,    -97,    102,    -93,
+        64,    -11,    -71,    184,   -330,    507,   -714,    949,  -1216,   1534,  -1992,   3112,
+     14790,   -196,   -529,    743,   -793,    761,   -681,    574,   -456,    338,   -229,    136,
+       -61,      7,     29,    -48,     54,    -52,     44,    -33,     23,    -14,      7,     -3,
+    /* Phase 132 */
+        -1,      0,      3,     -8,     18,    -31,     47,    -65,     82,    -95,    100,    -90,
+        60,     -6,    -77,    191,   -337,    513,   -717,    948,  -1208,   1514,  -1949,   2992,
+     14819,   -105,   -577,    773,   -812,    772,   -686,    575,   -454,    335,   -225,    132,
+       -58,      4,     31,    -50,     56,    -53,     44,    -34,     23,    -14,      7,     -3,
+    /* Phase 133 */
+        -1,      0,      3,     -9,     18,    -31,     47,    -65,     82,    -94,     98,    -87,
+        56,     -1,    -83,    197,   -343,    518,   -720,    947,  -1199,   1494,  -1905,   2873,
+     14849,    -13,   -626,    802,   -830,    782,   -691,    576,   -453,    331,   -221,    128,
+       -54,      0,     34,    -52,     57,    -53,     44,    -34,     23,    -14,      7,     -3,
+    /* Phase 134 */
+        -1,      0,      3,     -9,     18,    -31,     47,    -65,     81,    -93,     96,    -84,
+        52,      4,    -89,    204,   -349,    523,   -723,    945,  -1190,   1473,  -1860,   2755,
+     14874,     81,   -674,    831,   -848,    792,   -696,    577,   -451,    328,   -217,    123,
+       -50,     -3,     36,    -54,     58,    -54,     45,    -34,     23,    -14,      7,     -3,
+    /* Phase 135 */
+        -1,      0,      3,     -9,     18,    -31,     47,    -65,     81,    -92,     93,    -80,
+        48,     10,    -95,    210,   -355,    528,   -725,    943,  -1181,   1452,  -1816,   2638,
+     14893,    176,   -723,    860,   -865,    802,   -700,    578,   -449,    325,   -213,    119,
+       -46,     -6,     39,    -55,     59,    -55,     45,    -34,     23,    -14,      7,     -3,
+    /* Phase 136 */
+        -1,      0,      3,     -9,     19,    -32,     47,    -64,     80,    -90,     91,    -77,
+        44,     15,   -101,    216,   -361,    533,   -727,    940,  -1171,   1430,  -1770,   2521,
+     14913,    271,   -771,    889,   -882,    811,   -704,    578,   -447,    321,   -209,    115,
+       -42,     -9,     41,    -57,     61,    -55,     45,    -34,     23,    -14,      7,     -3,
+    /* Phase 137 */
+        -1,      0,      4,    -10,     19,    -32,     47,    -64,     79,    -89,     89,    -74,
+        39,     20,   -107,    222,   -367,    537,   -729,    937,  -1161,   1408,  -1725,   2405,
+     14933,    368,   -820,    918,   -899,    821,   -708,    578,   -444,    317,   -204,    111,
+       -38,    -13,     44,    -59,     62,    -56,     46,    -34,     23,    -13,      7,     -3,
+    /* Phase 138 */
+        -1,     -1,      4,    -10,     19,    -32,     48,    -64,     79,    -88,     87,    -71,
+        35,     25,   -112,    228,   -372,    541,   -730,    934,  -1151,   1385,  -1679,   2289,
+     14951,    467,   -868,    946,   -916,    830,   -711,    578,   -442,    313,   -200,    106,
+       -34,    -16,     46,    -61,     63,    -57,     46,    -34,     23,    -13,      7,     -3,
+    /* Phase 139 */
+         0,     -1,      4,    -10,     20,    -32,     48,    -64,     78,    -86,     85,    -68,
+        31,     30,   -118,    234,   -378,    545,   -731,    931,  -1140,   1362,  -1633,   2175,
+     14964,    566,   -917,    975,   -933,    838,   -715,    577,   -439,    309,   -195,    102,
+       -30,    -19,     49,    -63,     64,    -57,     46,    -34,     22,    -13,      7,     -2,
+    /* Phase 140 */
+         0,     -1,      4,    -10,     20,    -33,     48,    -63,     77,    -85,     83,    -65,
+        27,     35,   -124,    240,   -383,    549,   -732,    927,  -1129,   1339,  -1587,   2061,
+     14980,    666,   -965,   1002,   -949,    847,   -718,    577,   -436,    305,   -191,     97,
+       -26,    -22,     51,    -64,     65,    -58,     46,    -34,     22,    -13,      6,     -2,
+    /* Phase 141 */
+         0,     -1,      4,    -11,     20,    -33,     48,    -63,     76,    -84,     80,    -62,
+        23,     40,   -129,    246,   -388,    552,   -733,    923,  -1117,   1315,  -1540,   1948,
+     14992,    767,  -1014,   1030,   -965,    855,   -720,    576,   -433,    301,   -186,     93,
+       -22,    -26,     54,    -66,     66,    -58,     47,    -34,     22,    -13,      6,     -2,
+    /* Phase 142 */
+         0,     -1,      5,    -11,     20,    -33,     48,    -63,     76,    -82,     78,    -58,
+        19,     45,   -135,    251,   -393,    556,   -733,    918,  -1105,   1291,  -1493,   1836,
+     14999,    870,  -1062,   1058,   -980,    862,   -723,    575,   -430,    297,   -181,     88,
+       -18,    -29,     56,    -68,     67,    -59,     47,    -34,     22,    -13,      6,     -2,
+    /* Phase 143 */
+         0,     -1,      5,    -11,     21,    -33,     48,    -62,     75,    -81,     76,    -55,
+        14,     50,   -140,    257,   -398,    559,   -733,    913,  -1092,   1266,  -1446,   1725,
+     15003,    973,  -1111,   1085,   -995,    870,   -725,    574,   -426,    292,   -177,     84,
+       -14,    -32,     59,    -69,     68,    -59,     47,    -34,     22,    -12,      6,     -2,
+    /* Phase 144 */
+         0,     -1,      5,    -11,     21,    -33,     48,    -62,     74,    -79,     73,    -52,
+        10,     55,   -146,    262,   -402,    561,   -733,    908,  -1080,   1241,  -1399,   1615,
+     15015,   1078,  -1159,   1112,  -1010,    877,   -727,    572,   -423,    287,   -172,     79,
+       -10,    -36,     61,    -71,     69,    -60,     47,    -34,     22,    -12,      6,     -2,
+    /* Phase 145 */
+         0,     -1,      5,    -11,     21,    -33,     47,    -62,     73,    -78,     71,    -49,
+         6,     60,   -151,    268,   -407,    564,   -732,    903,  -1066,   1216,  -1351,   1506,
+     15017,   1183,  -1207,   1138,  -1025,    884,   -729,    570,   -419,    283,   -167,     74,
+        -6,    -39,     64,    -73,     70,    -60,     47,    -34,     22,    -12,      6,     -2,
+    /* Phase 146 */
+         0,     -2,      5,    -12,     21,    -33,     47,    -61,     72,    -76,     69,    -45,
+         2,     65,   -156,    273,   -411,    566,   -731,    897,  -1053,   1191,  -1303,   1397,
+     15017,   1290,  -1255,   1165,  -1039,    890,   -730,    569,   -415,    278,   -161,     69,
+        -2,    -42,     66,    -74,     71,    -61,     47,    -33,     21,    -12,      5,     -2,
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,282 @@
+/*****************************************************************************
+* File Name    : dsp_vad.c
+*
+* Description  : This file contains the voice activity detection stage of the
+*                DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_vad.h"
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Decision, active periods in a row, and periods left before the end of
+ * speech
+ */
+static volatile bool dsp_vad_speech = false;
+static uint32_t dsp_vad_active_periods = 0U;
+static uint32_t dsp_vad_hangover = 0U;
+
+/* Noise floor, kept from one stream to the next */
+static uint32_t dsp_vad_noise = DSP_VAD_NOISE_MIN;
+static bool dsp_vad_noise_set = false;
+
+/* Energy smoothed over the last periods */
+static uint32_t dsp_vad_energy = 0U;
+
+static dsp_vad_stats_t dsp_vad_stats;
+
+
+/*****************************************************************************
+* Function Name: dsp_vad_reset
+******************************************************************************
+* Summary:
+*  Start a new stream without speech, the energy at the noise floor. The
+*  noise floor is kept, the microphones are the same.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_vad_reset(void)
+{
+    dsp_vad_speech = false;
+    dsp_vad_active_periods = 0U;
+    dsp_vad_hangover = 0U;
+    dsp_vad_energy = dsp_vad_noise;
+}
+
+/*****************************************************************************
+* Function Name: dsp_vad_is_speech
+******************************************************************************
+* Summary:
+*  Get the decision of the detector for the last period.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool: true while speech is detected, hangover included
+*
+*****************************************************************************/
+bool dsp_vad_is_speech(void)
+{
+    return dsp_vad_speech;
+}
+
+/*****************************************************************************
+* Function Name: dsp_vad_get_stats
+******************************************************************************
+* Summary:
+*  Get the statistics of the detector since the last reset of the
+*  statistics.
+*
+* Parameters:
+*  stats: Statistics
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_vad_get_stats(dsp_vad_stats_t *stats)
+{
+    *stats = dsp_vad_stats;
+    stats->speech = dsp_vad_speech;
+    stats->noise = dsp_vad_noise;
+}
+
+/*****************************************************************************
+* Function Name: dsp_vad_reset_stats
+******************************************************************************
+* Summary:
+*  Reset the statistics of the detector. Must be called from the context
+*  running dsp_chain_process().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_vad_reset_stats(void)
+{
+    dsp_vad_stats.periods = 0U;
+    dsp_vad_stats.speech_periods = 0U;
+    dsp_vad_stats.onsets = 0U;
+}
+
+/*****************************************************************************
+* Function Name: dsp_vad_process
+******************************************************************************
+* Summary:
+*  Decide whether a period holds speech, from its energy relative to the
+*  noise floor and from the zero-crossing rate of its first channel: loud
+*  periods start or extend speech, and quieter periods with the crossing
+*  rate of an unvoiced sound only extend it. A loud period must also keep
+*  the energy smoothed over about 2^DSP_VAD_SMOOTH_SHIFT periods loud,
+*  which the noise floor follows too, so the swings of the energy of low
+*  frequency noise from one period to the next do not trigger speech. The
+*  samples are not modified. The cost is one multiply-accumulate and one
+*  compare per sample.
+*
+*  Speech starts after DSP_VAD_ONSET_PERIODS active periods in a row, so
+*  clicks do not trigger it, and ends DSP_VAD_HANGOVER_PERIODS after the
+*  last active period, so the pauses between words do not cut it. The noise
+*  floor follows the energy down faster than up, so it settles on the
+*  background noise between the words.
+*
+* Parameters:
+*  block: Block of samples
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_vad_process(dsp_block_t *block)
+{
+    uint32_t count = block->frames * block->channels;
+    uint32_t channels = block->channels;
+    uint64_t sum = 0U;
+    uint32_t crossings = 0U;
+    uint32_t energy;
+    bool negative = false;
+    bool active;
+    int32_t x;
+    uint32_t channel = 0U;
+    uint32_t i;
+
+    if (0U == count)
+    {
+        return;
+    }
+
+    /* Energy of all the channels and zero crossings of the first one, on
+     * the 16-bit scale
+     */
+    for (i = 0U; i < count; i++)
+    {
+        if (sizeof(int16_t) == block->sample_size)
+        {
+            x = ((const int16_t *) block->samples)[i];
+        }
+        else
+        {
+            x = ((const int32_t *) block->samples)[i] >> 8;
+        }
+
+        sum += (uint32_t) (x * x);
+
+        if (0U == channel)
+        {
+            crossings += ((i > 0U) && ((x < 0) != negative)) ? 1U : 0U;
+            negative = (x < 0);
+        }
+        channel = ((channel + 1U) < channels) ? (channel + 1U) : 0U;
+    }
+
+    energy = (uint32_t) (sum / count);
+
+    /* The first period of the first stream sets the noise floor */
+    if (!dsp_vad_noise_set)
+    {
+        dsp_vad_noise_set = true;
+        dsp_vad_noise = (energy < (DSP_VAD_NOISE_MIN)) ? (DSP_VAD_NOISE_MIN) : energy;
+        dsp_vad_energy = energy;
+    }
+
+    /* Smoothed energy */
+    if (energy > dsp_vad_energy)
+    {
+        dsp_vad_energy += (energy - dsp_vad_energy) >> DSP_VAD_SMOOTH_SHIFT;
+    }
+    else
+    {
+        dsp_vad_energy -= (dsp_vad_energy - energy) >> DSP_VAD_SMOOTH_SHIFT;
+    }
+
+    /* A loud period must also be loud on average, and the average alone
+     * stays loud after a click. Unvoiced sounds only extend speech: alone,
+     * they look like noise.
+     */
+    active = ((energy > (dsp_vad_noise << DSP_VAD_SNR_SHIFT)) &&
+              (dsp_vad_energy > (dsp_vad_noise << DSP_VAD_SNR_SHIFT))) ||
+             (dsp_vad_speech && (dsp_vad_energy > (dsp_vad_noise << 1U)) &&
+              (crossings >= (DSP_VAD_UNVOICED_CROSSINGS)));
+
+    /* Noise floor */
+    if (dsp_vad_energy < dsp_vad_noise)
+    {
+        dsp_vad_noise -= (dsp_vad_noise - dsp_vad_energy) >> DSP_VAD_NOISE_DOWN_SHIFT;
+    }
+    else
+    {
+        dsp_vad_noise += (dsp_vad_energy - dsp_vad_noise) >> DSP_VAD_NOISE_UP_SHIFT;
+    }
+    dsp_vad_noise = (dsp_vad_noise < (DSP_VAD_NOISE_MIN)) ? (DSP_VAD_NOISE_MIN) : dsp_vad_noise;
+
+    /* Onset and hangover */
+    dsp_vad_active_periods = active ? (dsp_vad_active_periods + 1U) : 0U;
+
+    if (dsp_vad_active_periods >= (DSP_VAD_ONSET_PERIODS))
+    {
+        if (!dsp_vad_speech)
+        {
+            dsp_vad_speech = true;
+            dsp_vad_stats.onsets++;
+        }
+        dsp_vad_hangover = (DSP_VAD_HANGOVER_PERIODS);
+    }
+    else if (dsp_vad_hangover > 0U)
+    {
+        dsp_vad_hangover--;
+    }
+    else
+    {
+        dsp_vad_speech = false;
+    }
+
+    dsp_vad_stats.periods++;
+    dsp_vad_stats.speech_periods += dsp_vad_speech ? 1U : 0U;
+    dsp_vad_stats.energy = energy;
+    dsp_vad_stats.crossings = crossings;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,213 @@
+/*****************************************************************************
+* File Name    : latency_hist.c
+*
+* Description  : This file contains a fixed-bucket histogram of latencies.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "latency_hist.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Percentile reported by latency_hist_get_summary() */
+#define LATENCY_HIST_PERCENTILE         (99U)
+#define LATENCY_HIST_PERCENT            (100U)
+
+
+/*****************************************************************************
+* Function Name: latency_hist_reset
+******************************************************************************
+* Summary:
+*  Clear all the samples of the histogram.
+*
+* Parameters:
+*  hist: Histogram to reset
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void latency_hist_reset(latency_hist_t *hist)
+{
+    memset(hist->buckets, 0, sizeof(hist->buckets));
+    hist->count = 0U;
+    hist->min_us = UINT32_MAX;
+    hist->max_us = 0U;
+    hist->sum_us = 0U;
+}
+
+/*****************************************************************************
+* Function Name: latency_hist_add
+******************************************************************************
+* Summary:
+*  Add one latency sample to the histogram.
+*
+* Parameters:
+*  hist: Histogram to update
+*  latency_us: Latency in microseconds
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void latency_hist_add(latency_hist_t *hist, uint32_t latency_us)
+{
+    uint32_t bucket = latency_us / LATENCY_HIST_BUCKET_US;
+
+    if (bucket >= LATENCY_HIST_NUM_BUCKETS)
+    {
+        bucket = LATENCY_HIST_NUM_BUCKETS - 1U;
+    }
+
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_us += latency_us;
+
+    if (latency_us < hist->min_us)
+    {
+        hist->min_us = latency_us;
+    }
+    if (latency_us > hist->max_us)
+    {
+        hist->max_us = latency_us;
+    }
+}
+
+/*****************************************************************************
+* Function Name: latency_hist_get_summary
+******************************************************************************
+* Summary:
+*  Compute the min/avg/p99/max of the histogram. The 99th percentile is the
+*  upper edge of the bucket in which it falls, capped to the maximum.
+*
+* Parameters:
+*  hist: Histogram to query
+*  summary: Summary of the histogram, all zeros if it is empty
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void latency_hist_get_summary(const latency_hist_t *hist, latency_hist_summary_t *summary)
+{
+    uint32_t rank;
+    uint32_t cumulative = 0U;
+    uint32_t bucket;
+
+    memset(summary, 0, sizeof(*summary));
+
+    if (0U == hist->count)
+    {
+        return;
+    }
+
+    summary->count = hist->count;
+    summary->min_us = hist->min_us;
+    summary->max_us = hist->max_us;
+    summary->avg_us = (uint32_t) (hist->sum_us / hist->count);
+
+    /* Rank of the percentile, rounded up */
+    rank = (uint32_t) ((((uint64_t) hist->count * LATENCY_HIST_PERCENTILE) + (LATENCY_HIST_PERCENT - 1U)) / LATENCY_HIST_PERCENT);
+
+    for (bucket = 0U; bucket < LATENCY_HIST_NUM_BUCKETS; bucket++)
+    {
+        cumulative += hist->buckets[bucket];
+        if (cumulative >= rank)
+        {
+            break;
+        }
+    }
+
+    summary->p99_us = (bucket + 1U) * LATENCY_HIST_BUCKET_US;
+    if (summary->p99_us > hist->max_us)
+    {
+        summary->p99_us = hist->max_us;
+    }
+}
+
+/*****************************************************************************
+* Function Name: latency_hist_print
+******************************************************************************
+* Summary:
+*  Print the summary and the non-empty buckets of the histogram on the debug
+*  UART.
+*
+* Parameters:
+*  hist: Histogram to print
+*  name: Name of the histogram
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void latency_hist_print(const latency_hist_t *hist, const char *name)
+{
+    latency_hist_summary_t summary;
+    uint32_t bucket;
+
+    latency_hist_get_summary(hist, &summary);
+
+    printf("%s: %lu samples, min %lu us, avg %lu us, p99 %lu us, max %lu us\r\n", name,
+           (unsigned long) summary.count, (unsigned long) summary.min_us, (unsigned long) summary.avg_us,
+           (unsigned long) summary.p99_us, (unsigned long) summary.max_us);
+
+    for (bucket = 0U; bucket < LATENCY_HIST_NUM_BUCKETS; bucket++)
+    {
+        if (0U == hist->buckets[bucket])
+        {
+            continue;
+        }
+
+        if (bucket == (LATENCY_HIST_NUM_BUCKETS - 1U))
+        {
+            printf("  %5lu us and above : %lu\r\n",
+                   (unsigned long) (bucket * LATENCY_HIST_BUCKET_US), (unsigned long) hist->buckets[bucket]);
+        }
+        else
+        {
+            printf("  %5lu - %5lu us   : %lu\r\n",
+                   (unsigned long) (bucket * LATENCY_HIST_BUCKET_US),
+                   (unsigned long) (((bucket + 1U) * LATENCY_HIST_BUCKET_US) - 1U),
+                   (unsigned long) hist->buckets[bucket]);
+        }
+    }
+}
+
+/* [] END OF FILE */
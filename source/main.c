@@ -43,6 +43,9 @@
 #include "cybsp.h"
 #include "cy_retarget_io.h"
 #include "audio_app.h"
+#include "console.h"
+#include "cycle_counter.h"
+#include "telemetry.h"
 
 #include "rtos.h"
 
@@ -54,8 +57,9 @@
 *  This is the main function for CM4 CPU. It does...
 *    1. Initializes the target BSP.
 *    2. Initializes retarget-io to use the debug UART port.
-*    3. Initializes the User LED.
-*    4. Initializes the audio app and starts the FreeRTOS scheduler.
+*    3. Initializes the User LED and the cycle counter.
+*    4. Initializes the audio app, the console and the telemetry, and starts
+*       the FreeRTOS scheduler.
 *
 * Parameters:
 *  None
@@ -93,6 +97,9 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* Enable the cycle counter used for the timing measurements */
+    cycle_counter_init();
+
     /* Enable global interrupts */
     __enable_irq();
 
@@ -105,6 +112,12 @@ int main(void)
 
     /* Initialize the Audio application */
     audio_app_init();
+
+    /* Initialize the debug UART console */
+    console_init();
+
+    /* Start sampling the stack and heap usage */
+    telemetry_init();
     
     /* Start the RTOS Scheduler */
     vTaskStartScheduler();
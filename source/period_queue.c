@@ -0,0 +1,319 @@
+/*****************************************************************************
+* File Name    : period_queue.c
+*
+* Description  : This file contains the lock-free queue of capture periods
+*                shared by the capture side (producer) and the Audio IN
+*                endpoint (consumer).
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "period_queue.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "cmsis_compiler.h"
+#endif
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Periods that are never available to hold captured audio: the one being
+ * written by the producer and the one being sent on the USB bus.
+ */
+#define PERIOD_QUEUE_RESERVED_PERIODS   (2U)
+
+/* Slot of a free running index */
+#define PERIOD_QUEUE_SLOT(index)        ((index) & ((PERIOD_QUEUE_DEPTH) - 1U))
+
+/* Orders the accesses to a period against the update of the index that hands
+ * it over to the other side. The producer may be an interrupt or a DMA
+ * channel, so the compiler and the bus must not reorder them.
+ */
+#if defined(__ARM_ARCH)
+#define PERIOD_QUEUE_BARRIER()          __DMB()
+#else
+#define PERIOD_QUEUE_BARRIER()          __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+
+/*****************************************************************************
+* Function Name: period_queue_init
+******************************************************************************
+* Summary:
+*  Split the storage into PERIOD_QUEUE_DEPTH periods and reset the queue.
+*
+* Parameters:
+*  queue: Queue to initialize
+*  storage: Storage of PERIOD_QUEUE_DEPTH * period_words words
+*  period_words: Size of one period in 32-bit words
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void period_queue_init(period_queue_t *queue, uint32_t *storage, uint32_t period_words)
+{
+    uint32_t i;
+
+    for (i = 0U; i < PERIOD_QUEUE_DEPTH; i++)
+    {
+        queue->periods[i].buffer = &storage[i * period_words];
+        queue->periods[i].count = 0U;
+    }
+
+    period_queue_reset(queue);
+    period_queue_clear_stats(queue);
+}
+
+/*****************************************************************************
+* Function Name: period_queue_reset
+******************************************************************************
+* Summary:
+*  Discard all the captured periods. The statistics are kept, see
+*  period_queue_clear_stats(). Must only be called while the producer is
+*  stopped.
+*
+* Parameters:
+*  queue: Queue to reset
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void period_queue_reset(period_queue_t *queue)
+{
+    queue->head = 0U;
+    queue->tail = 0U;
+}
+
+/*****************************************************************************
+* Function Name: period_queue_clear_stats
+******************************************************************************
+* Summary:
+*  Clear the fill level statistics. Can be called from the consumer while the
+*  producer runs, in which case an update of the producer may be lost.
+*
+* Parameters:
+*  queue: Queue to update
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void period_queue_clear_stats(period_queue_t *queue)
+{
+    queue->produced = 0U;
+    queue->overruns = 0U;
+    queue->peak_level = 0U;
+    queue->underruns = 0U;
+    memset(queue->level_counts, 0, sizeof(queue->level_counts));
+}
+
+/*****************************************************************************
+* Function Name: period_queue_level
+******************************************************************************
+* Summary:
+*  Get the number of captured periods waiting to be consumed.
+*
+* Parameters:
+*  queue: Queue to query
+*
+* Return:
+*  uint32_t: Number of periods
+*
+*****************************************************************************/
+uint32_t period_queue_level(const period_queue_t *queue)
+{
+    return (queue->head - queue->tail);
+}
+
+/*****************************************************************************
+* Function Name: period_queue_samples
+******************************************************************************
+* Summary:
+*  Get the number of captured samples waiting to be consumed.
+*
+* Parameters:
+*  queue: Queue to query
+*
+* Return:
+*  uint32_t: Number of samples
+*
+*****************************************************************************/
+uint32_t period_queue_samples(const period_queue_t *queue)
+{
+    uint32_t head = queue->head;
+    uint32_t index;
+    uint32_t samples = 0U;
+
+    /* Read the counts published before head */
+    PERIOD_QUEUE_BARRIER();
+
+    for (index = queue->tail; index != head; index++)
+    {
+        samples += queue->periods[PERIOD_QUEUE_SLOT(index)].count;
+    }
+
+    return samples;
+}
+
+/*****************************************************************************
+* Function Name: period_queue_producer_period
+******************************************************************************
+* Summary:
+*  Get the period the producer should write next.
+*
+* Parameters:
+*  queue: Queue to query
+*
+* Return:
+*  period_t*: Period to write
+*
+*****************************************************************************/
+period_t *period_queue_producer_period(period_queue_t *queue)
+{
+    return &queue->periods[PERIOD_QUEUE_SLOT(queue->head)];
+}
+
+/*****************************************************************************
+* Function Name: period_queue_produce
+******************************************************************************
+* Summary:
+*  Publish the period written by the producer. When the queue is full the
+*  period is not published and the producer writes the same period again,
+*  so the periods owned by the consumer are never overwritten.
+*
+* Parameters:
+*  queue: Queue to update
+*  count: Number of samples written in the period
+*
+* Return:
+*  bool: true if the period was published, false if it was dropped
+*
+*****************************************************************************/
+bool period_queue_produce(period_queue_t *queue, uint32_t count)
+{
+    uint32_t head = queue->head;
+    uint32_t level = (head + 1U) - queue->tail;
+
+    if (level > (PERIOD_QUEUE_DEPTH - PERIOD_QUEUE_RESERVED_PERIODS))
+    {
+        queue->overruns++;
+        return false;
+    }
+
+    queue->periods[PERIOD_QUEUE_SLOT(head)].count = count;
+
+    /* Publish the samples and the count before the period itself */
+    PERIOD_QUEUE_BARRIER();
+    queue->head = head + 1U;
+
+    queue->produced++;
+    if (level > queue->peak_level)
+    {
+        queue->peak_level = level;
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+* Function Name: period_queue_consume
+******************************************************************************
+* Summary:
+*  Take the oldest captured period. The period stays owned by the consumer
+*  until the next call, which gives the USB controller a full frame to send
+*  it.
+*
+* Parameters:
+*  queue: Queue to update
+*
+* Return:
+*  period_t*: Oldest period, NULL if the queue is empty
+*
+*****************************************************************************/
+period_t *period_queue_consume(period_queue_t *queue)
+{
+    uint32_t tail = queue->tail;
+    uint32_t level = queue->head - tail;
+    period_t *period;
+
+    queue->level_counts[level]++;
+
+    if (0U == level)
+    {
+        queue->underruns++;
+        return NULL;
+    }
+
+    /* Read the period only after head announced it, and release the
+     * previous period only after the consumer is done with it.
+     */
+    PERIOD_QUEUE_BARRIER();
+    period = &queue->periods[PERIOD_QUEUE_SLOT(tail)];
+    queue->tail = tail + 1U;
+
+    return period;
+}
+
+/*****************************************************************************
+* Function Name: period_queue_get_stats
+******************************************************************************
+* Summary:
+*  Take a snapshot of the fill level statistics. Each counter is consistent
+*  on its own, the counters are not consistent with each other.
+*
+* Parameters:
+*  queue: Queue to query
+*  stats: Snapshot of the statistics
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void period_queue_get_stats(const period_queue_t *queue, period_queue_stats_t *stats)
+{
+    stats->level = period_queue_level(queue);
+    stats->peak_level = queue->peak_level;
+    stats->produced = queue->produced;
+    stats->overruns = queue->overruns;
+    stats->underruns = queue->underruns;
+    memcpy(stats->level_counts, queue->level_counts, sizeof(stats->level_counts));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,332 @@
+/*****************************************************************************
+* File Name    : rate_ctrl.c
+*
+* Description  : This file contains the closed-loop rate matching controller of
+*                the asynchronous Audio IN endpoint.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "rate_ctrl.h"
+#include "audio.h"
+
+#include <stddef.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* USB (full-speed) frames per second */
+#define RATE_CTRL_PACKETS_PER_SEC       (1000)
+
+#define RATE_CTRL_ONE                   ((int64_t) 1 << (RATE_CTRL_FRAC_BITS))
+#define RATE_CTRL_MAX_CORRECTION        ((int32_t) ((RATE_CTRL_MAX_CORRECTION_FRAMES) * (RATE_CTRL_ONE)))
+
+/* Frames of packet k of the cadence of a sample rate: the frames captured
+ * by the end of the packet minus the frames captured before it
+ */
+#define RATE_CTRL_CADENCE_FRAMES(rate, k) \
+    ((uint8_t) (((((k) + 1UL) * (rate)) / (RATE_CTRL_PACKETS_PER_SEC)) - (((k) * (rate)) / (RATE_CTRL_PACKETS_PER_SEC))))
+
+#define RATE_CTRL_CADENCE(rate) \
+    {(rate), {RATE_CTRL_CADENCE_FRAMES((rate), 0UL),  RATE_CTRL_CADENCE_FRAMES((rate), 1UL),  \
+              RATE_CTRL_CADENCE_FRAMES((rate), 2UL),  RATE_CTRL_CADENCE_FRAMES((rate), 3UL),  \
+              RATE_CTRL_CADENCE_FRAMES((rate), 4UL),  RATE_CTRL_CADENCE_FRAMES((rate), 5UL),  \
+              RATE_CTRL_CADENCE_FRAMES((rate), 6UL),  RATE_CTRL_CADENCE_FRAMES((rate), 7UL),  \
+              RATE_CTRL_CADENCE_FRAMES((rate), 8UL),  RATE_CTRL_CADENCE_FRAMES((rate), 9UL),  \
+              RATE_CTRL_CADENCE_FRAMES((rate), 10UL), RATE_CTRL_CADENCE_FRAMES((rate), 11UL), \
+              RATE_CTRL_CADENCE_FRAMES((rate), 12UL), RATE_CTRL_CADENCE_FRAMES((rate), 13UL), \
+              RATE_CTRL_CADENCE_FRAMES((rate), 14UL), RATE_CTRL_CADENCE_FRAMES((rate), 15UL), \
+              RATE_CTRL_CADENCE_FRAMES((rate), 16UL), RATE_CTRL_CADENCE_FRAMES((rate), 17UL), \
+              RATE_CTRL_CADENCE_FRAMES((rate), 18UL), RATE_CTRL_CADENCE_FRAMES((rate), 19UL)}}
+
+/* The cadence of a rate repeats every RATE_CTRL_CADENCE_PACKETS packets
+ * when the rate is a multiple of 50 Hz
+ */
+#if (((AUDIO_SAMPLING_RATE_8KHZ) % 50U) != 0U)  || (((AUDIO_SAMPLING_RATE_16KHZ) % 50U) != 0U) || \
+    (((AUDIO_SAMPLING_RATE_22KHZ) % 50U) != 0U) || (((AUDIO_SAMPLING_RATE_32KHZ) % 50U) != 0U) || \
+    (((AUDIO_SAMPLING_RATE_44KHZ) % 50U) != 0U) || (((AUDIO_SAMPLING_RATE_48KHZ) % 50U) != 0U) || \
+    (((AUDIO_SAMPLING_RATE_96KHZ) % 50U) != 0U)
+#error "The packet cadence needs sample rates that are multiples of 50 Hz."
+#endif
+
+#if ((AUDIO_IN_MAX_SAMPLE_FREQ) / (RATE_CTRL_PACKETS_PER_SEC)) >= 255
+#error "The packets of the highest sample rate do not fit the cadence tables."
+#endif
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/* Frames of each packet of a cadence cycle */
+typedef struct
+{
+    uint32_t sample_rate;
+    uint8_t frames[RATE_CTRL_CADENCE_PACKETS];
+} rate_ctrl_cadence_t;
+
+
+/*****************************************************************************
+* Static const data
+*****************************************************************************/
+/* Packet cadence of each sample rate of include/audio.h, computed by the
+ * compiler: e.g. nine packets of 44 frames then one of 45 frames, twice,
+ * at 44.1 KHz
+ */
+static const rate_ctrl_cadence_t rate_ctrl_cadences[] =
+{
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_8KHZ),
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_16KHZ),
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_22KHZ),
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_32KHZ),
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_44KHZ),
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_48KHZ),
+    RATE_CTRL_CADENCE(AUDIO_SAMPLING_RATE_96KHZ),
+};
+
+
+/*****************************************************************************
+* Function Name: rate_ctrl_clamp
+******************************************************************************
+* Summary:
+*  Limit a Q8.24 value to +/- RATE_CTRL_MAX_CORRECTION_FRAMES.
+*
+* Parameters:
+*  value: Value to limit
+*
+* Return:
+*  int32_t: Limited value
+*
+*****************************************************************************/
+static int32_t rate_ctrl_clamp(int64_t value)
+{
+    if (value > RATE_CTRL_MAX_CORRECTION)
+    {
+        return RATE_CTRL_MAX_CORRECTION;
+    }
+    if (value < -RATE_CTRL_MAX_CORRECTION)
+    {
+        return -RATE_CTRL_MAX_CORRECTION;
+    }
+    return (int32_t) value;
+}
+
+/*****************************************************************************
+* Function Name: rate_ctrl_init
+******************************************************************************
+* Summary:
+*  Initialize the rate controller for a given sample rate, and select the
+*  packet cadence of the rate.
+*
+* Parameters:
+*  ctrl: Rate controller
+*  sample_rate: Nominal sample rate in Hz
+*  target_depth: Buffer depth to maintain, in frames
+*  max_frames: Largest packet the endpoint accepts, in frames
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rate_ctrl_init(rate_ctrl_t *ctrl, uint32_t sample_rate, uint32_t target_depth, uint32_t max_frames)
+{
+    uint32_t index;
+    uint32_t shortest = (sample_rate / RATE_CTRL_PACKETS_PER_SEC);
+    uint32_t longest = shortest;
+
+    ctrl->cadence = NULL;
+    for (index = 0U; index < (sizeof(rate_ctrl_cadences) / sizeof(rate_ctrl_cadences[0])); index++)
+    {
+        if (sample_rate == rate_ctrl_cadences[index].sample_rate)
+        {
+            ctrl->cadence = rate_ctrl_cadences[index].frames;
+        }
+    }
+
+    ctrl->nominal = (int32_t) (((int64_t) sample_rate * RATE_CTRL_ONE) / RATE_CTRL_PACKETS_PER_SEC);
+    ctrl->target_depth = (int32_t) target_depth;
+    ctrl->max_frames = max_frames;
+    ctrl->min_frames = shortest - (RATE_CTRL_MAX_CORRECTION_FRAMES);
+
+    /* A cadence with two packet sizes absorbs the correction within them:
+     * a frame added waits for a short packet, a frame removed for a long one
+     */
+    if (NULL != ctrl->cadence)
+    {
+        for (index = 0U; index < (RATE_CTRL_CADENCE_PACKETS); index++)
+        {
+            longest = (ctrl->cadence[index] > longest) ? ctrl->cadence[index] : longest;
+        }
+        if ((longest > shortest) && (longest <= max_frames))
+        {
+            ctrl->min_frames = shortest;
+            ctrl->max_frames = longest;
+        }
+    }
+
+    rate_ctrl_reset(ctrl);
+}
+
+/*****************************************************************************
+* Function Name: rate_ctrl_reset
+******************************************************************************
+* Summary:
+*  Restart the rate controller from the nominal packet size, e.g. at the
+*  beginning of a recording session.
+*
+* Parameters:
+*  ctrl: Rate controller
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rate_ctrl_reset(rate_ctrl_t *ctrl)
+{
+    ctrl->integral = 0;
+    ctrl->correction = 0;
+    ctrl->phase = 0;
+    ctrl->cadence_index = 0U;
+}
+
+/*****************************************************************************
+* Function Name: rate_ctrl_update
+******************************************************************************
+* Summary:
+*  Run one step of the PI controller. Must be called once per USB frame
+*  (SOF cadence) with the current buffer depth. The integral term converges
+*  to the offset between the PDM/PCM clock and the host clock, while the
+*  proportional term pulls the depth back to its target.
+*
+* Parameters:
+*  ctrl: Rate controller
+*  depth: Frames captured and not yet sent to the host
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rate_ctrl_update(rate_ctrl_t *ctrl, uint32_t depth)
+{
+    int64_t error = ((int64_t) depth - ctrl->target_depth) * RATE_CTRL_ONE;
+    int32_t integral;
+
+    /* Anti-windup: the integral term alone never exceeds the correction range */
+    integral = rate_ctrl_clamp((int64_t) ctrl->integral + (error >> (RATE_CTRL_KI_SHIFT)));
+    ctrl->integral = integral;
+
+    ctrl->correction = rate_ctrl_clamp((error >> (RATE_CTRL_KP_SHIFT)) + integral);
+}
+
+/*****************************************************************************
+* Function Name: rate_ctrl_next_frames
+******************************************************************************
+* Summary:
+*  Get the number of frames of the next packet. The packets follow the
+*  cadence of the sample rate, which sends its exact average, and the
+*  correction only adds or removes a frame once its carried fractional part
+*  reaches a whole frame. A frame that does not fit in the packet size range
+*  waits for the next packet. Rates without a cadence carry the whole
+*  corrected rate the same way.
+*
+* Parameters:
+*  ctrl: Rate controller
+*
+* Return:
+*  uint32_t: Number of frames of the next packet
+*
+*****************************************************************************/
+uint32_t rate_ctrl_next_frames(rate_ctrl_t *ctrl)
+{
+    int64_t base = 0;
+    int64_t frames;
+
+    if (NULL != ctrl->cadence)
+    {
+        base = ctrl->cadence[ctrl->cadence_index];
+        ctrl->cadence_index = (ctrl->cadence_index + 1U) % (RATE_CTRL_CADENCE_PACKETS);
+        ctrl->phase += ctrl->correction;
+    }
+    else
+    {
+        ctrl->phase += (int64_t) ctrl->nominal + ctrl->correction;
+    }
+
+    /* Whole frames only, towards zero: a correction hovering around zero
+     * leaves the cadence untouched
+     */
+    frames = base + (ctrl->phase / RATE_CTRL_ONE);
+
+    if (frames > (int64_t) ctrl->max_frames)
+    {
+        frames = (int64_t) ctrl->max_frames;
+    }
+    else if (frames < (int64_t) ctrl->min_frames)
+    {
+        frames = (int64_t) ctrl->min_frames;
+    }
+    ctrl->phase -= (frames - base) * RATE_CTRL_ONE;
+
+    /* Never owe more than a waiting frame plus the correction range */
+    if (ctrl->phase > (2 * (int64_t) RATE_CTRL_MAX_CORRECTION))
+    {
+        ctrl->phase = 2 * (int64_t) RATE_CTRL_MAX_CORRECTION;
+    }
+    else if (ctrl->phase < (-2 * (int64_t) RATE_CTRL_MAX_CORRECTION))
+    {
+        ctrl->phase = -2 * (int64_t) RATE_CTRL_MAX_CORRECTION;
+    }
+
+    return (uint32_t) frames;
+}
+
+/*****************************************************************************
+* Function Name: rate_ctrl_get_drift_ppm
+******************************************************************************
+* Summary:
+*  Get the estimated offset of the PDM/PCM clock against the host clock.
+*
+* Parameters:
+*  ctrl: Rate controller
+*
+* Return:
+*  int32_t: Offset in ppm, positive when the PDM/PCM clock runs fast
+*
+*****************************************************************************/
+int32_t rate_ctrl_get_drift_ppm(const rate_ctrl_t *ctrl)
+{
+    return (int32_t) (((int64_t) ctrl->integral * 1000000) / ctrl->nominal);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,291 @@
+/*****************************************************************************
+* File Name    : rtos_stats.c
+*
+* Description  : This file contains the CPU time accounting of the FreeRTOS
+*                tasks, based on the CPU cycle counter.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "rtos_stats.h"
+#include "cycle_counter.h"
+#include "cy_utils.h"
+
+#include <stdio.h>
+
+#include "rtos.h"
+
+#if (configGENERATE_RUN_TIME_STATS)
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define RTOS_STATS_PERMILLE             (1000U)
+
+/* Period of the extension of the cycle counter to 64 bits, well within the
+ * wrap-around of the cycle counter (28.6 s at 150 MHz)
+ */
+#define RTOS_STATS_EXTEND_MS            (10000U)
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void rtos_stats_extend(TimerHandle_t timer);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Cycle counter extended to 64 bits */
+static uint64_t rtos_stats_cycles = 0U;
+static uint32_t rtos_stats_last_cycles = 0U;
+
+/* Timer extending the cycle counter while no task switches */
+static TimerHandle_t rtos_stats_timer = NULL;
+static StaticTimer_t rtos_stats_timer_buffer;
+
+/* Cycle counter when the running task was switched in */
+static uint32_t rtos_stats_switch_in_cycles = 0U;
+
+/* Array filled by uxTaskGetSystemState() */
+static TaskStatus_t rtos_stats_tasks[RTOS_STATS_MAX_TASKS];
+
+
+/*****************************************************************************
+* Function Name: rtos_stats_init
+******************************************************************************
+* Summary:
+*  Start the run time counter. Called by the scheduler on start-up through
+*  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(), once the cycle counter runs.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rtos_stats_init(void)
+{
+    rtos_stats_cycles = 0U;
+    rtos_stats_last_cycles = cycle_counter_get();
+    rtos_stats_switch_in_cycles = rtos_stats_last_cycles;
+
+    if (NULL == rtos_stats_timer)
+    {
+        rtos_stats_timer = xTimerCreateStatic("Run Time", pdMS_TO_TICKS(RTOS_STATS_EXTEND_MS), pdTRUE, NULL,
+                                              rtos_stats_extend, &rtos_stats_timer_buffer);
+        if ((NULL == rtos_stats_timer) || (pdPASS != xTimerStart(rtos_stats_timer, 0U)))
+        {
+            CY_ASSERT(0);
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: rtos_stats_get_counter
+******************************************************************************
+* Summary:
+*  Get the run time counter, through portGET_RUN_TIME_COUNTER_VALUE(). The
+*  cycle counter is extended to 64 bits on each call, which must happen at
+*  least once per wrap-around of the cycle counter: besides the context
+*  switches, rtos_stats_extend() calls it every RTOS_STATS_EXTEND_MS.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: CPU cycles since start-up divided by 2^RTOS_STATS_COUNTER_SHIFT
+*
+*****************************************************************************/
+uint32_t rtos_stats_get_counter(void)
+{
+    UBaseType_t interrupt_status;
+    uint32_t cycles;
+    uint32_t counter;
+
+    /* Called by the scheduler with interrupts masked and by tasks */
+    interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+
+    cycles = cycle_counter_get();
+    rtos_stats_cycles += (uint32_t) (cycles - rtos_stats_last_cycles);
+    rtos_stats_last_cycles = cycles;
+    counter = (uint32_t) (rtos_stats_cycles >> RTOS_STATS_COUNTER_SHIFT);
+
+    taskEXIT_CRITICAL_FROM_ISR(interrupt_status);
+
+    return counter;
+}
+
+/*****************************************************************************
+* Function Name: rtos_stats_extend
+******************************************************************************
+* Summary:
+*  Timer callback extending the cycle counter, so the run time counter
+*  stays right however seldom the tasks switch.
+*
+* Parameters:
+*  timer: Unused
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void rtos_stats_extend(TimerHandle_t timer)
+{
+    CY_UNUSED_PARAMETER(timer);
+
+    (void) rtos_stats_get_counter();
+}
+
+/*****************************************************************************
+* Function Name: rtos_stats_task_switched_in
+******************************************************************************
+* Summary:
+*  Called by the scheduler through traceTASK_SWITCHED_IN() when a task
+*  starts to run.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rtos_stats_task_switched_in(void)
+{
+    rtos_stats_switch_in_cycles = cycle_counter_get();
+}
+
+/*****************************************************************************
+* Function Name: rtos_stats_task_switched_out
+******************************************************************************
+* Summary:
+*  Called by the scheduler through traceTASK_SWITCHED_OUT() when a task
+*  stops running. Keeps the longest uninterrupted run of the task, in CPU
+*  cycles, in one of its thread local storage pointers. The interrupts
+*  serviced during the run are included.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rtos_stats_task_switched_out(void)
+{
+    uint32_t run = cycle_counter_get() - rtos_stats_switch_in_cycles;
+
+    if (run > (uint32_t) (uintptr_t) pvTaskGetThreadLocalStoragePointer(NULL, RTOS_STATS_TLS_INDEX))
+    {
+        vTaskSetThreadLocalStoragePointer(NULL, RTOS_STATS_TLS_INDEX, (void *) (uintptr_t) run);
+    }
+}
+
+/*****************************************************************************
+* Function Name: rtos_stats_reset
+******************************************************************************
+* Summary:
+*  Clear the longest run of all the tasks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rtos_stats_reset(void)
+{
+    UBaseType_t num_tasks;
+    UBaseType_t i;
+
+    vTaskSuspendAll();
+
+    num_tasks = uxTaskGetSystemState(rtos_stats_tasks, RTOS_STATS_MAX_TASKS, NULL);
+    for (i = 0U; i < num_tasks; i++)
+    {
+        vTaskSetThreadLocalStoragePointer(rtos_stats_tasks[i].xHandle, RTOS_STATS_TLS_INDEX, NULL);
+    }
+
+    (void) xTaskResumeAll();
+}
+
+/*****************************************************************************
+* Function Name: rtos_stats_print
+******************************************************************************
+* Summary:
+*  Print the share of CPU time used by each task since start-up and its
+*  longest uninterrupted run on the debug UART.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void rtos_stats_print(void)
+{
+    UBaseType_t num_tasks;
+    UBaseType_t i;
+    uint32_t total_run_time;
+    uint32_t share;
+    uint32_t longest_run;
+
+    num_tasks = uxTaskGetSystemState(rtos_stats_tasks, RTOS_STATS_MAX_TASKS, &total_run_time);
+    if (0U == total_run_time)
+    {
+        return;
+    }
+
+    printf("Task             CPU      Longest run\r\n");
+
+    for (i = 0U; i < num_tasks; i++)
+    {
+        share = (uint32_t) (((uint64_t) rtos_stats_tasks[i].ulRunTimeCounter * RTOS_STATS_PERMILLE) / total_run_time);
+        longest_run = (uint32_t) (uintptr_t) pvTaskGetThreadLocalStoragePointer(rtos_stats_tasks[i].xHandle, RTOS_STATS_TLS_INDEX);
+
+        printf("%-16s %3lu.%lu %%  %lu us\r\n", rtos_stats_tasks[i].pcTaskName,
+               (unsigned long) (share / 10U), (unsigned long) (share % 10U),
+               (unsigned long) cycle_counter_to_us(longest_run));
+    }
+}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+/* [] END OF FILE */
@@ -0,0 +1,296 @@
+/*****************************************************************************
+* File Name    : telemetry.c
+*
+* Description  : This file contains the sampling of the stack and heap
+*                high-water marks of the application.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "telemetry.h"
+#include "cy_utils.h"
+#include "cy_retarget_io.h"
+
+#include <malloc.h>
+#include <string.h>
+
+#include "rtos.h"
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    TaskHandle_t *handle;
+    uint32_t stack_depth;   /* In words */
+} telemetry_task_t;
+
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void telemetry_sample(TimerHandle_t timer);
+static uint32_t telemetry_heap_free(void);
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Heap of the C library, bounds set by the linker script */
+extern uint8_t __HeapBase[];
+extern uint8_t __HeapLimit[];
+
+/* RTOS tasks created by the kernel, known once the scheduler runs */
+static TaskHandle_t telemetry_idle_task = NULL;
+static TaskHandle_t telemetry_timer_task = NULL;
+
+/* Tasks monitored and the size of their stack */
+static const telemetry_task_t telemetry_tasks[TELEMETRY_NUM_TASKS] =
+{
+    {&rtos_audio_app_task,      AUDIO_APP_TASK_STACK_DEPTH},
+    {&rtos_audio_in_task,       AUDIO_IN_TASK_STACK_DEPTH},
+    {&rtos_console_task,        CONSOLE_TASK_STACK_DEPTH},
+    {&telemetry_idle_task,      configMINIMAL_STACK_SIZE},
+    {&telemetry_timer_task,     configTIMER_TASK_STACK_DEPTH},
+};
+
+/* History of the samples, the oldest one is overwritten first */
+static telemetry_sample_t telemetry_history[TELEMETRY_HISTORY_LENGTH];
+static uint32_t telemetry_num_samples = 0U;
+
+/* Lowest heap left seen by the samples, in bytes */
+static uint32_t telemetry_heap_min_free = UINT32_MAX;
+
+/* Tasks for which the low stack warning was printed */
+static uint32_t telemetry_warned_tasks = 0U;
+
+/* Sampling timer */
+static TimerHandle_t telemetry_timer;
+static StaticTimer_t telemetry_timer_buffer;
+
+
+/*****************************************************************************
+* Function Name: telemetry_init
+******************************************************************************
+* Summary:
+*  Start the periodic sampling of the stack high-water marks of the tasks
+*  and of the free heap. The samples are taken by the RTOS timer task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void telemetry_init(void)
+{
+    telemetry_timer = xTimerCreateStatic("Telemetry", pdMS_TO_TICKS(TELEMETRY_PERIOD_MS), pdTRUE, NULL,
+                                         telemetry_sample, &telemetry_timer_buffer);
+    if (NULL == telemetry_timer)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (pdPASS != xTimerStart(telemetry_timer, 0U))
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: telemetry_heap_free
+******************************************************************************
+* Summary:
+*  Get the heap left to the C library allocator (heap_3 serves the RTOS
+*  allocations from the same heap).
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Free heap, in bytes
+*
+*****************************************************************************/
+static uint32_t telemetry_heap_free(void)
+{
+    struct mallinfo info = mallinfo();
+    uint32_t heap_size = (uint32_t) (__HeapLimit - __HeapBase);
+
+    return (heap_size > (uint32_t) info.uordblks) ? (heap_size - (uint32_t) info.uordblks) : 0U;
+}
+
+/*****************************************************************************
+* Function Name: telemetry_sample
+******************************************************************************
+* Summary:
+*  Timer callback, called every TELEMETRY_PERIOD_MS. Records the stack
+*  high-water mark of each task and the free heap in the history, and warns
+*  once per task when its stack gets close to the limit.
+*
+* Parameters:
+*  timer: Sampling timer
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+static void telemetry_sample(TimerHandle_t timer)
+{
+    telemetry_sample_t *sample;
+    TaskHandle_t handle;
+    UBaseType_t free_words;
+    uint32_t i;
+
+    CY_UNUSED_PARAMETER(timer);
+
+    if (NULL == telemetry_idle_task)
+    {
+        telemetry_idle_task = xTaskGetIdleTaskHandle();
+        telemetry_timer_task = xTimerGetTimerDaemonTaskHandle();
+    }
+
+    sample = &telemetry_history[telemetry_num_samples % (TELEMETRY_HISTORY_LENGTH)];
+    sample->time_ms = (uint32_t) (xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+    for (i = 0U; i < (TELEMETRY_NUM_TASKS); i++)
+    {
+        handle = *telemetry_tasks[i].handle;
+        free_words = (NULL != handle) ? uxTaskGetStackHighWaterMark(handle) : 0U;
+        sample->stack_free[i] = (uint16_t) free_words;
+
+        if ((NULL != handle) && (free_words < (TELEMETRY_STACK_WARN_WORDS)) &&
+            (0U == (telemetry_warned_tasks & (1UL << i))))
+        {
+            telemetry_warned_tasks |= (1UL << i);
+            printf("TELEMETRY: %s has %lu words of stack left\r\n", pcTaskGetName(handle),
+                   (unsigned long) free_words);
+        }
+    }
+
+    sample->heap_free = telemetry_heap_free();
+    if (sample->heap_free < telemetry_heap_min_free)
+    {
+        telemetry_heap_min_free = sample->heap_free;
+    }
+
+    telemetry_num_samples++;
+}
+
+/*****************************************************************************
+* Function Name: telemetry_print
+******************************************************************************
+* Summary:
+*  Print the stack use of each task and the free heap, with their change
+*  over the history, followed by the history itself.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void telemetry_print(void)
+{
+    static telemetry_sample_t history[TELEMETRY_HISTORY_LENGTH];
+    uint32_t num_samples;
+    uint32_t heap_min_free;
+    uint32_t first;
+    uint32_t last;
+    uint32_t count;
+    uint32_t i;
+    uint32_t n;
+    TaskHandle_t handle;
+
+    /* Copy the history out of the reach of the timer task */
+    vTaskSuspendAll();
+    memcpy(history, telemetry_history, sizeof(history));
+    num_samples = telemetry_num_samples;
+    heap_min_free = telemetry_heap_min_free;
+    (void) xTaskResumeAll();
+
+    if (0U == num_samples)
+    {
+        printf("Telemetry: no sample yet\r\n");
+        return;
+    }
+
+    count = (num_samples < (TELEMETRY_HISTORY_LENGTH)) ? num_samples : (TELEMETRY_HISTORY_LENGTH);
+    first = (num_samples - count) % (TELEMETRY_HISTORY_LENGTH);
+    last = (num_samples - 1U) % (TELEMETRY_HISTORY_LENGTH);
+
+    printf("Telemetry over the last %lu s:\r\n",
+           (unsigned long) ((history[last].time_ms - history[first].time_ms) / 1000U));
+
+    for (i = 0U; i < (TELEMETRY_NUM_TASKS); i++)
+    {
+        handle = *telemetry_tasks[i].handle;
+        if (NULL == handle)
+        {
+            continue;
+        }
+
+        printf("  %-16s stack %4lu words, peak use %4lu words (%+ld)\r\n", pcTaskGetName(handle),
+               (unsigned long) telemetry_tasks[i].stack_depth,
+               (unsigned long) (telemetry_tasks[i].stack_depth - history[last].stack_free[i]),
+               (long) history[first].stack_free[i] - (long) history[last].stack_free[i]);
+    }
+
+    printf("  Heap free %lu bytes, lowest sampled %lu bytes (%+ld)\r\n", (unsigned long) history[last].heap_free,
+           (unsigned long) heap_min_free, (long) history[last].heap_free - (long) history[first].heap_free);
+
+    /* History, oldest sample first. Stack left in words, heap left in bytes */
+    printf("  time(s)");
+    for (i = 0U; i < (TELEMETRY_NUM_TASKS); i++)
+    {
+        printf("  task%lu", (unsigned long) i);
+    }
+    printf("     heap\r\n");
+
+    for (n = 0U; n < count; n++)
+    {
+        const telemetry_sample_t *sample = &history[(first + n) % (TELEMETRY_HISTORY_LENGTH)];
+
+        printf("  %7lu", (unsigned long) (sample->time_ms / 1000U));
+        for (i = 0U; i < (TELEMETRY_NUM_TASKS); i++)
+        {
+            printf("  %5u", (unsigned int) sample->stack_free[i]);
+        }
+        printf("  %7lu\r\n", (unsigned long) sample->heap_free);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,326 @@
+/*****************************************************************************
+* File Name    : bench_beam.c
+*
+* Description  : This file contains the benchmark of the beamformer: cycles per period,
+*                accuracy against a model with exact interpolator coefficients, and
+*                response to plane waves from the steered and from other directions.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_beam.h"
+#include "dsp_bench.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (1U)
+#define BENCH_SETTLE_FRAMES         (64U)
+
+/* Resolution of the samples of each size */
+#define BENCH_BITS(sample_size)     ((2U == (sample_size)) ? 16UL : 24UL)
+
+/* Error against the model, in LSB: rounding of the Q14 coefficients */
+#define BENCH_MAX_ERROR_LSB         (2.0)
+#define BENCH_MAX_ERROR_LSB_24      (32.0)
+
+/* Response to a tone, against the delay-and-sum of ideal delays */
+#define BENCH_RESPONSE_HZ           (2000.0)
+#define BENCH_MAX_RESPONSE_ERROR_DB (0.2)
+#define BENCH_STEER_DEG             (60)
+
+/* Directions of the sources, in degrees */
+#define BENCH_DEG_TO_RAD(degrees)   ((double) (degrees) * DSP_BENCH_PI / 180.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t sample_size;
+} bench_format_t;
+
+/* Steering of the model */
+typedef struct
+{
+    uint32_t sample_rate;
+    int32_t degrees;
+} bench_steer_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    { 16000U, 2U },
+    { 44100U, 2U },
+    { 48000U, 2U },
+    { 96000U, 2U },
+    { 48000U, 4U },
+};
+
+/* Directions of the sources of the response, in degrees */
+static const int32_t bench_sources[] = { 60, 30, 0, -30, -90 };
+
+
+/*****************************************************************************
+* Function Name: bench_delay
+******************************************************************************
+* Summary:
+*  Get the delay between the microphones for a direction, in samples:
+*  positive when the sound reaches the left microphone (channel 0) first.
+*
+*****************************************************************************/
+static double bench_delay(int32_t degrees, uint32_t sample_rate)
+{
+    return ((double) (DSP_BEAM_MIC_SPACING_MM) / 1000.0) * sin(BENCH_DEG_TO_RAD(degrees)) * (double) sample_rate /
+           (double) (DSP_BEAM_SPEED_OF_SOUND);
+}
+
+/*****************************************************************************
+* Function Name: bench_reference
+******************************************************************************
+* Summary:
+*  Model of the stage: the other microphone delayed by one sample, the
+*  first one by 1 + delay samples with a 4-tap Lagrange interpolator of
+*  exact coefficients, and the average of both. Mono on return.
+*
+*****************************************************************************/
+static void bench_reference(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    const bench_steer_t *steer = (const bench_steer_t *) arg;
+    double delay = bench_delay(steer->degrees, steer->sample_rate);
+    uint32_t lead = (delay >= 0.0) ? 0U : 1U;
+    double *mono = calloc(frames, sizeof(double));
+    double coefs[4];
+    double other;
+    double acc;
+    double d;
+    uint32_t base;
+    uint32_t frame;
+    uint32_t k;
+    int32_t n;
+
+    delay = fabs(delay);
+    base = (uint32_t) delay;
+    d = 1.0 + (delay - (double) base);
+    coefs[0] = -(d - 1.0) * (d - 2.0) * (d - 3.0) / 6.0;
+    coefs[1] = d * (d - 2.0) * (d - 3.0) / 2.0;
+    coefs[2] = -d * (d - 1.0) * (d - 3.0) / 2.0;
+    coefs[3] = d * (d - 1.0) * (d - 2.0) / 6.0;
+
+    (void) channels;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        other = (frame >= 1U) ? samples[((frame - 1U) * 2U) + (1U - lead)] : 0.0;
+        acc = 0.0;
+        for (k = 0U; k < 4U; k++)
+        {
+            n = (int32_t) frame - (int32_t) base - (int32_t) k;
+            acc += (n >= 0) ? (coefs[k] * samples[((uint32_t) n * 2U) + lead]) : 0.0;
+        }
+        mono[frame] = floor((other + acc) / 2.0);
+    }
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        samples[frame] = mono[frame];
+    }
+
+    free(mono);
+}
+
+/*****************************************************************************
+* Function Name: bench_wave
+******************************************************************************
+* Summary:
+*  Fill the two microphones with a tone arriving from a direction, as a
+*  plane wave: each microphone gets the tone half the delay before or
+*  after the center of the pair.
+*
+*****************************************************************************/
+static void bench_wave(double *samples, uint32_t frames, uint32_t sample_rate, int32_t degrees, double frequency,
+                       double level)
+{
+    double delay = bench_delay(degrees, sample_rate);
+    double w = 2.0 * DSP_BENCH_PI * frequency / (double) sample_rate;
+    uint32_t frame;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        samples[2U * frame] += level * sin(w * ((double) frame + (delay / 2.0)));
+        samples[(2U * frame) + 1U] += level * sin(w * ((double) frame - (delay / 2.0)));
+    }
+}
+
+/*****************************************************************************
+* Function Name: bench_response
+******************************************************************************
+* Summary:
+*  Steer the beam, run a tone from a direction and return the gain of the
+*  output against the tone, in dB.
+*
+*****************************************************************************/
+static double bench_response(dsp_bench_t *bench, double *input, int32_t steer, int32_t source)
+{
+    dsp_bench_result_t result;
+    const double *output;
+    double power = 0.0;
+    uint32_t frame;
+
+    for (frame = 0U; frame < (bench->frames * 2U); frame++)
+    {
+        input[frame] = 0.0;
+    }
+    bench_wave(input, bench->frames, bench->sample_rate, source, BENCH_RESPONSE_HZ, 0.5);
+
+    dsp_beam_set_angle(steer);
+    dsp_beam_reset();
+    bench->reference = NULL;
+    dsp_bench_run(bench, &result);
+    output = dsp_bench_output();
+
+    for (frame = bench->settle_frames; frame < bench->frames; frame++)
+    {
+        power += output[frame] * output[frame];
+    }
+
+    return 10.0 * log10((power / (double) (bench->frames - bench->settle_frames)) / (0.5 * 0.5 / 2.0));
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Time the stage on a format against the model, steered off broadside on
+*  a mix of plane waves, then check its response to sources around it.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    double *input = calloc((size_t) frames * 2U, sizeof(double));
+    double max_error = (2U == format->sample_size) ? (BENCH_MAX_ERROR_LSB) : (BENCH_MAX_ERROR_LSB_24);
+    bench_steer_t steer = { format->sample_rate, BENCH_STEER_DEG };
+    dsp_bench_result_t result;
+    dsp_bench_t bench;
+    double expected_db;
+    double response_db;
+    double w;
+    uint32_t i;
+
+    /* Speech band tones from the steered direction, and from the side */
+    bench_wave(input, frames, format->sample_rate, BENCH_STEER_DEG, 300.0, 0.2);
+    bench_wave(input, frames, format->sample_rate, BENCH_STEER_DEG, 1200.0, 0.2);
+    bench_wave(input, frames, format->sample_rate, -45, 3100.0, 0.2);
+    dsp_bench_noise(input, frames, 2U, 0.01, 13U);
+
+    dsp_beam_configure(format->sample_rate);
+    dsp_beam_set_angle(BENCH_STEER_DEG);
+
+    bench.name = "Beamformer";
+    bench.sample_rate = format->sample_rate;
+    bench.channels = 2U;
+    bench.sample_size = format->sample_size;
+    bench.frames = frames;
+    bench.input = input;
+    bench.process = dsp_beam_process;
+    bench.reference = bench_reference;
+    bench.arg = &steer;
+    bench.latency = 0U;
+    bench.settle_frames = BENCH_SETTLE_FRAMES;
+    bench.output_channels = 1U;
+
+    dsp_bench_run(&bench, &result);
+    dsp_bench_print(&bench, &result);
+    TEST_CHECK(result.max_error <= max_error, "%lu Hz %lu bits: error of %.2f LSB",
+               (unsigned long) format->sample_rate, BENCH_BITS(format->sample_size), result.max_error);
+
+    /* Delay-and-sum of two microphones: |cos(w (steer - source) / 2)| */
+    w = 2.0 * DSP_BENCH_PI * BENCH_RESPONSE_HZ / (double) format->sample_rate;
+    printf("    %.0f Hz steered to %+d deg:", BENCH_RESPONSE_HZ, BENCH_STEER_DEG);
+    for (i = 0U; i < (sizeof(bench_sources) / sizeof(bench_sources[0])); i++)
+    {
+        response_db = bench_response(&bench, input, BENCH_STEER_DEG, bench_sources[i]);
+        expected_db = 20.0 * log10(fabs(cos(w * (bench_delay(BENCH_STEER_DEG, format->sample_rate) -
+                                                 bench_delay(bench_sources[i], format->sample_rate)) / 2.0)));
+        printf(" %+d deg %.2f dB (%.2f)", (int) bench_sources[i], response_db, expected_db);
+
+        TEST_CHECK(fabs(response_db - expected_db) <= (BENCH_MAX_RESPONSE_ERROR_DB),
+                   "%lu Hz: %.2f dB from %+d deg instead of %.2f dB", (unsigned long) format->sample_rate,
+                   response_db, (int) bench_sources[i], expected_db);
+    }
+    printf("\n");
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark on every format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    printf("Beamformer, %s\n", BENCH_PATH);
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
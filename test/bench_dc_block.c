@@ -0,0 +1,298 @@
+/*****************************************************************************
+* File Name    : bench_dc_block.c
+*
+* Description  : This file contains the benchmark of the DC block stage on the host:
+*                host cycles per 1 ms period against a floating point reference, the
+*                -3 dB corner, the passband and the rejection of a DC offset.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_bench.h"
+#include "dsp_dc_block.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (2U)
+
+/* Time for the filter to settle before a level is measured */
+#define BENCH_SETTLE_MS             (500U)
+
+/* Error against the reference, in LSB */
+#define BENCH_MAX_ERROR_LSB         (1.0)
+
+/* Gain at the cutoff frequency and in the passband, in dB */
+#define BENCH_CORNER_DB             (-3.01)
+#define BENCH_MAX_CORNER_ERROR_DB   (0.3)
+#define BENCH_PASSBAND_HZ           (1000.0)
+#define BENCH_MAX_PASSBAND_DB       (0.1)
+
+/* Offset step at the input, and largest offset left at the output, in LSB */
+#define BENCH_DC_OFFSET             (0.25)
+#define BENCH_MAX_DC_LSB            (1.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t sample_size;
+} bench_format_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    {  8000U, 2U, 2U },
+    { 48000U, 1U, 2U },
+    { 48000U, 2U, 2U },
+    { 96000U, 2U, 2U },
+    { 48000U, 2U, 4U },
+    { 96000U, 2U, 4U },
+};
+
+
+/*****************************************************************************
+* Function Name: bench_reference
+******************************************************************************
+* Summary:
+*  Floating point model of the filter, with the coefficient computed by
+*  dsp_dc_block_configure().
+*
+*****************************************************************************/
+static void bench_reference(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    uint32_t sample_rate = *(const uint32_t *) arg;
+    double k;
+    double x1;
+    double y1;
+    double x;
+    uint32_t frame;
+    uint32_t channel;
+
+    k = (double) (((uint64_t) 411775U * (DSP_DC_BLOCK_CUTOFF_HZ) * (1U << (DSP_DC_BLOCK_Q))) /
+                  ((uint64_t) sample_rate << 16)) / (double) (1U << (DSP_DC_BLOCK_Q));
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        x1 = 0.0;
+        y1 = 0.0;
+        for (frame = 0U; frame < frames; frame++)
+        {
+            x = samples[(frame * channels) + channel];
+            y1 = x - x1 + ((1.0 - k) * y1);
+            x1 = x;
+            samples[(frame * channels) + channel] = y1;
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: bench_offset
+******************************************************************************
+* Summary:
+*  Run the stage on a step of DC offset and return the offset left once
+*  settled, in LSB. The first channel only.
+*
+*****************************************************************************/
+static double bench_offset(dsp_bench_t *bench, double *input)
+{
+    dsp_bench_result_t result;
+    const double *output;
+    double offset = 0.0;
+    uint32_t frame;
+
+    for (frame = 0U; frame < (bench->frames * bench->channels); frame++)
+    {
+        input[frame] = BENCH_DC_OFFSET;
+    }
+
+    dsp_dc_block_configure(bench->sample_rate);
+    dsp_dc_block_reset();
+    bench->reference = NULL;
+    dsp_bench_run(bench, &result);
+    output = dsp_bench_output();
+
+    for (frame = bench->settle_frames; frame < bench->frames; frame++)
+    {
+        offset += output[frame * bench->channels];
+    }
+
+    return (offset / (double) (bench->frames - bench->settle_frames)) * DSP_BENCH_FULL_SCALE(bench->sample_size);
+}
+
+/*****************************************************************************
+* Function Name: bench_level
+******************************************************************************
+* Summary:
+*  Run the stage on a tone and return its gain in dB, from the RMS levels
+*  once settled. The first channel only.
+*
+*****************************************************************************/
+static double bench_level(dsp_bench_t *bench, double *input, double frequency, double level)
+{
+    dsp_bench_result_t result;
+    const double *output;
+    double in_power = 0.0;
+    double out_power = 0.0;
+    uint32_t frame;
+
+    for (frame = 0U; frame < (bench->frames * bench->channels); frame++)
+    {
+        input[frame] = 0.0;
+    }
+    dsp_bench_tone(input, bench->frames, bench->channels, bench->sample_rate, frequency, level);
+
+    dsp_dc_block_configure(bench->sample_rate);
+    dsp_dc_block_reset();
+    bench->reference = NULL;
+    dsp_bench_run(bench, &result);
+    output = dsp_bench_output();
+
+    for (frame = bench->settle_frames; frame < bench->frames; frame++)
+    {
+        in_power += input[frame * bench->channels] * input[frame * bench->channels];
+        out_power += output[frame * bench->channels] * output[frame * bench->channels];
+    }
+
+    return 10.0 * log10(out_power / in_power);
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Time the stage on a format against the reference, then check its
+*  response.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    uint32_t sample_rate = format->sample_rate;
+    dsp_bench_result_t result;
+    dsp_bench_t bench;
+    double corner_db;
+    double passband_db;
+    double offset;
+    uint32_t i;
+
+    /* Tones over a DC offset */
+    for (i = 0U; i < (frames * format->channels); i++)
+    {
+        input[i] = BENCH_DC_OFFSET;
+    }
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 440.0, 0.25);
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, format->sample_rate / 5.0, 0.1);
+    dsp_bench_noise(input, frames, format->channels, 0.01, 3U);
+
+    dsp_dc_block_configure(format->sample_rate);
+    dsp_dc_block_reset();
+
+    bench.name = "DC block";
+    bench.sample_rate = format->sample_rate;
+    bench.channels = format->channels;
+    bench.sample_size = format->sample_size;
+    bench.frames = frames;
+    bench.input = input;
+    bench.process = dsp_dc_block_process;
+    bench.reference = bench_reference;
+    bench.arg = &sample_rate;
+    bench.latency = 0U;
+    bench.settle_frames = (format->sample_rate / 1000U) * (BENCH_SETTLE_MS);
+    bench.output_channels = 0U;
+
+    dsp_bench_run(&bench, &result);
+    dsp_bench_print(&bench, &result);
+
+    offset = bench_offset(&bench, input);
+    corner_db = bench_level(&bench, input, (double) (DSP_DC_BLOCK_CUTOFF_HZ), 0.5);
+    passband_db = bench_level(&bench, input, BENCH_PASSBAND_HZ, 0.5);
+
+    printf("    gain %.2f dB at %u Hz, %.3f dB at %.0f Hz, offset of %.0f LSB left at %.2f LSB\n", corner_db,
+           (unsigned int) (DSP_DC_BLOCK_CUTOFF_HZ), passband_db, BENCH_PASSBAND_HZ, BENCH_DC_OFFSET * DSP_BENCH_FULL_SCALE(format->sample_size), offset);
+
+    TEST_CHECK(result.max_error <= (BENCH_MAX_ERROR_LSB), "%lu Hz %lu ch: error of %.2f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels, result.max_error);
+    TEST_CHECK(fabs(corner_db - (BENCH_CORNER_DB)) <= (BENCH_MAX_CORNER_ERROR_DB), "%lu Hz: %.2f dB at the corner",
+               (unsigned long) format->sample_rate, corner_db);
+    TEST_CHECK(fabs(passband_db) <= (BENCH_MAX_PASSBAND_DB), "%lu Hz: %.3f dB in the passband",
+               (unsigned long) format->sample_rate, passband_db);
+    TEST_CHECK(fabs(offset) <= (BENCH_MAX_DC_LSB), "%lu Hz: offset of %.2f LSB left",
+               (unsigned long) format->sample_rate, offset);
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark on every format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    printf("DC block, %s\n", BENCH_PATH);
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
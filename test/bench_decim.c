@@ -0,0 +1,384 @@
+/*****************************************************************************
+* File Name    : bench_decim.c
+*
+* Description  : This file contains the benchmark of the decimator of the second
+*                stream: cycles per period, output against an exact model of the
+*                stage, passband ripple and rejection of the aliases.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+*****************************************************************************/
+#include "dsp_decim.h"
+#include "dsp_bench.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (1U)
+#define BENCH_OUT_RATE              (16000U)
+
+#define BENCH_BITS(sample_size)     ((2U == (sample_size)) ? 16UL : 24UL)
+
+/* Largest block of 1 ms, and its output */
+#define BENCH_MAX_FRAMES            (97U)
+
+/* Output samples skipped at the start of each tone, past the lowpass */
+#define BENCH_SETTLE_SAMPLES        (64U)
+
+/* Passband, from 0 to BENCH_PASSBAND_HZ, and stopband, from
+ * BENCH_STOPBAND_HZ to half the input rate, where the tones alias
+ */
+#define BENCH_TONES                 (20U)
+#define BENCH_TONE_LEVEL            (0.5)
+#define BENCH_PASSBAND_HZ           (5600.0)
+#define BENCH_STOPBAND_HZ           (10400.0)
+#define BENCH_MAX_RIPPLE_DB         (0.1)
+#define BENCH_MIN_REJECTION_DB      (50.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;           /* Rate of the capture */
+    uint32_t channels;
+    uint32_t sample_size;
+} bench_format_t;
+
+/* Lowpass of the stage, read back from its impulse responses */
+typedef struct
+{
+    int16_t coefs[DSP_DECIM_MAX_TAPS];
+    uint32_t taps;
+    uint32_t factor;
+    uint32_t sample_size;
+} bench_model_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    { 32000U, 2U, 2U },
+    { 48000U, 2U, 2U },
+    { 48000U, 1U, 2U },
+    { 48000U, 2U, 4U },
+    { 96000U, 2U, 2U },
+};
+
+/* Sample size of the blocks of bench_process() */
+static uint32_t bench_sample_size;
+
+
+/*****************************************************************************
+* Function Name: bench_process
+******************************************************************************
+* Summary:
+*  Decimate a block, the mono output replaces its samples in the full scale
+*  of the block.
+*
+*****************************************************************************/
+static void bench_process(dsp_block_t *block)
+{
+    int16_t output[BENCH_MAX_FRAMES];
+    uint32_t count = dsp_decim_process(block, output);
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        if (2U == bench_sample_size)
+        {
+            ((int16_t *) block->samples)[i] = output[i];
+        }
+        else
+        {
+            ((int32_t *) block->samples)[i] = (int32_t) output[i] * 256;
+        }
+    }
+    block->frames = count;
+    block->channels = 1U;
+}
+
+/*****************************************************************************
+* Function Name: bench_read_coefs
+******************************************************************************
+* Summary:
+*  Read the lowpass of the stage back: an impulse of 0.5 (Q14 unity) at each
+*  phase of the decimation gives every factor-th coefficient, exactly.
+*
+*****************************************************************************/
+static void bench_read_coefs(uint32_t sample_rate, bench_model_t *model)
+{
+    uint32_t frames = (sample_rate / 1000U) * 4U;
+    int16_t input[4U * (BENCH_MAX_FRAMES)];
+    int16_t output[4U * (BENCH_MAX_FRAMES)];
+    dsp_block_t block = { input, frames, 1U, 2U };
+    uint32_t count;
+    uint32_t phase;
+    uint32_t k;
+    int32_t i;
+
+    model->factor = dsp_decim_configure(sample_rate, BENCH_OUT_RATE);
+    model->taps = model->factor * (DSP_DECIM_TAPS_PER_FACTOR);
+
+    for (phase = 0U; phase < model->factor; phase++)
+    {
+        for (k = 0U; k < frames; k++)
+        {
+            input[k] = (k == phase) ? (int16_t) (1L << (DSP_DECIM_Q)) : 0;
+        }
+        dsp_decim_reset();
+        count = dsp_decim_process(&block, output);
+
+        /* Output k is the sum of coefs[i] * input[k * factor + i - (taps - 1)] */
+        for (k = 0U; k < count; k++)
+        {
+            i = (int32_t) (phase + model->taps - 1U) - (int32_t) (k * model->factor);
+            if ((i >= 0) && (i < (int32_t) model->taps))
+            {
+                model->coefs[i] = output[k];
+            }
+        }
+    }
+    dsp_decim_reset();
+}
+
+/*****************************************************************************
+* Function Name: bench_exact
+******************************************************************************
+* Summary:
+*  Exact model of the stage: channels averaged in 16 bits, lowpass with a
+*  64-bit sum, rounded and saturated every factor frames. The mono output
+*  replaces the first samples.
+*
+*****************************************************************************/
+static void bench_exact(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    const bench_model_t *model = (const bench_model_t *) arg;
+    uint32_t history = model->taps - 1U;
+    int16_t *mono = calloc((size_t) frames + history, sizeof(int16_t));
+    int64_t acc;
+    int32_t sum;
+    uint32_t frame;
+    uint32_t ch;
+    uint32_t out;
+    uint32_t i;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        sum = 0;
+        for (ch = 0U; ch < channels; ch++)
+        {
+            sum += (2U == model->sample_size) ? (int32_t) samples[(frame * channels) + ch] :
+                                                ((int32_t) samples[(frame * channels) + ch] >> 8);
+        }
+        mono[history + frame] = (int16_t) (sum / (int32_t) channels);
+    }
+
+    for (out = 0U; (out * model->factor) < frames; out++)
+    {
+        acc = 0;
+        for (i = 0U; i < model->taps; i++)
+        {
+            acc += (int64_t) model->coefs[i] * mono[(out * model->factor) + i];
+        }
+        acc = (acc + (1L << ((DSP_DECIM_Q) - 1U))) >> (DSP_DECIM_Q);
+        acc = (acc > 32767) ? 32767 : ((acc < -32768) ? -32768 : acc);
+        samples[out] = (2U == model->sample_size) ? (double) acc : (double) (acc * 256);
+    }
+
+    free(mono);
+}
+
+/*****************************************************************************
+* Function Name: bench_init
+******************************************************************************
+* Summary:
+*  Fill the benchmark of a format.
+*
+*****************************************************************************/
+static void bench_init(dsp_bench_t *bench, const bench_format_t *format, const double *input, bench_model_t *model)
+{
+    bench->name = "Decimator";
+    bench->sample_rate = format->sample_rate;
+    bench->channels = format->channels;
+    bench->sample_size = format->sample_size;
+    bench->frames = format->sample_rate * (BENCH_SECONDS);
+    bench->input = input;
+    bench->process = bench_process;
+    bench->reference = NULL;
+    bench->arg = model;
+    bench->latency = 0U;
+    bench->settle_frames = 0U;
+    bench->output_channels = 1U;
+}
+
+/*****************************************************************************
+* Function Name: bench_level_db
+******************************************************************************
+* Summary:
+*  Decimate a tone and return the RMS level of the output against the RMS
+*  level of the tone, in dB.
+*
+*****************************************************************************/
+static double bench_level_db(const bench_format_t *format, double frequency)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    uint32_t out_frames = (BENCH_OUT_RATE) * (BENCH_SECONDS);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    const double *output;
+    dsp_bench_result_t result;
+    dsp_bench_t bench;
+    double power = 0.0;
+    uint32_t i;
+
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, frequency, BENCH_TONE_LEVEL);
+    bench_init(&bench, format, input, NULL);
+    dsp_decim_reset();
+    dsp_bench_run(&bench, &result);
+
+    output = dsp_bench_output();
+    for (i = (BENCH_SETTLE_SAMPLES); i < out_frames; i++)
+    {
+        power += output[i] * output[i];
+    }
+    power /= (double) (out_frames - (BENCH_SETTLE_SAMPLES));
+
+    free(input);
+    return 10.0 * log10(power / ((BENCH_TONE_LEVEL) * (BENCH_TONE_LEVEL) / 2.0));
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Time the decimator on a format, check it against the exact model, and
+*  measure its passband ripple and the rejection of the tones that alias.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    double nyquist = (double) format->sample_rate / 2.0;
+    dsp_bench_result_t exact;
+    bench_model_t model;
+    dsp_bench_t bench;
+    double frequency;
+    double level;
+    double min_gain = INFINITY;
+    double max_gain = -INFINITY;
+    double max_alias = -INFINITY;
+    uint32_t i;
+
+    bench_sample_size = format->sample_size;
+    bench_read_coefs(format->sample_rate, &model);
+    model.sample_size = format->sample_size;
+
+    /* Full scale speech band content and noise: the sums saturate */
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 440.0, 0.6);
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 3100.0, 0.3);
+    dsp_bench_noise(input, frames, format->channels, 0.3, 5U);
+    bench_init(&bench, format, input, &model);
+    bench.reference = bench_exact;
+    dsp_decim_reset();
+    dsp_bench_run(&bench, &exact);
+    dsp_bench_print(&bench, &exact);
+
+    for (i = 0U; i <= (BENCH_TONES); i++)
+    {
+        frequency = (BENCH_PASSBAND_HZ) * (double) ((0U == i) ? 1U : (2U * i)) / (2.0 * (BENCH_TONES));
+        level = bench_level_db(format, frequency);
+        min_gain = (level < min_gain) ? level : min_gain;
+        max_gain = (level > max_gain) ? level : max_gain;
+
+        frequency = (BENCH_STOPBAND_HZ) + (((nyquist - (BENCH_STOPBAND_HZ)) * (double) i) / (double) (BENCH_TONES));
+        level = bench_level_db(format, (frequency < nyquist) ? frequency : (nyquist - 100.0));
+        max_alias = (level > max_alias) ? level : max_alias;
+    }
+
+    printf("    %lu taps, passband ripple %.3f dB up to %.0f Hz, aliases from %.0f Hz at %.1f dB\n",
+           (unsigned long) model.taps, max_gain - min_gain, BENCH_PASSBAND_HZ, BENCH_STOPBAND_HZ, max_alias);
+
+    TEST_CHECK(0.0 == exact.max_error, "%lu Hz %lu ch %lu bits: off the exact model by %.0f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels,
+               BENCH_BITS(format->sample_size), exact.max_error);
+    TEST_CHECK((max_gain - min_gain) <= (BENCH_MAX_RIPPLE_DB), "%lu Hz: ripple of %.3f dB",
+               (unsigned long) format->sample_rate, max_gain - min_gain);
+    TEST_CHECK(max_alias <= -(BENCH_MIN_REJECTION_DB), "%lu Hz: aliases at %.1f dB",
+               (unsigned long) format->sample_rate, max_alias);
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark on every format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    printf("Decimator of the second stream, %s path\n", BENCH_PATH);
+
+    /* Only integer factors up to DSP_DECIM_MAX_FACTOR */
+    TEST_CHECK(0U == dsp_decim_configure(44100U, BENCH_OUT_RATE), "44100 Hz decimated to %lu Hz",
+               (unsigned long) BENCH_OUT_RATE);
+    TEST_CHECK(0U == dsp_decim_configure(128000U, BENCH_OUT_RATE), "128000 Hz decimated to %lu Hz",
+               (unsigned long) BENCH_OUT_RATE);
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
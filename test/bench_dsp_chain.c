@@ -0,0 +1,215 @@
+/*****************************************************************************
+* File Name    : bench_dsp_chain.c
+*
+* Description  : This file contains the benchmark of the DSP chain on the host: the
+*                host cycles of each stage per 1 ms period, and the output of the
+*                chain against a floating point model of its stages.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_bench.h"
+#include "dsp_dc_block.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (1U)
+
+/* The DC step at the start decays within 8 ms */
+#define BENCH_SETTLE_MS             (200U)
+
+/* Largest error against the model, in LSB, and lowest SNR of each size */
+#define BENCH_MAX_ERROR_LSB         (2.0)
+#define BENCH_MIN_SNR_DB_16         (80.0)
+#define BENCH_MIN_SNR_DB_24         (120.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t sample_size;
+} bench_format_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    { 48000U, 2U, 2U },
+    { 48000U, 1U, 2U },
+    { 44100U, 2U, 2U },
+    { 96000U, 2U, 2U },
+    { 48000U, 2U, 4U },
+    { 96000U, 2U, 4U },
+};
+
+
+/*****************************************************************************
+* Function Name: bench_reference
+******************************************************************************
+* Summary:
+*  Floating point model of the default chain on a signal below the limiter
+*  threshold: the DC block high-pass, with the coefficient computed by
+*  dsp_dc_block_configure(); the flat EQ, the unity gain and the VAD leave
+*  the samples as they are, the limiter, when enabled, only delays them.
+*
+*****************************************************************************/
+static void bench_reference(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    uint32_t sample_rate = *(const uint32_t *) arg;
+    double k;
+    double x1;
+    double y1;
+    double x;
+    uint32_t frame;
+    uint32_t channel;
+
+    k = (double) (((uint64_t) 411775U * (DSP_DC_BLOCK_CUTOFF_HZ) * (1U << (DSP_DC_BLOCK_Q))) /
+                  ((uint64_t) sample_rate << 16)) / (double) (1U << (DSP_DC_BLOCK_Q));
+
+    for (channel = 0U; channel < channels; channel++)
+    {
+        x1 = 0.0;
+        y1 = 0.0;
+        for (frame = 0U; frame < frames; frame++)
+        {
+            x = samples[(frame * channels) + channel];
+            y1 = x - x1 + ((1.0 - k) * y1);
+            x1 = x;
+            samples[(frame * channels) + channel] = y1;
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Run the chain on a format: two tones and a DC offset, below the limiter
+*  threshold. Print the cycles of each stage and check the output.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    uint32_t sample_rate = format->sample_rate;
+    dsp_bench_result_t result;
+    dsp_stage_stats_t stats;
+    dsp_bench_t bench;
+    uint32_t i;
+
+    for (i = 0U; i < (frames * format->channels); i++)
+    {
+        input[i] = 0.05;
+    }
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 1000.0, 0.25);
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 5000.0, 0.05);
+    dsp_bench_noise(input, frames, format->channels, 0.001, 1U);
+
+    dsp_chain_configure(format->sample_rate);
+    dsp_chain_reset_stats();
+
+    bench.name = "DSP chain";
+    bench.sample_rate = format->sample_rate;
+    bench.channels = format->channels;
+    bench.sample_size = format->sample_size;
+    bench.frames = frames;
+    bench.input = input;
+    bench.process = dsp_chain_process;
+    bench.reference = bench_reference;
+    bench.arg = &sample_rate;
+    bench.latency = dsp_chain_get_latency();
+    bench.settle_frames = (format->sample_rate / 1000U) * (BENCH_SETTLE_MS);
+    bench.output_channels = 0U;
+
+    dsp_bench_run(&bench, &result);
+    dsp_bench_print(&bench, &result);
+
+    for (i = 0U; i < dsp_chain_get_num_stages(); i++)
+    {
+        dsp_chain_get_stats(i, &stats);
+        printf("    %-12s %8.0f host cycles per period (max %lu)\n", stats.name,
+               (double) stats.total_cycles / (double) stats.calls, (unsigned long) stats.max_cycles);
+    }
+
+    TEST_CHECK(result.max_error <= (BENCH_MAX_ERROR_LSB), "%lu Hz %lu ch: error of %.2f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels, result.max_error);
+    TEST_CHECK(result.snr_db >= ((2U == format->sample_size) ? (BENCH_MIN_SNR_DB_16) : (BENCH_MIN_SNR_DB_24)),
+               "%lu Hz %lu ch: SNR of %.1f dB", (unsigned long) format->sample_rate,
+               (unsigned long) format->channels, result.snr_db);
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark on every format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    printf("DSP chain, %s\n", BENCH_PATH);
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,517 @@
+/*****************************************************************************
+* File Name    : bench_eq.c
+*
+* Description  : This file contains the benchmark of the equalizer: cycles per
+*                section per period at 44.1 and 48 KHz, accuracy against a floating
+*                point cascade and saturation, without wrap around, of the boosts
+*                that overload the output.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_bench.h"
+#include "dsp_eq.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (2U)
+
+/* Resolution of the samples of each size */
+#define BENCH_BITS(sample_size)     ((2U == (sample_size)) ? 16UL : 24UL)
+#define BENCH_SETTLE_MS             (200U)
+
+/* Accuracy of the cascade against the floating point cascade. The rounding
+ * of each section is fed back by its poles: the poles of the low frequency
+ * sections, near z = 1, amplify it by up to 40 dB. */
+#define BENCH_MIN_SNR_16_DB         (33.0)
+#define BENCH_MIN_SNR_24_DB         (80.0)
+
+/* Gain of a peaking band at its center frequency */
+#define BENCH_PEAK_HZ               (1000.0)
+#define BENCH_PEAK_DB               (6.0)
+#define BENCH_MAX_PEAK_ERROR_DB     (0.1)
+
+/* Treble boost overloading the output of full scale noise: the sum of the
+ * products exceeds 2^31, the output must saturate like the exact model */
+#define BENCH_BOOST_HZ              (8000.0)
+#define BENCH_BOOST_DB              (12.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t sample_size;
+} bench_format_t;
+
+/* Sections of the cascade, shared with the references */
+typedef struct
+{
+    dsp_eq_coefs_t coefs[DSP_EQ_MAX_SECTIONS];
+    uint32_t num_sections;
+    uint32_t sample_size;
+} bench_cascade_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    { 44100U, 2U, 2U },
+    { 48000U, 2U, 2U },
+    { 44100U, 1U, 2U },
+    { 48000U, 1U, 2U },
+    { 44100U, 2U, 4U },
+    { 48000U, 2U, 4U },
+};
+
+/* Bands of a typical correction, in processing order */
+static const dsp_eq_band_t bench_bands[DSP_EQ_MAX_SECTIONS] =
+{
+    { DSP_EQ_LOW_SHELF,   150.0f, 0.7f, -4.0f },
+    { DSP_EQ_PEAKING,     300.0f, 1.5f,  3.0f },
+    { DSP_EQ_PEAKING,     700.0f, 2.0f, -5.0f },
+    { DSP_EQ_PEAKING,    1500.0f, 1.0f,  2.0f },
+    { DSP_EQ_PEAKING,    3000.0f, 3.0f, -3.0f },
+    { DSP_EQ_PEAKING,    5000.0f, 1.0f,  4.0f },
+    { DSP_EQ_PEAKING,    9000.0f, 2.0f, -6.0f },
+    { DSP_EQ_HIGH_SHELF, 12000.0f, 0.7f, 3.0f },
+};
+
+/* Custom section at the edge of Q14: a1 = -2.0, a low frequency resonance */
+static const dsp_eq_coefs_t bench_edge = { 64, 0, 0, INT16_MIN, 16383 };
+
+
+/*****************************************************************************
+* Function Name: bench_to_q14
+******************************************************************************
+* Summary:
+*  Convert a normalized coefficient to Q14, rounded and saturated.
+*
+*****************************************************************************/
+static int16_t bench_to_q14(double value)
+{
+    double scaled = nearbyint(value * (double) (1U << (DSP_EQ_Q)));
+
+    return (int16_t) ((scaled > 32767.0) ? 32767.0 : ((scaled < -32767.0) ? -32767.0 : scaled));
+}
+
+/*****************************************************************************
+* Function Name: bench_design
+******************************************************************************
+* Summary:
+*  Design a peaking or shelving section with the formulas of the Audio EQ
+*  Cookbook, in double precision.
+*
+*****************************************************************************/
+static void bench_design(const dsp_eq_band_t *band, uint32_t sample_rate, dsp_eq_coefs_t *coefs)
+{
+    double w0 = (2.0 * DSP_BENCH_PI * band->freq_hz) / (double) sample_rate;
+    double cos_w0 = cos(w0);
+    double alpha = sin(w0) / (2.0 * band->q);
+    double a = pow(10.0, band->gain_db / 40.0);
+    double sqrt_a = 2.0 * sqrt(a) * alpha;
+    double b[3];
+    double den[3];
+
+    if (DSP_EQ_LOW_SHELF == band->type)
+    {
+        b[0] = a * ((a + 1.0) - ((a - 1.0) * cos_w0) + sqrt_a);
+        b[1] = 2.0 * a * ((a - 1.0) - ((a + 1.0) * cos_w0));
+        b[2] = a * ((a + 1.0) - ((a - 1.0) * cos_w0) - sqrt_a);
+        den[0] = (a + 1.0) + ((a - 1.0) * cos_w0) + sqrt_a;
+        den[1] = -2.0 * ((a - 1.0) + ((a + 1.0) * cos_w0));
+        den[2] = (a + 1.0) + ((a - 1.0) * cos_w0) - sqrt_a;
+    }
+    else if (DSP_EQ_HIGH_SHELF == band->type)
+    {
+        b[0] = a * ((a + 1.0) + ((a - 1.0) * cos_w0) + sqrt_a);
+        b[1] = -2.0 * a * ((a - 1.0) + ((a + 1.0) * cos_w0));
+        b[2] = a * ((a + 1.0) + ((a - 1.0) * cos_w0) - sqrt_a);
+        den[0] = (a + 1.0) - ((a - 1.0) * cos_w0) + sqrt_a;
+        den[1] = 2.0 * ((a - 1.0) - ((a + 1.0) * cos_w0));
+        den[2] = (a + 1.0) - ((a - 1.0) * cos_w0) - sqrt_a;
+    }
+    else
+    {
+        b[0] = 1.0 + (alpha * a);
+        b[1] = -2.0 * cos_w0;
+        b[2] = 1.0 - (alpha * a);
+        den[0] = 1.0 + (alpha / a);
+        den[1] = -2.0 * cos_w0;
+        den[2] = 1.0 - (alpha / a);
+    }
+
+    coefs->b0 = bench_to_q14(b[0] / den[0]);
+    coefs->b1 = bench_to_q14(b[1] / den[0]);
+    coefs->b2 = bench_to_q14(b[2] / den[0]);
+    coefs->a1 = bench_to_q14(den[1] / den[0]);
+    coefs->a2 = bench_to_q14(den[2] / den[0]);
+}
+
+/*****************************************************************************
+* Function Name: bench_run_cascade
+******************************************************************************
+* Summary:
+*  Run the cascade on the samples in place, in double precision, or as the
+*  exact model of the stage: sum rounded, shifted and saturated per section.
+*
+*****************************************************************************/
+static void bench_run_cascade(const bench_cascade_t *cascade, double *samples, uint32_t frames,
+                              uint32_t channels, bool exact)
+{
+    double full_scale = DSP_BENCH_FULL_SCALE(cascade->sample_size);
+    double one = (double) (1U << (DSP_EQ_Q));
+    const dsp_eq_coefs_t *coefs;
+    double x1;
+    double x2;
+    double y1;
+    double y2;
+    double x;
+    double y;
+    uint32_t section;
+    uint32_t channel;
+    uint32_t frame;
+
+    for (section = 0U; section < cascade->num_sections; section++)
+    {
+        coefs = &cascade->coefs[section];
+
+        for (channel = 0U; channel < channels; channel++)
+        {
+            x1 = 0.0;
+            x2 = 0.0;
+            y1 = 0.0;
+            y2 = 0.0;
+
+            for (frame = 0U; frame < frames; frame++)
+            {
+                x = samples[(frame * channels) + channel];
+
+                /* Products and sums of integers below 2^53 are exact */
+                y = (coefs->b0 * x) + (coefs->b1 * x1) + (coefs->b2 * x2) - (coefs->a1 * y1) - (coefs->a2 * y2);
+                if (exact)
+                {
+                    y = floor((y + (one / 2.0)) / one);
+                    y = (y > (full_scale - 1.0)) ? (full_scale - 1.0) : ((y < -full_scale) ? -full_scale : y);
+                }
+                else
+                {
+                    y /= one;
+                }
+
+                x2 = x1;
+                x1 = x;
+                y2 = y1;
+                y1 = y;
+                samples[(frame * channels) + channel] = y;
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: bench_reference
+******************************************************************************
+* Summary:
+*  Floating point cascade, with the coefficients of the stage.
+*
+*****************************************************************************/
+static void bench_reference(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    bench_run_cascade((const bench_cascade_t *) arg, samples, frames, channels, false);
+}
+
+/*****************************************************************************
+* Function Name: bench_exact
+******************************************************************************
+* Summary:
+*  Exact model of the stage, saturation included.
+*
+*****************************************************************************/
+static void bench_exact(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    bench_run_cascade((const bench_cascade_t *) arg, samples, frames, channels, true);
+}
+
+/*****************************************************************************
+* Function Name: bench_load
+******************************************************************************
+* Summary:
+*  Configure the stage for the sample rate with the sections of the
+*  cascade on every channel, all the other sections flat.
+*
+*****************************************************************************/
+static void bench_load(const bench_cascade_t *cascade, uint32_t sample_rate)
+{
+    static const dsp_eq_band_t flat = { DSP_EQ_NONE, 0.0f, 0.0f, 0.0f };
+    dsp_block_t block = { NULL, 0U, 0U, 2U };
+    uint32_t channel;
+    uint32_t index;
+
+    for (channel = 0U; channel < (DSP_EQ_MAX_CHANNELS); channel++)
+    {
+        for (index = 0U; index < (DSP_EQ_MAX_SECTIONS); index++)
+        {
+            dsp_eq_set_band(channel, index, &flat);
+        }
+        for (index = 0U; index < cascade->num_sections; index++)
+        {
+            dsp_eq_set_coefs(channel, index, &cascade->coefs[index]);
+        }
+    }
+
+    /* The coefficients set apply from the next block */
+    dsp_eq_configure(sample_rate);
+    dsp_eq_process(&block);
+    dsp_eq_reset();
+}
+
+/*****************************************************************************
+* Function Name: bench_init
+******************************************************************************
+* Summary:
+*  Fill the benchmark of a format.
+*
+*****************************************************************************/
+static void bench_init(dsp_bench_t *bench, const bench_format_t *format, const double *input,
+                       bench_cascade_t *cascade)
+{
+    bench->name = "EQ";
+    bench->sample_rate = format->sample_rate;
+    bench->channels = format->channels;
+    bench->sample_size = format->sample_size;
+    bench->frames = format->sample_rate * (BENCH_SECONDS);
+    bench->input = input;
+    bench->process = dsp_eq_process;
+    bench->reference = bench_reference;
+    bench->arg = cascade;
+    bench->latency = 0U;
+    bench->settle_frames = (format->sample_rate / 1000U) * (BENCH_SETTLE_MS);
+    bench->output_channels = 0U;
+}
+
+/*****************************************************************************
+* Function Name: bench_peak
+******************************************************************************
+* Summary:
+*  Return the gain, in dB, of a peaking band set with dsp_eq_set_band() at
+*  its center frequency. The first channel only.
+*
+*****************************************************************************/
+static double bench_peak(dsp_bench_t *bench, double *input)
+{
+    static const dsp_eq_band_t flat = { DSP_EQ_NONE, 0.0f, 0.0f, 0.0f };
+    dsp_eq_band_t band = { DSP_EQ_PEAKING, (float) (BENCH_PEAK_HZ), 1.0f, (float) (BENCH_PEAK_DB) };
+    dsp_bench_result_t result;
+    const double *output;
+    double in_power = 0.0;
+    double out_power = 0.0;
+    uint32_t channel;
+    uint32_t index;
+    uint32_t frame;
+
+    for (channel = 0U; channel < (DSP_EQ_MAX_CHANNELS); channel++)
+    {
+        for (index = 0U; index < (DSP_EQ_MAX_SECTIONS); index++)
+        {
+            dsp_eq_set_band(channel, index, (0U == index) ? &band : &flat);
+        }
+    }
+    dsp_eq_configure(bench->sample_rate);
+
+    for (frame = 0U; frame < (bench->frames * bench->channels); frame++)
+    {
+        input[frame] = 0.0;
+    }
+    dsp_bench_tone(input, bench->frames, bench->channels, bench->sample_rate, BENCH_PEAK_HZ, 0.25);
+
+    bench->reference = NULL;
+    dsp_bench_run(bench, &result);
+    output = dsp_bench_output();
+
+    for (frame = bench->settle_frames; frame < bench->frames; frame++)
+    {
+        in_power += input[frame * bench->channels] * input[frame * bench->channels];
+        out_power += output[frame * bench->channels] * output[frame * bench->channels];
+    }
+
+    return 10.0 * log10(out_power / in_power);
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Time the stage with one and with all the sections, check the cascade
+*  against the reference and the exact model, an overload against the exact
+*  model and the design of a band.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    dsp_eq_band_t boost = { DSP_EQ_HIGH_SHELF, (float) (BENCH_BOOST_HZ), 0.7f, (float) (BENCH_BOOST_DB) };
+    double min_snr = (2U == format->sample_size) ? (BENCH_MIN_SNR_16_DB) : (BENCH_MIN_SNR_24_DB);
+    dsp_bench_result_t one;
+    dsp_bench_result_t all;
+    dsp_bench_result_t exact;
+    dsp_bench_result_t overload;
+    dsp_bench_result_t edge;
+    bench_cascade_t cascade;
+    dsp_bench_t bench;
+    double peak_db;
+    uint32_t i;
+
+    bench_init(&bench, format, input, &cascade);
+    cascade.sample_size = format->sample_size;
+    for (i = 0U; i < (DSP_EQ_MAX_SECTIONS); i++)
+    {
+        bench_design(&bench_bands[i], format->sample_rate, &cascade.coefs[i]);
+    }
+
+    /* Speech band content and noise, with headroom for the boosts */
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 220.0, 0.15);
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 1000.0, 0.1);
+    dsp_bench_tone(input, frames, format->channels, format->sample_rate, 4700.0, 0.05);
+    dsp_bench_noise(input, frames, format->channels, 0.01, 7U);
+
+    cascade.num_sections = 1U;
+    bench_load(&cascade, format->sample_rate);
+    dsp_bench_run(&bench, &one);
+
+    cascade.num_sections = DSP_EQ_MAX_SECTIONS;
+    bench_load(&cascade, format->sample_rate);
+    dsp_bench_run(&bench, &all);
+    dsp_bench_print(&bench, &all);
+
+    printf("    %.0f host cycles per section per period (%.0f with one section)\n",
+           all.avg_cycles / (double) (DSP_EQ_MAX_SECTIONS), one.avg_cycles);
+
+    /* The same cascade against the exact model of the stage */
+    bench_load(&cascade, format->sample_rate);
+    bench.reference = bench_exact;
+    bench.settle_frames = 0U;
+    dsp_bench_run(&bench, &exact);
+    printf("    error of %.2f LSB against the exact model\n", exact.max_error);
+
+    /* A boost overloading full scale noise, against the exact model */
+    for (i = 0U; i < (frames * format->channels); i++)
+    {
+        input[i] = 0.0;
+    }
+    dsp_bench_noise(input, frames, format->channels, 1.0, 11U);
+    cascade.num_sections = 1U;
+    bench_design(&boost, format->sample_rate, &cascade.coefs[0]);
+    bench_load(&cascade, format->sample_rate);
+    dsp_bench_run(&bench, &overload);
+    printf("    shelf of +%.0f dB at %.0f Hz on full scale noise: error of %.2f LSB against the exact model\n",
+           BENCH_BOOST_DB, BENCH_BOOST_HZ, overload.max_error);
+
+    /* A section set with a1 at -2.0, whose negation does not fit Q14: the
+     * stage saturates it, like the exact model
+     */
+    for (i = 0U; i < (frames * format->channels); i++)
+    {
+        input[i] = 0.0;
+    }
+    dsp_bench_noise(input, frames, format->channels, 0.1, 13U);
+    cascade.coefs[0] = bench_edge;
+    bench_load(&cascade, format->sample_rate);
+    cascade.coefs[0].a1 = -INT16_MAX;
+    dsp_bench_run(&bench, &edge);
+    printf("    section with a1 = -2.0: error of %.2f LSB against the exact model with a1 saturated\n",
+           edge.max_error);
+
+    bench_init(&bench, format, input, &cascade);
+    peak_db = bench_peak(&bench, input);
+    printf("    peaking band of %+.0f dB at %.0f Hz: %+.3f dB\n", BENCH_PEAK_DB, BENCH_PEAK_HZ, peak_db);
+
+    TEST_CHECK(all.snr_db >= min_snr, "%lu Hz %lu ch %lu bits: SNR of %.1f dB", (unsigned long) format->sample_rate,
+               (unsigned long) format->channels, BENCH_BITS(format->sample_size), all.snr_db);
+    TEST_CHECK(0.0 == exact.max_error, "%lu Hz %lu ch %lu bits: off the exact model by %.0f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels,
+               BENCH_BITS(format->sample_size), exact.max_error);
+    TEST_CHECK(0.0 == overload.max_error, "%lu Hz %lu ch %lu bits: overload off the exact model by %.0f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels,
+               BENCH_BITS(format->sample_size), overload.max_error);
+    TEST_CHECK(0.0 == edge.max_error, "%lu Hz %lu ch %lu bits: a1 = -2.0 off the exact model by %.0f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels,
+               BENCH_BITS(format->sample_size), edge.max_error);
+    TEST_CHECK(fabs(peak_db - (BENCH_PEAK_DB)) <= (BENCH_MAX_PEAK_ERROR_DB), "%lu Hz: %.3f dB at the peak",
+               (unsigned long) format->sample_rate, peak_db);
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark on every format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    printf("EQ, %s\n", BENCH_PATH);
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
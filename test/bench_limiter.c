@@ -0,0 +1,422 @@
+/*****************************************************************************
+* File Name    : bench_limiter.c
+*
+* Description  : This file contains the benchmark of the limiter: cycles per period
+*                while limiting, accuracy against a model with an exact divide, gain of
+*                the Newton-Raphson reciprocal over the whole range of levels, and
+*                steps and bursts that must never exceed the ceiling.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_bench.h"
+#include "dsp_limiter.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (2U)
+
+/* Resolution of the samples of each size */
+#define BENCH_BITS(sample_size)     ((2U == (sample_size)) ? 16UL : 24UL)
+
+/* Bursts of a tone, loud enough to be limited half of the time */
+#define BENCH_TONE_HZ               (1000.0)
+#define BENCH_QUIET_LEVEL           (0.3)
+#define BENCH_LOUD_LEVEL            (1.0)
+#define BENCH_BURST_MS              (100U)
+
+/* Error of the gain against the exact divide, in LSB of the Q15 gain: the
+ * two Newton-Raphson iterations and the truncation to Q15 */
+#define BENCH_MAX_GAIN_ERROR        (2U)
+
+/* Frames of a constant level for the envelope to settle on it */
+#define BENCH_SWEEP_FRAMES          (128U)
+#define BENCH_SWEEP_STEP_24         (97)
+
+/* Gains in Q15, levels in Q31, as in the stage */
+#define BENCH_UNITY                 (32768.0)
+#define BENCH_THRESHOLD_Q31         ((uint32_t) (DSP_LIMITER_THRESHOLD_Q15) << 16U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t sample_size;
+} bench_format_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    { 44100U, 2U, 2U },
+    { 48000U, 2U, 2U },
+    { 48000U, 1U, 2U },
+    { 96000U, 2U, 2U },
+    { 48000U, 2U, 4U },
+};
+
+
+/*****************************************************************************
+* Function Name: bench_ceiling
+******************************************************************************
+* Summary:
+*  Get the ceiling of the output, in LSB of the samples.
+*
+*****************************************************************************/
+static int32_t bench_ceiling(uint32_t sample_size)
+{
+    return (2U == sample_size) ? (int32_t) (DSP_LIMITER_THRESHOLD_Q15) :
+                                 ((int32_t) (DSP_LIMITER_THRESHOLD_Q15) << 8U);
+}
+
+/*****************************************************************************
+* Function Name: bench_reference
+******************************************************************************
+* Summary:
+*  Model of the stage: the same integer peak hold and envelope, the gain
+*  threshold / envelope computed with an exact divide, the look-ahead left
+*  out (the harness aligns the output on the latency).
+*
+*****************************************************************************/
+static void bench_reference(void *arg, double *samples, uint32_t frames, uint32_t channels)
+{
+    const bench_format_t *format = (const bench_format_t *) arg;
+    uint32_t release = (format->sample_rate * (DSP_LIMITER_RELEASE_MS)) / 1000U;
+    uint32_t level_shift = (2U == format->sample_size) ? 16U : 8U;
+    double ceiling = (double) bench_ceiling(format->sample_size);
+    double *gains = calloc(frames, sizeof(double));
+    uint32_t release_shift = 0U;
+    uint32_t hold = 0U;
+    uint32_t hold_frames = 0U;
+    uint32_t envelope = 0U;
+    uint32_t level;
+    uint32_t frame;
+    uint32_t channel;
+    double y;
+
+    while ((2UL << release_shift) <= release)
+    {
+        release_shift++;
+    }
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        level = 0U;
+        for (channel = 0U; channel < channels; channel++)
+        {
+            y = fabs(samples[(frame * channels) + channel]);
+            level = (((uint32_t) y << level_shift) > level) ? ((uint32_t) y << level_shift) : level;
+        }
+
+        if (level >= hold)
+        {
+            hold = level;
+            hold_frames = DSP_LIMITER_LOOKAHEAD_FRAMES;
+        }
+        else if (hold_frames > 0U)
+        {
+            hold_frames--;
+        }
+        else
+        {
+            hold = level;
+        }
+
+        if (hold > envelope)
+        {
+            envelope += (hold - envelope) >> (DSP_LIMITER_ATTACK_SHIFT);
+        }
+        else
+        {
+            envelope -= (envelope - hold) >> release_shift;
+        }
+
+        gains[frame] = (envelope > (BENCH_THRESHOLD_Q31)) ? ((double) (BENCH_THRESHOLD_Q31) / (double) envelope) : 1.0;
+    }
+
+    /* A frame gets the gain of the frame it leaves the look-ahead with */
+    for (frame = 0U; (frame + (DSP_LIMITER_LOOKAHEAD_FRAMES)) < frames; frame++)
+    {
+        for (channel = 0U; channel < channels; channel++)
+        {
+            y = samples[(frame * channels) + channel] * gains[frame + (DSP_LIMITER_LOOKAHEAD_FRAMES)];
+            samples[(frame * channels) + channel] = (y > ceiling) ? ceiling : ((y < -ceiling) ? -ceiling : y);
+        }
+    }
+
+    free(gains);
+}
+
+/*****************************************************************************
+* Function Name: bench_sweep
+******************************************************************************
+* Summary:
+*  Settle the envelope on each level from the threshold to the full scale
+*  and check the gain of the Newton-Raphson reciprocal against the exact
+*  divide: never above it, and at most BENCH_MAX_GAIN_ERROR below.
+*
+*****************************************************************************/
+static void bench_sweep(uint32_t sample_size)
+{
+    int32_t full_scale = (2U == sample_size) ? 32767 : 8388607;
+    int32_t step = (2U == sample_size) ? 1 : (BENCH_SWEEP_STEP_24);
+    uint32_t level_shift = (2U == sample_size) ? 16U : 8U;
+    int16_t samples_16[BENCH_SWEEP_FRAMES];
+    int32_t samples_32[BENCH_SWEEP_FRAMES];
+    dsp_block_t block;
+    double exact;
+    double error;
+    double worst = 0.0;
+    bool above = false;
+    uint32_t levels = 0U;
+    int32_t value;
+    uint32_t frame;
+
+    block.samples = (2U == sample_size) ? (void *) samples_16 : (void *) samples_32;
+    block.channels = 1U;
+    block.sample_size = sample_size;
+
+    for (value = bench_ceiling(sample_size) + 1; value <= full_scale; value += step)
+    {
+        for (frame = 0U; frame < (BENCH_SWEEP_FRAMES); frame++)
+        {
+            samples_16[frame] = (int16_t) ((2U == sample_size) ? value : 0);
+            samples_32[frame] = value;
+        }
+        block.frames = BENCH_SWEEP_FRAMES;
+
+        /* The envelope settles within 2^ATTACK_SHIFT of the level, Q31 */
+        dsp_limiter_reset();
+        dsp_limiter_process(&block);
+
+        exact = ((double) (BENCH_THRESHOLD_Q31) * (BENCH_UNITY)) / (double) ((uint32_t) value << level_shift);
+        error = exact - (double) dsp_limiter_get_min_gain();
+        worst = (error > worst) ? error : worst;
+        above = above || (error < -0.01);
+        levels++;
+    }
+
+    printf("    %2lu bits: gain within %.2f LSB (Q15) below the exact divide on %lu levels\n",
+           BENCH_BITS(sample_size), worst, (unsigned long) levels);
+    TEST_CHECK(!above, "%lu bits: gain above the exact divide", BENCH_BITS(sample_size));
+    TEST_CHECK(worst <= (double) (BENCH_MAX_GAIN_ERROR), "%lu bits: gain %.2f LSB below the exact divide",
+               BENCH_BITS(sample_size), worst);
+}
+
+/*****************************************************************************
+* Function Name: bench_peak
+******************************************************************************
+* Summary:
+*  Return the highest sample of the last output, in LSB.
+*
+*****************************************************************************/
+static int32_t bench_peak(const dsp_bench_t *bench)
+{
+    const double *output = dsp_bench_output();
+    double full_scale = DSP_BENCH_FULL_SCALE(bench->sample_size);
+    double peak = 0.0;
+    uint32_t i;
+
+    for (i = 0U; i < (bench->frames * bench->channels); i++)
+    {
+        peak = (fabs(output[i]) > peak) ? fabs(output[i]) : peak;
+    }
+
+    return (int32_t) lrint(peak * full_scale);
+}
+
+/*****************************************************************************
+* Function Name: bench_steps
+******************************************************************************
+* Summary:
+*  Run steps from silence to the full scale and to just above the
+*  threshold, of either sign, and single full scale samples, and check the
+*  output never exceeds the ceiling.
+*
+*****************************************************************************/
+static void bench_steps(dsp_bench_t *bench, double *input)
+{
+    static const double offsets[] = { 0.0, 1.0, 2.0, 3.0, 8.0 };
+    double full_scale = DSP_BENCH_FULL_SCALE(bench->sample_size);
+    double ceiling = (double) bench_ceiling(bench->sample_size) / full_scale;
+    dsp_bench_result_t result;
+    int32_t peak = 0;
+    int32_t run_peak;
+    double step;
+    uint32_t samples = bench->frames * bench->channels;
+    uint32_t start = samples / 4U;
+    uint32_t i;
+    uint32_t j;
+
+    bench->reference = NULL;
+
+    for (j = 0U; j < ((sizeof(offsets) / sizeof(offsets[0])) * 2U); j++)
+    {
+        /* Full scale, then ceiling plus 1, 2, 3 and 8 LSB, each of both signs */
+        step = (0U == (j / 2U)) ? 1.0 : (ceiling + (offsets[j / 2U] / full_scale));
+        step = (0U == (j % 2U)) ? step : -step;
+
+        for (i = 0U; i < samples; i++)
+        {
+            input[i] = (i >= start) ? step : 0.0;
+        }
+
+        dsp_limiter_reset();
+        dsp_bench_run(bench, &result);
+        run_peak = bench_peak(bench);
+        peak = (run_peak > peak) ? run_peak : peak;
+    }
+
+    /* Lone full scale samples, alternating in sign */
+    for (i = 0U; i < samples; i++)
+    {
+        input[i] = (0U == (i % 997U)) ? (((i / 997U) % 2U) ? -1.0 : 1.0) : 0.0;
+    }
+    dsp_limiter_reset();
+    dsp_bench_run(bench, &result);
+    run_peak = bench_peak(bench);
+    peak = (run_peak > peak) ? run_peak : peak;
+
+    printf("    steps and lone samples: peak of %ld LSB, ceiling %ld LSB\n", (long) peak,
+           (long) bench_ceiling(bench->sample_size));
+    TEST_CHECK(peak <= bench_ceiling(bench->sample_size), "%lu Hz %lu ch %lu bits: peak of %ld LSB over the ceiling",
+               (unsigned long) bench->sample_rate, (unsigned long) bench->channels,
+               BENCH_BITS(bench->sample_size), (long) peak);
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Time the stage on bursts of a loud tone against the model, then check
+*  the ceiling on steps.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t frames = format->sample_rate * (BENCH_SECONDS);
+    uint32_t burst = (format->sample_rate / 1000U) * (BENCH_BURST_MS);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    double full_scale = DSP_BENCH_FULL_SCALE(format->sample_size);
+    double max_error = ((BENCH_MAX_GAIN_ERROR) * full_scale / (BENCH_UNITY)) + 1.0;
+    dsp_bench_result_t result;
+    dsp_bench_t bench;
+    double level;
+    double phase;
+    uint32_t frame;
+    uint32_t channel;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        level = (0U == ((frame / burst) % 2U)) ? (BENCH_QUIET_LEVEL) : (BENCH_LOUD_LEVEL);
+        phase = (2.0 * DSP_BENCH_PI * BENCH_TONE_HZ * frame) / format->sample_rate;
+        for (channel = 0U; channel < format->channels; channel++)
+        {
+            input[(frame * format->channels) + channel] = level * sin(phase + (0.5 * channel));
+        }
+    }
+
+    dsp_limiter_configure(format->sample_rate);
+
+    bench.name = "Limiter";
+    bench.sample_rate = format->sample_rate;
+    bench.channels = format->channels;
+    bench.sample_size = format->sample_size;
+    bench.frames = frames;
+    bench.input = input;
+    bench.process = dsp_limiter_process;
+    bench.reference = bench_reference;
+    bench.arg = (void *) format;
+    bench.latency = DSP_LIMITER_LOOKAHEAD_FRAMES;
+    bench.settle_frames = 0U;
+    bench.output_channels = 0U;
+
+    dsp_bench_run(&bench, &result);
+    dsp_bench_print(&bench, &result);
+    printf("    lowest gain %.3f\n", (double) dsp_limiter_get_min_gain() / (BENCH_UNITY));
+
+    TEST_CHECK(result.max_error <= max_error, "%lu Hz %lu ch %lu bits: error of %.2f LSB",
+               (unsigned long) format->sample_rate, (unsigned long) format->channels,
+               BENCH_BITS(format->sample_size), result.max_error);
+
+    bench_steps(&bench, input);
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark on every format, then sweep the gain.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    printf("Limiter, %s\n", BENCH_PATH);
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    dsp_limiter_configure(48000U);
+    bench_sweep(2U);
+    bench_sweep(4U);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,178 @@
+/*****************************************************************************
+* File Name    : bench_pack.c
+*
+* Description  : This file contains the benchmark of the 24-bit and 32-bit packing
+*                kernels: checks them against a reference and reports the cycles
+*                per sample on the host.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_pack.h"
+#include "bench_util.h"
+#include "test_util.h"
+
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Largest period, 97 stereo frames at 96 KHz, and a count with a tail */
+#define BENCH_MAX_SAMPLES           (194U)
+#define BENCH_TAIL_SAMPLES          (7U)
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static uint32_t bench_input[BENCH_MAX_SAMPLES];
+static uint32_t bench_buffer[BENCH_MAX_SAMPLES];
+static uint8_t bench_expected[BENCH_MAX_SAMPLES * 4U];
+
+
+/*****************************************************************************
+* Function Name: bench_fill
+******************************************************************************
+* Summary:
+*  Fill the input with right-aligned 24-bit samples, as captured.
+*
+*****************************************************************************/
+static void bench_fill(void)
+{
+    uint32_t seed = 12345U;
+    uint32_t i;
+
+    for (i = 0U; i < (BENCH_MAX_SAMPLES); i++)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        bench_input[i] = (uint32_t) (((int32_t) seed) >> 8);
+    }
+}
+
+/*****************************************************************************
+* Function Name: bench_check
+******************************************************************************
+* Summary:
+*  Check a kernel against the reference on a number of samples.
+*
+*****************************************************************************/
+static void bench_check(const char *name, uint32_t (*kernel)(uint32_t *, uint32_t), uint32_t sample_bytes,
+                        uint32_t count)
+{
+    uint32_t bytes;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        /* Little-endian, 3 bytes of the 24-bit sample or left-justified in 4 */
+        if (3U == sample_bytes)
+        {
+            bench_expected[(3U * i)]      = (uint8_t) bench_input[i];
+            bench_expected[(3U * i) + 1U] = (uint8_t) (bench_input[i] >> 8);
+            bench_expected[(3U * i) + 2U] = (uint8_t) (bench_input[i] >> 16);
+        }
+        else
+        {
+            bench_expected[(4U * i)]      = 0U;
+            bench_expected[(4U * i) + 1U] = (uint8_t) bench_input[i];
+            bench_expected[(4U * i) + 2U] = (uint8_t) (bench_input[i] >> 8);
+            bench_expected[(4U * i) + 3U] = (uint8_t) (bench_input[i] >> 16);
+        }
+    }
+
+    memcpy(bench_buffer, bench_input, count * sizeof(uint32_t));
+    bytes = kernel(bench_buffer, count);
+
+    TEST_CHECK(bytes == (count * sample_bytes), "%s: %u bytes for %u samples", name, bytes, count);
+    TEST_CHECK(0 == memcmp(bench_buffer, bench_expected, count * sample_bytes), "%s: wrong output for %u samples",
+               name, count);
+}
+
+/*****************************************************************************
+* Function Name: bench_run
+******************************************************************************
+* Summary:
+*  Measure a kernel on the largest period.
+*
+*****************************************************************************/
+static void bench_run(const char *name, uint32_t (*kernel)(uint32_t *, uint32_t))
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t start;
+    uint32_t run;
+
+    for (run = 0U; run < (BENCH_RUNS); run++)
+    {
+        memcpy(bench_buffer, bench_input, sizeof(bench_buffer));
+        start = bench_cycles();
+        (void) kernel(bench_buffer, BENCH_MAX_SAMPLES);
+        bench_keep_min(&best, start);
+    }
+
+    printf("%-16s %6.2f host cycles per sample (%llu per %u samples)\n", name,
+           (double) best / (double) (BENCH_MAX_SAMPLES), (unsigned long long) best, BENCH_MAX_SAMPLES);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the benchmark.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if the kernels match the reference
+*
+*****************************************************************************/
+int main(void)
+{
+    printf("Packing kernels, %s path\n", BENCH_PATH);
+
+    bench_fill();
+
+    bench_check("audio_pack_s24_3", audio_pack_s24_3, 3U, BENCH_MAX_SAMPLES);
+    bench_check("audio_pack_s24_3", audio_pack_s24_3, 3U, BENCH_TAIL_SAMPLES);
+    bench_check("audio_pack_s32", audio_pack_s32, 4U, BENCH_MAX_SAMPLES);
+    bench_check("audio_pack_s32", audio_pack_s32, 4U, BENCH_TAIL_SAMPLES);
+
+    bench_run("audio_pack_s24_3", audio_pack_s24_3);
+    bench_run("audio_pack_s32", audio_pack_s32);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,325 @@
+/*****************************************************************************
+* File Name    : bench_src.c
+*
+* Description  : This file contains the benchmark of the sample rate converter:
+*                cycles per period, passband response against the response of
+*                the coefficient table computed like scripts/src_coefs.py, and
+*                delay against dsp_src_get_latency().
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_src.h"
+#include "dsp_bench.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define BENCH_SECONDS               (1U)
+
+/* Output frames skipped at the start of each tone, past the filter */
+#define BENCH_SETTLE_FRAMES         (128U)
+
+#define BENCH_BITS(sample_size)     ((2U == (sample_size)) ? 16UL : 24UL)
+
+/* Tones of the passband check, from 0 to BENCH_PASSBAND_HZ at the capture
+ * rate of 48 KHz, scaled with the capture rate. BENCH_MAX_RIPPLE_DB is
+ * MAX_RIPPLE_DB of scripts/src_coefs.py, BENCH_RESPONSE_POINTS its
+ * CHECK_POINTS.
+ */
+#define BENCH_PASSBAND_HZ           (20000.0)
+#define BENCH_CAPTURE_RATE          (48000.0)
+#define BENCH_TONES                 (40U)
+#define BENCH_TONE_LEVEL            (0.5)
+#define BENCH_MAX_RIPPLE_DB         (0.05)
+#define BENCH_RESPONSE_POINTS       (1000U)
+
+/* Largest gap between the gain measured on a tone and the response of the
+ * table: the rounding of the samples only
+ */
+#define BENCH_MAX_GAIN_ERROR_DB     (0.005)
+
+/* Tone of the delay check, low enough for its phase not to wrap */
+#define BENCH_DELAY_HZ              (200.0)
+#define BENCH_MAX_DELAY_ERROR       (0.5)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint32_t sample_rate;           /* Rate of the host */
+    uint32_t channels;
+    uint32_t sample_size;
+} bench_format_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const bench_format_t bench_formats[] =
+{
+    { 44100U, 2U, 2U },
+    { 44100U, 1U, 2U },
+    { 22050U, 2U, 2U },
+    { 44100U, 2U, 4U },
+};
+
+
+/*****************************************************************************
+* Function Name: bench_table_gain_db
+******************************************************************************
+* Summary:
+*  Gain of the quantized filter of dsp_src_coefs_147_160[] at a frequency
+*  given in cycles per captured sample, computed like response_db() of
+*  scripts/src_coefs.py.
+*
+*****************************************************************************/
+static double bench_table_gain_db(double freq)
+{
+    double step = 2.0 * (DSP_BENCH_PI) * freq / (double) (DSP_SRC_UP);
+    double re = 0.0;
+    double im = 0.0;
+    double n;
+    uint32_t phase;
+    uint32_t i;
+
+    for (phase = 0U; phase < (DSP_SRC_UP); phase++)
+    {
+        for (i = 0U; i < (DSP_SRC_TAPS); i++)
+        {
+            n = (double) (phase + (((DSP_SRC_TAPS) - 1U - i) * (DSP_SRC_UP)));
+            re += (double) dsp_src_coefs_147_160[(phase * (DSP_SRC_TAPS)) + i] * cos(step * n);
+            im -= (double) dsp_src_coefs_147_160[(phase * (DSP_SRC_TAPS)) + i] * sin(step * n);
+        }
+    }
+
+    return 20.0 * log10(hypot(re, im) / ((double) (DSP_SRC_UP) * (double) (1UL << (DSP_SRC_Q))));
+}
+
+/*****************************************************************************
+* Function Name: bench_fit
+******************************************************************************
+* Summary:
+*  Least-squares fit of a sine and a cosine of a frequency to one channel of
+*  the output: amplitude, and phase relative to a sine starting at frame 0.
+*
+*****************************************************************************/
+static void bench_fit(const double *samples, uint32_t frames, uint32_t channels, double omega, double *amplitude,
+                      double *phase)
+{
+    double ss = 0.0;
+    double cc = 0.0;
+    double sc = 0.0;
+    double ys = 0.0;
+    double yc = 0.0;
+    double s;
+    double c;
+    double det;
+    double a;
+    double b;
+    uint32_t frame;
+
+    for (frame = (BENCH_SETTLE_FRAMES); frame < frames; frame++)
+    {
+        s = sin(omega * (double) frame);
+        c = cos(omega * (double) frame);
+        ss += s * s;
+        cc += c * c;
+        sc += s * c;
+        ys += samples[frame * channels] * s;
+        yc += samples[frame * channels] * c;
+    }
+
+    det = (ss * cc) - (sc * sc);
+    a = ((ys * cc) - (yc * sc)) / det;
+    b = ((yc * ss) - (ys * sc)) / det;
+    *amplitude = hypot(a, b);
+    *phase = atan2(b, a);
+}
+
+/*****************************************************************************
+* Function Name: bench_tone
+******************************************************************************
+* Summary:
+*  Convert a tone captured at the capture rate of a format and fit the
+*  output at the rate of the host.
+*
+*****************************************************************************/
+static void bench_tone(const bench_format_t *format, double frequency, dsp_bench_result_t *result,
+                       double *amplitude, double *phase)
+{
+    uint32_t capture_rate = dsp_src_get_capture_rate(format->sample_rate);
+    uint32_t frames = capture_rate * (BENCH_SECONDS);
+    uint32_t out_frames = ((frames * (DSP_SRC_UP)) / (DSP_SRC_DOWN)) - (DSP_SRC_UP);
+    double *input = calloc((size_t) frames * format->channels, sizeof(double));
+    dsp_bench_t bench;
+
+    dsp_bench_tone(input, frames, format->channels, capture_rate, frequency, BENCH_TONE_LEVEL);
+    dsp_src_configure(format->sample_rate);
+
+    bench.name = "SRC";
+    bench.sample_rate = capture_rate;
+    bench.channels = format->channels;
+    bench.sample_size = format->sample_size;
+    bench.frames = frames;
+    bench.input = input;
+    bench.process = dsp_src_process;
+    bench.reference = NULL;
+    bench.arg = NULL;
+    bench.latency = 0U;
+    bench.settle_frames = 0U;
+    bench.output_channels = 0U;
+
+    dsp_bench_run(&bench, result);
+    bench_fit(dsp_bench_output(), out_frames, format->channels,
+              2.0 * (DSP_BENCH_PI) * frequency / (double) format->sample_rate, amplitude, phase);
+    *amplitude /= BENCH_TONE_LEVEL;
+
+    free(input);
+}
+
+/*****************************************************************************
+* Function Name: bench_format
+******************************************************************************
+* Summary:
+*  Time the conversion of a format, measure its passband and its delay.
+*
+*****************************************************************************/
+static void bench_format(const bench_format_t *format)
+{
+    uint32_t capture_rate = dsp_src_get_capture_rate(format->sample_rate);
+    double scale = (double) capture_rate / (BENCH_CAPTURE_RATE);
+    dsp_bench_result_t result;
+    double frequency;
+    double amplitude;
+    double phase;
+    double gain;
+    double expected;
+    double error;
+    double max_error = 0.0;
+    double min_gain = INFINITY;
+    double max_gain = -INFINITY;
+    double delay;
+    uint32_t i;
+
+    for (i = 0U; i <= (BENCH_TONES); i++)
+    {
+        frequency = ((BENCH_PASSBAND_HZ) * scale * (double) ((0U == i) ? 1U : (2U * i))) / (2.0 * (BENCH_TONES));
+        bench_tone(format, frequency, &result, &amplitude, &phase);
+        gain = 20.0 * log10(amplitude);
+        expected = bench_table_gain_db(frequency / (double) capture_rate);
+        error = fabs(gain - expected);
+        max_error = (error > max_error) ? error : max_error;
+        min_gain = (gain < min_gain) ? gain : min_gain;
+        max_gain = (gain > max_gain) ? gain : max_gain;
+    }
+
+    /* Cycles of the last tone */
+    printf("SRC %6lu Hz from %6lu Hz %lu ch %2lu bits: %8.0f host cycles per period (min %llu), "
+           "%.1f per output sample\n", (unsigned long) format->sample_rate, (unsigned long) capture_rate,
+           (unsigned long) format->channels, BENCH_BITS(format->sample_size), result.avg_cycles,
+           (unsigned long long) result.min_cycles,
+           result.avg_cycles / (((double) format->sample_rate / 1000.0) * (double) format->channels));
+
+    bench_tone(format, (BENCH_DELAY_HZ) * scale, &result, &amplitude, &phase);
+    delay = -phase / (2.0 * (DSP_BENCH_PI) * (BENCH_DELAY_HZ) * scale / (double) format->sample_rate);
+
+    printf("    passband ripple %.4f dB up to %.0f Hz, %.4f dB from the table, delay %.2f frames (reported %lu)\n",
+           max_gain - min_gain, (BENCH_PASSBAND_HZ) * scale, max_error, delay,
+           (unsigned long) dsp_src_get_latency());
+
+    TEST_CHECK((max_gain - min_gain) <= (BENCH_MAX_RIPPLE_DB), "%lu Hz: ripple of %.4f dB",
+               (unsigned long) format->sample_rate, max_gain - min_gain);
+    TEST_CHECK(max_error <= (BENCH_MAX_GAIN_ERROR_DB), "%lu Hz: %.4f dB from the response of the table",
+               (unsigned long) format->sample_rate, max_error);
+    TEST_CHECK(fabs(delay - (double) dsp_src_get_latency()) <= (BENCH_MAX_DELAY_ERROR),
+               "%lu Hz: delay of %.2f frames, %lu reported", (unsigned long) format->sample_rate, delay,
+               (unsigned long) dsp_src_get_latency());
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Check the response of the table, then run the benchmark on every format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    double gain;
+    double min_gain = INFINITY;
+    double max_gain = -INFINITY;
+    uint32_t i;
+
+    printf("Sample rate converter, %s path\n", BENCH_PATH);
+
+    /* Passband of the table, on the points of scripts/src_coefs.py */
+    for (i = 0U; i <= (BENCH_RESPONSE_POINTS); i++)
+    {
+        gain = bench_table_gain_db(((BENCH_PASSBAND_HZ) / (BENCH_CAPTURE_RATE)) * (double) i /
+                                   (double) (BENCH_RESPONSE_POINTS));
+        min_gain = (gain < min_gain) ? gain : min_gain;
+        max_gain = (gain > max_gain) ? gain : max_gain;
+    }
+    printf("Table: passband ripple %.3f dB up to %.0f Hz\n", max_gain - min_gain, BENCH_PASSBAND_HZ);
+    TEST_CHECK((max_gain - min_gain) <= (BENCH_MAX_RIPPLE_DB), "table ripple of %.4f dB", max_gain - min_gain);
+
+    /* Rates captured as is */
+    dsp_src_configure(48000U);
+    TEST_CHECK(0U == dsp_src_get_latency(), "latency of %lu frames at 48000 Hz",
+               (unsigned long) dsp_src_get_latency());
+
+    for (i = 0U; i < (sizeof(bench_formats) / sizeof(bench_formats[0])); i++)
+    {
+        bench_format(&bench_formats[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,304 @@
+/*****************************************************************************
+* File Name    : dsp_bench.c
+*
+* Description  : This file contains the harness of the host benchmarks of the DSP
+*                stages, and the cycle counter of the host used by the DSP chain.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_bench.h"
+#include "cycle_counter.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Output of the last run, 1.0 is the full scale */
+static double *dsp_bench_last_output = NULL;
+
+
+/*****************************************************************************
+* Function Name: cycle_counter_init
+******************************************************************************
+* Summary:
+*  The cycle counter of the host always runs.
+*
+*****************************************************************************/
+void cycle_counter_init(void)
+{
+}
+
+/*****************************************************************************
+* Function Name: cycle_counter_get
+******************************************************************************
+* Summary:
+*  Get the cycle counter of the host, for the statistics of the DSP chain.
+*
+*****************************************************************************/
+uint32_t cycle_counter_get(void)
+{
+    return (uint32_t) bench_cycles();
+}
+
+/*****************************************************************************
+* Function Name: dsp_bench_tone
+******************************************************************************
+* Summary:
+*  Add a tone to every channel of a signal.
+*
+* Parameters:
+*  samples: Interleaved samples, 1.0 is the full scale
+*  frames: Frames of the signal
+*  channels: Channels of the signal
+*  sample_rate: Sample rate in Hz
+*  frequency: Frequency of the tone in Hz
+*  level: Amplitude of the tone
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_bench_tone(double *samples, uint32_t frames, uint32_t channels, uint32_t sample_rate, double frequency,
+                    double level)
+{
+    uint32_t frame;
+    uint32_t channel;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        for (channel = 0U; channel < channels; channel++)
+        {
+            samples[(frame * channels) + channel] +=
+                level * sin((2.0 * (DSP_BENCH_PI) * frequency * (double) frame / (double) sample_rate) +
+                            (0.5 * (double) channel));
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_bench_noise
+******************************************************************************
+* Summary:
+*  Add uniform white noise to a signal.
+*
+* Parameters:
+*  samples: Interleaved samples, 1.0 is the full scale
+*  frames: Frames of the signal
+*  channels: Channels of the signal
+*  level: Peak amplitude of the noise
+*  seed: Seed of the generator, the same seed gives the same noise
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_bench_noise(double *samples, uint32_t frames, uint32_t channels, double level, uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0U; i < (frames * channels); i++)
+    {
+        seed = (seed * 1664525U) + 1013904223U;
+        samples[i] += level * (((double) (seed >> 8) / (double) (1U << 23)) - 1.0);
+    }
+}
+
+/*****************************************************************************
+* Function Name: dsp_bench_output
+******************************************************************************
+* Summary:
+*  Get the output of the stage in the last run.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  const double*: Interleaved samples, 1.0 is the full scale
+*
+*****************************************************************************/
+const double *dsp_bench_output(void)
+{
+    return dsp_bench_last_output;
+}
+
+/*****************************************************************************
+* Function Name: dsp_bench_run
+******************************************************************************
+* Summary:
+*  Quantize the signal, run the stage on it one 1 ms period at a time and
+*  compare the output with the reference run on the quantized signal. The
+*  44.1 KHz family gets the periods of 44 and 45 frames of the host.
+*
+* Parameters:
+*  bench: Benchmark to run
+*  result: Timing and accuracy of the stage
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_bench_run(const dsp_bench_t *bench, dsp_bench_result_t *result)
+{
+    uint32_t samples = bench->frames * bench->channels;
+    uint32_t out_channels = (0U != bench->output_channels) ? bench->output_channels : bench->channels;
+    double full_scale = DSP_BENCH_FULL_SCALE(bench->sample_size);
+    double *reference = calloc(samples, sizeof(double));
+    void *buffer = calloc(samples, bench->sample_size);
+    uint64_t total = 0U;
+    uint64_t start;
+    uint64_t cycles;
+    uint32_t frame = 0U;
+    uint32_t out_frame = 0U;
+    uint32_t phase = 0U;
+    uint32_t in_frames;
+    double signal = 0.0;
+    double noise = 0.0;
+    double value;
+    double error;
+    dsp_block_t block;
+    uint32_t i;
+
+    free(dsp_bench_last_output);
+    dsp_bench_last_output = calloc(bench->frames * out_channels, sizeof(double));
+
+    /* Quantize, the reference runs on the same samples */
+    for (i = 0U; i < samples; i++)
+    {
+        value = nearbyint(bench->input[i] * full_scale);
+        value = (value > (full_scale - 1.0)) ? (full_scale - 1.0) : ((value < -full_scale) ? -full_scale : value);
+        reference[i] = value;
+        if (2U == bench->sample_size)
+        {
+            ((int16_t *) buffer)[i] = (int16_t) value;
+        }
+        else
+        {
+            ((int32_t *) buffer)[i] = (int32_t) value;
+        }
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->min_cycles = UINT64_MAX;
+
+    while (frame < bench->frames)
+    {
+        /* Frames of the period, the remainder is spread over the periods */
+        phase += bench->sample_rate % 1000U;
+        block.frames = (bench->sample_rate / 1000U) + ((phase >= 1000U) ? 1U : 0U);
+        phase %= 1000U;
+        if (block.frames > (bench->frames - frame))
+        {
+            break;
+        }
+
+        block.samples = (uint8_t *) buffer + ((size_t) frame * bench->channels * bench->sample_size);
+        block.channels = bench->channels;
+        block.sample_size = bench->sample_size;
+        in_frames = block.frames;
+
+        start = bench_cycles();
+        bench->process(&block);
+        cycles = bench_cycles() - start;
+
+        total += cycles;
+        result->min_cycles = (cycles < result->min_cycles) ? cycles : result->min_cycles;
+        result->periods++;
+
+        /* A stage may change the frames or the channels, in place */
+        for (i = 0U; i < (block.frames * block.channels); i++)
+        {
+            value = (2U == bench->sample_size) ? (double) ((int16_t *) block.samples)[i] :
+                                                 (double) ((int32_t *) block.samples)[i];
+            dsp_bench_last_output[((size_t) out_frame * out_channels) + i] = value / full_scale;
+        }
+
+        out_frame += block.frames;
+        frame += in_frames;
+    }
+
+    result->avg_cycles = (0U != result->periods) ? ((double) total / (double) result->periods) : 0.0;
+
+    if (NULL != bench->reference)
+    {
+        bench->reference(bench->arg, reference, bench->frames, bench->channels);
+
+        for (i = bench->settle_frames * out_channels; i < ((out_frame - bench->latency) * out_channels); i++)
+        {
+            error = (dsp_bench_last_output[i + (bench->latency * out_channels)] * full_scale) - reference[i];
+            signal += reference[i] * reference[i];
+            noise += error * error;
+            result->max_error = (fabs(error) > result->max_error) ? fabs(error) : result->max_error;
+        }
+        result->snr_db = (noise > 0.0) ? (10.0 * log10(signal / noise)) : INFINITY;
+    }
+
+    free(reference);
+    free(buffer);
+}
+
+/*****************************************************************************
+* Function Name: dsp_bench_print
+******************************************************************************
+* Summary:
+*  Print the timing and accuracy of a stage.
+*
+* Parameters:
+*  bench: Benchmark run
+*  result: Timing and accuracy of the stage
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void dsp_bench_print(const dsp_bench_t *bench, const dsp_bench_result_t *result)
+{
+    printf("%-24s %6lu Hz %lu ch %2lu bits: %8.0f host cycles per period (min %llu)", bench->name,
+           (unsigned long) bench->sample_rate, (unsigned long) bench->channels,
+           (unsigned long) ((2U == bench->sample_size) ? 16U : 24U), result->avg_cycles,
+           (unsigned long long) result->min_cycles);
+
+    if (NULL != bench->reference)
+    {
+        printf(", max error %.2f LSB, SNR %.1f dB", result->max_error, result->snr_db);
+    }
+    printf("\n");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name   : dsp_bench.h
+*
+* Description : This file contains the harness of the host benchmarks of the DSP
+*               stages: runs a stage on 1 ms periods of a signal, times it and
+*               compares its output with a floating point reference.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef DSP_BENCH_H
+#define DSP_BENCH_H
+
+#include "dsp_chain.h"
+#include "bench_util.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define DSP_BENCH_PI                (3.14159265358979323846)
+
+/* Full scale of the samples of each size */
+#define DSP_BENCH_FULL_SCALE(sample_size) (((sample_size) == 2U) ? 32768.0 : 8388608.0)
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/* Floating point reference, processes the whole signal in place. The
+ * samples are interleaved, with the full scale of the fixed point samples.
+ */
+typedef void (*dsp_bench_reference_t)(void *arg, double *samples, uint32_t frames, uint32_t channels);
+
+typedef struct
+{
+    const char *name;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t sample_size;               /* 2: int16_t, 4: 24-bit right-aligned in int32_t */
+    uint32_t frames;                    /* Frames of the signal */
+    const double *input;                /* Interleaved samples, 1.0 is the full scale */
+    void (*process)(dsp_block_t *block);/* Stage under test, configured and reset */
+    dsp_bench_reference_t reference;    /* NULL to only time the stage */
+    void *arg;                          /* Argument of the reference */
+    uint32_t latency;                   /* Frames the stage delays the samples */
+    uint32_t settle_frames;             /* Frames not compared at the start */
+    uint32_t output_channels;           /* Channels of the output, 0 if same as the input */
+} dsp_bench_t;
+
+typedef struct
+{
+    uint32_t periods;
+    uint64_t min_cycles;                /* Fastest period */
+    double avg_cycles;                  /* Average period */
+    double max_error;                   /* Largest error, in LSB of the samples */
+    double snr_db;                      /* Reference against the error */
+} dsp_bench_result_t;
+
+
+/******************************************************************************
+* Functions
+******************************************************************************/
+void dsp_bench_tone(double *samples, uint32_t frames, uint32_t channels, uint32_t sample_rate, double frequency,
+                    double level);
+void dsp_bench_noise(double *samples, uint32_t frames, uint32_t channels, double level, uint32_t seed);
+void dsp_bench_run(const dsp_bench_t *bench, dsp_bench_result_t *result);
+void dsp_bench_print(const dsp_bench_t *bench, const dsp_bench_result_t *result);
+const double *dsp_bench_output(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DSP_BENCH_H */
+
+/* [] END OF FILE */
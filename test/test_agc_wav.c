@@ -0,0 +1,380 @@
+/*****************************************************************************
+* File Name    : test_agc_wav.c
+*
+* Description  : This file contains the test of the AGC stage on WAV files: talkers at
+*                several levels are brought to the target level without clipping, and
+*                background noise is not boosted. Given a WAV file, it runs the AGC on
+*                it and writes the result.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_agc.h"
+#include "dsp_bench.h"
+#include "test_util.h"
+#include "wav.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_SAMPLE_RATE            (16000U)
+#define TEST_PERIOD_FRAMES          ((TEST_SAMPLE_RATE) / 1000U)
+#define TEST_SECONDS                (10U)
+
+/* The AGC gain reaches the samples this many periods after it is computed,
+ * like the capture path (queued periods of the DMA)
+ */
+#define TEST_HANDOVER_PERIODS       (2U)
+
+/* Levels are checked once the gain settled */
+#define TEST_SETTLE_S               (4U)
+
+/* Periods quieter than this before the gain are pauses of the talker */
+#define TEST_ACTIVE_DB              (-60.0)
+
+/* Level of the background noise of the recordings, below the gate */
+#define TEST_NOISE_DB               (-72.0)
+
+/* Active level of the talkers reached by the AGC, around DSP_AGC_TARGET_RMS.
+ * The target applies to each 1 ms period: the attack on the onsets of the
+ * syllables keeps the average below it.
+ */
+#define TEST_MAX_ABOVE_TARGET_DB    (2.0)
+#define TEST_MAX_BELOW_TARGET_DB    (7.0)
+
+/* Largest spread of the active levels of the talkers, 18 dB at the input */
+#define TEST_MAX_SPREAD_DB          (3.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    double active_db;           /* Level of the talker when not in a pause */
+    double rms_db;              /* Output level of the active periods, once settled */
+    double peak_db;             /* Output peak, once settled */
+    double min_gain_db;         /* Range of the gain applied, once settled */
+    double max_gain_db;
+    uint32_t clipped;           /* Output samples at full scale, once settled */
+} test_result_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* Active level of each talker, in dBFS */
+static const double test_talkers[] = { -30.0, -24.0, -18.0, -12.0 };
+
+
+/*****************************************************************************
+* Function Name: test_talker
+******************************************************************************
+* Summary:
+*  Synthesize a talker: a voiced source with a gliding pitch and its
+*  harmonics, cut into syllables of about 200 ms with pauses, over a
+*  background noise. The active level is the RMS level outside the pauses.
+*
+*****************************************************************************/
+static void test_talker(wav_t *wav, double active_db, uint32_t seed)
+{
+    uint32_t frames = (TEST_SAMPLE_RATE) * (TEST_SECONDS);
+    double *voice = calloc(frames, sizeof(double));
+    double *noise = calloc(frames, sizeof(double));
+    double phase = 0.0;
+    double sum = 0.0;
+    uint32_t active = 0U;
+    double pitch;
+    double envelope;
+    double t;
+    double scale;
+    uint32_t harmonic;
+    uint32_t i;
+
+    dsp_bench_noise(noise, frames, 1U, pow(10.0, (TEST_NOISE_DB) / 20.0) * sqrt(3.0), seed);
+
+    for (i = 0U; i < frames; i++)
+    {
+        t = (double) i / (double) (TEST_SAMPLE_RATE);
+        pitch = 120.0 + (20.0 * sin(2.0 * (DSP_BENCH_PI) * 0.7 * t));
+        phase += 2.0 * (DSP_BENCH_PI) * pitch / (double) (TEST_SAMPLE_RATE);
+
+        /* Syllables at 2.5 Hz, 40 % of the time in pauses */
+        envelope = sin(2.0 * (DSP_BENCH_PI) * 2.5 * t);
+        envelope = (envelope > 0.3) ? pow(envelope - 0.3, 0.5) * (0.6 + (0.4 * sin(2.0 * (DSP_BENCH_PI) * 0.3 * t))) : 0.0;
+
+        for (harmonic = 1U; harmonic <= 12U; harmonic++)
+        {
+            voice[i] += sin((double) harmonic * phase) / (double) harmonic;
+        }
+        voice[i] *= envelope;
+
+        if (envelope > 0.0)
+        {
+            sum += voice[i] * voice[i];
+            active++;
+        }
+    }
+
+    scale = pow(10.0, active_db / 20.0) / sqrt(sum / (double) active);
+
+    wav->frames = frames;
+    wav->channels = 1U;
+    wav->sample_rate = TEST_SAMPLE_RATE;
+    wav->samples = malloc(frames * sizeof(int16_t));
+    for (i = 0U; i < frames; i++)
+    {
+        t = nearbyint(((voice[i] * scale) + noise[i]) * 32768.0);
+        wav->samples[i] = (int16_t) ((t > 32767.0) ? 32767.0 : ((t < -32768.0) ? -32768.0 : t));
+    }
+
+    free(voice);
+    free(noise);
+}
+
+/*****************************************************************************
+* Function Name: test_run
+******************************************************************************
+* Summary:
+*  Run the AGC on a file the way the capture path does: each 1 ms period
+*  gets the gain computed TEST_HANDOVER_PERIODS periods earlier, is measured
+*  by the AGC, which is told the gain it got, and goes to the output.
+*
+*****************************************************************************/
+static void test_run(const wav_t *in, wav_t *out, test_result_t *result)
+{
+    int32_t gains[(TEST_HANDOVER_PERIODS) + 1U];
+    uint32_t settle = in->sample_rate * (TEST_SETTLE_S);
+    uint32_t period_frames = in->sample_rate / 1000U;
+    uint32_t count = period_frames * in->channels;
+    double sum = 0.0;
+    uint32_t active = 0U;
+    double in_power;
+    double out_power;
+    double gain_db;
+    double value;
+    dsp_block_t block;
+    uint32_t frame;
+    uint32_t i;
+
+    *out = *in;
+    out->samples = malloc((size_t) in->frames * in->channels * sizeof(int16_t));
+
+    result->rms_db = -INFINITY;
+    result->peak_db = -INFINITY;
+    result->min_gain_db = INFINITY;
+    result->max_gain_db = -INFINITY;
+    result->clipped = 0U;
+
+    dsp_agc_reset();
+    for (i = 0U; i <= (TEST_HANDOVER_PERIODS); i++)
+    {
+        gains[i] = dsp_agc_get_gain();
+    }
+
+    for (frame = 0U; (frame + period_frames) <= in->frames; frame += period_frames)
+    {
+        /* Gain computed TEST_HANDOVER_PERIODS periods ago */
+        for (i = 0U; i < (TEST_HANDOVER_PERIODS); i++)
+        {
+            gains[i] = gains[i + 1U];
+        }
+        gains[TEST_HANDOVER_PERIODS] = dsp_agc_get_gain();
+        gain_db = (double) gains[0] / 256.0;
+
+        in_power = 0.0;
+        out_power = 0.0;
+        for (i = 0U; i < count; i++)
+        {
+            value = in->samples[(frame * in->channels) + i];
+            in_power += value * value;
+
+            value = nearbyint(value * pow(10.0, gain_db / 20.0));
+            value = (value > 32767.0) ? 32767.0 : ((value < -32768.0) ? -32768.0 : value);
+            out->samples[(frame * in->channels) + i] = (int16_t) value;
+            out_power += value * value;
+
+            if (frame >= settle)
+            {
+                result->clipped += ((32767.0 == value) || (-32768.0 == value)) ? 1U : 0U;
+                value = 20.0 * log10((fabs(value) + 1e-9) / 32768.0);
+                result->peak_db = (value > result->peak_db) ? value : result->peak_db;
+            }
+        }
+
+        block.samples = &out->samples[frame * in->channels];
+        block.frames = period_frames;
+        block.channels = in->channels;
+        block.sample_size = sizeof(int16_t);
+        dsp_agc_set_period_gain(gains[0]);
+        dsp_agc_process(&block);
+
+        if ((frame >= settle) &&
+            ((10.0 * log10((in_power / (double) count) / (32768.0 * 32768.0))) > (TEST_ACTIVE_DB)))
+        {
+            sum += out_power;
+            active += count;
+            result->min_gain_db = (gain_db < result->min_gain_db) ? gain_db : result->min_gain_db;
+            result->max_gain_db = (gain_db > result->max_gain_db) ? gain_db : result->max_gain_db;
+        }
+    }
+
+    if (0U != active)
+    {
+        result->rms_db = 10.0 * log10((sum / (double) active) / (32768.0 * 32768.0));
+    }
+}
+
+/*****************************************************************************
+* Function Name: test_print
+******************************************************************************
+* Summary:
+*  Print the result of a run.
+*
+*****************************************************************************/
+static void test_print(const char *name, const test_result_t *result)
+{
+    printf("%-24s active %6.1f dBFS, gain %5.1f..%5.1f dB, peak %5.1f dBFS, %lu clipped\n", name,
+           result->rms_db, result->min_gain_db, result->max_gain_db, result->peak_db,
+           (unsigned long) result->clipped);
+}
+
+/*****************************************************************************
+* Function Name: test_file
+******************************************************************************
+* Summary:
+*  Run the AGC on a WAV file and write the result.
+*
+*****************************************************************************/
+static int test_file(const char *in_path, const char *out_path)
+{
+    test_result_t result;
+    wav_t in;
+    wav_t out;
+
+    if (!wav_read(in_path, &in))
+    {
+        printf("Cannot read %s, 16-bit PCM only\n", in_path);
+        return EXIT_FAILURE;
+    }
+
+    test_run(&in, &out, &result);
+    test_print(in_path, &result);
+
+    if ((NULL != out_path) && !wav_write(out_path, &out))
+    {
+        printf("Cannot write %s\n", out_path);
+    }
+
+    wav_free(&in);
+    wav_free(&out);
+    return EXIT_SUCCESS;
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Without argument, write the talkers and the background noise to WAV
+*  files, run the AGC on them and check the levels. With a WAV file (and an
+*  output file), run the AGC on it.
+*
+* Parameters:
+*  argc: Number of arguments
+*  argv: [input.wav [output.wav]]
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    double target = (double) (DSP_AGC_TARGET_RMS) / 256.0;
+    test_result_t result;
+    double min_db = INFINITY;
+    double max_db = -INFINITY;
+    char path[64];
+    wav_t talker;
+    wav_t in;
+    wav_t out;
+    uint32_t i;
+
+    if (argc > 1)
+    {
+        return test_file(argv[1], (argc > 2) ? argv[2] : NULL);
+    }
+
+    for (i = 0U; i < (sizeof(test_talkers) / sizeof(test_talkers[0])); i++)
+    {
+        snprintf(path, sizeof(path), "agc_talker_%+.0fdB.wav", test_talkers[i]);
+        test_talker(&talker, test_talkers[i], i + 1U);
+        TEST_CHECK(wav_write(path, &talker) && wav_read(path, &in), "%s not written", path);
+        wav_free(&talker);
+
+        test_run(&in, &out, &result);
+        test_print(path, &result);
+
+        TEST_CHECK((result.rms_db <= (target + (TEST_MAX_ABOVE_TARGET_DB))) &&
+                   (result.rms_db >= (target - (TEST_MAX_BELOW_TARGET_DB))),
+                   "%s: active level of %.1f dBFS", path, result.rms_db);
+        TEST_CHECK(0U == result.clipped, "%s: %lu samples clipped", path, (unsigned long) result.clipped);
+        min_db = (result.rms_db < min_db) ? result.rms_db : min_db;
+        max_db = (result.rms_db > max_db) ? result.rms_db : max_db;
+
+        wav_free(&in);
+        wav_free(&out);
+    }
+
+    TEST_CHECK((max_db - min_db) <= (TEST_MAX_SPREAD_DB), "active levels spread over %.1f dB", max_db - min_db);
+
+    /* Background noise only: the gain is held at its initial value */
+    test_talker(&talker, -INFINITY, 9U);
+    TEST_CHECK(wav_write("agc_noise.wav", &talker) && wav_read("agc_noise.wav", &in), "agc_noise.wav not written");
+    wav_free(&talker);
+    test_run(&in, &out, &result);
+    printf("%-24s gain %d dB\n", "agc_noise.wav", (int) (dsp_agc_get_gain() / 256));
+    TEST_CHECK((DSP_AGC_GAIN_INITIAL) == dsp_agc_get_gain(), "gain moved to %d/256 dB on background noise",
+               (int) dsp_agc_get_gain());
+    wav_free(&in);
+    wav_free(&out);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
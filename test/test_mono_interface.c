@@ -0,0 +1,175 @@
+/*****************************************************************************
+* File Name    : test_mono_interface.c
+*
+* Description  : This file contains the test of the mono interface: its
+*                terminal has one Center Front channel, its own endpoint is
+*                sized for the mono formats, and the host can hand the capture
+*                over between the mono interface and the microphone interface.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "cycfg_emusbdev.h"
+#include "sim.h"
+#include "test_util.h"
+
+
+#if (AUDIO_IN_MONO_INTERFACE)
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Audio instances, in the order of USBD_AUDIO_Add() */
+#define TEST_INSTANCE_MIC           (0U)
+#define TEST_INSTANCE_MONO          (1U)
+
+/* Alternate settings of 48 KHz, 16 bits: stereo on the microphone interface,
+ * average of both microphones on the mono interface
+ */
+#define TEST_ALT_48K                (6U)
+#define TEST_ALT_MONO_48K           (6U)
+#define TEST_STEREO_FRAME_BYTES     (2U * 2U)
+#define TEST_MONO_FRAME_BYTES       (2U)
+
+/* Warm-up of the capture, then the time checked */
+#define TEST_WARMUP_MS              (200U)
+#define TEST_RUN_MS                 (2000U)
+
+
+/*****************************************************************************
+* Function Name: test_stream
+******************************************************************************
+* Summary:
+*  Check an instance sends a packet of the nominal size at 48 KHz every
+*  frame, within its wMaxPacketSize.
+*
+*****************************************************************************/
+static void test_stream(uint32_t instance, uint32_t frame_bytes)
+{
+    sim_usb_stats_t stats;
+    uint32_t nominal = 48U * frame_bytes;
+
+    sim_usb_clear_stats(instance);
+    sim_run(TEST_RUN_MS);
+    sim_usb_get_stats(instance, &stats);
+
+    printf("instance %u: %u packets, %u empty, %u..%u bytes\n", (unsigned) instance, stats.packets,
+           stats.empty_packets, stats.min_size, stats.max_size);
+    TEST_CHECK(stats.packets == (TEST_RUN_MS), "%u packets", stats.packets);
+    TEST_CHECK(0U == stats.empty_packets, "%u empty packets", stats.empty_packets);
+    TEST_CHECK(0U == stats.oversized, "%u oversized packets", stats.oversized);
+    TEST_CHECK((stats.min_size >= (nominal - frame_bytes)) && (stats.max_size <= (nominal + frame_bytes)),
+               "packets of %u..%u bytes", stats.min_size, stats.max_size);
+}
+#endif /* AUDIO_IN_MONO_INTERFACE */
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test, skipped without the mono interface (with the beamformer).
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed, TEST_SKIPPED() without the mono
+*       interface
+*
+*****************************************************************************/
+int main(void)
+{
+#if (AUDIO_IN_MONO_INTERFACE)
+    const USBD_AUDIO_IF_CONF *mic = &audio_interfaces[AUDIO_IF_MICROPHONE];
+    const USBD_AUDIO_IF_CONF *mono = &audio_interfaces[AUDIO_IF_MONO];
+    sim_usb_stats_t stats;
+
+    /* Descriptors: a two-channel terminal and a one-channel terminal */
+    TEST_CHECK((2U == mic->TotalNrChannels) && (0x0003U == mic->bmChannelConfig),
+               "microphone terminal: %u channels, config 0x%04x", mic->TotalNrChannels, mic->bmChannelConfig);
+    TEST_CHECK((1U == mono->TotalNrChannels) && (0x0004U == mono->bmChannelConfig),
+               "mono terminal: %u channels, config 0x%04x", mono->TotalNrChannels, mono->bmChannelConfig);
+    TEST_CHECK(6U == mono->NumFormats, "%u mono formats", mono->NumFormats);
+    TEST_CHECK(1U == mono->paFormats[TEST_ALT_MONO_48K - 1U].NrChannels, "mono format of %u channels",
+               mono->paFormats[TEST_ALT_MONO_48K - 1U].NrChannels);
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+
+    /* Bandwidth reserved by each endpoint */
+    printf("wMaxPacketSize: %u bytes (microphone), %u bytes (mono)\n",
+           (unsigned) sim_usb_get_max_packet_size(TEST_INSTANCE_MIC),
+           (unsigned) sim_usb_get_max_packet_size(TEST_INSTANCE_MONO));
+    TEST_CHECK(776U == sim_usb_get_max_packet_size(TEST_INSTANCE_MIC), "microphone endpoint of %u bytes",
+               (unsigned) sim_usb_get_max_packet_size(TEST_INSTANCE_MIC));
+    TEST_CHECK(98U == sim_usb_get_max_packet_size(TEST_INSTANCE_MONO), "mono endpoint of %u bytes",
+               (unsigned) sim_usb_get_max_packet_size(TEST_INSTANCE_MONO));
+
+    /* Mono alone */
+    sim_usb_set_interface(TEST_INSTANCE_MONO, TEST_ALT_MONO_48K);
+    sim_run(TEST_WARMUP_MS);
+    TEST_CHECK(sim_pdm_is_running(), "capture not running for the mono interface");
+    sim_usb_clear_stats(TEST_INSTANCE_MIC);
+    test_stream(TEST_INSTANCE_MONO, TEST_MONO_FRAME_BYTES);
+    sim_usb_get_stats(TEST_INSTANCE_MIC, &stats);
+    TEST_CHECK(0U == stats.packets, "%u packets on the closed microphone interface", stats.packets);
+
+    /* The host opens the microphone interface, then closes the mono one */
+    sim_usb_set_interface(TEST_INSTANCE_MIC, TEST_ALT_48K);
+    sim_usb_set_interface(TEST_INSTANCE_MONO, 0U);
+    sim_run(TEST_WARMUP_MS);
+    TEST_CHECK(sim_pdm_is_running(), "capture stopped by closing the mono interface");
+    test_stream(TEST_INSTANCE_MIC, TEST_STEREO_FRAME_BYTES);
+
+    /* And back, the other way round */
+    sim_usb_set_interface(TEST_INSTANCE_MIC, 0U);
+    sim_usb_set_interface(TEST_INSTANCE_MONO, TEST_ALT_MONO_48K);
+    sim_run(TEST_WARMUP_MS);
+    test_stream(TEST_INSTANCE_MONO, TEST_MONO_FRAME_BYTES);
+
+    sim_usb_set_interface(TEST_INSTANCE_MONO, 0U);
+    sim_run(100U);
+    TEST_CHECK(!sim_pdm_is_powered(), "capture powered after the streams closed");
+
+    return TEST_RESULT();
+#else
+    printf("No mono interface\n");
+
+    return TEST_SKIPPED();
+#endif /* AUDIO_IN_MONO_INTERFACE */
+}
+
+/* [] END OF FILE */
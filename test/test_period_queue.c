@@ -0,0 +1,262 @@
+/*****************************************************************************
+* File Name    : test_period_queue.c
+*
+* Description  : This file contains the stress test of the period queue: a producer
+*                and a consumer thread exchange periods as fast as they can, the
+*                consumer checks that no period is torn, reordered or overwritten.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "period_queue.h"
+#include "test_util.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_PERIOD_WORDS           (16U)
+#define TEST_PERIODS                (2000000U)
+
+/* Every 2^n periods a thread yields, to vary the interleaving */
+#define TEST_PRODUCER_YIELD_MASK    (0x3FU)
+#define TEST_CONSUMER_YIELD_MASK    (0x7FU)
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static period_queue_t test_queue;
+static uint32_t test_storage[PERIOD_QUEUE_DEPTH * TEST_PERIOD_WORDS];
+static volatile bool test_producer_done = false;
+
+/* Periods attempted by the producer */
+static uint32_t test_attempts = 0U;
+
+/* Consumer side results */
+static uint32_t test_consumed = 0U;
+static uint32_t test_missing = 0U;
+static uint32_t test_torn = 0U;
+static uint32_t test_reordered = 0U;
+static uint32_t test_overwritten = 0U;
+
+
+/*****************************************************************************
+* Function Name: test_count
+******************************************************************************
+* Summary:
+*  Number of samples of the period with a sequence number, it varies like
+*  the periods of the rate controller.
+*
+*****************************************************************************/
+static uint32_t test_count(uint32_t sequence)
+{
+    return (TEST_PERIOD_WORDS) - (sequence % 3U);
+}
+
+/*****************************************************************************
+* Function Name: test_intact
+******************************************************************************
+* Summary:
+*  Check that a period only holds its sequence number.
+*
+*****************************************************************************/
+static bool test_intact(const period_t *period, uint32_t sequence)
+{
+    uint32_t i;
+
+    if (period->count != test_count(sequence))
+    {
+        return false;
+    }
+
+    for (i = 0U; i < period->count; i++)
+    {
+        if (period->buffer[i] != sequence)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************
+* Function Name: test_producer
+******************************************************************************
+* Summary:
+*  Write each period with its sequence number, like the DMA interrupt.
+*
+*****************************************************************************/
+static void *test_producer(void *arg)
+{
+    period_t *period;
+    uint32_t sequence;
+    uint32_t i;
+
+    (void) arg;
+
+    for (sequence = 1U; sequence <= (TEST_PERIODS); sequence++)
+    {
+        period = period_queue_producer_period(&test_queue);
+        for (i = 0U; i < test_count(sequence); i++)
+        {
+            period->buffer[i] = sequence;
+        }
+        /* Leave the consumer some time on an overrun, like a period of the DMA */
+        if (!period_queue_produce(&test_queue, test_count(sequence)) ||
+            (0U == (sequence & (TEST_PRODUCER_YIELD_MASK))))
+        {
+            sched_yield();
+        }
+    }
+
+    test_attempts = TEST_PERIODS;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    test_producer_done = true;
+
+    return NULL;
+}
+
+/*****************************************************************************
+* Function Name: test_consumer
+******************************************************************************
+* Summary:
+*  Take the periods in order, like the USB endpoint callback. The period
+*  taken stays owned until the next call, it is checked again before it.
+*
+*****************************************************************************/
+static void *test_consumer(void *arg)
+{
+    period_t *held = NULL;
+    period_t *period;
+    uint32_t last = 0U;
+    bool done;
+
+    (void) arg;
+
+    for (;;)
+    {
+        done = test_producer_done;
+
+        if ((NULL != held) && !test_intact(held, last))
+        {
+            test_overwritten++;
+        }
+
+        period = period_queue_consume(&test_queue);
+        if (NULL == period)
+        {
+            if (done)
+            {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        test_consumed++;
+        if (period->buffer[0] <= last)
+        {
+            test_reordered++;
+        }
+        else
+        {
+            test_missing += period->buffer[0] - last - 1U;
+            last = period->buffer[0];
+        }
+
+        if (!test_intact(period, period->buffer[0]))
+        {
+            test_torn++;
+        }
+        held = period;
+
+        if (0U == (test_consumed & (TEST_CONSUMER_YIELD_MASK)))
+        {
+            sched_yield();
+        }
+    }
+
+    /* The periods the producer dropped at the end of the run */
+    test_missing += (TEST_PERIODS) - last;
+
+    return NULL;
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    period_queue_stats_t stats;
+    pthread_t producer;
+    pthread_t consumer;
+
+    period_queue_init(&test_queue, test_storage, TEST_PERIOD_WORDS);
+
+    pthread_create(&consumer, NULL, test_consumer, NULL);
+    pthread_create(&producer, NULL, test_producer, NULL);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    period_queue_get_stats(&test_queue, &stats);
+    printf("%u periods: %u consumed, %u dropped (%u overruns), %u underruns, peak level %u\n", test_attempts,
+           test_consumed, test_missing, stats.overruns, stats.underruns, stats.peak_level);
+
+    TEST_CHECK(0U == test_torn, "%u torn periods", test_torn);
+    TEST_CHECK(0U == test_reordered, "%u reordered periods", test_reordered);
+    TEST_CHECK(0U == test_overwritten, "%u periods overwritten while held", test_overwritten);
+    TEST_CHECK((test_consumed + stats.overruns) == test_attempts, "%u consumed + %u overruns != %u",
+               test_consumed, stats.overruns, test_attempts);
+    TEST_CHECK(test_missing == stats.overruns, "%u missing periods for %u overruns", test_missing, stats.overruns);
+    TEST_CHECK(stats.produced == test_consumed, "%u produced, %u consumed", stats.produced, test_consumed);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
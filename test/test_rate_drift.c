@@ -0,0 +1,204 @@
+/*****************************************************************************
+* File Name    : test_rate_drift.c
+*
+* Description  : This file contains the test of the rate controller against clock
+*                drift: with the microphones from -500 to +500 ppm off the USB host,
+*                the depth of the capture buffer stays bounded and no sample is lost.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "sim.h"
+#include "test_util.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Alternate settings of 44.1 KHz and 48 KHz, 16 bits, on every channel of
+ * the microphone interface
+ */
+#define TEST_ALT_44K                (5U)
+#define TEST_ALT_48K                (6U)
+#define TEST_FRAME_BYTES            AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE)
+
+/* Time for the loop to settle, then the time checked */
+#define TEST_SETTLE_MS              (2000U)
+#define TEST_RUN_MS                 (20000U)
+
+/* Largest swing of the depth once settled, in frames. The depth moves by
+ * one packet within a USB frame, plus the correction of the controller.
+ */
+#define TEST_MAX_SWING_FRAMES       (64.0)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    double rate;                /* Frames per second of the microphones */
+    double received;            /* Frames received by the host */
+    double min_depth;
+    double max_depth;
+} test_depth_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const int32_t test_ppms[] = { -500, -200, -50, 50, 200, 500 };
+
+
+/*****************************************************************************
+* Function Name: test_sink
+******************************************************************************
+* Summary:
+*  Track the frames produced by the microphones minus the frames received by
+*  the host. Its absolute value depends on the origin, its swing is the
+*  swing of the depth of the buffers of the device.
+*
+*****************************************************************************/
+static void test_sink(void *arg, uint32_t instance, const uint8_t *data, uint32_t size)
+{
+    test_depth_t *depth = (test_depth_t *) arg;
+    double produced = depth->rate * ((double) sim_now_ns() / (double) (SIM_NS_PER_S));
+    double level;
+
+    (void) instance;
+    (void) data;
+
+    depth->received += (double) (size / (TEST_FRAME_BYTES));
+    level = produced - depth->received;
+
+    if (level < depth->min_depth)
+    {
+        depth->min_depth = level;
+    }
+    if (level > depth->max_depth)
+    {
+        depth->max_depth = level;
+    }
+}
+
+/*****************************************************************************
+* Function Name: test_drift
+******************************************************************************
+* Summary:
+*  Stream at a clock offset and check the depth, the queue and the packets.
+*
+*****************************************************************************/
+static void test_drift(uint8_t alt_setting, uint32_t sample_rate, int32_t ppm)
+{
+    test_depth_t depth;
+    period_queue_stats_t queue;
+    sim_usb_stats_t stats;
+    uint32_t overflows;
+    uint32_t nominal = sample_rate / 1000U;
+
+    sim_usb_set_interface(0U, 0U);
+    sim_run(10U);
+    sim_pdm_set_ppm(ppm);
+    sim_usb_set_interface(0U, alt_setting);
+    sim_usb_set_sink(NULL, NULL);
+    sim_run(TEST_SETTLE_MS);
+
+    depth.rate = (double) sample_rate * (1.0 + ((double) ppm / 1e6));
+    depth.received = depth.rate * ((double) sim_now_ns() / (double) (SIM_NS_PER_S));
+    depth.min_depth = 0.0;
+    depth.max_depth = 0.0;
+    audio_in_reset_stats();
+    sim_usb_clear_stats(0U);
+    overflows = sim_pdm_get_overflows();
+    sim_usb_set_sink(test_sink, &depth);
+    sim_run(TEST_RUN_MS);
+
+    audio_in_get_queue_stats(&queue);
+    sim_usb_get_stats(0U, &stats);
+    printf("%6lu Hz %+4ld ppm: depth swing %.1f frames, packets %u..%u bytes, queue peak %u\n",
+           (unsigned long) sample_rate, (long) ppm, depth.max_depth - depth.min_depth, stats.min_size,
+           stats.max_size, queue.peak_level);
+
+    TEST_CHECK((depth.max_depth - depth.min_depth) < (TEST_MAX_SWING_FRAMES), "%ld ppm: depth swing of %.1f frames",
+               (long) ppm, depth.max_depth - depth.min_depth);
+    TEST_CHECK((0U == queue.overruns) && (0U == queue.underruns), "%ld ppm: %u overruns, %u underruns",
+               (long) ppm, queue.overruns, queue.underruns);
+    TEST_CHECK(overflows == sim_pdm_get_overflows(), "%ld ppm: FIFO overflow", (long) ppm);
+    TEST_CHECK(0U == stats.empty_packets, "%ld ppm: %u empty packets", (long) ppm, stats.empty_packets);
+    TEST_CHECK((stats.min_size >= ((nominal - 1U) * (TEST_FRAME_BYTES))) &&
+               (stats.max_size <= ((nominal + 2U) * (TEST_FRAME_BYTES))),
+               "%ld ppm: packets of %u..%u bytes", (long) ppm, stats.min_size, stats.max_size);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed, TEST_SKIPPED() with the voice
+*       activity gating
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+#if (AUDIO_IN_VAD_GATING)
+    /* The stationary tone is not speech: it is gated, see test_vad_gating */
+    printf("Voice activity gating\n");
+    return TEST_SKIPPED();
+#endif /* AUDIO_IN_VAD_GATING */
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+
+    for (i = 0U; i < (sizeof(test_ppms) / sizeof(test_ppms[0])); i++)
+    {
+        test_drift(TEST_ALT_48K, 48000U, test_ppms[i]);
+        test_drift(TEST_ALT_44K, 44100U, test_ppms[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+/*****************************************************************************
+* File Name    : test_rtos_stats.c
+*
+* Description  : This file contains the test of the run time statistics of the tasks
+*                on the host simulation: the shares of the tasks add up to the time
+*                elapsed and the longest runs of the tasks are measured.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "console.h"
+#include "telemetry.h"
+#include "rtos_stats.h"
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "test_util.h"
+
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Alternate setting of 48 KHz, 16 bits stereo */
+#define TEST_ALT_48K                (6U)
+#define TEST_RUN_MS                 (5000U)
+
+/* Suspended bus, longer than a wrap-around of the cycle counter (28.6 s) */
+#define TEST_SUSPEND_MS             (40000U)
+
+/* Virtual time charged for each run of a task, instead of the host CPU
+ * time, so the runs do not depend on the load of the host. The cost drops
+ * before the reset of the longest runs, so the runs measured after it are
+ * shorter.
+ */
+#define TEST_RUN_COST_NS            (200000U)
+#define TEST_RESET_COST_NS          (50000U)
+#define TEST_COST_CYCLES(ns)        ((uint32_t) (((uint64_t) (ns) * ((SIM_CORE_CLOCK_HZ) / 1000000U)) / 1000U))
+
+/* Cycles of the run time counter */
+#define TEST_CYCLES_PER_COUNT       (1UL << (RTOS_STATS_COUNTER_SHIFT))
+
+/* Tolerance on the total run time, in counts, for the time the counter
+ * was last read
+ */
+#define TEST_TOTAL_TOLERANCE        ((SIM_CORE_CLOCK_HZ) / 1000U / (TEST_CYCLES_PER_COUNT))
+
+
+/*****************************************************************************
+* Function Name: test_find
+******************************************************************************
+* Summary:
+*  Find a task in the snapshot of the system state.
+*
+*****************************************************************************/
+static const TaskStatus_t *test_find(const TaskStatus_t *tasks, UBaseType_t num_tasks, const char *name)
+{
+    UBaseType_t i;
+
+    for (i = 0U; i < num_tasks; i++)
+    {
+        if (0 == strcmp(tasks[i].pcTaskName, name))
+        {
+            return &tasks[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*****************************************************************************
+* Function Name: test_longest_run
+******************************************************************************
+* Summary:
+*  Get the longest run of a task recorded by rtos_stats, in cycles.
+*
+*****************************************************************************/
+static uint32_t test_longest_run(const TaskStatus_t *task)
+{
+    return (uint32_t) (uintptr_t) pvTaskGetThreadLocalStoragePointer(task->xHandle, RTOS_STATS_TLS_INDEX);
+}
+
+/*****************************************************************************
+* Function Name: test_elapsed
+******************************************************************************
+* Summary:
+*  Get the virtual time since start-up in counts of the run time counter.
+*
+*****************************************************************************/
+static uint64_t test_elapsed(void)
+{
+    return (sim_now_ns() * ((SIM_CORE_CLOCK_HZ) / 1000000U)) / (SIM_NS_PER_US) / (TEST_CYCLES_PER_COUNT);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test. A fixed time is charged to the virtual time for each run
+*  of a task, so the tasks get a share of the CPU.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    TaskStatus_t tasks[RTOS_STATS_MAX_TASKS];
+    const TaskStatus_t *audio_in;
+    const TaskStatus_t *idle;
+    UBaseType_t num_tasks;
+    UBaseType_t i;
+    uint32_t total;
+    uint64_t sum = 0U;
+    uint64_t elapsed;
+
+    sim_set_cpu_cost(TEST_RUN_COST_NS);
+    audio_app_init();
+    console_init();
+    telemetry_init();
+    sim_usb_connect();
+    sim_run(100U);
+    sim_usb_set_interface(0U, TEST_ALT_48K);
+    sim_run(TEST_RUN_MS);
+
+    sim_console_input("t");
+    sim_run(100U);
+
+    num_tasks = uxTaskGetSystemState(tasks, RTOS_STATS_MAX_TASKS, &total);
+    elapsed = test_elapsed();
+    for (i = 0U; i < num_tasks; i++)
+    {
+        sum += tasks[i].ulRunTimeCounter;
+    }
+    audio_in = test_find(tasks, num_tasks, "Audio In Task");
+    idle = test_find(tasks, num_tasks, "IDLE");
+
+    printf("%lu tasks, total %lu counts, sum of the tasks %llu, elapsed %llu\n", (unsigned long) num_tasks,
+           (unsigned long) total, (unsigned long long) sum, (unsigned long long) elapsed);
+
+    TEST_CHECK(5U == num_tasks, "%lu tasks", (unsigned long) num_tasks);
+    TEST_CHECK((total <= elapsed) && ((total + (TEST_TOTAL_TOLERANCE)) >= elapsed),
+               "total run time %lu counts for %llu elapsed", (unsigned long) total, (unsigned long long) elapsed);
+    TEST_CHECK((sum <= total) && ((sum + (TEST_TOTAL_TOLERANCE)) >= total),
+               "tasks add up to %llu counts of %lu", (unsigned long long) sum, (unsigned long) total);
+    TEST_CHECK((NULL != audio_in) && (audio_in->ulRunTimeCounter > 0U), "no run time for the Audio In Task");
+    TEST_CHECK((NULL != idle) && (idle->ulRunTimeCounter > (total / 2U)), "idle below half of the CPU");
+    /* Each run takes the cost, within the rounding of the cycle counter */
+    TEST_CHECK((NULL != audio_in) && (test_longest_run(audio_in) >= TEST_COST_CYCLES(TEST_RUN_COST_NS)) &&
+               (test_longest_run(audio_in) <= (TEST_COST_CYCLES(TEST_RUN_COST_NS) + 1U)),
+               "longest run of the Audio In Task of %lu cycles",
+               (unsigned long) ((NULL != audio_in) ? test_longest_run(audio_in) : 0U));
+
+    /* The reset clears the longest runs, the next runs are measured again */
+    sim_set_cpu_cost(TEST_RESET_COST_NS);
+    sim_console_input("r");
+    sim_run(100U);
+    num_tasks = uxTaskGetSystemState(tasks, RTOS_STATS_MAX_TASKS, NULL);
+    audio_in = test_find(tasks, num_tasks, "Audio In Task");
+    TEST_CHECK((NULL != audio_in) && (test_longest_run(audio_in) <= (TEST_COST_CYCLES(TEST_RESET_COST_NS) + 1U)),
+               "longest run of %lu cycles not reset",
+               (unsigned long) ((NULL != audio_in) ? test_longest_run(audio_in) : 0U));
+    TEST_CHECK((NULL != audio_in) && (test_longest_run(audio_in) >= TEST_COST_CYCLES(TEST_RESET_COST_NS)),
+               "longest run not measured after reset");
+
+    /* No USB frames wake the tasks up and no key is typed while the cycle
+     * counter wraps around, the run time counter still follows the time
+     */
+    sim_usb_suspend();
+    sim_run(TEST_SUSPEND_MS);
+    (void) uxTaskGetSystemState(tasks, RTOS_STATS_MAX_TASKS, &total);
+    elapsed = test_elapsed();
+    TEST_CHECK((total <= elapsed) && ((total + (TEST_TOTAL_TOLERANCE)) >= elapsed),
+               "total run time %lu counts for %llu elapsed after a suspend", (unsigned long) total,
+               (unsigned long long) elapsed);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
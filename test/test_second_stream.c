@@ -0,0 +1,325 @@
+/*****************************************************************************
+* File Name    : test_second_stream.c
+*
+* Description  : This file contains the test of the second stream: packets of
+*                16 KHz next to a 48 KHz stream and alone, and their content
+*                against the first stream.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "cycfg_emusbdev.h"
+#include "sim.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Audio instances, in the order of USBD_AUDIO_Add() */
+#define TEST_INSTANCE_MIC           (0U)
+#define TEST_INSTANCE_SECOND        (AUDIO_IF_SECOND)
+
+/* 48 KHz 16 bits on every channel of the microphone interface, single
+ * format of the second stream
+ */
+#define TEST_ALT_48K                (6U)
+#define TEST_ALT_SECOND             (1U)
+#define TEST_FIRST_FRAME_BYTES      AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE)
+#define TEST_SECOND_FRAME_BYTES     (2U)
+
+/* Tone in the band of the second stream, and one above it that aliases to
+ * TEST_ALIAS_HZ - TEST_SECOND_RATE once decimated
+ */
+#define TEST_TONE_HZ                (997.0)
+#define TEST_TONE_LEVEL             (0.1)
+#define TEST_ALIAS_HZ               (19000.0)
+#define TEST_ALIAS_LEVEL            (TEST_TONE_LEVEL)
+#define TEST_FIRST_RATE             (48000.0)
+#define TEST_SECOND_RATE            ((double) AUDIO_IN_SECOND_SAMPLE_FREQ)
+
+/* Tone of the second stream against the one of the first stream (average
+ * of its channels), and level of the alias against the tone above the band
+ * (both in the full scale of the capture)
+ */
+#define TEST_MAX_TONE_ERROR_DB      (0.1)
+#define TEST_MAX_ALIAS_DB           (-50.0)
+
+/* Warm-up of the capture, then the time checked */
+#define TEST_WARMUP_MS              (200U)
+#define TEST_RUN_MS                 (1000U)
+#define TEST_MAX_FRAMES             (48000U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    double *samples;            /* First channel received on an instance */
+    uint32_t frames;
+} test_channel_t;
+
+typedef struct
+{
+    test_channel_t first;       /* Average of the channels of the microphone interface */
+    test_channel_t second;
+} test_capture_t;
+
+
+/*****************************************************************************
+* Function Name: test_source
+******************************************************************************
+* Summary:
+*  Tones of both microphones.
+*
+*****************************************************************************/
+static double test_source(void *arg, uint32_t microphone, double time_s)
+{
+    (void) arg;
+    (void) microphone;
+
+    return ((TEST_TONE_LEVEL) * sin(2.0 * M_PI * (TEST_TONE_HZ) * time_s)) +
+           ((TEST_ALIAS_LEVEL) * sin(2.0 * M_PI * (TEST_ALIAS_HZ) * time_s));
+}
+
+/*****************************************************************************
+* Function Name: test_sink
+******************************************************************************
+* Summary:
+*  Keep the samples of both streams, in full scale.
+*
+*****************************************************************************/
+static void test_sink(void *arg, uint32_t instance, const uint8_t *data, uint32_t size)
+{
+    test_capture_t *capture = (test_capture_t *) arg;
+    const int16_t *samples = (const int16_t *) data;
+    double sum;
+    uint32_t frame;
+    uint32_t ch;
+
+    if (TEST_INSTANCE_MIC == instance)
+    {
+        for (frame = 0U; (frame < (size / (TEST_FIRST_FRAME_BYTES))) && (capture->first.frames < (TEST_MAX_FRAMES)); frame++)
+        {
+            sum = 0.0;
+            for (ch = 0U; ch < (AUDIO_IN_NUM_CHANNELS); ch++)
+            {
+                sum += (double) samples[(frame * (AUDIO_IN_NUM_CHANNELS)) + ch];
+            }
+            capture->first.samples[capture->first.frames++] = sum / (32768.0 * (AUDIO_IN_NUM_CHANNELS));
+        }
+    }
+    else if (TEST_INSTANCE_SECOND == instance)
+    {
+        for (frame = 0U; (frame < (size / (TEST_SECOND_FRAME_BYTES))) && (capture->second.frames < (TEST_MAX_FRAMES)); frame++)
+        {
+            capture->second.samples[capture->second.frames++] = (double) samples[frame] / 32768.0;
+        }
+    }
+}
+
+/*****************************************************************************
+* Function Name: test_level
+******************************************************************************
+* Summary:
+*  Amplitude of a frequency in a channel, from its correlation with a
+*  complex tone over a whole number of periods of the tone.
+*
+*****************************************************************************/
+static double test_level(const test_channel_t *channel, double sample_rate, double frequency)
+{
+    uint32_t frames = (uint32_t) (floor(((double) channel->frames * frequency) / sample_rate) * sample_rate / frequency);
+    double re = 0.0;
+    double im = 0.0;
+    uint32_t i;
+
+    for (i = 0U; i < frames; i++)
+    {
+        re += channel->samples[i] * cos(2.0 * M_PI * frequency * (double) i / sample_rate);
+        im += channel->samples[i] * sin(2.0 * M_PI * frequency * (double) i / sample_rate);
+    }
+
+    return (0U == frames) ? 0.0 : (2.0 * sqrt((re * re) + (im * im)) / (double) frames);
+}
+
+/*****************************************************************************
+* Function Name: test_packets
+******************************************************************************
+* Summary:
+*  Check an instance sent a packet of the nominal size every frame since
+*  its statistics were cleared.
+*
+*****************************************************************************/
+static void test_packets(uint32_t instance, uint32_t nominal_frames, uint32_t frame_bytes)
+{
+    sim_usb_stats_t stats;
+    uint32_t nominal = nominal_frames * frame_bytes;
+
+    sim_usb_get_stats(instance, &stats);
+
+    printf("instance %u: %u packets, %u empty, %u..%u bytes\n", (unsigned) instance, stats.packets,
+           stats.empty_packets, stats.min_size, stats.max_size);
+    TEST_CHECK(stats.packets == (TEST_RUN_MS), "%u packets on instance %u", stats.packets, (unsigned) instance);
+    TEST_CHECK(0U == stats.empty_packets, "%u empty packets on instance %u", stats.empty_packets, (unsigned) instance);
+    TEST_CHECK(0U == stats.oversized, "%u oversized packets on instance %u", stats.oversized, (unsigned) instance);
+    TEST_CHECK((stats.min_size >= (nominal - frame_bytes)) && (stats.max_size <= (nominal + frame_bytes)),
+               "packets of %u..%u bytes on instance %u", stats.min_size, stats.max_size, (unsigned) instance);
+}
+
+/*****************************************************************************
+* Function Name: test_stream
+******************************************************************************
+* Summary:
+*  Stream for a while from the open interfaces, and check the packets and
+*  the tones of the second stream against the first one, or against the
+*  tone of the first stream measured before when it is closed. Return the
+*  tone of the first stream.
+*
+*****************************************************************************/
+static double test_stream(test_capture_t *capture, bool first_open, double reference)
+{
+    double tone;
+    double alias;
+    double drift;
+
+    capture->first.frames = 0U;
+    capture->second.frames = 0U;
+    sim_usb_clear_stats(TEST_INSTANCE_MIC);
+    sim_usb_clear_stats(TEST_INSTANCE_SECOND);
+    sim_usb_set_sink(test_sink, capture);
+    sim_run(TEST_RUN_MS);
+    sim_usb_set_sink(NULL, NULL);
+
+    test_packets(TEST_INSTANCE_SECOND, AUDIO_IN_SECOND_SAMPLE_FREQ / 1000U, TEST_SECOND_FRAME_BYTES);
+
+    tone = test_level(&capture->second, TEST_SECOND_RATE, TEST_TONE_HZ);
+    alias = test_level(&capture->second, TEST_SECOND_RATE, (TEST_ALIAS_HZ) - (TEST_SECOND_RATE));
+    if (first_open)
+    {
+        test_packets(TEST_INSTANCE_MIC, 48U, TEST_FIRST_FRAME_BYTES);
+        reference = test_level(&capture->first, TEST_FIRST_RATE, TEST_TONE_HZ);
+        alias = test_level(&capture->first, TEST_FIRST_RATE, TEST_ALIAS_HZ);
+        printf("first stream: %u frames, tone %.5f, %.5f at %.0f Hz\n", (unsigned) capture->first.frames,
+               reference, alias, TEST_ALIAS_HZ);
+
+        /* Every frame of the first stream decimated into the second one */
+        drift = ((double) capture->first.frames * (TEST_SECOND_RATE) / (TEST_FIRST_RATE)) - (double) capture->second.frames;
+        TEST_CHECK(fabs(drift) <= 1.0, "%u frames in the second stream for %u in the first one",
+                   (unsigned) capture->second.frames, (unsigned) capture->first.frames);
+    }
+
+    /* Same gains and DSP chain: the same tone, decimated, without the tone
+     * above the band
+     */
+    tone = test_level(&capture->second, TEST_SECOND_RATE, TEST_TONE_HZ);
+    alias = test_level(&capture->second, TEST_SECOND_RATE, (TEST_ALIAS_HZ) - (TEST_SECOND_RATE));
+    printf("second stream: %u frames, tone %.5f, alias at %.1f dB\n", (unsigned) capture->second.frames, tone,
+           20.0 * log10((alias / reference) + 1e-12));
+    TEST_CHECK(fabs(20.0 * log10(tone / reference)) <= (TEST_MAX_TONE_ERROR_DB),
+               "tone of %.5f in the second stream, %.5f in the first one", tone, reference);
+    TEST_CHECK((20.0 * log10((alias / reference) + 1e-12)) <= (TEST_MAX_ALIAS_DB),
+               "alias of %.5f in the second stream", alias);
+
+    return reference;
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed, TEST_SKIPPED() with the voice
+*       activity gating
+*
+*****************************************************************************/
+int main(void)
+{
+    const USBD_AUDIO_IF_CONF *second = &audio_interfaces[AUDIO_IF_SECOND];
+    test_capture_t capture;
+    double reference;
+
+#if (AUDIO_IN_VAD_GATING)
+    /* The stationary tone is not speech: it is gated, see test_vad_gating */
+    printf("Voice activity gating\n");
+    return TEST_SKIPPED();
+#endif /* AUDIO_IN_VAD_GATING */
+
+    capture.first.samples = calloc(TEST_MAX_FRAMES, sizeof(double));
+    capture.second.samples = calloc(TEST_MAX_FRAMES, sizeof(double));
+
+    /* Descriptors: a one-channel terminal with a single 16 KHz format */
+    TEST_CHECK((1U == second->TotalNrChannels) && (1U == second->NumFormats) &&
+               (AUDIO_IN_SECOND_SAMPLE_FREQ == second->paFormats[0].SamFreq),
+               "second stream: %u channels, %u formats", second->TotalNrChannels, second->NumFormats);
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+    sim_pdm_set_source(test_source, NULL);
+
+    /* Both interfaces */
+    sim_usb_set_interface(TEST_INSTANCE_MIC, TEST_ALT_48K);
+    sim_usb_set_interface(TEST_INSTANCE_SECOND, TEST_ALT_SECOND);
+    sim_run(TEST_WARMUP_MS);
+    reference = test_stream(&capture, true, 0.0);
+
+    /* The second stream alone, captured at AUDIO_IN_SECOND_CAPTURE_FREQ */
+    sim_usb_set_interface(TEST_INSTANCE_MIC, 0U);
+    sim_run(TEST_WARMUP_MS);
+    TEST_CHECK(sim_pdm_is_running(), "capture stopped by closing the microphone interface");
+    (void) test_stream(&capture, false, reference);
+
+    sim_usb_set_interface(TEST_INSTANCE_SECOND, 0U);
+    sim_run(100U);
+    TEST_CHECK(!sim_pdm_is_powered(), "capture powered after the streams closed");
+    TEST_CHECK(0U == sim_pdm_get_overflows(), "%u overflows", (unsigned) sim_pdm_get_overflows());
+
+    free(capture.first.samples);
+    free(capture.second.samples);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
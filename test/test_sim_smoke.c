@@ -0,0 +1,111 @@
+/*****************************************************************************
+* File Name    : test_sim_smoke.c
+*
+* Description  : This file contains the smoke test of the host simulation: the
+*                device enumerates, streams 48 KHz stereo and every packet matches
+*                the nominal rate and fits in wMaxPacketSize.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "sim.h"
+#include "test_util.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* Alternate setting of 48 KHz, 16 bits, on every channel of the microphone
+ * interface (one with the beamformer)
+ */
+#define TEST_ALT_48K                (6U)
+#define TEST_FRAME_BYTES            AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE)
+#define TEST_NOMINAL_BYTES          (48U * (TEST_FRAME_BYTES))
+
+/* Warm-up of the capture, then the time checked */
+#define TEST_WARMUP_MS              (200U)
+#define TEST_RUN_MS                 (5000U)
+
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    sim_usb_stats_t stats;
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+
+    TEST_CHECK(!sim_pdm_is_powered(), "capture powered before the stream opens");
+
+    sim_usb_set_interface(0U, TEST_ALT_48K);
+    sim_run(TEST_WARMUP_MS);
+    TEST_CHECK(sim_pdm_is_running(), "capture not running");
+
+    sim_usb_clear_stats(0U);
+    sim_run(TEST_RUN_MS);
+    sim_usb_get_stats(0U, &stats);
+
+    printf("%u packets, %u empty, %u..%u bytes\n", stats.packets, stats.empty_packets, stats.min_size,
+           stats.max_size);
+    TEST_CHECK(stats.packets == (TEST_RUN_MS), "%u packets", stats.packets);
+    TEST_CHECK(0U == stats.empty_packets, "%u empty packets", stats.empty_packets);
+    TEST_CHECK(0U == stats.oversized, "%u oversized packets", stats.oversized);
+    TEST_CHECK((stats.min_size >= ((TEST_NOMINAL_BYTES) - (TEST_FRAME_BYTES))) &&
+               (stats.max_size <= ((TEST_NOMINAL_BYTES) + (TEST_FRAME_BYTES))),
+               "packets of %u..%u bytes", stats.min_size, stats.max_size);
+    TEST_CHECK(0U == sim_pdm_get_overflows(), "%u samples lost", sim_pdm_get_overflows());
+
+    sim_usb_set_interface(0U, 0U);
+    sim_run(100U);
+    TEST_CHECK(!sim_pdm_is_powered(), "capture powered after the stream closed");
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/*****************************************************************************
+* File Name    : test_stats_session.c
+*
+* Description  : This file contains the test of the statistics of the capture: they
+*                cover a whole stream, across the restarts of the capture (mute), and
+*                are reset when a stream opens and on request.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio_in.h"
+#include "sim.h"
+#include "test_util.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* 48 KHz 16 bits stereo */
+#define TEST_ALT_48K                (6U)
+
+#define TEST_RUN_MS                 (200U)
+#define TEST_MUTE_MS                (50U)
+
+/* Packets missing from the histogram: warm-up and prefill of each capture */
+#define TEST_MAX_MISSING            (20U)
+
+
+/*****************************************************************************
+* Function Name: test_count
+******************************************************************************
+* Summary:
+*  Get the number of packets in the latency histogram.
+*
+*****************************************************************************/
+static uint32_t test_count(void)
+{
+    latency_hist_t hist;
+
+    audio_in_get_latency(&hist);
+    return hist.count;
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed, TEST_SKIPPED() with the voice
+*       activity gating
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t first;
+    uint32_t count;
+
+#if (AUDIO_IN_VAD_GATING)
+    /* The stationary tone is not speech: it is gated, see test_vad_gating */
+    printf("Voice activity gating\n");
+    return TEST_SKIPPED();
+#endif /* AUDIO_IN_VAD_GATING */
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+
+    sim_usb_set_interface(0U, TEST_ALT_48K);
+    sim_run(TEST_RUN_MS);
+    first = test_count();
+    TEST_CHECK((first + (TEST_MAX_MISSING)) >= (TEST_RUN_MS), "%lu packets in the first run", (unsigned long) first);
+
+    /* The capture stops while muted, the statistics stay */
+    sim_usb_set_mute(0U, 1U);
+    sim_run(TEST_MUTE_MS);
+    TEST_CHECK(!sim_pdm_is_running(), "capture running while muted");
+    sim_usb_set_mute(0U, 0U);
+    sim_run(TEST_RUN_MS);
+    count = test_count();
+    printf("%lu packets, %lu after a mute\n", (unsigned long) first, (unsigned long) count);
+    TEST_CHECK((count + (2U * (TEST_MAX_MISSING))) >= (2U * (TEST_RUN_MS)), "%lu packets after a mute",
+               (unsigned long) count);
+
+    /* Reset on request */
+    audio_in_reset_stats();
+    sim_run(TEST_RUN_MS);
+    count = test_count();
+    TEST_CHECK((count <= (TEST_RUN_MS)) && ((count + (TEST_MAX_MISSING)) >= (TEST_RUN_MS)),
+               "%lu packets after a reset", (unsigned long) count);
+
+    /* Reset when a stream opens */
+    sim_usb_set_interface(0U, 0U);
+    sim_run(10U);
+    sim_usb_set_interface(0U, TEST_ALT_48K);
+    sim_run(TEST_RUN_MS);
+    count = test_count();
+    TEST_CHECK((count <= (TEST_RUN_MS)) && ((count + (TEST_MAX_MISSING)) >= (TEST_RUN_MS)),
+               "%lu packets in a new stream", (unsigned long) count);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
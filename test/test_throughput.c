@@ -0,0 +1,206 @@
+/*****************************************************************************
+* File Name    : test_throughput.c
+*
+* Description  : This file contains the throughput test of the capture modes: at 8,
+*                48 and 96 KHz, every 1 ms USB frame gets its packet, produced within
+*                the frame, at the rate of the microphones.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "sim.h"
+#include "test_util.h"
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_SETTLE_MS              (500U)
+#define TEST_RUN_MS                 (10000U)
+
+/* Bytes sent may differ from the rate by the depth regulated, in frames */
+#define TEST_MAX_DEPTH_FRAMES       (2U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    uint8_t alt_setting;
+    uint32_t sample_rate;
+    uint32_t frame_bytes;
+} test_mode_t;
+
+typedef struct
+{
+    uint64_t max_ns;            /* Latest packet from the start of its frame */
+    uint64_t last_frame;        /* USB frame of the last packet */
+    uint32_t skipped;           /* Frames without a packet, or with two */
+} test_budget_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+/* 16 bits at 8, 48 and 96 KHz, and the widest packet, 96 KHz 32 bits, on
+ * every channel of the microphone interface
+ */
+static const test_mode_t test_modes[] =
+{
+    {  1U,  8000U, AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE) },
+    {  6U, 48000U, AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE) },
+    {  7U, 96000U, AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE) },
+    { 13U, 96000U, AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE_32BIT) },
+};
+
+
+/*****************************************************************************
+* Function Name: test_sink
+******************************************************************************
+* Summary:
+*  Record how late in its USB frame each packet gets sent, and check every
+*  frame gets exactly one packet.
+*
+*****************************************************************************/
+static void test_sink(void *arg, uint32_t instance, const uint8_t *data, uint32_t size)
+{
+    test_budget_t *budget = (test_budget_t *) arg;
+    uint64_t frame = sim_now_ns() / (SIM_NS_PER_MS);
+    uint64_t offset = sim_now_ns() % (SIM_NS_PER_MS);
+
+    (void) instance;
+    (void) data;
+    (void) size;
+
+    if (offset > budget->max_ns)
+    {
+        budget->max_ns = offset;
+    }
+
+    if ((0U != budget->last_frame) && (frame != (budget->last_frame + 1U)))
+    {
+        budget->skipped++;
+    }
+    budget->last_frame = frame;
+}
+
+/*****************************************************************************
+* Function Name: test_mode
+******************************************************************************
+* Summary:
+*  Stream a mode and check every frame got its packet in time.
+*
+*****************************************************************************/
+static void test_mode(const test_mode_t *mode)
+{
+    test_budget_t budget = { 0U, 0U, 0U };
+    period_queue_stats_t queue;
+    sim_usb_stats_t stats;
+    uint64_t expected = ((uint64_t) mode->sample_rate * (TEST_RUN_MS) / 1000U) * mode->frame_bytes;
+    uint64_t tolerance = (uint64_t) (TEST_MAX_DEPTH_FRAMES) * ((mode->sample_rate / 1000U) + 1U) * mode->frame_bytes;
+
+    sim_usb_set_interface(0U, 0U);
+    sim_usb_set_sink(NULL, NULL);
+    sim_run(10U);
+    sim_usb_set_interface(0U, mode->alt_setting);
+    sim_run(TEST_SETTLE_MS);
+
+    audio_in_reset_stats();
+    sim_usb_clear_stats(0U);
+    sim_usb_set_sink(test_sink, &budget);
+    sim_run(TEST_RUN_MS);
+
+    audio_in_get_queue_stats(&queue);
+    sim_usb_get_stats(0U, &stats);
+    printf("%5lu Hz %u bytes/frame: %u packets, %llu bytes, latest packet %llu us into its frame\n",
+           (unsigned long) mode->sample_rate, mode->frame_bytes, stats.packets, (unsigned long long) stats.bytes,
+           (unsigned long long) (budget.max_ns / (SIM_NS_PER_US)));
+
+    /* The time charged moves the ends of the run within a frame */
+    TEST_CHECK(0U == budget.skipped, "%lu Hz: %u frames skipped", (unsigned long) mode->sample_rate, budget.skipped);
+    TEST_CHECK(((stats.packets + 1U) >= (TEST_RUN_MS)) && (stats.packets <= ((TEST_RUN_MS) + 1U)),
+               "%lu Hz: %u packets in %u ms", (unsigned long) mode->sample_rate, stats.packets, TEST_RUN_MS);
+    TEST_CHECK(budget.max_ns < (SIM_NS_PER_MS), "%lu Hz: packet sent after its frame",
+               (unsigned long) mode->sample_rate);
+    TEST_CHECK((0U == stats.empty_packets) && (0U == stats.oversized), "%lu Hz: %u empty, %u oversized",
+               (unsigned long) mode->sample_rate, stats.empty_packets, stats.oversized);
+    TEST_CHECK(0U == queue.underruns, "%lu Hz: %u underruns", (unsigned long) mode->sample_rate, queue.underruns);
+    TEST_CHECK((stats.bytes + tolerance >= expected) && (stats.bytes <= expected + tolerance),
+               "%lu Hz: %llu bytes instead of %llu", (unsigned long) mode->sample_rate,
+               (unsigned long long) stats.bytes, (unsigned long long) expected);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test. The time spent in the application is charged to the
+*  virtual time, so a slow path delays the packets.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed, TEST_SKIPPED() with the voice
+*       activity gating
+*
+*****************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+#if (AUDIO_IN_VAD_GATING)
+    /* The stationary tone is not speech: it is gated, see test_vad_gating */
+    printf("Voice activity gating\n");
+    return TEST_SKIPPED();
+#endif /* AUDIO_IN_VAD_GATING */
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+    sim_set_cpu_charge(true);
+
+    for (i = 0U; i < (sizeof(test_modes) / sizeof(test_modes[0])); i++)
+    {
+        test_mode(&test_modes[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
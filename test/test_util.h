@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name   : test_util.h
+*
+* Description : This file contains the helpers shared by the host tests.
+*
+* Note        : See README.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+******************************************************************************/
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Record a failed check, the test carries on to report every failure */
+#define TEST_CHECK(cond, ...) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            printf("FAIL %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            test_failures++; \
+        } \
+    } while (0)
+
+/* Exit code of the test */
+#define TEST_RESULT()               ((0U == test_failures) ? EXIT_SUCCESS : EXIT_FAILURE)
+
+/* Exit code of a test not applicable to the settings of the build (the
+ * SKIP_RETURN_CODE of the tests in test/CMakeLists.txt), unless a check
+ * failed before
+ */
+#define TEST_SKIPPED()              ((0U == test_failures) ? 77 : EXIT_FAILURE)
+
+
+/******************************************************************************
+* Global Variables
+******************************************************************************/
+static unsigned test_failures = 0U;
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TEST_UTIL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,379 @@
+/*****************************************************************************
+* File Name    : test_vad_gating.c
+*
+* Description  : This file contains the test of the voice activity gating:
+*                silent packets without speech, power down of the capture on
+*                sustained silence, and time to send speech starting while the
+*                capture is powered down.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "sim.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* 48 KHz 16 bits on every channel of the microphone interface */
+#define TEST_ALT_48K                (6U)
+#define TEST_FRAME_BYTES            AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE)
+
+/* Background noise and active level of the speech, in dBFS at the
+ * microphones, as the vad_speech_quiet.wav scene of test_vad_wav
+ */
+#define TEST_NOISE_DB               (-65.0)
+#define TEST_SPEECH_DB              (-30.0)
+
+/* Syllables of a voiced source with a gliding pitch, with a short attack
+ * and release
+ */
+#define TEST_SYLLABLE_S             (0.150)
+#define TEST_SYLLABLE_EVERY_S       (0.200)
+#define TEST_ATTACK_S               (0.010)
+#define TEST_HARMONICS              (20U)
+
+/* Speech, then silence long enough for the capture to power down */
+#define TEST_SPEECH_MS              (3000U)
+#define TEST_SILENCE_MS             (4000U)
+#define TEST_SETTLE_MS              (500U)
+
+/* The gate of audio_in.c: silence sent once the hangover of the VAD
+ * (DSP_VAD_HANGOVER_PERIODS) is over, power down AUDIO_IN_VAD_GATE_MS of
+ * silence later
+ */
+#define TEST_MAX_SILENT_AFTER_MS    (300U)
+#define TEST_MIN_GATE_MS            (2000U)
+#define TEST_MAX_GATE_MS            (2500U)
+
+/* Speech starting while the capture is powered down, at several times of
+ * the cycle of AUDIO_IN_VAD_SLEEP_MS (200 ms) asleep and
+ * AUDIO_IN_VAD_LISTEN_MS (40 ms) listening. A listen window may fall in the
+ * gap between two syllables, longer than what is left of the window after
+ * the warm-up: the speech is then sent from the next window. A capture
+ * sending speech does so within its listen window.
+ */
+#define TEST_RESUMES                (8U)
+#define TEST_RESUME_STEP_MS         (31U)
+#define TEST_MAX_RESUME_MS          (2U * (200U + 40U) + 20U)
+#define TEST_MAX_CAPTURE_RESUME_US  (40000U)
+
+/* Share of the packets sent during speech */
+#define TEST_MIN_SPEECH_PACKETS     (0.98)
+
+#define TEST_MAX_PACKETS            (60000U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    double speech_from_s;           /* Speech between these times, none if equal */
+    double speech_until_s;
+    uint32_t seed;                  /* Of the background noise */
+} test_stimulus_t;
+
+typedef struct
+{
+    uint64_t time_ms[TEST_MAX_PACKETS];
+    bool silent[TEST_MAX_PACKETS];
+    uint32_t packets;
+    uint32_t bad_sizes;             /* Packets off the nominal size */
+} test_capture_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static test_stimulus_t test_stimulus;
+static test_capture_t test_capture;
+
+
+/*****************************************************************************
+* Function Name: test_source
+******************************************************************************
+* Summary:
+*  Sound at both microphones: flat noise, and the syllables of the speech
+*  while it lasts.
+*
+*****************************************************************************/
+static double test_source(void *arg, uint32_t microphone, double time_s)
+{
+    test_stimulus_t *stimulus = (test_stimulus_t *) arg;
+    double noise;
+    double voice = 0.0;
+    double start;
+    double envelope;
+    double phase;
+    uint32_t harmonic;
+
+    (void) microphone;
+
+    /* Uniform noise of unit RMS */
+    stimulus->seed = (stimulus->seed * 1664525U) + 1013904223U;
+    noise = sqrt(3.0) * (((double) stimulus->seed / 2147483648.0) - 1.0);
+
+    if ((time_s >= stimulus->speech_from_s) && (time_s < stimulus->speech_until_s))
+    {
+        start = fmod(time_s - stimulus->speech_from_s, TEST_SYLLABLE_EVERY_S);
+        envelope = (start < (TEST_ATTACK_S)) ? (start / (TEST_ATTACK_S)) : 1.0;
+        envelope = (((TEST_SYLLABLE_S) - start) < (TEST_ATTACK_S)) ? (((TEST_SYLLABLE_S) - start) / (TEST_ATTACK_S)) : envelope;
+        envelope = (start < (TEST_SYLLABLE_S)) ? envelope : 0.0;
+
+        /* Pitch of 140 Hz gliding by 30 Hz at 1.3 Hz */
+        phase = 2.0 * M_PI * ((140.0 * time_s) - ((30.0 / (2.0 * M_PI * 1.3)) * cos(2.0 * M_PI * 1.3 * time_s)));
+        for (harmonic = 1U; harmonic <= (TEST_HARMONICS); harmonic++)
+        {
+            voice += sin((double) harmonic * phase) / (double) harmonic;
+        }
+
+        /* RMS of the harmonics: sqrt(sum of 1 / (2 n^2)) */
+        voice *= envelope * pow(10.0, (TEST_SPEECH_DB) / 20.0) / sqrt((M_PI * M_PI) / 12.0);
+    }
+
+    return (noise * pow(10.0, (TEST_NOISE_DB) / 20.0)) + voice;
+}
+
+/*****************************************************************************
+* Function Name: test_sink
+******************************************************************************
+* Summary:
+*  Record the time of each packet and whether it is silent.
+*
+*****************************************************************************/
+static void test_sink(void *arg, uint32_t instance, const uint8_t *data, uint32_t size)
+{
+    test_capture_t *capture = (test_capture_t *) arg;
+    uint32_t nominal = 48U * (TEST_FRAME_BYTES);
+    bool silent = true;
+    uint32_t i;
+
+    (void) instance;
+
+    for (i = 0U; (i < size) && silent; i++)
+    {
+        silent = (0U == data[i]);
+    }
+
+    if ((size < (nominal - (TEST_FRAME_BYTES))) || (size > (nominal + (TEST_FRAME_BYTES))))
+    {
+        capture->bad_sizes++;
+    }
+
+    if (capture->packets < (TEST_MAX_PACKETS))
+    {
+        capture->time_ms[capture->packets] = sim_now_ns() / (SIM_NS_PER_MS);
+        capture->silent[capture->packets] = silent;
+        capture->packets++;
+    }
+}
+
+/*****************************************************************************
+* Function Name: test_first
+******************************************************************************
+* Summary:
+*  Get the time of the first packet from a time on that is silent, or not.
+*  Return UINT64_MAX if none.
+*
+*****************************************************************************/
+static uint64_t test_first(uint64_t from_ms, bool silent)
+{
+    uint32_t i;
+
+    for (i = 0U; i < test_capture.packets; i++)
+    {
+        if ((test_capture.time_ms[i] >= from_ms) && (silent == test_capture.silent[i]))
+        {
+            return test_capture.time_ms[i];
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+/*****************************************************************************
+* Function Name: test_count
+******************************************************************************
+* Summary:
+*  Count the packets between two times, and the silent ones among them.
+*
+*****************************************************************************/
+static uint32_t test_count(uint64_t from_ms, uint64_t until_ms, uint32_t *silent)
+{
+    uint32_t count = 0U;
+    uint32_t i;
+
+    *silent = 0U;
+    for (i = 0U; i < test_capture.packets; i++)
+    {
+        if ((test_capture.time_ms[i] >= from_ms) && (test_capture.time_ms[i] < until_ms))
+        {
+            count++;
+            *silent += test_capture.silent[i] ? 1U : 0U;
+        }
+    }
+
+    return count;
+}
+
+/*****************************************************************************
+* Function Name: test_silence
+******************************************************************************
+* Summary:
+*  Stop the speech and stream until the capture powers down. Return the time
+*  of the power down, UINT64_MAX if it did not.
+*
+*****************************************************************************/
+static uint64_t test_silence(void)
+{
+    uint64_t end_ms = sim_now_ns() / (SIM_NS_PER_MS);
+    uint32_t i;
+
+    test_stimulus.speech_until_s = (double) end_ms / 1000.0;
+
+    for (i = 0U; i < (TEST_SILENCE_MS); i++)
+    {
+        sim_run(1U);
+        if (!sim_pdm_is_powered())
+        {
+            return sim_now_ns() / (SIM_NS_PER_MS);
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test: speech, silence until the capture powers down, then speech
+*  again at several times of the sleep and listen cycle of the gate.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    audio_in_power_stats_t power;
+    uint64_t start_ms;
+    uint64_t end_ms;
+    uint64_t gate_ms;
+    uint64_t resume_ms;
+    uint64_t max_resume_ms = 0U;
+    uint32_t packets;
+    uint32_t silent;
+    uint32_t i;
+
+    test_stimulus.seed = 1U;
+    test_stimulus.speech_from_s = 0.0;
+    test_stimulus.speech_until_s = 1e9;
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+    sim_pdm_set_source(test_source, &test_stimulus);
+    sim_usb_set_sink(test_sink, &test_capture);
+    sim_usb_set_interface(0U, TEST_ALT_48K);
+
+    /* Speech: sent, the capture keeps running */
+    sim_run(TEST_SETTLE_MS);
+    start_ms = sim_now_ns() / (SIM_NS_PER_MS);
+    sim_run(TEST_SPEECH_MS);
+    end_ms = sim_now_ns() / (SIM_NS_PER_MS);
+    packets = test_count(start_ms, end_ms, &silent);
+    audio_in_get_power_stats(&power);
+    printf("Speech: %lu packets, %lu silent\n", (unsigned long) packets, (unsigned long) silent);
+    TEST_CHECK(packets == (TEST_SPEECH_MS), "%lu packets during the speech", (unsigned long) packets);
+    TEST_CHECK((double) (packets - silent) >= ((TEST_MIN_SPEECH_PACKETS) * (double) packets),
+               "%lu silent packets during the speech", (unsigned long) silent);
+    TEST_CHECK(power.capturing && (0U == power.vad_gates), "capture gated during the speech");
+
+    /* Silence: silent packets after the hangover, then the power down */
+    gate_ms = test_silence();
+    printf("Silence: first silent packet %lld ms after the speech, power down after %lld ms\n",
+           (long long) (test_first(end_ms, true) - end_ms), (long long) (gate_ms - end_ms));
+    TEST_CHECK((test_first(end_ms, true) - end_ms) <= (TEST_MAX_SILENT_AFTER_MS),
+               "no silent packet %u ms after the speech", TEST_MAX_SILENT_AFTER_MS);
+    TEST_CHECK(UINT64_MAX == test_first(end_ms + (TEST_MAX_SILENT_AFTER_MS), false),
+               "packet not silent %u ms after the speech", TEST_MAX_SILENT_AFTER_MS);
+    TEST_CHECK(((gate_ms - end_ms) >= (TEST_MIN_GATE_MS)) && ((gate_ms - end_ms) <= (TEST_MAX_GATE_MS)),
+               "capture powered down %lld ms after the speech", (long long) (gate_ms - end_ms));
+
+    /* The packets carry on, silent, while the capture sleeps and listens */
+    sim_run(TEST_SETTLE_MS);
+    packets = test_count(gate_ms, gate_ms + (TEST_SETTLE_MS), &silent);
+    TEST_CHECK((packets == (TEST_SETTLE_MS)) && (silent == packets), "%lu packets, %lu silent, while gated",
+               (unsigned long) packets, (unsigned long) silent);
+
+    /* Speech again, from several times after the power down */
+    for (i = 0U; i < (TEST_RESUMES); i++)
+    {
+        TEST_CHECK(test_capture.packets < (TEST_MAX_PACKETS), "%lu packets recorded", (unsigned long) test_capture.packets);
+        sim_run(i * (TEST_RESUME_STEP_MS));
+        start_ms = sim_now_ns() / (SIM_NS_PER_MS);
+        test_stimulus.speech_from_s = (double) start_ms / 1000.0;
+        test_stimulus.speech_until_s = 1e9;
+        sim_run(TEST_SETTLE_MS);
+
+        resume_ms = test_first(start_ms, false) - start_ms;
+        max_resume_ms = (resume_ms > max_resume_ms) ? resume_ms : max_resume_ms;
+        TEST_CHECK(resume_ms <= (TEST_MAX_RESUME_MS), "speech sent %lld ms after its start", (long long) resume_ms);
+
+        TEST_CHECK(UINT64_MAX != test_silence(), "capture not powered down after the speech");
+    }
+
+    audio_in_get_power_stats(&power);
+    printf("%lu gates, speech sent within %lu ms of its start, capture resumed within %lu us\n",
+           (unsigned long) power.vad_gates, (unsigned long) max_resume_ms, (unsigned long) power.max_resume_us);
+    TEST_CHECK(power.vad_gates >= (1U + (TEST_RESUMES)), "%lu gates", (unsigned long) power.vad_gates);
+    TEST_CHECK(power.max_resume_us <= (TEST_MAX_CAPTURE_RESUME_US), "capture resumed in %lu us",
+               (unsigned long) power.max_resume_us);
+    TEST_CHECK(0U == test_capture.bad_sizes, "%lu packets off the nominal size", (unsigned long) test_capture.bad_sizes);
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,497 @@
+/*****************************************************************************
+* File Name    : test_vad_wav.c
+*
+* Description  : This file contains the test of the voice activity detector on WAV
+*                files: detection latency of utterances over several backgrounds, and
+*                false triggers on background noise, hum, level drift and clicks.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "dsp_bench.h"
+#include "dsp_vad.h"
+#include "test_util.h"
+#include "wav.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define TEST_SAMPLE_RATE            (16000U)
+#define TEST_PERIOD_FRAMES          ((TEST_SAMPLE_RATE) / 1000U)
+#define TEST_SECONDS                (12U)
+
+/* Background alone at the start of each file: the noise floor is kept
+ * across streams and settles on the new background meanwhile. Nothing is
+ * measured before.
+ */
+#define TEST_LEAD_IN_MS             (2000U)
+
+/* Utterances of 800 ms, one every 2 s after the lead-in, in syllables of
+ * 150 ms and gaps of 50 ms
+ */
+#define TEST_UTTERANCE_MS           (800U)
+#define TEST_UTTERANCE_EVERY_MS     (2000U)
+#define TEST_SYLLABLE_MS            (150.0)
+#define TEST_SYLLABLE_EVERY_MS      (200.0)
+#define TEST_ATTACK_MS              (10.0)
+
+/* Detection: latency from the start of an utterance, and part of the
+ * utterance decided as speech
+ */
+#define TEST_MAX_LATENCY_MS         (20U)
+#define TEST_MIN_COVERAGE           (0.95)
+
+/* False triggers: periods decided as speech on a background alone */
+#define TEST_MAX_FALSE_RATE         (0.01)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef enum
+{
+    TEST_NOISE_WHITE,               /* Flat noise */
+    TEST_NOISE_FAN,                 /* Low-pass noise */
+    TEST_NOISE_HUM,                 /* Mains hum and its harmonics over flat noise */
+    TEST_NOISE_DRIFT,               /* Flat noise rising 6 dB over the file */
+    TEST_NOISE_CLICKS,              /* Lone 2 ms clicks every 500 ms over flat noise */
+} test_noise_t;
+
+typedef struct
+{
+    const char *name;
+    test_noise_t noise;
+    double noise_db;                /* RMS level of the background */
+    double speech_db;               /* Active level of the utterances, -INFINITY for none */
+} test_scene_t;
+
+typedef struct
+{
+    uint32_t utterances;            /* Utterances in the file, and detected */
+    uint32_t detected;
+    double max_latency_ms;
+    double avg_latency_ms;
+    double coverage;                /* Part of the utterances decided as speech */
+    double false_rate;              /* Part of the background decided as speech */
+    uint32_t onsets;                /* Transitions to speech after the lead-in */
+} test_result_t;
+
+
+/*****************************************************************************
+* Global Variables
+*****************************************************************************/
+static const test_scene_t test_scenes[] =
+{
+    { "vad_speech_quiet.wav",   TEST_NOISE_WHITE,  -65.0,     -30.0     },
+    { "vad_speech_fan.wav",     TEST_NOISE_FAN,    -45.0,     -24.0     },
+    { "vad_speech_low_snr.wav", TEST_NOISE_WHITE,  -50.0,     -36.0     },
+    { "vad_fan.wav",            TEST_NOISE_FAN,    -40.0,     -INFINITY },
+    { "vad_hum.wav",            TEST_NOISE_HUM,    -45.0,     -INFINITY },
+    { "vad_drift.wav",          TEST_NOISE_DRIFT,  -60.0,     -INFINITY },
+    { "vad_clicks.wav",         TEST_NOISE_CLICKS, -60.0,     -INFINITY },
+};
+
+
+/*****************************************************************************
+* Function Name: test_in_utterance
+******************************************************************************
+* Summary:
+*  Get whether a time falls in an utterance of a speech scene.
+*
+*****************************************************************************/
+static bool test_in_utterance(uint32_t ms)
+{
+    return (ms >= (TEST_LEAD_IN_MS)) && (((ms - (TEST_LEAD_IN_MS)) % (TEST_UTTERANCE_EVERY_MS)) < (TEST_UTTERANCE_MS));
+}
+
+/*****************************************************************************
+* Function Name: test_background
+******************************************************************************
+* Summary:
+*  Synthesize the background of a scene at its RMS level.
+*
+*****************************************************************************/
+static void test_background(const test_scene_t *scene, double *samples, uint32_t frames)
+{
+    double level = pow(10.0, scene->noise_db / 20.0);
+    double *white = calloc(frames, sizeof(double));
+    double t;
+    double lp = 0.0;
+    double sum = 0.0;
+    uint32_t harmonic;
+    uint32_t i;
+
+    /* Uniform noise of unit RMS */
+    dsp_bench_noise(white, frames, 1U, sqrt(3.0), 5U);
+
+    for (i = 0U; i < frames; i++)
+    {
+        t = (double) i / (double) (TEST_SAMPLE_RATE);
+
+        switch (scene->noise)
+        {
+            case TEST_NOISE_FAN:
+                /* One pole at about 200 Hz, normalized below */
+                lp += 0.08 * (white[i] - lp);
+                samples[i] = lp;
+                break;
+
+            case TEST_NOISE_HUM:
+                samples[i] = 0.1 * white[i];
+                for (harmonic = 1U; harmonic <= 5U; harmonic += 2U)
+                {
+                    samples[i] += sin(2.0 * (DSP_BENCH_PI) * 50.0 * harmonic * t) / (double) harmonic;
+                }
+                break;
+
+            case TEST_NOISE_DRIFT:
+                samples[i] = white[i] * pow(10.0, (6.0 * t) / (20.0 * (double) (TEST_SECONDS)));
+                break;
+
+            default:
+                samples[i] = white[i];
+                break;
+        }
+        sum += samples[i] * samples[i];
+    }
+
+    for (i = 0U; i < frames; i++)
+    {
+        samples[i] *= level / sqrt(sum / (double) frames);
+    }
+
+    /* Clicks of 2 ms at -10 dBFS, decaying */
+    if (TEST_NOISE_CLICKS == scene->noise)
+    {
+        for (i = 0U; i < frames; i++)
+        {
+            t = (double) (i % ((TEST_SAMPLE_RATE) / 2U)) / (double) (TEST_SAMPLE_RATE);
+            if (t < 0.002)
+            {
+                samples[i] += 0.3 * exp(-t / 0.0005) * ((0U == (i % 2U)) ? 1.0 : -1.0);
+            }
+        }
+    }
+
+    free(white);
+}
+
+/*****************************************************************************
+* Function Name: test_utterances
+******************************************************************************
+* Summary:
+*  Add the utterances of a speech scene: syllables of a voiced source with
+*  a gliding pitch and its harmonics, with a short attack and release, at
+*  the active level of the scene.
+*
+*****************************************************************************/
+static void test_utterances(const test_scene_t *scene, double *samples, uint32_t frames)
+{
+    double *voice = calloc(frames, sizeof(double));
+    double attack = (TEST_ATTACK_MS) / 1000.0;
+    double length = (TEST_SYLLABLE_MS) / 1000.0;
+    double phase = 0.0;
+    double sum = 0.0;
+    uint32_t active = 0U;
+    double envelope;
+    double start;
+    double pitch;
+    double t;
+    uint32_t harmonic;
+    uint32_t i;
+
+    for (i = 0U; i < frames; i++)
+    {
+        t = (double) i / (double) (TEST_SAMPLE_RATE);
+        if (!test_in_utterance((uint32_t) (t * 1000.0)))
+        {
+            continue;
+        }
+
+        start = fmod(t - ((double) (TEST_LEAD_IN_MS) / 1000.0), (double) (TEST_UTTERANCE_EVERY_MS) / 1000.0);
+        start = fmod(start, (TEST_SYLLABLE_EVERY_MS) / 1000.0);
+        envelope = (start < attack) ? (start / attack) : 1.0;
+        envelope = ((length - start) < attack) ? ((length - start) / attack) : envelope;
+        envelope = (start < length) ? envelope : 0.0;
+
+        pitch = 140.0 + (30.0 * sin(2.0 * (DSP_BENCH_PI) * 1.3 * t));
+        phase += 2.0 * (DSP_BENCH_PI) * pitch / (double) (TEST_SAMPLE_RATE);
+        for (harmonic = 1U; harmonic <= 20U; harmonic++)
+        {
+            voice[i] += sin((double) harmonic * phase) / (double) harmonic;
+        }
+        voice[i] *= envelope;
+        if (envelope > 0.0)
+        {
+            sum += voice[i] * voice[i];
+            active++;
+        }
+    }
+
+    for (i = 0U; i < frames; i++)
+    {
+        samples[i] += voice[i] * pow(10.0, scene->speech_db / 20.0) / sqrt(sum / (double) active);
+    }
+
+    free(voice);
+}
+
+/*****************************************************************************
+* Function Name: test_scene
+******************************************************************************
+* Summary:
+*  Synthesize the file of a scene.
+*
+*****************************************************************************/
+static void test_scene(const test_scene_t *scene, wav_t *wav)
+{
+    uint32_t frames = (TEST_SAMPLE_RATE) * (TEST_SECONDS);
+    double *samples = calloc(frames, sizeof(double));
+    double value;
+    uint32_t i;
+
+    test_background(scene, samples, frames);
+    if (isfinite(scene->speech_db))
+    {
+        test_utterances(scene, samples, frames);
+    }
+
+    wav->frames = frames;
+    wav->channels = 1U;
+    wav->sample_rate = TEST_SAMPLE_RATE;
+    wav->samples = malloc(frames * sizeof(int16_t));
+    for (i = 0U; i < frames; i++)
+    {
+        value = nearbyint(samples[i] * 32768.0);
+        wav->samples[i] = (int16_t) ((value > 32767.0) ? 32767.0 : ((value < -32768.0) ? -32768.0 : value));
+    }
+
+    free(samples);
+}
+
+/*****************************************************************************
+* Function Name: test_run
+******************************************************************************
+* Summary:
+*  Run the detector on a file in 1 ms periods. With utterances, measure the
+*  latency of the decision from the start of each utterance and the part
+*  of the utterances decided as speech; the periods decided as speech
+*  outside the utterances and their hangover are false triggers.
+*
+*****************************************************************************/
+static void test_run(const wav_t *wav, bool speech, test_result_t *result)
+{
+    uint32_t period_frames = wav->sample_rate / 1000U;
+    uint32_t periods = wav->frames / period_frames;
+    uint32_t latency_sum = 0U;
+    uint32_t latency = 0U;
+    uint32_t speech_periods = 0U;
+    uint32_t utterance_periods = 0U;
+    uint32_t background = 0U;
+    uint32_t false_periods = 0U;
+    uint32_t since_end = UINT32_MAX;
+    bool pending = false;
+    bool in_utterance;
+    bool was_in_utterance = false;
+    bool was_speech;
+    dsp_block_t block;
+    uint32_t ms;
+
+    memset(result, 0, sizeof(*result));
+    dsp_vad_reset();
+    was_speech = dsp_vad_is_speech();
+
+    for (ms = 0U; ms < periods; ms++)
+    {
+        block.samples = &wav->samples[(size_t) ms * period_frames * wav->channels];
+        block.frames = period_frames;
+        block.channels = wav->channels;
+        block.sample_size = sizeof(int16_t);
+        dsp_vad_process(&block);
+
+        if (ms >= (TEST_LEAD_IN_MS))
+        {
+            in_utterance = speech && test_in_utterance(ms);
+
+            if (in_utterance)
+            {
+                if (!was_in_utterance)
+                {
+                    result->utterances++;
+                    pending = true;
+                    latency = 0U;
+                }
+                latency++;
+                since_end = 0U;
+                utterance_periods++;
+                speech_periods += dsp_vad_is_speech() ? 1U : 0U;
+
+                if (pending && dsp_vad_is_speech())
+                {
+                    pending = false;
+                    result->detected++;
+                    latency_sum += latency;
+                    result->max_latency_ms = ((double) latency > result->max_latency_ms) ?
+                                             (double) latency : result->max_latency_ms;
+                }
+            }
+            else
+            {
+                since_end = (UINT32_MAX != since_end) ? (since_end + 1U) : since_end;
+
+                /* Outside the utterances and their hangover */
+                if (since_end > (DSP_VAD_HANGOVER_PERIODS))
+                {
+                    background++;
+                    false_periods += dsp_vad_is_speech() ? 1U : 0U;
+                }
+            }
+
+            result->onsets += (dsp_vad_is_speech() && !was_speech) ? 1U : 0U;
+            was_in_utterance = in_utterance;
+        }
+        was_speech = dsp_vad_is_speech();
+    }
+
+    result->avg_latency_ms = (0U != result->detected) ? ((double) latency_sum / (double) result->detected) : 0.0;
+    result->coverage = (0U != utterance_periods) ? ((double) speech_periods / (double) utterance_periods) : 0.0;
+    result->false_rate = (0U != background) ? ((double) false_periods / (double) background) : 0.0;
+}
+
+/*****************************************************************************
+* Function Name: test_print
+******************************************************************************
+* Summary:
+*  Print the result of a run.
+*
+*****************************************************************************/
+static void test_print(const char *name, const test_result_t *result)
+{
+    printf("%-24s ", name);
+    if (0U != result->utterances)
+    {
+        printf("%lu/%lu utterances, latency %.1f ms (max %.0f), %.1f %% of the speech detected, ",
+               (unsigned long) result->detected, (unsigned long) result->utterances, result->avg_latency_ms,
+               result->max_latency_ms, result->coverage * 100.0);
+    }
+    printf("%.2f %% false triggers, %lu onsets\n", result->false_rate * 100.0, (unsigned long) result->onsets);
+}
+
+/*****************************************************************************
+* Function Name: test_file
+******************************************************************************
+* Summary:
+*  Run the detector on a WAV file and print the periods decided as speech.
+*
+*****************************************************************************/
+static int test_file(const char *path)
+{
+    test_result_t result;
+    wav_t wav;
+
+    if (!wav_read(path, &wav))
+    {
+        printf("Cannot read %s, 16-bit PCM only\n", path);
+        return EXIT_FAILURE;
+    }
+
+    /* Without utterances known, every period after the lead-in counts */
+    test_run(&wav, false, &result);
+    printf("%-24s %.2f %% of the periods after %u ms decided as speech, %lu onsets\n", path,
+           result.false_rate * 100.0, TEST_LEAD_IN_MS, (unsigned long) result.onsets);
+
+    wav_free(&wav);
+    return EXIT_SUCCESS;
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Without argument, write the scenes to WAV files, run the detector on
+*  them and check the latency, the detection and the false triggers. With
+*  a WAV file, run the detector on it.
+*
+* Parameters:
+*  argc: Number of arguments
+*  argv: [input.wav]
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    const test_scene_t *scene;
+    test_result_t result;
+    wav_t wav;
+    wav_t in;
+    uint32_t i;
+
+    if (argc > 1)
+    {
+        return test_file(argv[1]);
+    }
+
+    for (i = 0U; i < (sizeof(test_scenes) / sizeof(test_scenes[0])); i++)
+    {
+        scene = &test_scenes[i];
+        test_scene(scene, &wav);
+        TEST_CHECK(wav_write(scene->name, &wav) && wav_read(scene->name, &in), "%s not written", scene->name);
+        wav_free(&wav);
+
+        test_run(&in, isfinite(scene->speech_db), &result);
+        test_print(scene->name, &result);
+        wav_free(&in);
+
+        TEST_CHECK(result.detected == result.utterances, "%s: %lu of %lu utterances detected", scene->name,
+                   (unsigned long) result.detected, (unsigned long) result.utterances);
+        TEST_CHECK(result.max_latency_ms <= (double) (TEST_MAX_LATENCY_MS), "%s: latency of %.0f ms", scene->name,
+                   result.max_latency_ms);
+        TEST_CHECK((0U == result.utterances) || (result.coverage >= (TEST_MIN_COVERAGE)),
+                   "%s: %.1f %% of the speech detected", scene->name, result.coverage * 100.0);
+        TEST_CHECK(result.false_rate <= (TEST_MAX_FALSE_RATE), "%s: %.2f %% false triggers", scene->name,
+                   result.false_rate * 100.0);
+    }
+
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
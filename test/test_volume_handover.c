@@ -0,0 +1,280 @@
+/*****************************************************************************
+* File Name    : test_volume_handover.c
+*
+* Description  : This file contains the test of the volume control: the host moves the
+*                volume in 0.5 dB steps across the gain steps of the PDM/PCM block,
+*                and the captured tone never clicks.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "audio_app.h"
+#include "audio.h"
+#include "audio_in.h"
+#include "sim.h"
+#include "test_util.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/* 48 KHz 16 bits, on every channel of the microphone interface */
+#define TEST_ALT_SETTING            (6U)
+#define TEST_SAMPLE_RATE            (48000.0)
+#define TEST_FRAME_BYTES            AUDIO_IN_FRAME_SIZE_BYTES(AUDIO_IN_SUB_FRAME_SIZE)
+
+/* Tone of the microphones, not locked to the 1 ms period */
+#define TEST_TONE_HZ                (997.0)
+#define TEST_TONE_LEVEL             (0.1)
+
+#define TEST_SETTLE_MS              (300U)
+#define TEST_STEP_MS                (40U)
+
+/* Volume of the steps, in 1/256 dB: down from the maximum and back */
+#define TEST_VOLUME_STEP            (128)
+#define TEST_VOLUME_LOW             (0)
+
+/* Largest second difference of the tone, over the one of a clean tone of
+ * the same amplitude, and in LSB for the rounding and the gain ramps
+ */
+#define TEST_MAX_CURVATURE_RATIO    (1.3)
+#define TEST_MAX_CURVATURE_LSB      (8.0)
+
+/* Envelope of the tone: peak of each period. While the volume only goes
+ * down (or up), it never goes up (or down) by more than the sampling of
+ * the peak of the tone.
+ */
+#define TEST_PERIOD_FRAMES          (48U)
+#define TEST_MAX_ENVELOPE_RATIO     (0.005)
+#define TEST_MAX_ENVELOPE_LSB       (2.0)
+
+#define TEST_MAX_FRAMES             (200000U)
+
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+typedef struct
+{
+    int16_t *samples;           /* First channel received by the host */
+    uint32_t frames;
+    uint32_t turn;              /* Frame received when the volume started going up */
+} test_capture_t;
+
+
+/*****************************************************************************
+* Function Name: test_tone
+******************************************************************************
+* Summary:
+*  Tone of both microphones.
+*
+*****************************************************************************/
+static double test_tone(void *arg, uint32_t microphone, double time_s)
+{
+    (void) arg;
+    (void) microphone;
+
+    return (TEST_TONE_LEVEL) * sin(2.0 * M_PI * (TEST_TONE_HZ) * time_s);
+}
+
+/*****************************************************************************
+* Function Name: test_envelope
+******************************************************************************
+* Summary:
+*  Check the envelope of the tone moves in one direction between two frames.
+*  Return the number of periods that moved the other way.
+*
+*****************************************************************************/
+static uint32_t test_envelope(const test_capture_t *capture, uint32_t first, uint32_t last, bool down)
+{
+    double previous = -1.0;
+    double peak;
+    double margin;
+    uint32_t errors = 0U;
+    uint32_t frame;
+    uint32_t i;
+
+    for (frame = first; (frame + (TEST_PERIOD_FRAMES)) <= last; frame += (TEST_PERIOD_FRAMES))
+    {
+        peak = 0.0;
+        for (i = frame; i < (frame + (TEST_PERIOD_FRAMES)); i++)
+        {
+            peak = (fabs((double) capture->samples[i]) > peak) ? fabs((double) capture->samples[i]) : peak;
+        }
+
+        if (previous >= 0.0)
+        {
+            margin = ((TEST_MAX_ENVELOPE_RATIO) * previous) + (TEST_MAX_ENVELOPE_LSB);
+            if ((down && (peak > (previous + margin))) || (!down && (peak < (previous - margin))))
+            {
+                if (0U == errors)
+                {
+                    printf("Envelope %s from %.0f to %.0f LSB at frame %lu\n", down ? "up" : "down", previous, peak,
+                           (unsigned long) frame);
+                }
+                errors++;
+            }
+        }
+        previous = peak;
+    }
+
+    return errors;
+}
+
+/*****************************************************************************
+* Function Name: test_sink
+******************************************************************************
+* Summary:
+*  Keep the first channel of the packets.
+*
+*****************************************************************************/
+static void test_sink(void *arg, uint32_t instance, const uint8_t *data, uint32_t size)
+{
+    test_capture_t *capture = (test_capture_t *) arg;
+    const int16_t *samples = (const int16_t *) data;
+    uint32_t frame;
+
+    (void) instance;
+
+    for (frame = 0U; (frame < (size / (TEST_FRAME_BYTES))) && (capture->frames < (TEST_MAX_FRAMES)); frame++)
+    {
+        capture->samples[capture->frames++] = samples[frame * (AUDIO_IN_NUM_CHANNELS)];
+    }
+}
+
+/*****************************************************************************
+* Function Name: test_step
+******************************************************************************
+* Summary:
+*  Set a volume and stream for a while.
+*
+*****************************************************************************/
+static void test_step(int16_t volume)
+{
+    sim_usb_set_volume(0U, volume);
+    sim_run(TEST_STEP_MS);
+}
+
+/*****************************************************************************
+* Function Name: main
+******************************************************************************
+* Summary:
+*  Run the test. A gain step of the PDM/PCM block not compensated on the
+*  same sample by the gain stage is a step in the envelope of the tone,
+*  which shows as a peak of its second difference, and as an envelope
+*  going the wrong way while the volume sweeps.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: EXIT_SUCCESS if every check passed
+*
+*****************************************************************************/
+int main(void)
+{
+    test_capture_t capture;
+    double omega = 2.0 * sin(M_PI * (TEST_TONE_HZ) / (TEST_SAMPLE_RATE));
+    double peak = 0.0;
+    double bound;
+    double curvature;
+    double worst = 0.0;
+    uint32_t worst_frame = 0U;
+    uint32_t errors;
+    int32_t volume;
+    uint32_t i;
+
+    capture.samples = calloc(TEST_MAX_FRAMES, sizeof(int16_t));
+    capture.frames = 0U;
+    capture.turn = 0U;
+
+    audio_app_init();
+    sim_usb_connect();
+    sim_run(100U);
+
+    sim_pdm_set_source(test_tone, NULL);
+    sim_usb_set_volume(0U, AUDIO_IN_VOLUME_MAX);
+    sim_usb_set_interface(0U, TEST_ALT_SETTING);
+    sim_run(TEST_SETTLE_MS);
+    sim_usb_set_sink(test_sink, &capture);
+
+    for (volume = AUDIO_IN_VOLUME_MAX; volume >= (TEST_VOLUME_LOW); volume -= (TEST_VOLUME_STEP))
+    {
+        test_step((int16_t) volume);
+    }
+    capture.turn = capture.frames;
+    for (volume = (TEST_VOLUME_LOW) + (TEST_VOLUME_STEP); volume <= AUDIO_IN_VOLUME_MAX; volume += (TEST_VOLUME_STEP))
+    {
+        test_step((int16_t) volume);
+    }
+
+    sim_usb_set_sink(NULL, NULL);
+
+    for (i = 0U; i < capture.frames; i++)
+    {
+        peak = (fabs((double) capture.samples[i]) > peak) ? fabs((double) capture.samples[i]) : peak;
+    }
+    bound = ((TEST_MAX_CURVATURE_RATIO) * peak * omega * omega) + (TEST_MAX_CURVATURE_LSB);
+
+    for (i = 2U; i < capture.frames; i++)
+    {
+        curvature = fabs((double) capture.samples[i] - (2.0 * (double) capture.samples[i - 1U]) +
+                         (double) capture.samples[i - 2U]);
+        if (curvature > worst)
+        {
+            worst = curvature;
+            worst_frame = i;
+        }
+    }
+
+    printf("%lu frames, peak %.0f LSB, largest second difference %.1f LSB at frame %lu (clean tone %.1f LSB)\n",
+           (unsigned long) capture.frames, peak, worst, (unsigned long) worst_frame, peak * omega * omega);
+
+    errors = test_envelope(&capture, 0U, capture.turn, true) + test_envelope(&capture, capture.turn, capture.frames, false);
+
+    TEST_CHECK(capture.frames >= (((AUDIO_IN_VOLUME_MAX) / (TEST_VOLUME_STEP)) * 2U * (TEST_STEP_MS) * 47U),
+               "%lu frames received", (unsigned long) capture.frames);
+    TEST_CHECK(0U == errors, "envelope of the tone went the wrong way in %lu periods", (unsigned long) errors);
+    TEST_CHECK(worst <= bound, "click of %.1f LSB at frame %lu, over %.1f LSB", worst, (unsigned long) worst_frame,
+               bound);
+
+    free(capture.samples);
+    return TEST_RESULT();
+}
+
+/* [] END OF FILE */
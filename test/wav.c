@@ -0,0 +1,262 @@
+/*****************************************************************************
+* File Name    : wav.c
+*
+* Description  : This file contains the reader and the writer of the 16-bit PCM WAV
+*                files used by the host tests of the DSP stages.
+*
+* Note         : See README.md
+*
+******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*****************************************************************************/
+#include "wav.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+#define WAV_FORMAT_PCM              (1U)
+#define WAV_BITS_PER_SAMPLE         (16U)
+#define WAV_FMT_SIZE                (16U)
+
+
+/*****************************************************************************
+* Function Name: wav_get_u16
+******************************************************************************
+* Summary:
+*  Read a little-endian 16-bit field.
+*
+*****************************************************************************/
+static uint32_t wav_get_u16(const uint8_t *data)
+{
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8);
+}
+
+/*****************************************************************************
+* Function Name: wav_get_u32
+******************************************************************************
+* Summary:
+*  Read a little-endian 32-bit field.
+*
+*****************************************************************************/
+static uint32_t wav_get_u32(const uint8_t *data)
+{
+    return wav_get_u16(data) | (wav_get_u16(&data[2]) << 16);
+}
+
+/*****************************************************************************
+* Function Name: wav_put_u16
+******************************************************************************
+* Summary:
+*  Write a little-endian 16-bit field.
+*
+*****************************************************************************/
+static void wav_put_u16(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t) value;
+    data[1] = (uint8_t) (value >> 8);
+}
+
+/*****************************************************************************
+* Function Name: wav_put_u32
+******************************************************************************
+* Summary:
+*  Write a little-endian 32-bit field.
+*
+*****************************************************************************/
+static void wav_put_u32(uint8_t *data, uint32_t value)
+{
+    wav_put_u16(data, value & 0xFFFFU);
+    wav_put_u16(&data[2], value >> 16);
+}
+
+/*****************************************************************************
+* Function Name: wav_read
+******************************************************************************
+* Summary:
+*  Read a 16-bit PCM WAV file. The chunks other than "fmt " and "data" are
+*  skipped.
+*
+* Parameters:
+*  path: Path of the file
+*  wav: Samples read, to be freed with wav_free()
+*
+* Return:
+*  bool: false if the file cannot be read or is not 16-bit PCM
+*
+*****************************************************************************/
+bool wav_read(const char *path, wav_t *wav)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t header[12];
+    uint8_t chunk[8];
+    uint8_t fmt[WAV_FMT_SIZE];
+    bool has_fmt = false;
+    uint32_t size;
+    uint32_t i;
+
+    memset(wav, 0, sizeof(*wav));
+
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    if ((1U != fread(header, sizeof(header), 1U, file)) || (0 != memcmp(header, "RIFF", 4U)) ||
+        (0 != memcmp(&header[8], "WAVE", 4U)))
+    {
+        fclose(file);
+        return false;
+    }
+
+    while (1U == fread(chunk, sizeof(chunk), 1U, file))
+    {
+        size = wav_get_u32(&chunk[4]);
+
+        if ((0 == memcmp(chunk, "fmt ", 4U)) && (size >= (WAV_FMT_SIZE)))
+        {
+            if (1U != fread(fmt, sizeof(fmt), 1U, file))
+            {
+                break;
+            }
+            fseek(file, (long) (size - (WAV_FMT_SIZE) + (size & 1U)), SEEK_CUR);
+
+            wav->channels = wav_get_u16(&fmt[2]);
+            wav->sample_rate = wav_get_u32(&fmt[4]);
+            has_fmt = ((WAV_FORMAT_PCM) == wav_get_u16(fmt)) && ((WAV_BITS_PER_SAMPLE) == wav_get_u16(&fmt[14])) &&
+                      (0U != wav->channels);
+        }
+        else if ((0 == memcmp(chunk, "data", 4U)) && has_fmt)
+        {
+            wav->frames = size / (wav->channels * sizeof(int16_t));
+            wav->samples = malloc((size_t) wav->frames * wav->channels * sizeof(int16_t));
+            if ((NULL == wav->samples) ||
+                (wav->frames != fread(wav->samples, wav->channels * sizeof(int16_t), wav->frames, file)))
+            {
+                break;
+            }
+            fclose(file);
+
+            /* Samples are little-endian */
+            for (i = 0U; i < (wav->frames * wav->channels); i++)
+            {
+                wav->samples[i] = (int16_t) wav_get_u16((const uint8_t *) &wav->samples[i]);
+            }
+            return true;
+        }
+        else
+        {
+            fseek(file, (long) (size + (size & 1U)), SEEK_CUR);
+        }
+    }
+
+    fclose(file);
+    wav_free(wav);
+    return false;
+}
+
+/*****************************************************************************
+* Function Name: wav_write
+******************************************************************************
+* Summary:
+*  Write a 16-bit PCM WAV file.
+*
+* Parameters:
+*  path: Path of the file
+*  wav: Samples to write
+*
+* Return:
+*  bool: false if the file cannot be written
+*
+*****************************************************************************/
+bool wav_write(const char *path, const wav_t *wav)
+{
+    FILE *file = fopen(path, "wb");
+    uint32_t size = wav->frames * wav->channels * sizeof(int16_t);
+    uint8_t header[44];
+    uint8_t sample[2];
+    bool written;
+    uint32_t i;
+
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    memcpy(header, "RIFF", 4U);
+    wav_put_u32(&header[4], 36U + size);
+    memcpy(&header[8], "WAVEfmt ", 8U);
+    wav_put_u32(&header[16], WAV_FMT_SIZE);
+    wav_put_u16(&header[20], WAV_FORMAT_PCM);
+    wav_put_u16(&header[22], wav->channels);
+    wav_put_u32(&header[24], wav->sample_rate);
+    wav_put_u32(&header[28], wav->sample_rate * wav->channels * sizeof(int16_t));
+    wav_put_u16(&header[32], wav->channels * sizeof(int16_t));
+    wav_put_u16(&header[34], WAV_BITS_PER_SAMPLE);
+    memcpy(&header[36], "data", 4U);
+    wav_put_u32(&header[40], size);
+
+    written = (1U == fwrite(header, sizeof(header), 1U, file));
+    for (i = 0U; written && (i < (wav->frames * wav->channels)); i++)
+    {
+        wav_put_u16(sample, (uint16_t) wav->samples[i]);
+        written = (1U == fwrite(sample, sizeof(sample), 1U, file));
+    }
+
+    return (0 == fclose(file)) && written;
+}
+
+/*****************************************************************************
+* Function Name: wav_free
+******************************************************************************
+* Summary:
+*  Free the samples of a file read with wav_read().
+*
+* Parameters:
+*  wav: Samples to free
+*
+* Return:
+*  None
+*
+*****************************************************************************/
+void wav_free(wav_t *wav)
+{
+    free(wav->samples);
+    wav->samples = NULL;
+    wav->frames = 0U;
+}
+
+/* [] END OF FILE */